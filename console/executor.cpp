@@ -21,15 +21,28 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <csignal>
+#include <cstdlib>
+#include <deque>
 #include <functional>
 #include <future>
 #include <iostream>
 #include <map>
 #include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include <boost/format.hpp>
 #include <bitcoin/node.hpp>
 
+#if defined(HAVE_MSC)
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
 namespace libbitcoin {
 namespace node {
 
@@ -50,25 +63,35 @@ const std::unordered_map<std::string, uint8_t> executor::options_
 {
     { "b", menu::backup },
     { "c", menu::close },
+    { "d", menu::dump },
     { "e", menu::errors },
     { "g", menu::go },
     { "h", menu::hold },
     { "i", menu::info },
+    { "j", menu::adjust },
+    { "k", menu::kernel },
+    { "l", menu::live },
     { "m", menu::menu_ },
     { "t", menu::test },
+    { "u", menu::update },
     { "w", menu::work },
     { "z", menu::zeroize }
 };
 const std::unordered_map<uint8_t, std::string> executor::options_menu_
 {
+    { menu::adjust,  "ad[j]ust a setting, as j <name> <value>" },
     { menu::backup,  "[b]ackup the store" },
     { menu::close,   "[c]lose the node" },
+    { menu::dump,    "[d]ump trace of recent spans" },
     { menu::errors,  "[e]rrors in store" },
     { menu::go,      "[g]o network communication" },
     { menu::hold,    "[h]old network communication" },
     { menu::info,    "[i]nfo about store" },
+    { menu::kernel,  "[k]ernel I/O profile of store since last profile" },
+    { menu::live,    "[l]ive pipeline view, refreshed until repeated" },
     { menu::menu_,   "[m]enu of options and toggles" },
     { menu::test,    "[t]est built-in case" },
+    { menu::update,  "[u]pdate address index of archived txs" },
     { menu::work,    "[w]ork distribution" },
     { menu::zeroize, "[z]eroize disk full error" }
 };
@@ -503,6 +526,45 @@ void executor::scan_buckets() const
         span.count());
 }
 
+// Recommended hashmap buckets, at one record per bucket (mean load of one),
+// for records projected linearly to the sizing height. Lookup cost follows
+// the mean chain length (load), which governs populate and is_associated.
+// Tables without a record count are sized by the table that keys them (one
+// validated or neutrino record per block, one validated record per tx).
+void executor::advise_buckets() const
+{
+    const auto& config = metadata_.configured;
+    const auto top = std::max(query_.get_top_confirmed(), one);
+    const auto height = is_zero(config.sizing_height) ? top :
+        size_t{ config.sizing_height };
+
+    const auto advise = [&](const std::string& name, size_t buckets,
+        size_t records) NOEXCEPT
+    {
+        const auto load = is_zero(buckets) ? 0.0 : (1.0 * records / buckets);
+        const auto projected = possible_narrow_cast<size_t>(
+            (1.0 * records * height) / top);
+        logger(format(BN_SIZING_ROW) % name % buckets % records % load %
+            std::max(projected, one));
+    };
+
+    logger(format(BN_SIZING_START) % top % height);
+    const auto headers = query_.header_records();
+    const auto txs = query_.tx_records();
+    advise("header", query_.header_buckets(), headers);
+    advise("txs", query_.txs_buckets(), headers);
+    advise("tx", query_.tx_buckets(), txs);
+    advise("point", query_.point_buckets(), query_.point_records());
+    advise("spend", query_.spend_buckets(), query_.spend_records());
+    advise("strong_tx", query_.strong_tx_buckets(), query_.strong_tx_records());
+    advise("valid_tx", query_.validated_tx_buckets(), txs);
+    advise("valid_bk", query_.validated_bk_buckets(), headers);
+    if (query_.address_enabled())
+        advise("address", query_.address_buckets(), query_.address_records());
+    if (query_.neutrino_enabled())
+        advise("neutrino", query_.neutrino_buckets(), headers);
+}
+
 // hashmap collision distributions.
 // BUGBUG: the vector allocations are exceessive and can result in sigkill.
 // BUGBUG: must process each header independently as buckets may not coincide.
@@ -1780,6 +1842,462 @@ void executor::write_test()
 
 #endif // UNDEFINED
 
+// Benchmark.
+// ----------------------------------------------------------------------------
+
+// Peak resident set size of the process in KiB (zero if unavailable).
+static size_t peak_rss() NOEXCEPT
+{
+#if defined(HAVE_MSC)
+    PROCESS_MEMORY_COUNTERS counters{};
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+        sizeof(counters)) ? counters.PeakWorkingSetSize / 1024u : zero;
+#else
+    rusage usage{};
+    return is_zero(getrusage(RUSAGE_SELF, &usage)) ?
+        possible_narrow_sign_cast<size_t>(usage.ru_maxrss) : zero;
+#endif
+}
+
+// Page faults (major, minor) and block operations (read, write) of the process.
+// Windows does not distinguish major faults, so all are reported as minor.
+static std_array<uint64_t, 4> io_counters() NOEXCEPT
+{
+#if defined(HAVE_MSC)
+    IO_COUNTERS io{};
+    PROCESS_MEMORY_COUNTERS memory{};
+    const auto process = GetCurrentProcess();
+    if (!GetProcessMemoryInfo(process, &memory, sizeof(memory)) ||
+        !GetProcessIoCounters(process, &io))
+        return {};
+
+    return { 0, memory.PageFaultCount, io.ReadOperationCount,
+        io.WriteOperationCount };
+#else
+    rusage usage{};
+    if (!is_zero(getrusage(RUSAGE_SELF, &usage)))
+        return {};
+
+    return
+    {
+        possible_narrow_sign_cast<uint64_t>(usage.ru_majflt),
+        possible_narrow_sign_cast<uint64_t>(usage.ru_minflt),
+        possible_narrow_sign_cast<uint64_t>(usage.ru_inblock),
+        possible_narrow_sign_cast<uint64_t>(usage.ru_oublock)
+    };
+#endif
+}
+
+// Power of two microsecond latency buckets, shared by benchmark workers.
+class latency
+{
+public:
+    void add(const fine_clock::duration& span) NOEXCEPT
+    {
+        const auto micro = duration_cast<microseconds>(span).count();
+        const auto value = possible_narrow_sign_cast<uint64_t>(micro);
+        const auto bucket = is_zero(value) ? zero : add1(floored_log2(value));
+        buckets_.at(std::min(bucket, sub1(buckets_.size()))).fetch_add(one,
+            std::memory_order_relaxed);
+    }
+
+    size_t count() const NOEXCEPT
+    {
+        size_t total{};
+        for (const auto& bucket: buckets_)
+            total += bucket.load(std::memory_order_relaxed);
+
+        return total;
+    }
+
+    template <typename Writer>
+    void write(Writer&& writer) const NOEXCEPT
+    {
+        for (size_t bucket = 0; bucket < buckets_.size(); ++bucket)
+            if (const auto value = buckets_.at(bucket).load())
+                writer(power2<uint64_t>(bucket), value);
+    }
+
+private:
+    std_array<std::atomic_size_t, 32> buckets_{};
+};
+
+// Replays the configured candidate range through block accept and connect,
+// without networking or store writes. Each worker claims the next height.
+void executor::benchmark() const
+{
+    enum stage : uint8_t { read, populate, accept, connect };
+    static const std_array<std::string, 4> stages
+    {
+        "read", "populate", "accept", "connect"
+    };
+
+    const auto& config = metadata_.configured;
+    const auto& coin = config.bitcoin;
+    const size_t first = config.benchmark_start;
+    const size_t last = sub1(ceilinged_add(first,
+        std::max(size_t{ config.benchmark_count }, one)));
+    const auto threads = std::max(size_t{ config.node.threads }, one);
+    logger(format(BN_BENCHMARK_START) % first % last % threads);
+    logger(BN_OPERATION_INTERRUPT);
+
+    std_array<latency, 4> latencies{};
+    std::atomic_size_t next{ first };
+    std::atomic_size_t blocks{};
+    std::atomic_size_t txs{};
+    std::atomic_size_t inputs{};
+
+    std::mutex mutex{};
+    std::atomic_bool failed{};
+    std::string failure{};
+    size_t failed_height{};
+    std::string failed_stage{};
+
+    const auto fail = [&](size_t height, stage step, const std::string& what)
+    {
+        std::unique_lock lock(mutex);
+        if (!failed.exchange(true))
+        {
+            failed_height = height;
+            failed_stage = stages.at(step);
+            failure = what;
+        }
+    };
+
+    const auto work = [&]()
+    {
+        code ec{};
+        for (auto height = next.fetch_add(one); !cancel_ && !failed &&
+            height <= last; height = next.fetch_add(one))
+        {
+            auto start = fine_clock::now();
+            const auto lap = [&](stage step)
+            {
+                const auto now = fine_clock::now();
+                latencies.at(step).add(now - start);
+                start = now;
+            };
+
+            database::context ctx{};
+            const auto link = query_.to_candidate(height);
+            const auto block = query_.get_block(link);
+            if (!block || !query_.get_context(ctx, link))
+            {
+                fail(height, stage::read, "block not associated");
+                return;
+            }
+
+            lap(stage::read);
+            if (!query_.populate(*block))
+            {
+                fail(height, stage::populate, "missing prevouts");
+                return;
+            }
+
+            lap(stage::populate);
+            const chain::context state
+            {
+                ctx.flags,
+                block->header().timestamp(),
+                ctx.mtp,
+                ctx.height,
+                {},
+                {}
+            };
+
+            if ((ec = block->accept(state, coin.subsidy_interval_blocks,
+                coin.initial_subsidy())))
+            {
+                fail(height, stage::accept, ec.message());
+                return;
+            }
+
+            lap(stage::accept);
+            if ((ec = block->connect(state)))
+            {
+                fail(height, stage::connect, ec.message());
+                return;
+            }
+
+            lap(stage::connect);
+            size_t block_inputs{};
+            const auto& transactions = *block->transactions_ptr();
+            for (const auto& tx: transactions)
+                block_inputs += tx->inputs_ptr()->size();
+
+            blocks.fetch_add(one);
+            txs.fetch_add(transactions.size());
+            inputs.fetch_add(block_inputs);
+        }
+    };
+
+    const auto start = fine_clock::now();
+    std::vector<std::thread> workers{};
+    for (size_t thread = 0; thread < threads; ++thread)
+        workers.emplace_back(work);
+
+    for (auto& worker: workers)
+        worker.join();
+
+    if (cancel_)
+        logger(BN_OPERATION_CANCELED);
+
+    if (failed)
+        logger(format(BN_BENCHMARK_FAILURE) % failed_height % failed_stage %
+            failure);
+
+    const auto span = duration_cast<milliseconds>(fine_clock::now() - start);
+    const auto msecs = std::max(span.count(), int64_t{ 1 });
+    const auto rate = [&](size_t count)
+    {
+        return (count * 1000u) / possible_narrow_sign_cast<size_t>(msecs);
+    };
+
+    logger(format(BN_BENCHMARK_RESULT) % blocks.load() % span.count() %
+        txs.load() % inputs.load() % rate(blocks) % rate(txs) % rate(inputs) %
+        peak_rss());
+
+    for (size_t step = 0; step < stages.size(); ++step)
+    {
+        const auto& histogram = latencies.at(step);
+        logger(format(BN_BENCHMARK_STAGE) % stages.at(step) %
+            histogram.count());
+
+        histogram.write([&](uint64_t bound, size_t count)
+        {
+            logger(format(BN_BENCHMARK_BUCKET) % bound % count);
+        });
+    }
+}
+
+// Writes the benchmark range of confirmed blocks as concatenated wire blocks
+// (with witness), for replay into another store. Headers replay with blocks.
+void executor::record() const
+{
+    const auto& config = metadata_.configured;
+    const size_t first = config.benchmark_start;
+    const size_t last = sub1(ceilinged_add(first,
+        std::max(size_t{ config.benchmark_count }, one)));
+
+    system::ofstream file{ config.record, std::ios::out | std::ios::binary };
+    if (!file)
+    {
+        logger(format(BN_RECORD_UNAVAILABLE) % config.record.string());
+        return;
+    }
+
+    logger(format(BN_RECORD_START) % first % last % config.record.string());
+    logger(BN_OPERATION_INTERRUPT);
+
+    size_t blocks{};
+    uint64_t bytes{};
+    write::bytes::ostream sink{ file };
+    const auto start = fine_clock::now();
+    for (auto height = first; !cancel_ && height <= last; ++height)
+    {
+        const auto block = query_.get_block(query_.to_confirmed(height));
+        if (!block)
+        {
+            logger(format(BN_RECORD_FAILURE) % height);
+            break;
+        }
+
+        block->to_data(sink, true);
+        bytes += block->serialized_size(true);
+        ++blocks;
+    }
+
+    sink.flush();
+    if (cancel_)
+        logger(BN_OPERATION_CANCELED);
+
+    const auto span = duration_cast<milliseconds>(fine_clock::now() - start);
+    logger(format(BN_RECORD_COMPLETE) % blocks % bytes % span.count());
+}
+
+// Writes a chain above the configured genesis in the replay file format. This
+// is intended for regtest, where proof of work is a few hashes and retarget
+// is disabled. Outputs are anyone-can-spend (op_true), so spends require no
+// signatures, and coinbase outputs are spent once mature. A fork is written
+// after the chain, as a coinbase-only branch one block longer than the fork
+// depth, so that replay organizes it as a reorganization of the chain.
+void executor::generate() const
+{
+    using namespace chain;
+    constexpr auto maturity = 100_size;
+    constexpr auto spacing = 600_u32;
+    constexpr auto version = 4_u32;
+
+    const auto& config = metadata_.configured;
+    const auto& coin = config.bitcoin;
+    const auto count = std::max(size_t{ config.generate_count }, one);
+    const size_t spends = config.generate_txs;
+    const auto fanout = std::max(size_t{ config.generate_fanout }, one);
+    const auto fork = std::min(size_t{ config.generate_fork }, count);
+
+    system::ofstream file{ config.generate, std::ios::out | std::ios::binary };
+    if (!file)
+    {
+        logger(format(BN_GENERATE_UNAVAILABLE) % config.generate.string());
+        return;
+    }
+
+    logger(format(BN_GENERATE_START) % count % spends % fanout % fork);
+    logger(BN_OPERATION_INTERRUPT);
+
+    const chain::block& genesis = coin.genesis_block;
+    const auto work = genesis.header().bits();
+    const auto target = compact::expand(work);
+    const script anyone{ operations{ operation{ opcode::push_positive_1 } } };
+
+    // Coinbase outputs mature after maturity, others in the next block.
+    struct unspent
+    {
+        chain::point point;
+        uint64_t value;
+        size_t mature;
+    };
+
+    std::deque<unspent> maturing{};
+    std::deque<unspent> matured{};
+    hashes ancestry{ genesis.hash() };
+
+    const auto subsidy = [&](size_t height) NOEXCEPT
+    {
+        const auto halvings = height / coin.subsidy_interval_blocks;
+        return halvings < bits<uint64_t> ?
+            coin.initial_subsidy() >> halvings : 0_u64;
+    };
+
+    // The branch push distinguishes coinbases (and so blocks) of a fork.
+    const auto make_coinbase = [&](size_t height, uint8_t branch) NOEXCEPT
+    {
+        const script height_script{ operations
+        {
+            operation{ machine::number::chunk::from_integer(
+                to_signed(height)), true },
+            operation{ data_chunk{ branch, 0x00 }, true }
+        } };
+
+        return transaction
+        {
+            1,
+            inputs{ input{ point{ null_hash, point::null_index },
+                height_script, max_uint32 } },
+            outputs{ output{ subsidy(height), anyone } },
+            0
+        };
+    };
+
+    const auto mine = [&](const hash_digest& parent, size_t height,
+        const transactions& txs) NOEXCEPT
+    {
+        const auto timestamp = possible_narrow_cast<uint32_t>(
+            genesis.header().timestamp() + height * spacing);
+        const chain::block draft{ header{ version, parent, null_hash,
+            timestamp, work, 0 }, txs };
+        const auto merkle = draft.generate_merkle_root(false);
+
+        for (uint32_t nonce = 0; nonce < max_uint32; ++nonce)
+        {
+            const header candidate{ version, parent, merkle, timestamp, work,
+                nonce };
+            if (to_uintx(candidate.hash()) <= target)
+                return chain::block{ candidate, txs };
+        }
+
+        return draft;
+    };
+
+    size_t blocks{};
+    size_t txs{};
+    uint64_t bytes{};
+    write::bytes::ostream sink{ file };
+    const auto write_block = [&](const chain::block& block) NOEXCEPT
+    {
+        block.to_data(sink, true);
+        bytes += block.serialized_size(true);
+        txs += block.transactions_ptr()->size();
+        ++blocks;
+    };
+
+    const auto start = fine_clock::now();
+    for (size_t height = 1; !cancel_ && height <= count; ++height)
+    {
+        while (!maturing.empty() && maturing.front().mature <= height)
+        {
+            matured.push_back(maturing.front());
+            maturing.pop_front();
+        }
+
+        transactions body{ make_coinbase(height, 0) };
+        std::vector<unspent> created{};
+        for (size_t tx = 0; tx < spends && matured.size() >= fanout; ++tx)
+        {
+            inputs ins{};
+            uint64_t value{};
+            for (size_t index = 0; index < fanout; ++index)
+            {
+                const auto& prevout = matured.front();
+                ins.emplace_back(prevout.point, script{}, max_uint32);
+                value += prevout.value;
+                matured.pop_front();
+            }
+
+            // Spends pay no fee, the first output takes the remainder.
+            outputs outs{};
+            for (size_t index = 0; index < fanout; ++index)
+                outs.emplace_back((value / fanout) +
+                    (is_zero(index) ? (value % fanout) : 0_u64), anyone);
+
+            const transaction spend{ 1, std::move(ins), std::move(outs), 0 };
+            const auto hash = spend.hash(false);
+            for (size_t index = 0; index < fanout; ++index)
+                created.push_back(
+                {
+                    { hash, possible_narrow_cast<uint32_t>(index) },
+                    spend.outputs_ptr()->at(index)->value(),
+                    add1(height)
+                });
+
+            body.push_back(spend);
+        }
+
+        maturing.push_back(
+        {
+            { body.front().hash(false), 0 },
+            subsidy(height),
+            height + maturity
+        });
+
+        const auto block = mine(ancestry.back(), height, body);
+        ancestry.push_back(block.hash());
+        write_block(block);
+        matured.insert(matured.end(), created.begin(), created.end());
+    }
+
+    if (!is_zero(fork) && !cancel_)
+    {
+        auto parent = ancestry.at(count - fork);
+        for (auto height = add1(count - fork); !cancel_ &&
+            height <= add1(count); ++height)
+        {
+            const auto block = mine(parent, height, { make_coinbase(height,
+                1) });
+            parent = block.hash();
+            write_block(block);
+        }
+    }
+
+    sink.flush();
+    if (cancel_)
+        logger(BN_OPERATION_CANCELED);
+
+    const auto span = duration_cast<milliseconds>(fine_clock::now() - start);
+    logger(format(BN_GENERATE_COMPLETE) % blocks % txs % bytes %
+        config.generate.string() % span.count());
+}
+
 // Store functions.
 // ----------------------------------------------------------------------------
 
@@ -1847,23 +2365,31 @@ bool executor::create_store(bool details)
     return true;
 }
 
-// not timed or announced (generally fast)
+// Each table event reports the time since the previous, which isolates the
+// slow table opens (map and verify) of a large store.
 code executor::open_store_coded(bool details)
 {
-    ////logger(BN_DATABASE_STARTING);
+    const auto start = logger::now();
+    auto last = start;
     if (const auto ec = store_.open([&](auto event_, auto table)
     {
         if (details)
+        {
+            const auto now = logger::now();
+            const auto span = duration_cast<milliseconds>(now - last);
+            last = now;
             logger(format(BN_OPEN) %
                 full_node::store::events.at(event_) %
-                full_node::store::tables.at(table));
+                full_node::store::tables.at(table) % span.count());
+        }
     }))
     {
         logger(format(BN_DATABASE_START_FAIL) % ec.message());
         return ec;
     }
 
-    logger(BN_DATABASE_STARTED);
+    const auto span = duration_cast<milliseconds>(logger::now() - start);
+    logger(format(BN_DATABASE_TIMED_START) % span.count());
     return error::success;
 }
 
@@ -2007,66 +2533,314 @@ bool executor::cold_backup_store(bool details)
     return true;
 }
 
-// Command line options.
-// ----------------------------------------------------------------------------
-
-// --[h]elp
-bool executor::do_help()
+// The store must be closed, so that its files are consistent while copied.
+bool executor::archive_store(const std::filesystem::path& from,
+    const std::filesystem::path& to, bool details)
 {
-    log_.stop();
-    printer help(metadata_.load_options(), name_, BN_INFORMATION_MESSAGE);
-    help.initialize();
-    help.commandline(output_);
+    const auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+    logger(format(BN_ARCHIVE_STARTED) % from % to % threads);
+    const auto start = logger::now();
+    if (const auto ec = store_archive::copy(from, to, threads,
+        [&](const std::filesystem::path& file, uint64_t bytes)
+    {
+        if (details)
+            logger(format(BN_ARCHIVE) % file.string() % bytes);
+    }))
+    {
+        logger(format(BN_ARCHIVE_FAIL) % ec.message());
+        return false;
+    }
+
+    const auto span = duration_cast<seconds>(logger::now() - start);
+    logger(format(BN_ARCHIVE_COMPLETE) % span.count());
     return true;
 }
 
-// --[d]hardware
-bool executor::do_hardware()
+// The extracted store must confirm the milestone, which commits its headers.
+// Its blocks are then audited in the background (chaser_audit).
+bool executor::bootstrap_store(bool details)
 {
-    // Intrinsics can be safely compiled for unsupported platforms.
-    // The "try" functions exclude out checks for instructions not compiled in.
-    // But for instructions comiled in, each use currently invokes the "try".
-    // HOWEVER: win32 compiler vectorization config is tied to these options.
-    // HOWEVER: The process will crash if those are compiled and not present.
-    // So our options are portable, but related compiler optimizations are not.
-    // And in that case this function cannot even be executed. So test for
-    // avx512 or shani here (for example) and only after enable compiler opts.
+    const auto& config = metadata_.configured;
+    const auto& milestone = config.bitcoin.milestone;
+    if (milestone.hash() == null_hash)
+    {
+        logger(BN_BOOTSTRAP_MILESTONE);
+        return false;
+    }
 
-    log_.stop();
-    logger("Intrinsics...");
-    logger(format("arm..... platform:%1%.") % with_arm);
-    logger(format("intel... platform:%1%.") % with_xcpu);
-    logger(format("avx512.. platform:%1% compiled:%2%.") % system::try_avx512() % with_avx512);
-    logger(format("avx2.... platform:%1% compiled:%2%.") % system::try_avx2() % with_avx2);
-    logger(format("sse41... platform:%1% compiled:%2%.") % system::try_sse41() % with_sse41);
-    logger(format("shani... platform:%1% compiled:%2%.") % system::try_shani() % with_shani);
-    logger(format("neon.... platform:%1% compiled:%2%.") % system::try_neon() % with_neon);
-    return true;
-}
+    if (!archive_store(config.node.bootstrap_path, config.database.path,
+        details) || !open_store(details))
+        return false;
 
-// --[s]ettings
-bool executor::do_settings()
-{
-    log_.stop();
-    printer print(metadata_.load_settings(), name_, BN_SETTINGS_MESSAGE);
-    print.initialize();
-    print.settings(output_);
+    const auto link = query_.to_confirmed(milestone.height());
+    if (query_.get_header_key(link) != milestone.hash())
+    {
+        logger(format(BN_BOOTSTRAP_UNCOMMITTED) % milestone.height());
+        close_store(details);
+        std::error_code ec{};
+        std::filesystem::remove_all(config.database.path, ec);
+        return false;
+    }
+
+    logger(format(BN_BOOTSTRAP_COMPLETE) % milestone.height());
     return true;
 }
 
-// --[v]ersion
-bool executor::do_version()
+bool executor::serve_store(bool details)
 {
-    log_.stop();
-    dump_version();
+    const auto& config = metadata_.configured;
+    const auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+    logger(format(BN_SERVE_STARTED) % config.database.path %
+        config.node.serve_address % config.serve);
+    if (const auto ec = store_archive::serve(config.database.path,
+        config.node.serve_address, config.serve, threads, cancel_,
+        [&](const std::filesystem::path& file, uint64_t bytes)
+    {
+        if (details)
+            logger(format(BN_SIBLING) % file.string() % bytes);
+    }))
+    {
+        logger(format(BN_SERVE_FAIL) % ec.message());
+        return false;
+    }
+
+    logger(BN_SERVE_COMPLETE);
     return true;
 }
 
-// --[n]ewstore
-bool executor::do_new_store()
+// The fetched store must match the genesis block, each checkpoint and the
+// milestone at or below its confirmed top, and its confirmed headers must
+// each commit to the one below. It then syncs from there by p2p as normal.
+bool executor::sibling_store(bool details)
 {
-    log_.stop();
-    if (!check_store_path(true) ||
+    const auto& config = metadata_.configured;
+    const auto& path = config.database.path;
+    const auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+    logger(format(BN_SIBLING_STARTED) % config.node.sibling_host %
+        config.node.sibling_port % threads);
+
+    const auto start = logger::now();
+    if (const auto ec = store_archive::fetch(config.node.sibling_host,
+        config.node.sibling_port, path, threads,
+        [&](const std::filesystem::path& file, uint64_t bytes)
+    {
+        if (details)
+            logger(format(BN_SIBLING) % file.string() % bytes);
+    }))
+    {
+        logger(format(BN_SIBLING_FAIL) % ec.message());
+        std::error_code fault{};
+        std::filesystem::remove_all(path, fault);
+        return false;
+    }
+
+    const auto span = duration_cast<seconds>(logger::now() - start);
+    logger(format(BN_SIBLING_COMPLETE) % span.count());
+    if (!open_store(details))
+        return false;
+
+    auto points = config.bitcoin.checkpoints;
+    points.emplace_back(config.bitcoin.genesis_block.hash(), zero);
+    if (config.bitcoin.milestone.hash() != null_hash)
+        points.push_back(config.bitcoin.milestone);
+
+    const auto top = query_.get_top_confirmed();
+    const auto failed = std::find_if(points.begin(), points.end(),
+        [&](const auto& point)
+        {
+            return point.height() <= top && point.hash() !=
+                query_.get_header_key(query_.to_confirmed(point.height()));
+        });
+
+    auto linked = failed == points.end();
+    auto height = linked ? zero : failed->height();
+    auto previous = query_.get_header_key(query_.to_confirmed(zero));
+    while (linked && !cancel_ && height < top)
+    {
+        const auto link = query_.to_confirmed(++height);
+        const auto header = query_.get_header(link);
+        linked = header && header->previous_block_hash() == previous;
+        previous = query_.get_header_key(link);
+    }
+
+    if (!linked || cancel_)
+    {
+        logger(format(BN_SIBLING_UNCOMMITTED) % height);
+        close_store(details);
+        std::error_code fault{};
+        std::filesystem::remove_all(path, fault);
+        return false;
+    }
+
+    logger(format(BN_SIBLING_VERIFIED) % top);
+    return true;
+}
+
+// The milestone commits to the written headers, as each is confirmed.
+bool executor::write_headers(bool details)
+{
+    const auto& config = metadata_.configured;
+    const auto& milestone = config.bitcoin.milestone;
+    const auto top = milestone.height();
+    if (milestone.hash() == null_hash || query_.get_top_confirmed() < top ||
+        query_.get_header_key(query_.to_confirmed(top)) != milestone.hash())
+    {
+        logger(BN_HEADERS_MILESTONE);
+        return false;
+    }
+
+    logger(format(BN_HEADERS_WRITING) % top % config.headers);
+    const auto start = logger::now();
+    if (const auto ec = header_archive::write(config.headers, top,
+        [&](size_t height)
+        {
+            return query_.get_header(query_.to_confirmed(height));
+        }))
+    {
+        logger(format(BN_HEADERS_FAIL) % ec.message());
+        return false;
+    }
+
+    if (details)
+    {
+        const auto span = duration_cast<seconds>(logger::now() - start);
+        logger(format(BN_HEADERS_COMPLETE) % top % span.count());
+    }
+
+    return true;
+}
+
+// A new store is loaded with the header chain committed by the milestone, as
+// candidates with their contexts, so header sync resumes from the milestone.
+// Nothing is stored unless the entire file is committed.
+bool executor::load_headers(bool details)
+{
+    const auto& config = metadata_.configured;
+    const auto& settings = config.bitcoin;
+    const auto& milestone = settings.milestone;
+    if (milestone.hash() == null_hash)
+    {
+        logger(BN_HEADERS_MILESTONE);
+        return false;
+    }
+
+    // A store that is not new has already synced headers or been loaded.
+    if (!is_zero(query_.get_top_candidate()))
+        return true;
+
+    logger(format(BN_HEADERS_LOADING) % config.node.headers_path %
+        milestone.height());
+
+    const auto start = logger::now();
+    auto state = query_.get_candidate_chain_state(settings, zero);
+    if (const auto ec = header_archive::read(config.node.headers_path,
+        settings.genesis_block.hash(), milestone,
+        [&](const chain::header& header)
+        {
+            if (!state)
+                return false;
+
+            state = std::make_shared<chain::chain_state>(*state, header,
+                settings);
+
+            const auto& context = state->context();
+            const auto link = query_.set_link(header, database::context
+            {
+                possible_narrow_cast<database::context::flag::integer>(
+                    context.flags),
+                possible_narrow_cast<database::context::block::integer>(
+                    context.height),
+                context.median_time_past
+            });
+
+            return !link.is_terminal() && query_.push_candidate(link);
+        }))
+    {
+        logger(format(BN_HEADERS_FAIL) % ec.message());
+        return false;
+    }
+
+    if (details)
+    {
+        const auto span = duration_cast<seconds>(logger::now() - start);
+        logger(format(BN_HEADERS_COMPLETE) % milestone.height() %
+            span.count());
+    }
+
+    return true;
+}
+
+// Command line options.
+// ----------------------------------------------------------------------------
+
+// --[h]elp
+bool executor::do_help()
+{
+    log_.stop();
+    printer help(metadata_.load_options(), name_, BN_INFORMATION_MESSAGE);
+    help.initialize();
+    help.commandline(output_);
+    return true;
+}
+
+// --[d]hardware
+bool executor::do_hardware()
+{
+    // Intrinsics can be safely compiled for unsupported platforms.
+    // The "try" functions exclude out checks for instructions not compiled in.
+    // But for instructions comiled in, each use currently invokes the "try".
+    // HOWEVER: win32 compiler vectorization config is tied to these options.
+    // HOWEVER: The process will crash if those are compiled and not present.
+    // So our options are portable, but related compiler optimizations are not.
+    // And in that case this function cannot even be executed. So test for
+    // avx512 or shani here (for example) and only after enable compiler opts.
+
+    log_.stop();
+    logger("Intrinsics...");
+    logger(format("arm..... platform:%1%.") % with_arm);
+    logger(format("intel... platform:%1%.") % with_xcpu);
+    logger(format("avx512.. platform:%1% compiled:%2%.") % system::try_avx512() % with_avx512);
+    logger(format("avx2.... platform:%1% compiled:%2%.") % system::try_avx2() % with_avx2);
+    logger(format("sse41... platform:%1% compiled:%2%.") % system::try_sse41() % with_sse41);
+    logger(format("shani... platform:%1% compiled:%2%.") % system::try_shani() % with_shani);
+    logger(format("neon.... platform:%1% compiled:%2%.") % system::try_neon() % with_neon);
+
+    // Block check hashes txs and merkle levels with the system sha256, which
+    // dispatches multi-lane (merkle) and single-lane (txid) kernels at runtime.
+    const auto merkle =
+        (with_avx512 && system::try_avx512()) ? "avx512" :
+        (with_avx2 && system::try_avx2()) ? "avx2" :
+        (with_sse41 && system::try_sse41()) ? "sse41" : "native";
+    const auto single =
+        (with_shani && system::try_shani()) ? "shani" :
+        (with_neon && system::try_neon()) ? "neon" : "native";
+    logger(format("sha256.. merkle:%1% single:%2%.") % merkle % single);
+    return true;
+}
+
+// --[s]ettings
+bool executor::do_settings()
+{
+    log_.stop();
+    printer print(metadata_.load_settings(), name_, BN_SETTINGS_MESSAGE);
+    print.initialize();
+    print.settings(output_);
+    return true;
+}
+
+// --[v]ersion
+bool executor::do_version()
+{
+    log_.stop();
+    dump_version();
+    return true;
+}
+
+// --[n]ewstore
+bool executor::do_new_store()
+{
+    log_.stop();
+    if (!check_store_path(true) ||
         !create_store(true))
         return false;
 
@@ -2101,6 +2875,47 @@ bool executor::do_restore()
         && close_store();
 }
 
+// --archive
+bool executor::do_archive()
+{
+    log_.stop();
+    const auto& config = metadata_.configured;
+    return check_store_path()
+        && open_store()
+        && close_store()
+        && archive_store(config.database.path, config.archive, true);
+}
+
+// --serve
+bool executor::do_serve()
+{
+    log_.stop();
+    return check_store_path()
+        && open_store()
+        && close_store()
+        && serve_store(true);
+}
+
+// --headers
+bool executor::do_headers()
+{
+    log_.stop();
+    return check_store_path()
+        && open_store()
+        && write_headers(true)
+        && close_store();
+}
+
+// --extract
+bool executor::do_extract()
+{
+    log_.stop();
+    const auto& config = metadata_.configured;
+    return archive_store(config.extract, config.database.path, true)
+        && open_store()
+        && close_store();
+}
+
 // --[f]lags
 bool executor::do_flags()
 {
@@ -2161,6 +2976,18 @@ bool executor::do_collisions()
     return close_store();
 }
 
+// --sizing
+bool executor::do_sizing()
+{
+    log_.stop();
+    if (!check_store_path() ||
+        !open_store())
+        return false;
+
+    advise_buckets();
+    return close_store();
+}
+
 // --[t]read
 bool executor::do_read()
 {
@@ -2185,9 +3012,147 @@ bool executor::do_write()
     return close_store();
 }
 
+// --bench[m]ark
+bool executor::do_benchmark()
+{
+    log_.stop();
+    if (!check_store_path() ||
+        !open_store())
+        return false;
+
+    benchmark();
+    return close_store();
+}
+
+// --generate
+bool executor::do_generate()
+{
+    log_.stop();
+    generate();
+    return true;
+}
+
+// --record
+bool executor::do_record()
+{
+    log_.stop();
+    if (!check_store_path() ||
+        !open_store())
+        return false;
+
+    record();
+    return close_store();
+}
+
+// --replay
+// Blocks-first organizes whole blocks, and no peers are connected, so the
+// chasers are driven only by the replay file.
+bool executor::do_replay()
+{
+    auto& config = metadata_.configured;
+    config.node.headers_first = false;
+    config.network.inbound_connections = 0;
+    config.network.outbound_connections = 0;
+    config.network.peers.clear();
+    config.network.seeds.clear();
+    return do_run();
+}
+
+// --[e]vents
+bool executor::do_events()
+{
+    log_.stop();
+    const auto& config = metadata_.configured;
+    if (!config.log.binary_events)
+    {
+        logger(BN_EVENTS_NOT_BINARY);
+        return false;
+    }
+
+    const auto file = config.log.events_file();
+    system::ifstream source{ file, std::ios::in | std::ios::binary };
+    if (!source)
+    {
+        logger(format(BN_EVENTS_UNAVAILABLE) % file.string());
+        return false;
+    }
+
+    // Each line is the event, its total, and its count in each interval.
+    const auto period = std::max(config.events_period, 1_u32);
+    const auto rates = event_log::aggregate(source, period * 1'000_u32);
+    logger(format(BN_EVENTS_RATES) % file.string() % period);
+    for (const auto& [event_, counts]: rates)
+    {
+        uint64_t total{};
+        std::ostringstream line{};
+        for (const auto count: counts)
+        {
+            line << " " << count;
+            total += count;
+        }
+
+        const auto name = fired_.contains(event_) ? fired_.at(event_) :
+            serialize(event_);
+        logger(format("%1% %2%:%3%") % name % total % line.str());
+    }
+
+    return true;
+}
+
 // Runtime options.
 // ----------------------------------------------------------------------------
 
+// ad[j]ust
+void executor::do_adjust(const std::string& argument)
+{
+    static const std::unordered_map<std::string, bool> integral
+    {
+        { "allowed_deviation", false },
+        { "maximum_concurrency", true },
+        { "snapshot_bytes", true },
+        { "snapshot_valid", true }
+    };
+
+    const auto space = argument.find(' ');
+    const auto name = argument.substr(zero, space);
+    if (!integral.contains(name) || space == std::string::npos)
+    {
+        logger(BN_ADJUST_USAGE);
+        return;
+    }
+
+    // The entire value must parse, and integral settings must be whole.
+    // Values must be finite and within the domain of the tuned setting.
+    char* end{};
+    const auto text = trim_copy(argument.substr(add1(space)));
+    const auto value = std::strtod(text.c_str(), &end);
+    const auto parsed = !text.empty() && end == std::next(text.c_str(),
+        possible_narrow_and_sign_cast<ptrdiff_t>(text.size()));
+
+    uint64_t whole{};
+    float real{};
+    const tuning setting{ name, value };
+    const auto valid = parsed && (integral.at(name) ?
+        setting.integral(whole) : setting.real(real));
+
+    if (!valid)
+    {
+        logger(format(BN_ADJUST_INVALID) % name % text);
+        return;
+    }
+
+    if (!node_)
+    {
+        logger(BN_NODE_UNAVAILABLE);
+        return;
+    }
+
+    node_->notify(error::success, chase::tune, {},
+        make_payload<tuning>(setting));
+
+    logger(format(BN_ADJUST) % name % text);
+}
+
 // [b]ackup
 void executor::do_hot_backup()
 {
@@ -2207,6 +3172,35 @@ void executor::do_close()
     stop(error::success);
 }
 
+// [d]ump
+void executor::do_dump_trace() const
+{
+    if (!node_)
+    {
+        logger(BN_NODE_UNAVAILABLE);
+        return;
+    }
+
+    if (!node_->tracer().enabled())
+    {
+        logger(BN_NODE_TRACE_DISABLED);
+        return;
+    }
+
+    const auto file = metadata_.configured.log.trace_file();
+    system::ofstream sink{ file };
+    sink << node_->tracer().report();
+    sink.flush();
+
+    if (!sink)
+    {
+        logger(format(BN_NODE_TRACE_FAIL) % file.string());
+        return;
+    }
+
+    logger(format(BN_NODE_TRACE_WRITTEN) % file.string());
+}
+
 // [e]rrors
 void executor::do_report_condition() const
 {
@@ -2282,6 +3276,264 @@ void executor::do_test() const
     read_test();
 }
 
+// [u]pdate
+// Txs archived before the address table was populated are indexed by
+// partitions of their links across workers, on threads independent of the
+// node. Txs archived after the count is read are indexed by the store, so
+// the table must be empty (not yet indexed) when the backfill starts.
+void executor::do_index_addresses()
+{
+    if (!node_)
+    {
+        logger(BN_NODE_UNAVAILABLE);
+        return;
+    }
+
+    if (!query_.address_enabled())
+    {
+        logger(BN_ADDRESS_DISABLED);
+        return;
+    }
+
+    if (!is_zero(indexing_.load()) || !is_zero(query_.address_records()))
+    {
+        logger(BN_ADDRESS_POPULATED);
+        return;
+    }
+
+    stop_indexing();
+    const auto total = query_.tx_records();
+    const auto workers = std::min(total,
+        std::max(one, to_half(size_t{ std::thread::hardware_concurrency() })));
+
+    if (is_zero(workers))
+        return;
+
+    logger(format(BN_ADDRESS_STARTED) % total % workers);
+    const auto step = ceilinged_divide(total, workers);
+    indexed_.store(zero);
+    indexing_.store(workers);
+    for (size_t first = 0; first < total; first += step)
+        indexers_.emplace_back(&executor::index_addresses, this, first,
+            std::min(first + step, total), total);
+}
+
+// private (indexer thread)
+void executor::index_addresses(size_t first, size_t last, size_t total)
+{
+    using namespace database;
+    constexpr auto progress = 1'000'000_size;
+
+    auto failed = false;
+    for (auto tx = first; !failed && tx < last; ++tx)
+    {
+        if (cancel_ || halt_indexing_)
+            break;
+
+        for (const auto& out_fk: query_.to_outputs(possible_narrow_cast<
+            tx_link::integer>(tx)))
+        {
+            const auto output = query_.get_output(out_fk);
+            if (!output || !store_.address.put(output->script().hash(),
+                table::address::record{ {}, out_fk }))
+            {
+                logger(format(BN_ADDRESS_FAILED) % tx);
+                failed = true;
+                break;
+            }
+        }
+
+        const auto indexed = add1(indexed_.fetch_add(one));
+        if (is_multiple(indexed, progress))
+            logger(format(BN_ADDRESS_PROGRESS) % indexed % total);
+    }
+
+    if (is_one(indexing_.fetch_sub(one)))
+        logger(format(BN_ADDRESS_COMPLETE) % indexed_.load() %
+            query_.address_records());
+}
+
+// private
+void executor::stop_indexing()
+{
+    halt_indexing_.store(true);
+    for (auto& indexer: indexers_)
+        if (indexer.joinable())
+            indexer.join();
+
+    indexers_.clear();
+    halt_indexing_.store(false);
+}
+
+// [l]ive pipeline
+void executor::do_pipeline()
+{
+    if (!node_)
+    {
+        logger(BN_NODE_UNAVAILABLE);
+        return;
+    }
+
+    if (pipeline_.joinable())
+    {
+        stop_pipeline();
+        logger(BN_PIPELINE_STOPPED);
+        return;
+    }
+
+    pipeline_ = std::thread(&executor::pipeline, this);
+}
+
+// private (pipeline thread)
+// Heights are read from node metrics (candidate from the store), so this
+// does not post to any strand. Rates are blocks per second over the refresh.
+// Queue depths are handlers pending on each chaser strand, which requires
+// [node].instrument_strands (otherwise zero).
+void executor::pipeline() const
+{
+    using gauge = metrics_registry::gauge;
+    using strand = metrics_registry::strand;
+    constexpr auto refresh = seconds{ 5 };
+    constexpr auto poll = milliseconds{ 100 };
+
+    const auto& metrics = node_->metrics();
+    const auto heights = [&]() NOEXCEPT
+    {
+        return std_array<size_t, 4>
+        {
+            query_.get_top_candidate(),
+            possible_narrow_cast<size_t>(metrics.value(gauge::checked_height)),
+            possible_narrow_cast<size_t>(
+                metrics.value(gauge::validated_height)),
+            possible_narrow_cast<size_t>(
+                metrics.value(gauge::confirmed_height))
+        };
+    };
+
+    const auto depth = [&](strand id) NOEXCEPT
+    {
+        return metrics.strand_at(id).depth.load(std::memory_order_relaxed);
+    };
+
+    auto last = heights();
+    auto then = fine_clock::now();
+    while (!cancel_ && !halt_pipeline_)
+    {
+        for (auto wait = zero; wait < refresh / poll && !cancel_ &&
+            !halt_pipeline_; ++wait)
+            std::this_thread::sleep_for(poll);
+
+        const auto now = fine_clock::now();
+        const auto current = heights();
+        const auto msecs = std::max(duration_cast<milliseconds>(
+            now - then).count(), int64_t{ 1 });
+        const auto rate = [&](size_t stage) NOEXCEPT
+        {
+            return (floored_subtract(current.at(stage), last.at(stage)) *
+                1000u) / possible_narrow_sign_cast<size_t>(msecs);
+        };
+
+        logger(format(BN_PIPELINE) %
+            current.at(0) % rate(0) %
+            current.at(1) % rate(1) %
+            current.at(2) % rate(2) %
+            current.at(3) % rate(3) %
+            depth(strand::check) %
+            depth(strand::validate) %
+            depth(strand::confirm));
+
+        last = current;
+        then = now;
+    }
+}
+
+// private
+void executor::stop_pipeline()
+{
+    halt_pipeline_.store(true);
+    if (pipeline_.joinable())
+        pipeline_.join();
+
+    halt_pipeline_.store(false);
+}
+
+// [k]ernel I/O profile
+// Table body growth, page faults and block operations since the previous
+// profile (or store open). This is sampled only on demand, so it adds no cost
+// to the running node. Faults and block operations are of the process, as
+// tables are memory mapped and their paging is not attributed by the kernel.
+void executor::do_profile_io()
+{
+    static const std_array<std::string, 15> tables
+    {
+        "header", "txs", "tx", "point", "input", "output", "puts",
+        "candidate", "confirmed", "spend", "strong_tx", "valid_tx",
+        "valid_bk", "address", "neutrino"
+    };
+
+    static const std_array<std::string, 4> counters
+    {
+        "major_fault", "minor_fault", "block_read", "block_write"
+    };
+
+    const auto sample = sample_io();
+    const auto secs = std::max(duration_cast<seconds>(sample.time -
+        io_.time).count(), int64_t{ 1 });
+
+    const auto write = [&](std::ostringstream& out, const std::string& name,
+        uint64_t current, uint64_t previous) NOEXCEPT
+    {
+        const auto delta = floored_subtract(current, previous);
+        out << "\n   " << name << std::string(floored_subtract(11_size,
+            name.size()), ' ') << ":" << delta << " ("
+            << delta / possible_narrow_sign_cast<uint64_t>(secs) << "/s)";
+    };
+
+    std::ostringstream out{};
+    out << format(BN_PROFILE_IO) % secs;
+    for (size_t table = 0; table < tables.size(); ++table)
+        write(out, tables.at(table), sample.bodies.at(table),
+            io_.bodies.at(table));
+
+    for (size_t counter = 0; counter < counters.size(); ++counter)
+        write(out, counters.at(counter), sample.counters.at(counter),
+            io_.counters.at(counter));
+
+    if (node_)
+        out << "\n   archive_us :" << node_->metrics().observations(
+            metrics_registry::histogram::archive_microseconds);
+
+    logger(out.str());
+    io_ = sample;
+}
+
+// private
+executor::io_sample executor::sample_io() const
+{
+    return
+    {
+        {
+            query_.header_body_size(),
+            query_.txs_body_size(),
+            query_.tx_body_size(),
+            query_.point_body_size(),
+            query_.input_body_size(),
+            query_.output_body_size(),
+            query_.puts_body_size(),
+            query_.candidate_body_size(),
+            query_.confirmed_body_size(),
+            query_.spend_body_size(),
+            query_.strong_tx_body_size(),
+            query_.validated_tx_body_size(),
+            query_.validated_bk_body_size(),
+            query_.address_body_size(),
+            query_.neutrino_body_size()
+        },
+        io_counters(),
+        std::chrono::steady_clock::now()
+    };
+}
+
 // [w]ork
 void executor::do_report_work()
 {
@@ -2331,6 +3583,9 @@ bool executor::dispatch()
     if (config.slabs)
         return do_slabs();
 
+    if (!config.archive.empty())
+        return do_archive();
+
     if (config.backup)
         return do_backup();
 
@@ -2352,6 +3607,33 @@ bool executor::dispatch()
     if (config.information)
         return do_information();
 
+    if (config.sizing)
+        return do_sizing();
+
+    if (config.benchmark)
+        return do_benchmark();
+
+    if (config.events)
+        return do_events();
+
+    if (!config.extract.empty())
+        return do_extract();
+
+    if (!is_zero(config.serve))
+        return do_serve();
+
+    if (!config.headers.empty())
+        return do_headers();
+
+    if (!config.generate.empty())
+        return do_generate();
+
+    if (!config.record.empty())
+        return do_record();
+
+    if (!config.replay.empty())
+        return do_replay();
+
     if (config.test)
         return do_read();
 
@@ -2389,11 +3671,20 @@ executor::rotator_t executor::create_log_sink() const
 system::ofstream executor::create_event_sink() const
 {
     // Standard file name, within the [node].path directory.
-    return { metadata_.configured.log.events_file() };
+    const auto mode = metadata_.configured.log.binary_events ?
+        std::ios::out | std::ios::binary : std::ios::out;
+
+    return { metadata_.configured.log.events_file(), mode };
 }
 
 void executor::subscribe_log(std::ostream& sink)
 {
+    if (!is_zero(metadata_.configured.log.flush_milliseconds))
+    {
+        subscribe_buffered_log(sink);
+        return;
+    }
+
     log_.subscribe_messages([&](const code& ec, uint8_t level, time_t time,
         const std::string& message)
     {
@@ -2432,8 +3723,78 @@ void executor::subscribe_log(std::ostream& sink)
     });
 }
 
+// File and console are written by background threads, flushed upon each fault
+// message and terminated (with a final flush) by the terminal message.
+void executor::subscribe_buffered_log(std::ostream& sink)
+{
+    constexpr size_t limit = 65'536;
+    const milliseconds period{ metadata_.configured.log.flush_milliseconds };
+    const auto file = std::make_shared<buffered_sink>(sink, limit, period);
+    const auto console = std::make_shared<buffered_sink>(output_, limit,
+        period);
+
+    log_.subscribe_messages([&, file, console](const code& ec, uint8_t level,
+        time_t time, const std::string& message)
+    {
+        if (level >= toggle_.size())
+        {
+            const auto invalid = "Invalid log [" + serialize(level) + "] : " +
+                message;
+            file->write(invalid);
+            console->write(invalid);
+            return true;
+        }
+
+        // Write only selected logs.
+        if (!ec && !toggle_.at(level))
+            return true;
+
+        const auto prefix = format_zulu_time(time) + "." +
+            serialize(level) + " ";
+
+        if (ec)
+        {
+            file->write(prefix + message + "\n");
+            console->write(prefix + message + "\n");
+            file->write(prefix + BN_NODE_FOOTER + "\n");
+            console->write(prefix + BN_NODE_FOOTER + "\n");
+            console->write(prefix + BN_NODE_TERMINATE + "\n");
+            file->stop();
+            console->stop();
+            stopped_.set_value(ec);
+            return false;
+        }
+
+        file->write(prefix + message);
+        console->write(prefix + message);
+        if (level == levels::fault)
+        {
+            file->flush();
+            console->flush();
+        }
+
+        return true;
+    });
+}
+
 void executor::subscribe_events(std::ostream& sink)
 {
+    // Fixed-width records are neither formatted nor flushed per event.
+    if (metadata_.configured.log.binary_events)
+    {
+        log_.subscribe_events([&sink, start = logger::now()](const code& ec,
+            uint8_t event_, uint64_t value, const logger::time& point)
+        {
+            if (ec) return false;
+            const auto time = duration_cast<milliseconds>(point - start);
+            event_log::write(sink, { value, limit<uint32_t>(time.count()),
+                event_ });
+            return true;
+        });
+
+        return;
+    }
+
     log_.subscribe_events([&sink, start = logger::now()](const code& ec,
         uint8_t event_, uint64_t value, const logger::time& point)
     {
@@ -2530,10 +3891,21 @@ void executor::subscribe_capture()
             return true;
         }
 
-        if (options_.contains(token))
+        // An option may be followed by an argument (separated by space).
+        const auto space = token.find(' ');
+        const auto option = token.substr(zero, space);
+        const auto argument = space == std::string::npos ? std::string{} :
+            trim_copy(token.substr(add1(space)));
+
+        if (options_.contains(option))
         {
-            switch (options_.at(token))
+            switch (options_.at(option))
             {
+                case menu::adjust:
+                {
+                    do_adjust(argument);
+                    return true;
+                }
                 case menu::backup:
                 {
                     do_hot_backup();
@@ -2544,6 +3916,11 @@ void executor::subscribe_capture()
                     do_close();
                     return true;
                 }
+                case menu::dump:
+                {
+                    do_dump_trace();
+                    return true;
+                }
                 case menu::errors:
                 {
                     do_report_condition();
@@ -2564,6 +3941,16 @@ void executor::subscribe_capture()
                     do_info();
                     return true;
                 }
+                case menu::kernel:
+                {
+                    do_profile_io();
+                    return true;
+                }
+                case menu::live:
+                {
+                    do_pipeline();
+                    return true;
+                }
                 case menu::menu_:
                 {
                     do_menu();
@@ -2574,6 +3961,11 @@ void executor::subscribe_capture()
                     do_test();
                     return true;
                 }
+                case menu::update:
+                {
+                    do_index_addresses();
+                    return true;
+                }
                 case menu::work:
                 {
                     do_report_work();
@@ -2640,15 +4032,38 @@ bool executor::do_run()
             return false;
         }
     }
+    else if (!metadata_.configured.node.bootstrap_path.empty())
+    {
+        if (!bootstrap_store(true))
+        {
+            stopper(BN_NODE_STOPPED);
+            return false;
+        }
+    }
+    else if (!metadata_.configured.node.sibling_host.empty())
+    {
+        if (!sibling_store(true))
+        {
+            stopper(BN_NODE_STOPPED);
+            return false;
+        }
+    }
     else if (!check_store_path(true) || !create_store(true))
     {
         stopper(BN_NODE_STOPPED);
         return false;
     }
 
+    if (!metadata_.configured.node.headers_path.empty() && !load_headers(true))
+    {
+        stopper(BN_NODE_STOPPED);
+        return false;
+    }
+
     dump_body_sizes();
     dump_records();
     dump_buckets();
+    io_ = sample_io();
     ////logger(BN_MEASURE_PROGRESS_START);
     ////dump_progress();
 
@@ -2675,7 +4090,10 @@ bool executor::do_run()
     logger(BN_NETWORK_STOPPING);
 
     // Stop network (if not already stopped by self).
+    stop_replay();
+    stop_pipeline();
     node_->close();
+    stop_indexing();
 
     // Sizes and records change, buckets don't.
     dump_body_sizes();
@@ -2738,6 +4156,159 @@ void executor::handle_running(const code& ec)
     }
 
     logger(BN_NODE_RUNNING);
+    if (!metadata_.configured.replay.empty())
+        start_replay();
+}
+
+// Replay.
+// ----------------------------------------------------------------------------
+
+// Phase heights are taken from chaser events, which fire by height.
+void executor::start_replay()
+{
+    log_.subscribe_events([this](const code& ec, uint8_t event_,
+        uint64_t value, const logger::time&)
+    {
+        if (ec) return false;
+        const auto height = possible_narrow_cast<size_t>(value);
+        if (event_ == events::block_validated ||
+            event_ == events::validate_bypassed)
+            replay_validated_.store(std::max(replay_validated_.load(),
+                height));
+
+        if (event_ == events::block_confirmed ||
+            event_ == events::confirm_bypassed)
+            replay_confirmed_.store(std::max(replay_confirmed_.load(),
+                height));
+
+        return true;
+    });
+
+    replayer_ = std::thread(&executor::replay, this);
+}
+
+// private (replayer thread)
+// Blocks are organized in file order, with a bounded number outstanding, and
+// each phase is timed from the first organize until it reaches the last block.
+// The node is stopped when the replay completes (or fails).
+void executor::replay()
+{
+    constexpr auto window = 100_size;
+    constexpr auto poll = milliseconds{ 10 };
+    const auto& path = metadata_.configured.replay;
+    system::ifstream file{ path, std::ios::in | std::ios::binary };
+    if (!file)
+    {
+        logger(format(BN_REPLAY_UNAVAILABLE) % path.string());
+        stop(error::success);
+        return;
+    }
+
+    // Shared with organize handlers, which may outlive an early return.
+    // The top is the greatest organized height, as a file may contain forks.
+    struct progress
+    {
+        std::atomic_size_t pending{};
+        std::atomic_size_t top{};
+        std::atomic_size_t failed{};
+        std::mutex mutex{};
+        std::string failure{};
+    };
+
+    const auto state = std::make_shared<progress>();
+    const auto halted = [&]() NOEXCEPT
+    {
+        return cancel_ || halt_replay_ || !is_zero(state->failed.load());
+    };
+
+    const auto first = add1(query_.get_top_confirmed());
+    logger(format(BN_REPLAY_START) % path.string() % sub1(first));
+
+    size_t count{};
+    read::bytes::istream source{ file };
+    const auto start = fine_clock::now();
+    const auto lap = [&]() NOEXCEPT
+    {
+        return duration_cast<milliseconds>(fine_clock::now() - start).count();
+    };
+
+    while (!halted() && !source.is_exhausted())
+    {
+        const auto block = to_shared<chain::block>(source, true);
+        if (!source || !block->is_valid())
+        {
+            logger(format(BN_REPLAY_FAILURE) % add1(count) % "invalid block");
+            stop(error::success);
+            return;
+        }
+
+        while (state->pending.load() >= window && !halted())
+            std::this_thread::sleep_for(poll);
+
+        const auto position = ++count;
+        state->pending.fetch_add(one);
+        node_->organize(block, [state, position](const code& ec,
+            size_t height)
+        {
+            if (ec)
+            {
+                std::unique_lock lock(state->mutex);
+                if (is_zero(state->failed.load()))
+                {
+                    state->failure = ec.message();
+                    state->failed.store(position);
+                }
+            }
+            else if (height > state->top.load())
+            {
+                state->top.store(height);
+            }
+
+            state->pending.fetch_sub(one);
+        });
+    }
+
+    while (!is_zero(state->pending.load()) && !halted())
+        std::this_thread::sleep_for(poll);
+
+    const auto organized = lap();
+    const auto top = state->top.load();
+    while (replay_validated_.load() < top && !halted())
+        std::this_thread::sleep_for(poll);
+
+    const auto validated = lap();
+    while (replay_confirmed_.load() < top && !halted())
+        std::this_thread::sleep_for(poll);
+
+    const auto confirmed = lap();
+    if (const auto failed = state->failed.load())
+    {
+        std::unique_lock lock(state->mutex);
+        logger(format(BN_REPLAY_FAILURE) % failed % state->failure);
+    }
+    else if (cancel_ || halt_replay_)
+    {
+        logger(BN_OPERATION_CANCELED);
+    }
+    else
+    {
+        const auto msecs = std::max(confirmed, int64_t{ 1 });
+        logger(format(BN_REPLAY_RESULT) % count % first % top % organized %
+            validated % confirmed % ((count * 1000u) /
+                possible_narrow_sign_cast<size_t>(msecs)) % peak_rss());
+    }
+
+    stop(error::success);
+}
+
+// private
+void executor::stop_replay()
+{
+    halt_replay_.store(true);
+    if (replayer_.joinable())
+        replayer_.join();
+
+    halt_replay_.store(false);
 }
 
 bool executor::handle_stopped(const code& ec)
@@ -20,9 +20,13 @@
 #define LIBBITCOIN_NODE_EXECUTOR_HPP
 
 #include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <future>
 #include <iostream>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 #include <bitcoin/database.hpp>
 #include <bitcoin/node.hpp>
 
@@ -43,18 +47,31 @@ public:
 private:
     enum menu : uint8_t
     {
+        adjust,
         backup,
         close,
+        dump,
         errors,
         go,
         hold,
         info,
+        kernel,
+        live,
         menu_,
         test,
+        update,
         work,
         zeroize
     };
 
+    // Table body sizes, process I/O counters and time of an I/O profile.
+    struct io_sample
+    {
+        std_array<size_t, 15> bodies{};
+        std_array<uint64_t, 4> counters{};
+        std::chrono::steady_clock::time_point time{};
+    };
+
     using rotator_t = database::file::stream::out::rotator;
 
     void logger(const auto& message) const;
@@ -87,6 +104,13 @@ private:
     bool restore_store(bool details=false);
     bool hot_backup_store(bool details=false);
     bool cold_backup_store(bool details=false);
+    bool archive_store(const std::filesystem::path& from,
+        const std::filesystem::path& to, bool details=false);
+    bool bootstrap_store(bool details=false);
+    bool serve_store(bool details=false);
+    bool sibling_store(bool details=false);
+    bool write_headers(bool details=false);
+    bool load_headers(bool details=false);
     bool check_store_path(bool create=false) const;
 
     // Command line options.
@@ -97,24 +121,39 @@ private:
     bool do_new_store();
     bool do_backup();
     bool do_restore();
+    bool do_archive();
+    bool do_extract();
+    bool do_serve();
+    bool do_headers();
     bool do_flags();
     bool do_information();
     bool do_slabs();
     bool do_buckets();
     bool do_collisions();
+    bool do_sizing();
     bool do_read();
     bool do_write();
+    bool do_benchmark();
+    bool do_events();
+    bool do_generate();
+    bool do_record();
+    bool do_replay();
     bool do_run();
 
     // Runtime options.
+    void do_adjust(const std::string& argument);
     void do_hot_backup();
     void do_close();
     void do_suspend();
     void do_resume();
     void do_report_work();
+    void do_pipeline();
+    void do_profile_io();
+    void do_dump_trace() const;
     void do_reload_store();
     void do_menu() const;
     void do_test() const;
+    void do_index_addresses();
     void do_info() const;
     void do_report_condition() const;
 
@@ -123,12 +162,25 @@ private:
     void scan_buckets() const;
     void scan_collisions() const;
     void scan_slabs() const;
+    void advise_buckets() const;
+    void index_addresses(size_t first, size_t last, size_t total);
+    void stop_indexing();
+    void pipeline() const;
+    void stop_pipeline();
+    io_sample sample_io() const;
     void read_test() const;
     void write_test();
+    void benchmark() const;
+    void generate() const;
+    void record() const;
+    void start_replay();
+    void replay();
+    void stop_replay();
 
     rotator_t create_log_sink() const;
     system::ofstream create_event_sink() const;
     void subscribe_log(std::ostream& sink);
+    void subscribe_buffered_log(std::ostream& sink);
     void subscribe_events(std::ostream& sink);
     void subscribe_capture();
     void subscribe_connect();
@@ -158,6 +210,25 @@ private:
     std::promise<system::code> stopped_{};
     count_t sequence_{};
 
+    // Address backfill workers and progress.
+    std::vector<std::thread> indexers_{};
+    std::atomic_size_t indexed_{};
+    std::atomic_size_t indexing_{};
+    std::atomic_bool halt_indexing_{};
+
+    // Baseline of the next I/O profile.
+    io_sample io_{};
+
+    // Pipeline view refresh.
+    std::thread pipeline_{};
+    std::atomic_bool halt_pipeline_{};
+
+    // Replay feeder and phase heights (from chaser events).
+    std::thread replayer_{};
+    std::atomic_size_t replay_validated_{};
+    std::atomic_size_t replay_confirmed_{};
+    std::atomic_bool halt_replay_{};
+
     std::istream& input_;
     std::ostream& output_;
     network::logger log_{};
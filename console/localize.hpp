@@ -139,6 +139,12 @@ namespace node {
     "   wire conf :%8%\n" \
     "   wire cand :%9%"
 
+// --sizing
+#define BN_SIZING_START \
+    "Sizing from confirmed height [%1%] to projected height [%2%]..."
+#define BN_SIZING_ROW \
+    "   %1% buckets:%2% records:%3% load:%4% recommended:%5%"
+
 // --read
 #define BN_READ_ROW \
     ": %1% in %2% secs."
@@ -147,16 +153,71 @@ namespace node {
 #define BN_WRITE_ROW \
     ": %1% in %2% span."
 
+// --benchmark
+#define BN_BENCHMARK_START \
+    "Benchmark validation of candidates [%1%..%2%] on (%3%) threads."
+#define BN_BENCHMARK_FAILURE \
+    "Benchmark stopped at block [%1%] in %2%: %3%"
+#define BN_BENCHMARK_RESULT \
+    "Validated %1% blocks in %2% ms...\n" \
+    "   txs       :%3%\n" \
+    "   inputs    :%4%\n" \
+    "   blocks/s  :%5%\n" \
+    "   txs/s     :%6%\n" \
+    "   inputs/s  :%7%\n" \
+    "   peak rss  :%8% KiB"
+#define BN_BENCHMARK_STAGE \
+    "Stage %1% latency (%2% samples, microseconds)..."
+#define BN_BENCHMARK_BUCKET \
+    "   < %1% :%2%"
+
+// --record
+#define BN_RECORD_START \
+    "Record confirmed blocks [%1%..%2%] to [%3%]."
+#define BN_RECORD_UNAVAILABLE \
+    "Record file [%1%] cannot be created."
+#define BN_RECORD_FAILURE \
+    "Record stopped at block [%1%], not confirmed."
+#define BN_RECORD_COMPLETE \
+    "Recorded %1% blocks (%2% bytes) in %3% ms."
+
+// --generate
+#define BN_GENERATE_START \
+    "Generate (%1%) blocks of up to (%2%) txs of (%3%) fanout, fork (%4%)."
+#define BN_GENERATE_UNAVAILABLE \
+    "Generate file [%1%] cannot be created."
+#define BN_GENERATE_COMPLETE \
+    "Generated %1% blocks (%2% txs, %3% bytes) to [%4%] in %5% ms."
+
+// --replay
+#define BN_REPLAY_START \
+    "Replay blocks from [%1%] above height [%2%]."
+#define BN_REPLAY_UNAVAILABLE \
+    "Replay file [%1%] cannot be opened."
+#define BN_REPLAY_FAILURE \
+    "Replay stopped at block [%1%]: %2%"
+#define BN_REPLAY_RESULT \
+    "Replayed %1% blocks [%2%..%3%]...\n" \
+    "   organized :%4% ms\n" \
+    "   validated :%5% ms\n" \
+    "   confirmed :%6% ms\n" \
+    "   blocks/s  :%7%\n" \
+    "   peak rss  :%8% KiB"
+
 // run/general
 
 #define BN_CREATE \
     "create::%1%(%2%)"
 #define BN_OPEN \
-    "open::%1%(%2%)"
+    "open::%1%(%2%) %3% ms"
 #define BN_CLOSE \
     "close::%1%(%2%)"
 #define BN_BACKUP \
     "snapshot::%1%(%2%)"
+#define BN_ARCHIVE \
+    "archive::%1% (%2%) bytes"
+#define BN_SIBLING \
+    "sibling::%1% (%2%) bytes"
 #define BN_RESTORE \
     "restore::%1%(%2%)"
 #define BN_RELOAD \
@@ -166,14 +227,34 @@ namespace node {
 
 #define BN_NODE_INTERRUPT \
     "Press CTRL-C to stop the node."
-#define BN_DATABASE_STARTED \
-    "Database is started."
+#define BN_DATABASE_TIMED_START \
+    "Database started successfully in %1% ms."
 #define BN_NETWORK_STARTING \
     "Please wait while network is starting..."
 #define BN_NODE_START_FAIL \
     "Node failed to start with error '%1%'."
 #define BN_NODE_UNAVAILABLE \
     "Command not available until node started."
+#define BN_ADJUST \
+    "Setting [node].%1% adjusted to (%2%)."
+#define BN_ADJUST_INVALID \
+    "Setting [node].%1% value '%2%' is invalid."
+#define BN_ADJUST_USAGE \
+    "Adjust as 'j <name> <value>', where name is one of allowed_deviation, " \
+    "maximum_concurrency, snapshot_bytes or snapshot_valid."
+
+#define BN_ADDRESS_DISABLED \
+    "Address table is disabled, set [database].address_buckets to enable."
+#define BN_ADDRESS_POPULATED \
+    "Address index is populated or being populated."
+#define BN_ADDRESS_STARTED \
+    "Address index of (%1%) txs started with (%2%) workers."
+#define BN_ADDRESS_PROGRESS \
+    "Address index of (%1%) of (%2%) txs."
+#define BN_ADDRESS_FAILED \
+    "Address index failed at tx (%1%)."
+#define BN_ADDRESS_COMPLETE \
+    "Address index of (%1%) txs complete with (%2%) records."
 
 #define BN_NODE_BACKUP_STARTED \
     "Snapshot is started."
@@ -181,6 +262,44 @@ namespace node {
     "Snapshot failed with error '%1%'."
 #define BN_NODE_BACKUP_COMPLETE \
     "Snapshot complete in %1% secs."
+#define BN_ARCHIVE_STARTED \
+    "Copying store from %1% to %2% on %3% threads..."
+#define BN_ARCHIVE_FAIL \
+    "Store copy failed with error '%1%'."
+#define BN_ARCHIVE_COMPLETE \
+    "Store copy complete in %1% secs."
+#define BN_BOOTSTRAP_MILESTONE \
+    "Store bootstrap requires a milestone."
+#define BN_BOOTSTRAP_UNCOMMITTED \
+    "Store bootstrap is not committed by milestone [%1%], removed."
+#define BN_BOOTSTRAP_COMPLETE \
+    "Store bootstrapped to milestone [%1%]."
+#define BN_SERVE_STARTED \
+    "Serving store %1% to siblings on [%2%:%3%], press CTRL-C to stop..."
+#define BN_SERVE_FAIL \
+    "Store serve failed with error '%1%'."
+#define BN_SERVE_COMPLETE \
+    "Store serve stopped."
+#define BN_SIBLING_STARTED \
+    "Fetching store from sibling [%1%:%2%] on %3% connections..."
+#define BN_SIBLING_FAIL \
+    "Store fetch failed with error '%1%', removed."
+#define BN_SIBLING_COMPLETE \
+    "Store fetch complete in %1% secs."
+#define BN_SIBLING_UNCOMMITTED \
+    "Store from sibling is inconsistent at [%1%], removed."
+#define BN_SIBLING_VERIFIED \
+    "Store from sibling verified to confirmed height [%1%]."
+#define BN_HEADERS_MILESTONE \
+    "Header file requires a milestone, confirmed when writing."
+#define BN_HEADERS_WRITING \
+    "Writing (%1%) confirmed headers to %2%..."
+#define BN_HEADERS_LOADING \
+    "Loading headers from %1% to milestone [%2%]..."
+#define BN_HEADERS_FAIL \
+    "Header file failed with error '%1%'."
+#define BN_HEADERS_COMPLETE \
+    "Header file of (%1%) headers complete in %2% secs."
 
 #define BN_RELOAD_SPACE \
     "Free [%1%] bytes of disk space to restart."
@@ -202,6 +321,26 @@ namespace node {
 
 #define BN_NODE_REPORT_WORK \
     "Requested channel work report [%1%]."
+#define BN_PIPELINE \
+    "Pipeline (height +blocks/s) candidate:%1% +%2% checked:%3% +%4% " \
+    "validated:%5% +%6% confirmed:%7% +%8% queue check:%9% " \
+    "validate:%10% confirm:%11%"
+#define BN_PIPELINE_STOPPED \
+    "Pipeline view stopped."
+#define BN_PROFILE_IO \
+    "Store I/O over %1% secs (growth in bytes, count)..."
+#define BN_EVENTS_NOT_BINARY \
+    "Events analysis requires [log].binary_events."
+#define BN_EVENTS_UNAVAILABLE \
+    "Failed to open events file '%1%'."
+#define BN_EVENTS_RATES \
+    "Events of '%1%' as total and count per %2% seconds..."
+#define BN_NODE_TRACE_DISABLED \
+    "Tracing is disabled, set [node].trace_spans to enable."
+#define BN_NODE_TRACE_WRITTEN \
+    "Trace of recent spans written to '%1%'."
+#define BN_NODE_TRACE_FAIL \
+    "Failed to write trace to '%1%'."
 
 #define BN_NODE_STARTED \
     "Node is started."
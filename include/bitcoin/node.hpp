@@ -16,16 +16,50 @@
 
 #include <bitcoin/database.hpp>
 #include <bitcoin/network.hpp>
+#include <bitcoin/node/block_cache.hpp>
+#include <bitcoin/node/block_claims.hpp>
+#include <bitcoin/node/block_inventory.hpp>
+#include <bitcoin/node/block_template.hpp>
+#include <bitcoin/node/buffered_sink.hpp>
 #include <bitcoin/node/chase.hpp>
+#include <bitcoin/node/compact_relay.hpp>
 #include <bitcoin/node/configuration.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/download_budget.hpp>
 #include <bitcoin/node/error.hpp>
+#include <bitcoin/node/event_bus.hpp>
+#include <bitcoin/node/event_log.hpp>
 #include <bitcoin/node/events.hpp>
+#include <bitcoin/node/filter_checkpoints.hpp>
+#include <bitcoin/node/flow.hpp>
 #include <bitcoin/node/full_node.hpp>
+#include <bitcoin/node/hash_filter.hpp>
+#include <bitcoin/node/header_archive.hpp>
+#include <bitcoin/node/header_index.hpp>
+#include <bitcoin/node/header_ranges.hpp>
+#include <bitcoin/node/loopback_acceptor.hpp>
+#include <bitcoin/node/memory_governor.hpp>
+#include <bitcoin/node/metrics_registry.hpp>
+#include <bitcoin/node/metrics_server.hpp>
 #include <bitcoin/node/parser.hpp>
+#include <bitcoin/node/peer_scores.hpp>
+#include <bitcoin/node/prevout_cache.hpp>
+#include <bitcoin/node/query_server.hpp>
+#include <bitcoin/node/script_cache.hpp>
 #include <bitcoin/node/settings.hpp>
+#include <bitcoin/node/span_tracer.hpp>
+#include <bitcoin/node/startup_manifest.hpp>
+#include <bitcoin/node/store_archive.hpp>
+#include <bitcoin/node/template_server.hpp>
+#include <bitcoin/node/thread_affinity.hpp>
+#include <bitcoin/node/tx_pool.hpp>
+#include <bitcoin/node/tx_sketch.hpp>
 #include <bitcoin/node/version.hpp>
+#include <bitcoin/node/work_cache.hpp>
+#include <bitcoin/node/work_map.hpp>
+#include <bitcoin/node/worker_shares.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
+#include <bitcoin/node/chasers/chaser_audit.hpp>
 #include <bitcoin/node/chasers/chaser_block.hpp>
 #include <bitcoin/node/chasers/chaser_check.hpp>
 #include <bitcoin/node/chasers/chaser_confirm.hpp>
@@ -41,6 +75,9 @@
 #include <bitcoin/node/protocols/protocol_block_in.hpp>
 #include <bitcoin/node/protocols/protocol_block_in_31800.hpp>
 #include <bitcoin/node/protocols/protocol_block_out.hpp>
+#include <bitcoin/node/protocols/protocol_compact_in_70014.hpp>
+#include <bitcoin/node/protocols/protocol_compact_out_70014.hpp>
+#include <bitcoin/node/protocols/protocol_filter_out.hpp>
 #include <bitcoin/node/protocols/protocol_header_in_31800.hpp>
 #include <bitcoin/node/protocols/protocol_header_in_70012.hpp>
 #include <bitcoin/node/protocols/protocol_header_out_31800.hpp>
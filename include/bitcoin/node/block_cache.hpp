@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_BLOCK_CACHE_HPP
+#define LIBBITCOIN_NODE_BLOCK_CACHE_HPP
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe, memory-bounded, least recently used cache of blocks.
+/// Recently organized blocks are cached so that peers requesting the same
+/// block near the chain tip share one store read. Blocks are retained with
+/// witness, as one object serves both witness and non-witness requests.
+class BCN_API block_cache
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(block_cache);
+
+    /// Zero maximum bytes disables the cache.
+    block_cache(uint64_t maximum_bytes) NOEXCEPT;
+
+    /// Cache is enabled.
+    bool enabled() const NOEXCEPT;
+
+    /// Cache the block, evicting least recently used blocks upon overflow.
+    void put(const system::chain::block::cptr& block) NOEXCEPT;
+
+    /// Cached block by hash (and mark used), null if not cached.
+    system::chain::block::cptr get(
+        const system::hash_digest& hash) NOEXCEPT;
+
+    /// Evict least recently used blocks totaling at least the given bytes.
+    void trim(uint64_t bytes) NOEXCEPT;
+
+    /// Number of cached blocks.
+    size_t count() const NOEXCEPT;
+
+    /// Approximate current memory consumption.
+    uint64_t bytes() const NOEXCEPT;
+
+private:
+    struct entry
+    {
+        system::hash_digest hash;
+        system::chain::block::cptr block;
+        uint64_t bytes;
+    };
+
+    using entries = std::list<entry>;
+
+    // These are thread safe.
+    const uint64_t maximum_bytes_;
+    mutable std::mutex mutex_{};
+
+    // These are protected by mutex.
+    entries order_{};
+    std::unordered_map<system::hash_digest, entries::iterator> map_{};
+    uint64_t bytes_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_BLOCK_CLAIMS_HPP
+#define LIBBITCOIN_NODE_BLOCK_CLAIMS_HPP
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe claims of blocks that may be downloaded by more than one
+/// channel (endgame race, tip lane). A channel claims such a block before
+/// check and archive and releases it once archived, so that no other channel
+/// writes it concurrently. Hashes remain tracked (unclaimed) after release,
+/// until displaced by newer hashes, so that a late copy is still claimed.
+class BCN_API block_claims
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(block_claims);
+
+    /// Tracked hashes beyond which the oldest is displaced.
+    block_claims(size_t capacity) NOEXCEPT;
+
+    /// Track a hash issued to more than one channel (no-op if tracked).
+    void track(const system::hash_digest& hash) NOEXCEPT;
+
+    /// The hash is tracked.
+    bool tracked(const system::hash_digest& hash) const NOEXCEPT;
+
+    /// Claim (and track) the hash, false if claimed by another.
+    bool claim(const system::hash_digest& hash) NOEXCEPT;
+
+    /// Release a claim, the hash remains tracked.
+    void release(const system::hash_digest& hash) NOEXCEPT;
+
+    /// Number of tracked hashes.
+    size_t size() const NOEXCEPT;
+
+private:
+    void insert(const system::hash_digest& hash, bool claimed) NOEXCEPT;
+
+    // This is thread safe.
+    const size_t capacity_;
+
+    // These are protected by mutex.
+    std::unordered_map<system::hash_digest, bool> claimed_{};
+    std::deque<system::hash_digest> order_{};
+    mutable std::mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_BLOCK_INVENTORY_HPP
+#define LIBBITCOIN_NODE_BLOCK_INVENTORY_HPP
+
+#include <functional>
+#include <map>
+#include <shared_mutex>
+#include <unordered_map>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe merge of block inventories announced to blocks-first channels.
+/// Announced hashes are sequenced in order of first announcement and claimed
+/// by channels in sequence order, limited to a window above the next block to
+/// organize. Downloaded blocks are organized strictly in sequence order.
+class BCN_API block_inventory
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(block_inventory);
+
+    using organizer = std::function<void(const system::chain::block::cptr&,
+        organize_handler&&)>;
+
+    /// The window limits blocks claimed above the next to organize.
+    block_inventory(size_t window, organizer&& organize) NOEXCEPT;
+
+    /// Sequence announced hashes not previously merged, returns count added.
+    size_t merge(const system::hashes& announced) NOEXCEPT;
+
+    /// Claim up to count of the lowest unclaimed hashes within the window.
+    system::hashes claim(size_t count) NOEXCEPT;
+
+    /// Return claimed hashes not downloaded for claim by another channel.
+    void release(const system::hashes& hashes) NOEXCEPT;
+
+    /// Deposit a claimed block for organization, false if not claimed.
+    bool complete(const system::chain::block::cptr& block) NOEXCEPT;
+
+    /// Count of merged hashes not yet organized.
+    size_t pending() const NOEXCEPT;
+
+private:
+    void organize_next() NOEXCEPT;
+    void handle_organize(const code& ec, size_t height,
+        const system::chain::block::cptr& block) NOEXCEPT;
+
+    // These are thread safe.
+    const size_t window_;
+    const organizer organize_;
+
+    // These are protected by mutex.
+    std::unordered_map<system::hash_digest, size_t> sequence_{};
+    std::map<size_t, system::hash_digest> unclaimed_{};
+    std::map<size_t, system::chain::block::cptr> ready_{};
+    size_t next_{};
+    size_t count_{};
+    bool organizing_{};
+    mutable std::shared_mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
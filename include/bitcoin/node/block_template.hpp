@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_BLOCK_TEMPLATE_HPP
+#define LIBBITCOIN_NODE_BLOCK_TEMPLATE_HPP
+
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/tx_pool.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Block template maintained from pool changes (not thread safe).
+/// Entries mirror the pool and are indexed by ancestor fee rate as changes
+/// are applied, so the pool is never copied or resorted. Assembly walks the
+/// index from the highest rate, preceding each selection by its unselected
+/// ancestors, until the size or sigop limit (and only if changed since last
+/// assembly).
+class BCN_API block_template
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(block_template);
+
+    /// Transactions in block order (parents precede children).
+    struct assembly
+    {
+        typedef std::shared_ptr<const assembly> cptr;
+
+        system::chain::transaction_cptrs txs;
+        uint64_t fees;
+        uint64_t size;
+        size_t sigops;
+    };
+
+    /// Maximum virtual size and sigop cost of selected transactions (each
+    /// excludes coinbase).
+    block_template(uint64_t maximum_size, size_t maximum_sigops) NOEXCEPT;
+
+    /// Number of mirrored pool transactions.
+    size_t count() const NOEXCEPT;
+
+    /// Mirror pool changes (removals are applied first).
+    void apply(const tx_pool::changes& changes) NOEXCEPT;
+
+    /// Drop all mirrored transactions.
+    void clear() NOEXCEPT;
+
+    /// Selection from mirrored transactions, cached until the next change.
+    const assembly::cptr& assemble() NOEXCEPT;
+
+private:
+    using hash_set = std::unordered_set<system::hash_digest>;
+
+    struct order
+    {
+        uint64_t rate;
+        system::hash_digest hash;
+
+        bool operator<(const order& other) const NOEXCEPT
+        {
+            return rate < other.rate ||
+                (rate == other.rate && hash < other.hash);
+        }
+    };
+
+    void erase(const system::hash_digest& hash) NOEXCEPT;
+    bool select(const system::hash_digest& hash, hash_set& selected,
+        assembly& out) const NOEXCEPT;
+
+    // These are protected by the caller.
+    const uint64_t maximum_size_;
+    const size_t maximum_sigops_;
+    std::unordered_map<system::hash_digest, tx_pool::change> entries_{};
+    std::set<order> by_ancestors_{};
+    assembly::cptr assembly_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_BUFFERED_SINK_HPP
+#define LIBBITCOIN_NODE_BUFFERED_SINK_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Text sink that buffers writes for a background writer thread (thread safe).
+/// The stream is written and flushed when buffered bytes reach the limit or
+/// the period elapses, so that callers never block on stream flushes. A zero
+/// period writes through to the stream on the calling thread (no buffering).
+class BCN_API buffered_sink
+{
+public:
+    DELETE_COPY_MOVE(buffered_sink);
+
+    buffered_sink(std::ostream& stream, size_t limit,
+        const std::chrono::milliseconds& period) NOEXCEPT;
+
+    /// Stops the writer, which writes and flushes any buffered text.
+    ~buffered_sink() NOEXCEPT;
+
+    /// Buffer text for the writer (ignored once stopped).
+    void write(const std::string& text) NOEXCEPT;
+
+    /// Block until all previously buffered text is written and flushed.
+    void flush() NOEXCEPT;
+
+    /// Write and flush all buffered text and join the writer (idempotent).
+    /// The stream is not referenced once this returns.
+    void stop() NOEXCEPT;
+
+private:
+    bool buffered() const NOEXCEPT;
+    void run() NOEXCEPT;
+
+    // These are thread safe.
+    std::ostream& stream_;
+    const size_t limit_;
+    const std::chrono::milliseconds period_;
+
+    // These are protected by mutex.
+    std::string buffer_{};
+    uint64_t requested_{};
+    uint64_t completed_{};
+    bool stopped_{};
+    std::mutex mutex_{};
+    std::condition_variable ready_{};
+    std::condition_variable drained_{};
+
+    // This is started by construction and joined by stop.
+    std::thread writer_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
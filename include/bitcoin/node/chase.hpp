@@ -37,6 +37,16 @@ enum class chase
     /// Issued by full_node and handled by 'snapshot' and 'storage'.
     space,
 
+    /// Download window is limited to a percentage of its size (count_t).
+    /// Issued by 'storage' and handled by 'check'.
+    throttle,
+
+    /// A [node] setting is changed at runtime (count_t, zero).
+    /// Payload is the setting name and its new value (tuning).
+    /// Issued by 'executor' and handled by 'check', 'snapshot' and
+    /// 'session_outbound'.
+    tune,
+
     /// Chaser is directed to start when there are no downloads (height_t).
     /// Issued by 'organize' and handled by 'validate'.
     bump,
@@ -57,14 +67,22 @@ enum class chase
     /// Issued by 'session_outbound' and handled by 'block_in_31800'.
     stall,
 
-    /// Channels (all with work) directed to drop work and stop (channel_t).
+    /// Channels (all with work) directed to drop work above (height_t).
     /// Issued by 'check' and handled by 'block_in_31800'.
     purge,
 
+    /// Channels (all with work) directed to request work at once (header_t).
+    /// Issued by 'check' and handled by 'block_in_31800'.
+    expedite,
+
     /// Channels (all) directed to write work count to the log (count_t).
     /// Issued by 'executor' and handled by 'block_in_31800'.
     report,
 
+    /// Channel first reconstructed a new block from compact relay (object_t).
+    /// Issued by 'compact_in_70014' and handled by 'compact_in_70014'.
+    announced,
+
     /// Candidate Chain.
     /// -----------------------------------------------------------------------
 
@@ -108,6 +126,7 @@ enum class chase
     /// -----------------------------------------------------------------------
 
     /// A block has been downloaded, checked and stored (height_t).
+    /// Payload is the block's link and size, when provided (checked_block).
     /// Issued by 'block_in_31800' and handled by 'connect'.
     checked,
 
@@ -148,11 +167,13 @@ enum class chase
     /// Mining.
     /// -----------------------------------------------------------------------
 
-    /// A new transaction has been added to the pool (transaction_t).
+    /// The transaction pool has changed (transaction_t).
+    /// Payload is tx_pool::changes, applied by the template in order.
     /// Issued by 'transaction' and handled by 'template'.
     transaction,
 
     /// A new candidate block (template) has been created (height_t).
+    /// Payload is block_template::assembly (transactions in block order).
     /// Issued by 'template' and handled by [miners].
     template_,
 
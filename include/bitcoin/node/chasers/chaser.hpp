@@ -20,8 +20,17 @@
 #define LIBBITCOIN_NODE_CHASERS_CHASER_HPP
 
 #include <bitcoin/network.hpp>
+#include <bitcoin/node/block_cache.hpp>
 #include <bitcoin/node/configuration.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/hash_filter.hpp>
+#include <bitcoin/node/header_index.hpp>
+#include <bitcoin/node/memory_governor.hpp>
+#include <bitcoin/node/metrics_registry.hpp>
+#include <bitcoin/node/span_tracer.hpp>
+#include <bitcoin/node/prevout_cache.hpp>
+#include <bitcoin/node/script_cache.hpp>
+#include <bitcoin/node/work_cache.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -57,11 +66,15 @@ protected:
         return BIND_THIS(method, args);
     }
 
-    /// Post a method to channel strand (use POST).
+    /// Post a method to channel strand (use POST), instrumented if enabled.
     template <class Derived, typename Method, typename... Args>
     auto post(Method&& method, Args&&... args) NOEXCEPT
     {
-        return boost::asio::post(strand(), BIND_THIS(method, args));
+        if (is_null(monitor_))
+            return boost::asio::post(strand(), BIND_THIS(method, args));
+
+        return boost::asio::post(strand(),
+            monitor_->wrap(BIND_THIS(method, args)));
     }
 
     /// Methods.
@@ -71,6 +84,10 @@ protected:
     friend full_node;
     virtual void stopping(const code& ec) NOEXCEPT;
 
+    /// Override to stop and join chaser threads, allow full_node to invoke.
+    /// Invoked once network threads are joined, before the store is closed.
+    virtual void stopped() NOEXCEPT;
+
     /// Node threadpool is stopped and may still be joining.
     virtual bool closed() const NOEXCEPT;
 
@@ -90,6 +107,15 @@ protected:
     /// Reset store disk full condition.
     virtual code reload(const store::event_handler& handler) NOEXCEPT;
 
+    /// Retain block fees from validation for confirmation (thread safe).
+    virtual void set_fees(const database::header_link& link, size_t height,
+        uint64_t fees) NOEXCEPT;
+
+    /// Obtain and release retained block fees, releasing all others at or
+    /// below the height (thread safe).
+    virtual bool take_fees(uint64_t& fees, const database::header_link& link,
+        size_t height) NOEXCEPT;
+
     /// Events.
     /// -----------------------------------------------------------------------
 
@@ -100,10 +126,17 @@ protected:
     virtual void notify(const code& ec, chase event_,
         event_value value) const NOEXCEPT;
 
+    /// Set a chaser event with payload shared by all subscribers.
+    virtual void notify(const code& ec, chase event_, event_value value,
+        const event_payload& payload) const NOEXCEPT;
+
     /// Set event to one subscriber (does not require node strand).
     virtual void notify_one(object_key key, const code& ec, chase event_,
         event_value value) const NOEXCEPT;
 
+    /// Fire reporting event, also counted in metrics (hides reporter).
+    void fire(uint8_t event_, uint64_t value) const NOEXCEPT;
+
     /// Properties.
     /// -----------------------------------------------------------------------
 
@@ -113,6 +146,45 @@ protected:
     /// Thread safe synchronous archival interface.
     query& archive() const NOEXCEPT;
 
+    /// Cache of recently archived outputs (thread safe).
+    prevout_cache& prevouts() const NOEXCEPT;
+
+    /// Cache of script-verified transactions by fork flags (thread safe).
+    script_cache& scripts() const NOEXCEPT;
+
+    /// Cache of recently organized blocks served to peers (thread safe).
+    block_cache& blocks() const NOEXCEPT;
+
+    /// Index of confirmed headers served to peers (thread safe).
+    header_index& confirmed_headers() const NOEXCEPT;
+
+    /// Node-wide block download bandwidth budget (thread safe).
+    download_budget& budget() const NOEXCEPT;
+
+    /// Node-wide bound on memory of caches and queues (thread safe).
+    memory_governor& memory() const NOEXCEPT;
+
+    /// Claims of blocks downloaded by more than one channel (thread safe).
+    block_claims& claims() const NOEXCEPT;
+
+    /// Cache of cumulative work by header (thread safe).
+    work_cache& work() const NOEXCEPT;
+
+    /// Pool of threads checking downloaded headers and blocks.
+    network::threadpool& check_pool() const NOEXCEPT;
+
+    /// Division of threads between block check and validation (thread safe).
+    worker_shares& shares() const NOEXCEPT;
+
+    /// Filter of recently organized header hashes (thread safe).
+    hash_filter& seen() const NOEXCEPT;
+
+    /// Lock-free node metrics (thread safe).
+    metrics_registry& metrics() const NOEXCEPT;
+
+    /// Recorder of pipeline spans for trace export (thread safe).
+    span_tracer& tracer() const NOEXCEPT;
+
     /// The chaser's strand.
     network::asio::strand& strand() NOEXCEPT;
 
@@ -125,6 +197,10 @@ protected:
     /// Header timestamp is within configured span from current time.
     bool is_current(uint32_t timestamp) const NOEXCEPT;
 
+    /// Transaction accept/connect context from archived header context.
+    static system::chain::context to_chain_context(
+        const database::context& context) NOEXCEPT;
+
     /// Bypass (requires strand).
     /// -----------------------------------------------------------------------
 
@@ -146,6 +222,9 @@ private:
     // These are thread safe (mostly).
     full_node& node_;
     network::asio::strand strand_;
+
+    // This is set by full_node prior to start (null if not instrumented).
+    metrics_registry::strand_metrics* monitor_{};
 };
 
 #define SUBSCRIBE_EVENTS(method, ...) \
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_CHASERS_CHASER_AUDIT_HPP
+#define LIBBITCOIN_NODE_CHASERS_CHASER_AUDIT_HPP
+
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/chasers/chaser.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+class full_node;
+
+/// Audit the history of a bootstrapped store in the background.
+/// A bootstrapped store is committed to the milestone by its header chain,
+/// but its archived blocks are bypassed by validation. Each confirmed block
+/// up to the milestone is read and checked (including its merkle root) in
+/// small batches, yielding the strand between batches. Failure faults the
+/// node, as the archive does not match the committed header chain.
+class BCN_API chaser_audit
+  : public chaser
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(chaser_audit);
+
+    chaser_audit(full_node& node) NOEXCEPT;
+
+    code start() NOEXCEPT override;
+
+protected:
+    virtual void do_audit(height_t height) NOEXCEPT;
+
+private:
+    // Blocks checked in each strand invocation.
+    static constexpr size_t batch = 100;
+
+    // These are thread safe.
+    const size_t milestone_;
+    const bool enabled_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
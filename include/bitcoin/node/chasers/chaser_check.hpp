@@ -19,11 +19,14 @@
 #ifndef LIBBITCOIN_NODE_CHASERS_CHASER_CHECK_HPP
 #define LIBBITCOIN_NODE_CHASERS_CHASER_CHECK_HPP
 
-#include <deque>
+#include <atomic>
+#include <map>
 #include <memory>
+#include <set>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/work_map.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -49,49 +52,87 @@ public:
     code start() NOEXCEPT override;
     void stopping(const code& ec) NOEXCEPT override;
 
+    /// Resume from a checked height above the fork point (before start).
+    void restore(size_t height) NOEXCEPT;
+
+    /// Contiguous checked height, consistent once the node is stopped.
+    size_t checked_height() const NOEXCEPT;
+
     /// Interface for protocols to obtain/return pending download identifiers.
     /// Identifiers not downloaded must be returned or chain will remain gapped.
-    virtual void get_hashes(map_handler&& handler) NOEXCEPT;
+    /// A non-zero count sizes the obtained map to the rate of the channel.
+    /// A channel with high latency (time to first block in microseconds,
+    /// zero if unmeasured) is given work from the top of the window, leaving
+    /// the validation frontier to lower latency channels.
+    virtual void get_hashes(size_t count, uint64_t latency,
+        map_handler&& handler) NOEXCEPT;
     virtual void put_hashes(const map_ptr& map,
         network::result_handler&& handler) NOEXCEPT;
 
 protected:
     virtual void handle_purged(const code& ec) NOEXCEPT;
     virtual bool handle_event(const code& ec, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
 
     virtual void do_bump(height_t height) NOEXCEPT;
     virtual void do_header(header_t height) NOEXCEPT;
-    virtual void do_checked(height_t height) NOEXCEPT;
+    virtual void do_checked(height_t height,
+        const event_payload& payload) NOEXCEPT;
     virtual void do_headers(height_t branch_point) NOEXCEPT;
     virtual void do_regressed(height_t branch_point) NOEXCEPT;
+    virtual void do_throttle(count_t percent) NOEXCEPT;
+    virtual void do_tune(const tuning& setting) NOEXCEPT;
     virtual void do_handle_purged(const code& ec) NOEXCEPT;
-    virtual void do_get_hashes(const map_handler& handler) NOEXCEPT;
+    virtual void do_get_hashes(size_t count, uint64_t latency,
+        const map_handler& handler) NOEXCEPT;
     virtual void do_put_hashes(const map_ptr& map,
         const network::result_handler& handler) NOEXCEPT;
 
 private:
-    typedef std::deque<map_ptr> maps;
-
-    map_ptr get_map() NOEXCEPT;
+    /// Pending maps ordered by lowest height, so work is issued from the
+    /// validation frontier upward, including work returned by channels.
+    typedef std::multimap<height_t, map_ptr> maps;
+    typedef std::set<height_t> heights;
+
+    void set_checked(size_t height) NOEXCEPT;
+    bool is_associated(height_t height) NOEXCEPT;
+    map_ptr pop_map(bool frontier) NOEXCEPT;
+    map_ptr get_race() NOEXCEPT;
+    map_ptr get_map(size_t count, bool frontier) NOEXCEPT;
+    bool is_frontier(uint64_t latency) NOEXCEPT;
     size_t set_unassociated() NOEXCEPT;
     size_t get_inventory_size() const NOEXCEPT;
+    size_t get_window() const NOEXCEPT;
     bool set_map(const map_ptr& map) NOEXCEPT;
+    void set_candidates(work_map& map) const NOEXCEPT;
 
     void start_tracking() NOEXCEPT;
     void stop_tracking() NOEXCEPT;
     bool purging() const NOEXCEPT;
 
     // These are thread safe.
-    const size_t maximum_concurrency_;
     const size_t maximum_height_;
     const size_t connections_;
+    const uint64_t window_bytes_;
+    const network::steady_clock::duration endgame_;
+    std::atomic_size_t checked_height_{};
+    std::atomic_size_t queued_{};
 
     // These are protected by strand.
+    size_t maximum_concurrency_;
+    network::steady_clock::time_point advanced_{};
+    height_t raced_{};
+    uint64_t block_bytes_{};
+    uint64_t latency_{};
     size_t inventory_{};
     size_t requested_{};
+    size_t restored_{};
+    size_t regressed_{ max_size_t };
+    size_t throttle_{ 100 };
     job::ptr job_{};
     maps maps_{};
+    map_ptr urgent_{ empty_map() };
+    heights checked_{};
 };
 
 } // namespace node
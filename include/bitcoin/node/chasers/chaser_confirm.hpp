@@ -19,6 +19,10 @@
 #ifndef LIBBITCOIN_NODE_CHASERS_CHASER_CONFIRM_HPP
 #define LIBBITCOIN_NODE_CHASERS_CHASER_CONFIRM_HPP
 
+#include <atomic>
+#include <memory>
+#include <set>
+#include <vector>
 #include <bitcoin/database.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
@@ -38,24 +42,116 @@ public:
     chaser_confirm(full_node& node) NOEXCEPT;
 
     code start() NOEXCEPT override;
+    void stopped() NOEXCEPT override;
 
 protected:
     using header_links = std::vector<database::header_link>;
 
+    /// The fork of one confirmation pass, in height order from fork_point.
+    /// Blocks requiring the confirmability query are claimed by any worker,
+    /// and the last worker to finish posts the ordered push to the strand.
+    /// A worker cannot observe spends of its predecessors in the batch, so a
+    /// parallel result is used unless its block spends an outpoint spent by
+    /// a block already pushed in the pass.
+    struct confirmation
+    {
+        typedef std::shared_ptr<confirmation> ptr;
+
+        confirmation(height_t height, height_t fork_point,
+            header_links&& popped, header_links&& fork) NOEXCEPT
+          : height(height), fork_point(fork_point), popped(std::move(popped)),
+            fork(std::move(fork)), checks(this->fork.size()),
+            results(this->fork.size()), spends(this->fork.size())
+        {
+        }
+
+        /// Set outpoints spent by the block at the slot (worker).
+        void set_spends(size_t at, const system::chain::block& block) NOEXCEPT
+        {
+            auto& points = spends.at(at);
+            for (const auto& tx: *block.transactions_ptr())
+                for (const auto& in: *tx->inputs_ptr())
+                    if (!in->point().is_null())
+                        points.push_back(in->point());
+        }
+
+        /// Block at the slot spends an outpoint spent in the pass (strand).
+        bool conflicts(size_t at) const NOEXCEPT
+        {
+            if (partial.load())
+                return true;
+
+            for (const auto& point: spends.at(at))
+                if (spent.contains(point))
+                    return true;
+
+            return false;
+        }
+
+        /// Record outpoints spent by the block pushed at the slot (strand).
+        void spend(size_t at) NOEXCEPT
+        {
+            for (const auto& point: spends.at(at))
+                spent.insert(point);
+        }
+
+        const height_t height;
+        const height_t fork_point;
+        const header_links popped;
+        const header_links fork;
+
+        /// Set on the strand before distribution, read only by workers.
+        std::vector<bool> checks;
+
+        /// Each slot written by its claiming worker only.
+        std::vector<code> results;
+        std::vector<system::chain::points> spends;
+
+        /// Outpoints spent by blocks pushed in the pass (strand).
+        std::set<system::chain::point> spent{};
+
+        /// Journal of links pushed by the pass, read by roll_back (strand).
+        header_links pushed{};
+
+        std::atomic_size_t next{};
+        std::atomic_size_t pending{};
+
+        /// Set by a worker that could not obtain the spends of its block.
+        std::atomic_bool partial{};
+    };
+
     virtual bool handle_event(const code& ec, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
 
     virtual void do_validated(height_t height) NOEXCEPT;
+    virtual void do_confirm(height_t height) NOEXCEPT;
+    virtual void check_batch(const confirmation::ptr& batch) NOEXCEPT;
+    virtual void do_push(const confirmation::ptr& batch) NOEXCEPT;
 
 private:
+    bool set_checks(confirmation& batch) const NOEXCEPT;
+    void distribute(const confirmation::ptr& batch) NOEXCEPT;
+    void complete() NOEXCEPT;
     bool set_organized(header_t link, height_t height) NOEXCEPT;
     bool set_reorganized(header_t link, height_t height) NOEXCEPT;
-    bool roll_back(const header_links& popped,
-        size_t fork_point, size_t top) NOEXCEPT;
+    bool set_headers() NOEXCEPT;
+    bool is_gap(const code& ec, bool bypass) const NOEXCEPT;
+    bool roll_back(const confirmation& batch) NOEXCEPT;
     bool get_fork_work(uint256_t& fork_work, header_links& fork,
         height_t fork_top) const NOEXCEPT;
     bool get_is_strong(bool& strong, const uint256_t& fork_work,
         size_t fork_point) const NOEXCEPT;
+
+    // These are thread safe.
+    const size_t workers_;
+    const bool defer_strong_;
+
+    // These are protected by strand.
+    network::threadpool threadpool_;
+    height_t pending_{};
+    height_t strong_{};
+    bool confirming_{};
+    bool deferred_{};
 };
 
 } // namespace node
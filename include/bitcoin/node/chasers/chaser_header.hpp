@@ -48,7 +48,10 @@ protected:
     virtual bool get_block(system::chain::header::cptr& out,
         size_t index) const NOEXCEPT;
 
-    /// Determine if Block is valid.
+    /// Determine if Block is valid independent of context (thread safe).
+    code check(const system::chain::header& header) const NOEXCEPT override;
+
+    /// Determine if Block is valid (excluding check).
     virtual code validate(const system::chain::header& header,
         const system::chain::chain_state& state) const NOEXCEPT;
 
@@ -19,6 +19,9 @@
 #ifndef LIBBITCOIN_NODE_CHASERS_CHASER_ORGANIZE_HPP
 #define LIBBITCOIN_NODE_CHASERS_CHASER_ORGANIZE_HPP
 
+#include <atomic>
+#include <deque>
+#include <filesystem>
 #include <unordered_map>
 #include <bitcoin/database.hpp>
 #include <bitcoin/network.hpp>
@@ -42,20 +45,62 @@ public:
     /// Initialize chaser state.
     code start() NOEXCEPT override;
 
+    /// Spill the tree to disk (if configured).
+    void stopping(const code& ec) NOEXCEPT override;
+
+    using block_ptrs = std::vector<typename Block::cptr>;
+
     /// Validate and organize next block in sequence relative to caller peer.
     virtual void organize(const typename Block::cptr& block_ptr,
         organize_handler&& handler) NOEXCEPT;
 
+    /// Check sequence of blocks concurrently, then organize them in order.
+    /// Handler is invoked once, with the first failure (duplicates excluded)
+    /// or success and the height of the last block organized.
+    virtual void organize(block_ptrs&& blocks,
+        organize_handler&& handler) NOEXCEPT;
+
 protected:
     using chain_state = system::chain::chain_state;
     struct block_state
     {
         typename Block::cptr block;
+
+        /// Null unless retained, otherwise rolled forward from an ancestor.
         chain_state::ptr state;
+
+        /// Context of the Block, sufficient for its archival.
+        system::chain::context context;
+
+        /// Approximate memory footprint of the entry.
+        size_t bytes;
     };
     using block_tree = std::unordered_map<system::hash_digest, block_state>;
     using header_links = std::vector<database::header_link>;
 
+    /// The blocks of one batch organize, claimed by any check worker.
+    /// The last worker to finish posts the ordered organization to strand.
+    struct organization
+    {
+        typedef std::shared_ptr<organization> ptr;
+
+        organization(block_ptrs&& blocks,
+            organize_handler&& handler) NOEXCEPT
+          : blocks(std::move(blocks)), handler(std::move(handler)),
+            codes(this->blocks.size())
+        {
+        }
+
+        const block_ptrs blocks;
+        const organize_handler handler;
+
+        /// Each slot written by its claiming worker only.
+        std::vector<code> codes;
+
+        std::atomic_size_t next{};
+        std::atomic_size_t pending{};
+    };
+
     /// Protected constructor for abstract base.
     chaser_organize(full_node& node) NOEXCEPT;
 
@@ -70,7 +115,7 @@ protected:
     virtual bool get_block(typename Block::cptr& out,
         size_t index) const NOEXCEPT = 0;
 
-    /// Determine if Block is valid.
+    /// Determine if Block is valid (excluding check).
     virtual code validate(const Block& block,
         const chain_state& state) const NOEXCEPT = 0;
 
@@ -78,6 +123,12 @@ protected:
     virtual bool is_storable(const Block& block,
         const chain_state& state) const NOEXCEPT = 0;
 
+    /// Virtual
+    /// -----------------------------------------------------------------------
+
+    /// Determine if Block is valid independent of context (thread safe).
+    virtual code check(const Block& block) const NOEXCEPT;
+
     /// Properties
     /// -----------------------------------------------------------------------
 
@@ -92,18 +143,27 @@ protected:
 
     /// Handle chaser events.
     virtual bool handle_event(const code&, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
 
     /// Reorganize following strong branch discovery.
     virtual void do_organize(typename Block::cptr& block_ptr,
         const organize_handler& handler) NOEXCEPT;
 
+    /// Check the claimed blocks of a batch (check pool).
+    virtual void check_batch(const organization::ptr& batch) NOEXCEPT;
+
+    /// Organize a checked batch in order.
+    virtual void do_organize_batch(const organization::ptr& batch) NOEXCEPT;
+
     /// Reorganize following Block unconfirmability.
     virtual void do_disorganize(header_t header) NOEXCEPT;
 
     /// Disassociate malleated block and notify repeat header in current job.
     virtual void do_malleated(header_t link) NOEXCEPT;
 
+    /// Evict oldest branches totaling excess bytes (memory pressure).
+    virtual void do_shrink(size_t excess) NOEXCEPT;
+
     /// Store Block to database and push to top of candidate chain.
     virtual database::header_link push(const Block& block,
         const system::chain::context& context) const NOEXCEPT;
@@ -116,6 +176,14 @@ protected:
 
 private:
     static constexpr auto flag_bits = to_bits(sizeof(system::chain::flags));
+
+    // Tree heights at which chain state is retained, in addition to tips.
+    static constexpr size_t state_interval = 1000;
+
+    // Approximate chain state size, dominated by its bits, version and
+    // timestamp samples (retarget interval, activation sample, median span).
+    static constexpr size_t state_bytes = sizeof(chain_state) +
+        sizeof(uint32_t) * (2016 + 1000 + 11);
     static constexpr bool is_block() NOEXCEPT
     {
         return is_same_type<Block, system::chain::block>;
@@ -136,14 +204,45 @@ private:
     // Chain methods.
     // ------------------------------------------------------------------------
 
+    // Organize Block, with check omitted if already performed.
+    void organize_block(typename Block::cptr& block_ptr,
+        const organize_handler& handler, bool checked) NOEXCEPT;
+
+    // Mark organized or duplicate header hash as seen by channels.
+    void filter(const system::hash_digest& hash,
+        const code& ec) const NOEXCEPT;
+
+    // Unmark header hash removed from the tree without being stored.
+    void unfilter(const system::hash_digest& hash) const NOEXCEPT;
+
     // Store Block into logical tree cache.
     void cache(const typename Block::cptr& block_ptr,
         const chain_state::ptr& state) NOEXCEPT;
 
+    // Remove tree entry (without descendants) from tree accounting.
+    void unlink(const system::hash_digest& key,
+        const block_state& value) NOEXCEPT;
+
+    // Remove tree entry with all descendants, each of which depends on it.
+    size_t evict(const system::hash_digest& key) NOEXCEPT;
+
+    // Evict oldest branches until the tree is within the memory bound.
+    void limit(size_t maximum) NOEXCEPT;
+
+    // Approximate memory footprint of a tree entry for the Block.
+    static size_t footprint(const Block& block) NOEXCEPT;
+
     // Obtain chain state for given previous hash, nullptr if not found.
     chain_state::ptr get_chain_state(
         const system::hash_digest& previous_hash) const NOEXCEPT;
 
+    // Roll chain state forward from nearest retained ancestor to tree entry.
+    chain_state::ptr get_tree_state(
+        const system::hash_digest& hash) const NOEXCEPT;
+
+    // Release chain state of a tree parent that is not at a retained height.
+    void compact(const system::hash_digest& parent) NOEXCEPT;
+
     // Sum of work from header to branch point (excluded).
     bool get_branch_work(uint256_t& branch_work, size_t& branch_point,
         system::hashes& tree_branch, header_links& store_branch,
@@ -156,6 +255,10 @@ private:
     // Move tree Block to database and push to top of candidate chain.
     bool push(const system::hash_digest& key) NOEXCEPT;
 
+    // Notify download and validation of a new candidate branch.
+    void notify_organized(bool current, size_t branch_point,
+        size_t regressed) const NOEXCEPT;
+
     // Bypass methods.
     // ------------------------------------------------------------------------
 
@@ -174,6 +277,15 @@ private:
     // Notify chase::bypass subscribers of a change in bypass height.
     void notify_bypass() const NOEXCEPT;
 
+    // Persistence methods.
+    // ------------------------------------------------------------------------
+
+    // Write tree Blocks to disk, parents first.
+    void do_stopping(const code& ec) NOEXCEPT;
+
+    // Read tree Blocks from disk and reorganize them.
+    void load_tree() NOEXCEPT;
+
     // Logging.
     // ------------------------------------------------------------------------
 
@@ -186,11 +298,32 @@ private:
     const system::chain::checkpoint& milestone_;
     const system::chain::checkpoints checkpoints_;
     const size_t top_checkpoint_height_;
+    const size_t maximum_tree_bytes_;
+    const bool persist_tree_;
+    const bool governed_;
+    const std::filesystem::path tree_file_;
+    std::atomic_size_t tree_bytes_{};
 
     // These are protected by strand.
     size_t active_milestone_height_{};
     chain_state::ptr state_{};
     block_tree tree_{};
+
+    // Child hashes by parent hash, one per tree entry.
+    std::unordered_multimap<system::hash_digest, system::hash_digest>
+        children_{};
+
+    // Tree hashes in order of caching, may include removed entries.
+    std::deque<system::hash_digest> order_{};
+
+    // Candidate branch notifications deferred to the end of a batch.
+    struct deferral
+    {
+        bool active{};
+        bool current{};
+        size_t branch_point{ max_size_t };
+        size_t regressed{ max_size_t };
+    } deferred_{};
 };
 
 } // namespace node
@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_NODE_CHASERS_CHASER_SNAPSHOT_HPP
 #define LIBBITCOIN_NODE_CHASERS_CHASER_SNAPSHOT_HPP
 
+#include <array>
 #include <bitcoin/system.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
@@ -42,24 +43,31 @@ public:
 protected:
     virtual void do_confirm(height_t height) NOEXCEPT;
     virtual void do_archive(height_t height) NOEXCEPT;
+    virtual void do_tune(const tuning& setting) NOEXCEPT;
     virtual bool handle_event(const code& ec, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
 
 private:
+    using sizes = std::array<uint64_t, 15>;
+
+    sizes get_sizes() const NOEXCEPT;
+    void report_growth(const sizes& current) NOEXCEPT;
     bool update_bytes() NOEXCEPT;
     bool update_valid(height_t height) NOEXCEPT;
     void do_snapshot(height_t height) NOEXCEPT;
 
     // These are thread safe.
     const size_t top_checkpoint_;
-    const size_t snapshot_valid_;
-    const uint64_t snapshot_bytes_;
-    const bool enabled_valid_;
-    const bool enabled_bytes_;
+    const bool concurrent_;
+    std::atomic_bool enabled_valid_;
+    std::atomic_bool enabled_bytes_;
 
     // These are protected by strand.
+    size_t snapshot_valid_;
+    uint64_t snapshot_bytes_;
     uint64_t bytes_{};
     size_t valid_{};
+    sizes sizes_{};
 };
 
 } // namespace node
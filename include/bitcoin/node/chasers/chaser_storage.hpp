@@ -30,6 +30,12 @@ class full_node;
 
 /// Monitor storage capacity following a disk full condition.
 /// Clear disk full condition and restart network given increased capacity.
+/// Optionally forecast exhaustion from the recent store growth rate, and
+/// throttle the download window as the forecast falls below the horizon.
+/// Optionally reserve disk blocks ahead of large table files, so that store
+/// file extension does not allocate disk blocks while writers wait.
+/// Optionally balance the memory governor, which shrinks caches and scales
+/// intake, and bump downloads as its allowance recovers.
 class BCN_API chaser_storage
   : public chaser
 {
@@ -45,18 +51,36 @@ protected:
     virtual void do_reload() NOEXCEPT;
     virtual void do_space(size_t space) NOEXCEPT;
     virtual bool handle_event(const code& ec, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
 
 private:
     void do_stopping(const code& ec) NOEXCEPT;
     void handle_timer(const code& ec) NOEXCEPT;
     bool have_capacity() const NOEXCEPT;
+    void do_forecast(count_t) NOEXCEPT;
+    void handle_forecast(const code& ec) NOEXCEPT;
+    size_t get_throttle() NOEXCEPT;
+    void do_preallocate(count_t) NOEXCEPT;
+    void handle_preallocate(const code& ec) NOEXCEPT;
+    void preallocate() const NOEXCEPT;
+    void do_govern(count_t) NOEXCEPT;
+    void handle_govern(const code& ec) NOEXCEPT;
+    void govern() NOEXCEPT;
 
-    // This is thread safe.
+    // These are thread safe.
     const std::filesystem::path store_;
+    const uint64_t horizon_;
+    const uint64_t preallocate_;
 
-    // This is protected by strand.
+    // These are protected by strand.
     network::deadline::ptr disk_timer_{};
+    network::deadline::ptr forecast_timer_{};
+    network::deadline::ptr allocate_timer_{};
+    network::deadline::ptr memory_timer_{};
+    network::steady_clock::time_point sampled_{};
+    uint64_t sampled_bytes_{};
+    size_t throttle_{ 100 };
+    size_t allowance_{ 100 };
 };
 
 } // namespace node
@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_NODE_CHASERS_CHASER_TEMPLATE_HPP
 #define LIBBITCOIN_NODE_CHASERS_CHASER_TEMPLATE_HPP
 
+#include <bitcoin/node/block_template.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
 
@@ -40,9 +41,19 @@ public:
 
 protected:
     virtual bool handle_event(const code& ec, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
 
-    virtual void do_transaction(transaction_t value) NOEXCEPT;
+    virtual void do_transaction(transaction_t value,
+        const event_payload& payload) NOEXCEPT;
+    virtual void do_organized(header_t link) NOEXCEPT;
+
+private:
+    void set_height() NOEXCEPT;
+    void issue() NOEXCEPT;
+
+    // These are protected by strand.
+    block_template template_;
+    size_t height_{};
 };
 
 } // namespace node
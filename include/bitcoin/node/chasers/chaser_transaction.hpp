@@ -19,9 +19,13 @@
 #ifndef LIBBITCOIN_NODE_CHASERS_CHASER_TRANSACTION_HPP
 #define LIBBITCOIN_NODE_CHASERS_CHASER_TRANSACTION_HPP
 
+#include <atomic>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
+#include <bitcoin/node/compact_relay.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/tx_pool.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -38,16 +42,57 @@ public:
     chaser_transaction(full_node& node) NOEXCEPT;
 
     code start() NOEXCEPT override;
+    void stopped() NOEXCEPT override;
 
-    virtual void store(const system::chain::transaction::cptr& block) NOEXCEPT;
+    /// Validate and pool the transaction (thread safe).
+    /// Check and connect are parallel, pool admission is posted to strand.
+    virtual void store(const system::chain::transaction::cptr& tx) NOEXCEPT;
+
+    /// Fill compact block slots from pooled transactions (posted to strand).
+    virtual void reconstruct(const compact_relay::ptr& relay,
+        network::result_handler&& handler) NOEXCEPT;
+
+    /// Pooled transactions by hash, unpooled omitted (posted to strand).
+    virtual void get_transactions(const system::hashes& hashes,
+        transactions_handler&& handler) NOEXCEPT;
 
 protected:
+    using hashes = std::vector<system::hash_digest>;
+
     virtual bool handle_event(const code& ec, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
 
     virtual void do_confirmed(header_t link) NOEXCEPT;
-    virtual void do_store(
-        const system::chain::transaction::cptr& header) NOEXCEPT;
+    virtual void do_reorganized(header_t link) NOEXCEPT;
+    virtual void do_admit(
+        const system::chain::transaction::cptr& tx) NOEXCEPT;
+    virtual void do_store(const system::chain::transaction::cptr& tx,
+        const hashes& parents, size_t sigops) NOEXCEPT;
+    virtual void do_reconstruct(const compact_relay::ptr& relay,
+        const network::result_handler& handler) NOEXCEPT;
+    virtual void do_get_transactions(const system::hashes& hashes,
+        const transactions_handler& handler) NOEXCEPT;
+
+private:
+    // These are thread safe.
+    void check_tx(const system::chain::transaction::cptr& tx) NOEXCEPT;
+    void connect_tx(const system::chain::transaction::cptr& tx,
+        const database::context& context, const hashes& parents,
+        bool populated) NOEXCEPT;
+    code accept_tx(const system::chain::transaction& tx,
+        const database::context& context) const NOEXCEPT;
+
+    // These are protected by strand.
+    void publish() NOEXCEPT;
+    void set_context() NOEXCEPT;
+
+    // These are protected by strand.
+    tx_pool pool_;
+    database::context context_{};
+
+    // These are thread safe.
+    network::threadpool admission_pool_;
+    std::atomic<uint64_t> pool_bytes_{};
 };
 
 } // namespace node
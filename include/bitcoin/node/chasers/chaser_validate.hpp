@@ -19,6 +19,9 @@
 #ifndef LIBBITCOIN_NODE_CHASERS_CHASER_VALIDATE_HPP
 #define LIBBITCOIN_NODE_CHASERS_CHASER_VALIDATE_HPP
 
+#include <atomic>
+#include <map>
+#include <memory>
 #include <bitcoin/database.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
@@ -29,6 +32,9 @@ namespace node {
 class full_node;
 
 /// Chase down blocks in the the candidate header chain for validation.
+/// Optionally validate the bypassed history in a second lane, with its own
+/// position, backlog and threadpool, so that tip blocks do not queue behind
+/// historical work. A historical validation failure faults the node.
 class BCN_API chaser_validate
   : public chaser
 {
@@ -38,48 +44,154 @@ public:
     chaser_validate(full_node& node) NOEXCEPT;
 
     code start() NOEXCEPT override;
+    void stopped() NOEXCEPT override;
 
 protected:
-    typedef network::race_unity<const code&, const database::tx_link&> race;
+    using tx_links = std::vector<database::tx_link>;
+
+    /// The transactions of one block, claimed in chunks by any worker.
+    /// The last worker to finish a stage starts the next, and the last to
+    /// finish script validation posts the block result, with first error.
+    struct batch
+    {
+        typedef std::shared_ptr<batch> ptr;
+
+        batch(const database::header_link& link,
+            const database::context& context, tx_links&& txs,
+            bool neutrino, bool history) NOEXCEPT
+          : link(link), context(context),
+            rules(to_chain_context(context)),
+            bip16(rules.is_enabled(system::chain::flags::bip16_rule)),
+            bip141(rules.is_enabled(system::chain::flags::bip141_rule)),
+            txs(std::move(txs)),
+            neutrino(neutrino), history(history),
+            transactions(this->txs.size())
+        {
+        }
+
+        const database::header_link link;
+        const database::context context;
+
+        /// Chain context and sigop rules, resolved once for the block.
+        const system::chain::context rules;
+        const bool bip16;
+        const bool bip141;
+
+        const tx_links txs;
+
+        const bool neutrino;
+
+        /// Validated in the history lane (bypassed range).
+        const bool history;
+
+        /// Neutrino filter body, computed by the last script worker.
+        system::data_chunk filter{};
+
+        /// Populated txs, each slot written by its claiming worker only.
+        /// Null slots are txs connected before (or not yet populated).
+        std::vector<system::chain::transaction::cptr> transactions;
+
+        std::atomic_size_t next{};
+        std::atomic_size_t pending{};
+        std::atomic_bool failed{};
+        std::atomic_bool faulted{};
+
+        /// Totals of validated txs, partial if any tx was validated before.
+        std::atomic_uint64_t fees{};
+        std::atomic_size_t sigops{};
+        std::atomic_bool partial{};
+
+        /// Written only by the first failing worker, read upon completion.
+        code ec{};
+        database::tx_link tx{};
+    };
 
     virtual bool handle_event(const code& ec, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
 
     virtual void do_regressed(height_t branch_point) NOEXCEPT;
     virtual void do_checked(height_t height) NOEXCEPT;
     virtual void do_bump(height_t height) NOEXCEPT;
-
-    virtual bool enqueue_block(const database::header_link& link) NOEXCEPT;
-    virtual void validate_tx(const database::context& context,
-        const database::tx_link& link, const race::ptr& racer) NOEXCEPT;
-    virtual void handle_tx(const code& ec, const database::tx_link& tx,
-        const race::ptr& racer) NOEXCEPT;
-    virtual void handle_txs(const code& ec, const database::tx_link& tx,
-        const database::header_link& link,
-        const database::context& ctx) NOEXCEPT;
+    virtual void do_history(height_t height) NOEXCEPT;
+
+    virtual bool enqueue_block(const database::header_link& link,
+        bool history=false) NOEXCEPT;
+    virtual void populate_batch(const batch::ptr& work) NOEXCEPT;
+    virtual void validate_batch(const batch::ptr& work) NOEXCEPT;
+    virtual code populate_tx(const database::context& context,
+        const database::tx_link& link,
+        system::chain::transaction::cptr& tx) NOEXCEPT;
+    virtual code accept_tx(const batch& work, const database::tx_link& link,
+        const system::chain::transaction& tx) NOEXCEPT;
+    virtual code connect_tx(const batch& work, const database::tx_link& link,
+        const system::chain::transaction& tx, uint64_t& fee,
+        size_t& sigops) NOEXCEPT;
+    virtual void handle_txs(const batch::ptr& work) NOEXCEPT;
     virtual void validate_block(const code& ec,
+        const database::header_link& link, const database::context& ctx,
+        uint64_t fees, size_t sigops, system::data_chunk&& filter) NOEXCEPT;
+    virtual void validate_history(const code& ec,
         const database::header_link& link,
         const database::context& ctx) NOEXCEPT;
 
 private:
+    typedef void(chaser_validate::*stage)(const batch::ptr&) NOEXCEPT;
+
+    void bind_pools() NOEXCEPT;
+    void distribute(network::threadpool& pool, const batch::ptr& work,
+        stage method) NOEXCEPT;
+    network::threadpool& script_pool(const batch& work) NOEXCEPT;
+    static void set_failure(batch& work, const code& ec,
+        const database::tx_link& link) NOEXCEPT;
+    void prefetch(height_t height) NOEXCEPT;
+    void prefetch_block(const database::header_link& link) NOEXCEPT;
+    code set_invalid(const database::context& context,
+        const database::tx_link& link, const system::chain::transaction& tx,
+        const code& invalid) NOEXCEPT;
+
 #if defined (UNDEFINED)
     code validate(const database::header_link& link, size_t height) NOEXCEPT;
 #endif // UNDEFINED
 
     // neutrino
-    void update_position(size_t height) NOEXCEPT;
+    struct filter
+    {
+        database::header_link link;
+
+        /// Empty if not computed by validation (obtained from store).
+        system::data_chunk body;
+    };
+
     system::hash_digest get_neutrino(size_t height) const NOEXCEPT;
-    bool update_neutrino(const database::header_link& link) NOEXCEPT;
-    bool update_neutrino(const database::header_link& link,
-        const system::chain::block& block) NOEXCEPT;
+    bool compute_neutrino(batch& work) NOEXCEPT;
+    bool compute_neutrino(system::data_chunk& body,
+        const database::header_link& link) NOEXCEPT;
+    void reset_neutrino(height_t height) NOEXCEPT;
+    void chain_neutrino(height_t height, const database::header_link& link,
+        system::data_chunk&& body) NOEXCEPT;
 
     // These are thread safe.
     const uint64_t initial_subsidy_;
     const uint32_t subsidy_interval_blocks_;
+    const size_t maximum_backlog_;
+    const size_t workers_;
+    const size_t populators_;
+    const size_t prefetch_;
+    const size_t historians_;
+    const bool candidates_;
 
     // These are protected by strand.
     network::threadpool threadpool_;
+    network::threadpool populate_pool_;
+    network::threadpool prefetch_pool_;
+    network::threadpool history_pool_;
+    height_t prefetched_{};
+    height_t historical_{};
+    size_t backlog_{};
+    size_t history_backlog_{};
+    std::map<height_t, filter> filters_{};
     system::hash_digest neutrino_{};
+    height_t filtered_{};
 };
 
 } // namespace node
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_COMPACT_RELAY_HPP
+#define LIBBITCOIN_NODE_COMPACT_RELAY_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// BIP152 compact block short ids and reconstruction (not thread safe).
+/// A compact block is a header, a nonce, short ids of witness hashes and any
+/// prefilled transactions. Slots are filled from prefilled transactions, then
+/// from matching pooled transactions, then from requested transactions. A
+/// short id matched by two transactions is left unfilled (to be requested).
+class BCN_API compact_relay
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(compact_relay);
+
+    typedef std::shared_ptr<compact_relay> ptr;
+
+    /// Compact block version using witness hashes (bip152).
+    static constexpr uint64_t version = 2;
+    using short_id = system::mini_hash;
+    using short_ids = std::vector<short_id>;
+    using indexes = std::vector<uint64_t>;
+
+    /// Prefilled transactions by absolute (not differential) block index.
+    using prefills = std::vector<
+        std::pair<size_t, system::chain::transaction::cptr>>;
+
+    /// SipHash key from the single sha256 of the header and nonce.
+    static system::siphash_key to_key(const system::chain::header& header,
+        uint64_t nonce) NOEXCEPT;
+
+    /// Six byte short id (little endian) of the witness hash.
+    static short_id to_short_id(const system::siphash_key& key,
+        const system::hash_digest& wtxid) NOEXCEPT;
+
+    /// Short ids of all block transactions except the coinbase (prefilled).
+    static short_ids to_short_ids(const system::chain::block& block,
+        uint64_t nonce) NOEXCEPT;
+
+    /// Slots are invalid if prefilled indexes are duplicated or out of range,
+    /// or if short ids are not unique within the block (manipulated).
+    compact_relay(const system::chain::header::cptr& header, uint64_t nonce,
+        const short_ids& ids, const prefills& prefilled) NOEXCEPT;
+
+    /// Slots are valid.
+    bool is_valid() const NOEXCEPT;
+
+    /// Hash of block being reconstructed.
+    const system::hash_digest& hash() const NOEXCEPT;
+
+    /// Fill the unfilled slot with matching short id, if any.
+    void match(const system::chain::transaction::cptr& tx) NOEXCEPT;
+
+    /// Block indexes of unfilled slots, in order.
+    indexes missing() const NOEXCEPT;
+
+    /// Fill unfilled slots in order, false if count does not match.
+    bool fill(const system::chain::transaction_cptrs& txs) NOEXCEPT;
+
+    /// The reconstructed block, null if any slot is unfilled.
+    system::chain::block::cptr to_block() const NOEXCEPT;
+
+private:
+    static uint64_t to_number(const short_id& id) NOEXCEPT;
+
+    // These are not thread safe.
+    system::chain::header::cptr header_;
+    system::hash_digest hash_;
+    system::siphash_key key_;
+    system::chain::transaction_cptrs txs_{};
+    std::unordered_map<uint64_t, size_t> slots_{};
+    std::vector<bool> collided_{};
+    bool valid_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -35,15 +35,33 @@ namespace node {
 #define BN_NEWSTORE_VARIABLE "newstore"
 #define BN_BACKUP_VARIABLE "backup"
 #define BN_RESTORE_VARIABLE "restore"
+#define BN_ARCHIVE_VARIABLE "archive"
+#define BN_EXTRACT_VARIABLE "extract"
+#define BN_SERVE_VARIABLE "serve"
+#define BN_HEADERS_VARIABLE "headers"
 
 #define BN_FLAGS_VARIABLE "flags"
 #define BN_SLABS_VARIABLE "slabs"
 #define BN_BUCKETS_VARIABLE "buckets"
 #define BN_COLLISIONS_VARIABLE "collisions"
 #define BN_INFORMATION_VARIABLE "information"
+#define BN_SIZING_VARIABLE "sizing"
+#define BN_SIZING_HEIGHT_VARIABLE "sizing_height"
 
 #define BN_READ_VARIABLE "test"
 #define BN_WRITE_VARIABLE "write"
+#define BN_BENCHMARK_VARIABLE "benchmark"
+#define BN_BENCHMARK_START_VARIABLE "benchmark_start"
+#define BN_BENCHMARK_COUNT_VARIABLE "benchmark_count"
+#define BN_RECORD_VARIABLE "record"
+#define BN_REPLAY_VARIABLE "replay"
+#define BN_GENERATE_VARIABLE "generate"
+#define BN_GENERATE_COUNT_VARIABLE "generate_count"
+#define BN_GENERATE_TXS_VARIABLE "generate_txs"
+#define BN_GENERATE_FANOUT_VARIABLE "generate_fanout"
+#define BN_GENERATE_FORK_VARIABLE "generate_fork"
+#define BN_EVENTS_VARIABLE "events"
+#define BN_EVENTS_PERIOD_VARIABLE "events_period"
 
 // This must be lower case but the env var part can be any case.
 #define BN_CONFIG_VARIABLE "config"
@@ -72,6 +90,10 @@ public:
     bool newstore{};
     bool backup{};
     bool restore{};
+    std::filesystem::path archive{};
+    std::filesystem::path extract{};
+    uint16_t serve{};
+    std::filesystem::path headers{};
 
     /// Chain scans.
     bool flags{};
@@ -79,11 +101,31 @@ public:
     bool slabs{};
     bool buckets{};
     bool collisions{};
+    bool sizing{};
+    uint32_t sizing_height{};
 
     /// Ad-hoc Testing.
     bool test{};
     bool write{};
 
+    /// Benchmark.
+    bool benchmark{};
+    uint32_t benchmark_start{};
+    uint32_t benchmark_count{};
+    std::filesystem::path record{};
+    std::filesystem::path replay{};
+
+    /// Synthetic chain.
+    std::filesystem::path generate{};
+    uint32_t generate_count{};
+    uint32_t generate_txs{};
+    uint32_t generate_fanout{};
+    uint32_t generate_fork{};
+
+    /// Events analysis.
+    bool events{};
+    uint32_t events_period{};
+
     /// Settings.
     log::settings log;
     node::settings node;
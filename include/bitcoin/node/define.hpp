@@ -20,8 +20,11 @@
 #define LIBBITCOIN_NODE_DEFINE_HPP
 
 /// Standard includes (do not include directly).
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <string>
 #include <utility>
 
 /// Pulls in common /node headers (excluding settings/config/parser/full_node).
@@ -59,17 +62,82 @@ typedef database::query<store> query;
 
 /// Work types.
 typedef network::race_all<const code&> job;
-typedef std::shared_ptr<database::associations> map_ptr;
+class work_map;
+typedef std::shared_ptr<work_map> map_ptr;
 typedef std::function<void(const code&, const map_ptr&, const job::ptr&,
     size_t)> map_handler;
 
+/// Relay types.
+typedef std::function<void(const code&,
+    const system::chain::transaction_cptrs&)> transactions_handler;
+
 /// Node events.
 typedef uint64_t object_key;
 typedef uint64_t event_value;
-typedef network::desubscriber<object_key, chase, event_value> event_subscriber;
+typedef std::shared_ptr<const void> event_payload;
+typedef network::desubscriber<object_key, chase, event_value, event_payload>
+    event_subscriber;
 typedef event_subscriber::handler event_notifier;
 typedef event_subscriber::completer event_completer;
 
+/// Runtime change to a [node] setting, the payload of chase::tune.
+struct tuning
+{
+    std::string name;
+    double value;
+
+    /// The value as Integer, false if not finite, whole and within Integer.
+    template <typename Integer>
+    bool integral(Integer& out) const NOEXCEPT
+    {
+        // Two to the power of digits is exact, where maximum may round up.
+        constexpr auto digits = std::numeric_limits<Integer>::digits;
+        if (!std::isfinite(value) || value < 0.0 ||
+            std::floor(value) != value || value >= std::ldexp(1.0, digits))
+            return false;
+
+        BC_PUSH_WARNING(NO_STATIC_CAST)
+        out = static_cast<Integer>(value);
+        BC_POP_WARNING()
+        return true;
+    }
+
+    /// The value as Real, false if not finite, positive and within Real.
+    template <typename Real>
+    bool real(Real& out) const NOEXCEPT
+    {
+        if (!std::isfinite(value) || value <= 0.0 ||
+            value > std::numeric_limits<Real>::max())
+            return false;
+
+        BC_PUSH_WARNING(NO_STATIC_CAST)
+        out = static_cast<Real>(value);
+        BC_POP_WARNING()
+        return true;
+    }
+};
+
+/// Bitmask of chase events delivered to a subscriber (chase::stop implied).
+typedef uint64_t event_topics;
+constexpr event_topics all_topics = max_uint64;
+static_assert(static_cast<size_t>(chase::stop) < bits<event_topics>);
+
+constexpr event_topics to_topic(chase event_) NOEXCEPT
+{
+    return event_topics{ 1 } << static_cast<size_t>(event_);
+}
+
+template <typename... Events>
+constexpr event_topics to_topics(Events... events) NOEXCEPT
+{
+    return (to_topic(events) | ...);
+}
+
+constexpr bool is_topic(event_topics topics, chase event_) NOEXCEPT
+{
+    return !is_zero(topics & to_topic(event_));
+}
+
 /// Use for event_value variants (all unsigned integral integers).
 /// std::variant is inconsistent with interpretation of size_t as redundant or
 /// unique with respect to uint32_t and/or uint64_t (specifically macOS). So
@@ -83,6 +151,33 @@ using object_t = object_key;
 using header_t = database::header_link::integer;
 using transaction_t = database::tx_link::integer;
 
+/// Use for event_payload (optional, immutable and shared by all subscribers).
+/// As with event_value the payload type is implied by the chase event, so it
+/// is created with make_payload<Type> and recovered with payload_cast<Type>.
+/// This allows a producer to hand results to consumers without copy or store
+/// read. A subscriber must accept a null payload (not all issuers provide it).
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+template <typename Type, typename... Args>
+inline event_payload make_payload(Args&&... args) NOEXCEPT
+{
+    return std::make_shared<const Type>(std::forward<Args>(args)...);
+}
+
+template <typename Type>
+inline std::shared_ptr<const Type> payload_cast(
+    const event_payload& payload) NOEXCEPT
+{
+    return std::static_pointer_cast<const Type>(payload);
+}
+BC_POP_WARNING()
+
+/// Archived block, the payload of chase::checked.
+struct checked_block
+{
+    header_t link;
+    size_t size;
+};
+
 } // namespace node
 } // namespace libbitcoin
 
@@ -102,6 +197,32 @@ using transaction_t = database::tx_link::integer;
 // Each header includes only its required common headers.
 
 // settings       : define
+// buffered_sink  : define
+// block_cache    : define
+// download_budget: define
+// header_index   : define
+// tx_sketch      : define
+// prevout_cache  : define
+// script_cache   : define
+// work_cache     : define
+// worker_shares  : define
+// header_ranges  : define
+// block_inventory: define
+// thread_affinity: define
+// hash_filter    : define
+// event_bus      : define
+// event_log      : define
+// metrics_registry: define
+// metrics_server : define
+// query_server   : define
+// peer_scores    : define
+// span_tracer    : define
+// startup_manifest: define
+// store_archive  : define
+// work_map       : define
+// tx_pool        : define
+// block_template : define tx_pool
+// compact_relay  : define
 // configuration  : define settings
 // parser         : define configuration
 // /chasers       : define configuration  [forward: full_node]
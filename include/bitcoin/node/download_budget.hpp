@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_DOWNLOAD_BUDGET_HPP
+#define LIBBITCOIN_NODE_DOWNLOAD_BUDGET_HPP
+
+#include <atomic>
+#include <mutex>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe, node-wide token bucket of block download bytes.
+/// Channels are charged for received block bytes and defer requests while
+/// the bucket is overdrawn. Requests near the validation frontier may overdraw
+/// the bucket by one second of budget, so that they are not queued behind
+/// bulk requests (which wait for the bucket to refill). The mean rate across
+/// all channels is bounded by the budget either way.
+class BCN_API download_budget
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(download_budget);
+
+    /// Blocks above the checked height considered to be at the frontier.
+    static constexpr size_t frontier_blocks = 1'000;
+
+    /// Zero bytes per second disables the budget.
+    download_budget(uint64_t bytes_per_second) NOEXCEPT;
+
+    /// Budget is enabled.
+    bool enabled() const NOEXCEPT;
+
+    /// Set the validation frontier (checked height).
+    void set_frontier(size_t height) NOEXCEPT;
+
+    /// The validation frontier (checked height).
+    size_t frontier() const NOEXCEPT;
+
+    /// Charge received bytes against the budget.
+    void consume(uint64_t bytes) NOEXCEPT;
+
+    /// Time until a request with the given lowest block height may be sent.
+    network::steady_clock::duration delay(size_t height) NOEXCEPT;
+
+private:
+    void refill() NOEXCEPT;
+
+    // These are thread safe.
+    const double rate_;
+    std::atomic_size_t frontier_{};
+    mutable std::mutex mutex_{};
+
+    // These are protected by mutex.
+    double balance_;
+    network::steady_clock::time_point updated_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
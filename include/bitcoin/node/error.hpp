@@ -46,6 +46,17 @@ enum error_t : uint8_t
     store_uninitialized,
     store_reload,
     store_snapshot,
+    store_archive,
+    store_bootstrap,
+    store_sibling,
+    header_archive,
+    header_commitment,
+
+    /// mempool
+    pool_duplicate,
+    pool_conflict,
+    pool_package,
+    pool_full,
 
     /// network
     slow_channel,
@@ -54,6 +65,9 @@ enum error_t : uint8_t
     sacrificed_channel,
     suspended_channel,
     suspended_service,
+    metrics_bind,
+    query_bind,
+    template_bind,
 
     /// blockchain
     orphan_block,
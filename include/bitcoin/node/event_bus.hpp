@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_EVENT_BUS_HPP
+#define LIBBITCOIN_NODE_EVENT_BUS_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe distribution of chase events to channel subscribers.
+/// Subscribers are partitioned by key across shards, each with its own strand
+/// and subscriber, so that delivery is not serialized on the node strand.
+/// Events are posted only to shards with a subscriber to the event topic, and
+/// delivered only to those subscribers (chase::stop is delivered to all).
+class BCN_API event_bus
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(event_bus);
+
+    /// Shards is limited to one or more.
+    event_bus(network::asio::io_context& service, size_t shards) NOEXCEPT;
+
+    /// Subscribe handler to topics, complete is invoked on the shard strand.
+    void subscribe(event_notifier&& handler, event_topics topics,
+        object_key key, event_completer&& complete) NOEXCEPT;
+
+    /// Post event to subscribers of its topic.
+    void notify(const code& ec, chase event_, event_value value,
+        const event_payload& payload) NOEXCEPT;
+
+    /// Post event to the given subscriber only.
+    void notify_one(object_key key, const code& ec, chase event_,
+        event_value value) NOEXCEPT;
+
+    /// Stop all shards, subscribers are notified with chase::stop.
+    void stop(const code& ec) NOEXCEPT;
+
+private:
+    struct shard
+    {
+        DELETE_COPY_MOVE_DESTRUCT(shard);
+        shard(network::asio::io_context& service) NOEXCEPT;
+
+        // Union of all topics subscribed to the shard (never reduced).
+        std::atomic<event_topics> topics{};
+
+        // The subscriber is protected by the strand.
+        network::asio::strand strand;
+        event_subscriber subscriber;
+    };
+
+    typedef std::unique_ptr<shard> shard_ptr;
+    typedef std::vector<shard_ptr> shards;
+
+    static shards make_shards(network::asio::io_context& service,
+        size_t count) NOEXCEPT;
+    shard& to_shard(object_key key) const NOEXCEPT;
+
+    static void do_subscribe(shard& to, const event_notifier& handler,
+        event_topics topics, object_key key,
+        const event_completer& complete) NOEXCEPT;
+    static void do_notify(shard& to, const code& ec, chase event_,
+        event_value value, const event_payload& payload) NOEXCEPT;
+    static void do_notify_one(shard& to, object_key key, const code& ec,
+        chase event_, event_value value) NOEXCEPT;
+    static void do_stop(shard& to, const code& ec) NOEXCEPT;
+
+    // This is thread safe.
+    const shards shards_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_EVENT_LOG_HPP
+#define LIBBITCOIN_NODE_EVENT_LOG_HPP
+
+#include <iostream>
+#include <map>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Fixed-width binary encoding of fired events, and its offline aggregation.
+/// A record is the little-endian value (8 bytes), milliseconds since start
+/// (4 bytes), event (1 byte) and zero padding (3 bytes), so that the log is
+/// written without formatting and read without parsing.
+class BCN_API event_log
+{
+public:
+    static constexpr size_t record_size = 16;
+
+    struct record
+    {
+        uint64_t value;
+        uint32_t milliseconds;
+        uint8_t event;
+    };
+
+    /// Counts of each event by interval, index is milliseconds / period.
+    using rates = std::map<uint8_t, std::vector<uint64_t>>;
+
+    /// Write one record to the sink (stream state reflects failure).
+    static void write(std::ostream& sink, const record& record) NOEXCEPT;
+
+    /// Read one record from the source, false at end or on a partial record.
+    static bool read(std::istream& source, record& out) NOEXCEPT;
+
+    /// Count records of each event by period (milliseconds, zero is one).
+    static rates aggregate(std::istream& source, uint32_t period) NOEXCEPT;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
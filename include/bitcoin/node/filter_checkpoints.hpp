@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_FILTER_CHECKPOINTS_HPP
+#define LIBBITCOIN_NODE_FILTER_CHECKPOINTS_HPP
+
+#include <mutex>
+#include <vector>
+#include <bitcoin/database.hpp>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe, array of confirmed bip157 filter headers at each checkpoint
+/// interval, extended from the store on demand. Entries above a reorganized
+/// height are dropped upon the next get, detected by the top entry's block
+/// no longer being confirmed (confirmed chain ancestry is contiguous).
+class BCN_API filter_checkpoints
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(filter_checkpoints);
+
+    /// bip157: checkpoints are at each multiple of 1000 blocks.
+    static constexpr size_t interval = 1'000;
+
+    filter_checkpoints(query& query) NOEXCEPT;
+
+    /// Filter headers of checkpoints at or below height, false if missing.
+    bool get(system::hashes& out, size_t height) NOEXCEPT;
+
+private:
+    struct entry
+    {
+        database::header_link link;
+        system::hash_digest head;
+    };
+
+    // This is thread safe.
+    query& query_;
+
+    // These are protected by mutex.
+    std::vector<entry> entries_{};
+    std::mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
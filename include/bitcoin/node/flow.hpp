@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_FLOW_HPP
+#define LIBBITCOIN_NODE_FLOW_HPP
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Detached coroutine, runs on creation and frees its frame on completion.
+/// A request/response sequence of asynchronous calls is a single frame, with
+/// each completion captured by (and resumed from) the awaiter in the frame,
+/// in place of a bound handler allocated for each step of the sequence.
+/// The coroutine must hold a shared pointer to its owner (by parameter).
+struct flow
+{
+    struct promise_type
+    {
+        flow get_return_object() const NOEXCEPT { return {}; }
+        std::suspend_never initial_suspend() const NOEXCEPT { return {}; }
+        std::suspend_never final_suspend() const NOEXCEPT { return {}; }
+        void return_void() const NOEXCEPT {}
+        void unhandled_exception() const NOEXCEPT { std::terminate(); }
+    };
+};
+
+/// Awaiter of the completion of an asynchronous call, resumed on the strand.
+/// The initiator is invoked with a handler of Args, which owns the frame until
+/// invoked. The result is the tuple of Args. A frame that is never resumed
+/// (handler dropped by the initiator, or strand stopped) is freed with the
+/// last copy of its handler.
+template <typename Strand, typename Initiator, typename... Args>
+class completion
+{
+public:
+    completion(Strand& strand, Initiator initiate) NOEXCEPT
+      : strand_(strand), initiate_(std::move(initiate))
+    {
+    }
+
+    bool await_ready() const NOEXCEPT
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        const auto owner = std::make_shared<resumer>(handle);
+        BC_POP_WARNING()
+
+        initiate_([this, owner](const Args&... args) NOEXCEPT
+        {
+            result_.emplace(args...);
+            boost::asio::post(strand_, std::move(*owner));
+        });
+    }
+
+    std::tuple<Args...> await_resume() NOEXCEPT
+    {
+        return std::move(result_.value());
+    }
+
+private:
+    // Move-only, resumes the frame if invoked, otherwise frees it.
+    class resumer
+    {
+    public:
+        resumer(std::coroutine_handle<> handle) NOEXCEPT
+          : handle_(handle)
+        {
+        }
+
+        resumer(resumer&& other) NOEXCEPT
+          : handle_(std::exchange(other.handle_, {}))
+        {
+        }
+
+        resumer(const resumer&) = delete;
+        resumer& operator=(const resumer&) = delete;
+        resumer& operator=(resumer&&) = delete;
+
+        ~resumer() NOEXCEPT
+        {
+            if (handle_)
+                handle_.destroy();
+        }
+
+        void operator()() NOEXCEPT
+        {
+            std::exchange(handle_, {}).resume();
+        }
+
+    private:
+        std::coroutine_handle<> handle_;
+    };
+
+    Strand& strand_;
+    Initiator initiate_;
+    std::optional<std::tuple<Args...>> result_{};
+};
+
+/// Await completion of initiate(handler) with Args, resumed on the strand.
+template <typename... Args, typename Strand, typename Initiator>
+completion<Strand, std::decay_t<Initiator>, Args...> await(Strand& strand,
+    Initiator&& initiate) NOEXCEPT
+{
+    return { strand, std::forward<Initiator>(initiate) };
+}
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -19,10 +19,37 @@
 #ifndef LIBBITCOIN_NODE_FULL_NODE_HPP
 #define LIBBITCOIN_NODE_FULL_NODE_HPP
 
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <utility>
 #include <bitcoin/database.hpp>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/chasers/chasers.hpp>
+#include <bitcoin/node/compact_relay.hpp>
 #include <bitcoin/node/configuration.hpp>
+#include <bitcoin/node/download_budget.hpp>
+#include <bitcoin/node/event_bus.hpp>
+#include <bitcoin/node/filter_checkpoints.hpp>
+#include <bitcoin/node/hash_filter.hpp>
+#include <bitcoin/node/header_index.hpp>
+#include <bitcoin/node/header_ranges.hpp>
+#include <bitcoin/node/memory_governor.hpp>
+#include <bitcoin/node/metrics_registry.hpp>
+#include <bitcoin/node/peer_scores.hpp>
+#include <bitcoin/node/span_tracer.hpp>
+#include <bitcoin/node/metrics_server.hpp>
+#include <bitcoin/node/block_cache.hpp>
+#include <bitcoin/node/block_claims.hpp>
+#include <bitcoin/node/block_inventory.hpp>
+#include <bitcoin/node/prevout_cache.hpp>
+#include <bitcoin/node/query_server.hpp>
+#include <bitcoin/node/script_cache.hpp>
+#include <bitcoin/node/template_server.hpp>
+#include <bitcoin/node/work_cache.hpp>
+#include <bitcoin/node/worker_shares.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -63,15 +90,49 @@ public:
     virtual void organize(const system::chain::header::cptr& header,
         organize_handler&& handler) NOEXCEPT;
 
+    /// Organize a sequence of headers, handler invoked once.
+    virtual void organize(system::chain::header_cptrs&& headers,
+        organize_handler&& handler) NOEXCEPT;
+
     /// Organize a validated block.
     virtual void organize(const system::chain::block::cptr& block,
         organize_handler&& handler) NOEXCEPT;
 
-    /// Manage download queue.
-    virtual void get_hashes(map_handler&& handler) NOEXCEPT;
+    /// Organize a sequence of blocks, handler invoked once.
+    virtual void organize(system::chain::block_cptrs&& blocks,
+        organize_handler&& handler) NOEXCEPT;
+
+    /// Admit an unconfirmed transaction to the pool.
+    virtual void store(const system::chain::transaction::cptr& tx) NOEXCEPT;
+
+    /// Fill compact block slots from pooled transactions.
+    virtual void reconstruct(const compact_relay::ptr& relay,
+        network::result_handler&& handler) NOEXCEPT;
+
+    /// Pooled transactions by hash, unpooled omitted.
+    virtual void get_transactions(const system::hashes& hashes,
+        transactions_handler&& handler) NOEXCEPT;
+
+    /// Manage download queue, count is a size hint (zero for default).
+    /// Latency is the channel's mean time to first block in microseconds.
+    virtual void get_hashes(size_t count, uint64_t latency,
+        map_handler&& handler) NOEXCEPT;
     virtual void put_hashes(const map_ptr& map,
         network::result_handler&& handler) NOEXCEPT;
 
+    /// Validation results.
+    /// -----------------------------------------------------------------------
+
+    /// Retain block fees computed by validation, for confirmation.
+    virtual void set_fees(const database::header_link& link, size_t height,
+        uint64_t fees) NOEXCEPT;
+
+    /// Obtain and release retained block fees (false if not retained).
+    /// Fees retained at or below the height are released, as those blocks
+    /// were reorganized out or unconfirmable (and are revalidated if needed).
+    virtual bool take_fees(uint64_t& fees, const database::header_link& link,
+        size_t height) NOEXCEPT;
+
     /// Events.
     /// -----------------------------------------------------------------------
 
@@ -79,6 +140,10 @@ public:
     virtual void notify(const code& ec, chase event_,
         event_value value) NOEXCEPT;
 
+    /// Set chaser event with payload shared by all subscribers.
+    virtual void notify(const code& ec, chase event_, event_value value,
+        const event_payload& payload) NOEXCEPT;
+
     /// Set chaser event for the given subscriber only.
     virtual void notify_one(object_key key, const code& ec, chase event_,
         event_value value) NOEXCEPT;
@@ -86,9 +151,9 @@ public:
     /// Call from chaser start() methods (requires strand).
     virtual object_key subscribe_events(event_notifier&& handler) NOEXCEPT;
 
-    /// Call from protocol start() methods.
+    /// Call from protocol start() methods, delivered on an event bus strand.
     virtual void subscribe_events(event_notifier&& handler,
-        event_completer&& complete) NOEXCEPT;
+        event_topics topics, event_completer&& complete) NOEXCEPT;
 
     /// Unsubscribe from chaser events.
     virtual void unsubscribe_events(object_key key) NOEXCEPT;
@@ -121,6 +186,57 @@ public:
     /// Configuration settings for all libraries.
     virtual const configuration& config() const NOEXCEPT;
 
+    /// Cache of recently archived outputs (thread safe).
+    virtual prevout_cache& prevouts() NOEXCEPT;
+
+    /// Pool of threads checking downloaded headers and blocks.
+    virtual network::threadpool& check_pool() NOEXCEPT;
+
+    /// Cache of cumulative work by header (thread safe).
+    virtual work_cache& work() NOEXCEPT;
+
+    /// Partition of the header chain for concurrent download (thread safe).
+    virtual header_ranges& ranges() NOEXCEPT;
+
+    /// Filter of recently organized header hashes (thread safe).
+    virtual hash_filter& seen() NOEXCEPT;
+
+    /// Lock-free node metrics (thread safe).
+    virtual metrics_registry& metrics() NOEXCEPT;
+
+    /// Recorder of pipeline spans for trace export.
+    virtual span_tracer& tracer() NOEXCEPT;
+
+    /// Cache of script-verified transactions by fork flags (thread safe).
+    virtual script_cache& scripts() NOEXCEPT;
+
+    /// Cache of recently organized blocks served to peers (thread safe).
+    virtual block_cache& blocks() NOEXCEPT;
+
+    /// Index of confirmed headers served to peers (thread safe).
+    virtual header_index& confirmed_headers() NOEXCEPT;
+
+    /// Node-wide block download bandwidth budget.
+    virtual download_budget& budget() NOEXCEPT;
+
+    /// Node-wide bound on memory of caches and queues (thread safe).
+    virtual memory_governor& memory() NOEXCEPT;
+
+    /// Merged blocks-first inventory of all channels (thread safe).
+    virtual block_inventory& announced_blocks() NOEXCEPT;
+
+    /// Claims of blocks downloaded by more than one channel (thread safe).
+    virtual block_claims& claims() NOEXCEPT;
+
+    /// Division of threads between block check and validation (thread safe).
+    virtual worker_shares& shares() NOEXCEPT;
+
+    /// Checkpointed bip157 filter headers of the confirmed chain (thread safe).
+    virtual filter_checkpoints& checkpointed_filters() NOEXCEPT;
+
+    /// Download performance by peer, persisted across restarts (thread safe).
+    virtual peer_scores& scores() NOEXCEPT;
+
     /// The candidate chain is current.
     virtual bool is_current() const NOEXCEPT;
 
@@ -141,16 +257,74 @@ protected:
     void do_close() NOEXCEPT override;
 
 private:
+    // Post to the node strand, instrumented if enabled.
+    template <typename Handler>
+    void post_strand(Handler&& handler) NOEXCEPT
+    {
+        if (is_null(monitor_))
+            boost::asio::post(strand(), std::forward<Handler>(handler));
+        else
+            boost::asio::post(strand(),
+                monitor_->wrap(std::forward<Handler>(handler)));
+    }
+
     object_key create_key() NOEXCEPT;
+    void bind_pools() NOEXCEPT;
+    std::filesystem::path manifest_file() const NOEXCEPT;
+    std::filesystem::path scores_file() const NOEXCEPT;
+    void connect_preferred() NOEXCEPT;
+    void load_manifest() NOEXCEPT;
+    void save_manifest() const NOEXCEPT;
     void do_subscribe_events(const event_notifier& handler,
-        const event_completer& complete) NOEXCEPT;
-    void do_notify(const code& ec, chase event_, event_value value) NOEXCEPT;
+        event_topics topics, const event_completer& complete) NOEXCEPT;
+    void do_notify(const code& ec, chase event_, event_value value,
+        const event_payload& payload) NOEXCEPT;
+    void do_notify_coalesced(chase event_) NOEXCEPT;
+    bool coalesce(chase event_, event_value value) NOEXCEPT;
     void do_notify_one(object_key key, const code& ec, chase event_,
         event_value value) NOEXCEPT;
+    bool handle_template(const code& ec, chase event_, event_value value,
+        const event_payload& payload) NOEXCEPT;
 
     // These are thread safe.
     const configuration& config_;
     query& query_;
+    prevout_cache prevouts_;
+    block_cache blocks_;
+    header_index headers_;
+    filter_checkpoints checkpointed_filters_;
+    peer_scores scores_;
+    download_budget budget_;
+    memory_governor memory_;
+    script_cache scripts_;
+    work_cache work_;
+    worker_shares shares_;
+    network::threadpool check_pool_;
+    header_ranges ranges_;
+    block_inventory announced_blocks_;
+    block_claims claims_;
+    hash_filter seen_;
+    event_bus bus_;
+    metrics_registry metrics_{};
+    metrics_server metrics_server_;
+    query_server query_server_;
+    template_server template_server_;
+    span_tracer tracer_;
+    metrics_registry::strand_metrics* monitor_{};
+
+    // Pending maximum value (plus one) and posted flag by coalesced event.
+    struct coalesced
+    {
+        std::atomic<event_value> value{};
+        std::atomic_bool posted{};
+    };
+
+    // These are thread safe.
+    std::array<coalesced, add1(static_cast<size_t>(chase::stop))> coalesced_{};
+
+    // These are protected by mutex.
+    std::multimap<size_t, std::pair<header_t, uint64_t>> fees_{};
+    std::mutex fees_mutex_{};
 
     // These are protected by strand.
     chaser_block chaser_block_;
@@ -162,6 +336,7 @@ private:
     chaser_template chaser_template_;
     chaser_snapshot chaser_snapshot_;
     chaser_storage chaser_storage_;
+    chaser_audit chaser_audit_;
     event_subscriber event_subscriber_;
     object_key keys_{};
 };
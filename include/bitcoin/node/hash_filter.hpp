@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_HASH_FILTER_HPP
+#define LIBBITCOIN_NODE_HASH_FILTER_HPP
+
+#include <atomic>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Lock-free, fixed memory filter of recently seen hashes (thread safe).
+/// Each hash maps to one slot, which is overwritten by newer hashes, so that
+/// membership is recent only. A false positive requires a collision of both
+/// slot and 64 bit tag, which is not feasible for proof of work hashes.
+class BCN_API hash_filter
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(hash_filter);
+
+    /// Slots are rounded up to a power of two, zero disables the filter.
+    hash_filter(size_t slots) NOEXCEPT;
+
+    /// Filter is enabled.
+    bool enabled() const NOEXCEPT;
+
+    /// Mark the hash as seen (no-op if disabled).
+    void insert(const system::hash_digest& hash) NOEXCEPT;
+
+    /// Unmark the hash, unless its slot has since been overwritten.
+    void erase(const system::hash_digest& hash) NOEXCEPT;
+
+    /// The hash was recently seen (false if disabled).
+    bool contains(const system::hash_digest& hash) const NOEXCEPT;
+
+private:
+    static uint64_t to_tag(const system::hash_digest& hash) NOEXCEPT;
+    size_t to_slot(const system::hash_digest& hash) const NOEXCEPT;
+
+    // These are thread safe.
+    const size_t mask_;
+    std::vector<std::atomic_uint64_t> slots_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_HEADER_ARCHIVE_HPP
+#define LIBBITCOIN_NODE_HEADER_ARCHIVE_HPP
+
+#include <filesystem>
+#include <functional>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Compressed file of the header chain from genesis (excluded) to a
+/// checkpoint. Each header omits its previous block hash, which is implied by
+/// its predecessor, so the checkpoint hash commits to the entire file.
+class BCN_API header_archive
+{
+public:
+    /// Serialized bytes of a header less its previous block hash.
+    static constexpr size_t record_size = 48;
+
+    /// Obtain the header at the given height (nullptr to fail).
+    using source = std::function<system::chain::header::cptr(size_t height)>;
+
+    /// Accept the header at the next height (false to fail).
+    using sink = std::function<bool(const system::chain::header& header)>;
+
+    /// Write the headers from height one to the top (inclusive).
+    static code write(const std::filesystem::path& file, size_t top,
+        const source& get) NOEXCEPT;
+
+    /// Verify that the headers link from genesis to the checkpoint, and only
+    /// then pass each to the sink, in order of height.
+    static code read(const std::filesystem::path& file,
+        const system::hash_digest& genesis,
+        const system::chain::checkpoint& commitment, const sink& put) NOEXCEPT;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_HEADER_INDEX_HPP
+#define LIBBITCOIN_NODE_HEADER_INDEX_HPP
+
+#include <shared_mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe, height-indexed array of serialized confirmed headers.
+/// Headers are packed contiguously (80 bytes each), so that a get_headers
+/// reply is a single copy under a shared lock, with no store reads. The index
+/// is contiguous from genesis, a header may only be pushed at the top.
+class BCN_API header_index
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(header_index);
+
+    static constexpr size_t header_size =
+        system::chain::header::serialized_size();
+
+    header_index() NOEXCEPT;
+
+    /// Append the header at height, false if height is not the next height.
+    bool push(const system::chain::header& header, size_t height) NOEXCEPT;
+
+    /// Remove the header at height and all above it (reorganization).
+    void pop(size_t height) NOEXCEPT;
+
+    /// Remove all headers.
+    void clear() NOEXCEPT;
+
+    /// Number of indexed headers (top height plus one, or zero).
+    size_t count() const NOEXCEPT;
+
+    /// Up to maximum headers from start height, empty if start out of range.
+    system::chain::header_cptrs get(size_t start,
+        size_t maximum) const NOEXCEPT;
+
+private:
+    // This is thread safe.
+    mutable std::shared_mutex mutex_{};
+
+    // This is protected by mutex.
+    system::data_chunk headers_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_HEADER_RANGES_HPP
+#define LIBBITCOIN_NODE_HEADER_RANGES_HPP
+
+#include <functional>
+#include <map>
+#include <shared_mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe partition of the header chain into checkpoint bounded ranges.
+/// Ranges are claimed and downloaded concurrently by channels, and complete
+/// ranges are organized strictly in height order, one batch at a time.
+class BCN_API header_ranges
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(header_ranges);
+
+    struct range
+    {
+        size_t index;
+        system::chain::checkpoint start;
+        system::chain::checkpoint stop;
+    };
+
+    using organizer = std::function<void(system::chain::header_cptrs&&,
+        organize_handler&&)>;
+
+    /// Checkpoints must be sorted by height (ranges are bounded by them).
+    header_ranges(const system::chain::checkpoints& checkpoints,
+        organizer&& organize) NOEXCEPT;
+
+    /// Partition the checkpoints above top, with the first range from top.
+    void start(const system::chain::checkpoint& top) NOEXCEPT;
+
+    /// Claim the lowest unclaimed range, false if none remain.
+    bool claim(range& out) NOEXCEPT;
+
+    /// Return an incomplete claimed range for claim by another channel.
+    void release(const range& range) NOEXCEPT;
+
+    /// Deposit all headers of a claimed range, false (released) if invalid.
+    bool complete(const range& range,
+        system::chain::header_cptrs&& headers) NOEXCEPT;
+
+    /// All ranges have been organized.
+    bool done() const NOEXCEPT;
+
+private:
+    void organize_next() NOEXCEPT;
+    void handle_organize(const code& ec, size_t height,
+        size_t index) NOEXCEPT;
+
+    // These are thread safe.
+    const system::chain::checkpoints checkpoints_;
+    const organizer organize_;
+
+    // These are protected by mutex.
+    std::vector<range> ranges_{};
+    std::vector<bool> claimed_{};
+    std::map<size_t, system::chain::header_cptrs> ready_{};
+    size_t next_{};
+    bool organizing_{};
+    mutable std::shared_mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -29,6 +29,7 @@ namespace libbitcoin {
 namespace node {
 
 BC_PUSH_WARNING(NO_NEW_OR_DELETE)
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
 // Public
 // ----------------------------------------------------------------------------
@@ -39,7 +40,13 @@ CLASS::chaser_organize(full_node& node) NOEXCEPT
     settings_(config().bitcoin),
     milestone_(config().bitcoin.milestone),
     checkpoints_(config().bitcoin.sorted_checkpoints()),
-    top_checkpoint_height_(config().bitcoin.top_checkpoint().height())
+    top_checkpoint_height_(config().bitcoin.top_checkpoint().height()),
+    maximum_tree_bytes_(possible_narrow_cast<size_t>(
+        config().node.tree_bytes)),
+    persist_tree_(config().node.persist_tree),
+    governed_(memory().enabled()),
+    tree_file_(config().database.path / (is_block() ?
+        "block_tree.cache" : "header_tree.cache"))
 {
 }
 
@@ -73,10 +80,29 @@ code CLASS::start() NOEXCEPT
     LOGN("Candidate top [" << encode_hash(state_->hash()) << ":"
         << state_->height() << "].");
 
-    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3);
+    // Tree usage is sampled by the governor, and shrunk on the strand.
+    memory().enroll(is_block() ? "block_tree" : "header_tree",
+        [this]() NOEXCEPT
+        {
+            return possible_wide_cast<uint64_t>(tree_bytes_.load());
+        },
+        [this](uint64_t excess) NOEXCEPT
+        {
+            POST(do_shrink, possible_narrow_cast<size_t>(excess));
+        });
+
+    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3, _4);
+    load_tree();
     return error::success;
 }
 
+TEMPLATE
+void CLASS::stopping(const code& ec) NOEXCEPT
+{
+    POST(do_stopping, ec);
+    chaser::stopping(ec);
+}
+
 TEMPLATE
 void CLASS::organize(const typename Block::cptr& block_ptr,
     organize_handler&& handler) NOEXCEPT
@@ -87,6 +113,43 @@ void CLASS::organize(const typename Block::cptr& block_ptr,
     }
 }
 
+TEMPLATE
+void CLASS::organize(block_ptrs&& blocks,
+    organize_handler&& handler) NOEXCEPT
+{
+    if (closed())
+    {
+        handler(network::error::service_stopped, {});
+        return;
+    }
+
+    if (blocks.empty())
+    {
+        handler(error::success, {});
+        return;
+    }
+
+    const auto batch = std::make_shared<organization>(std::move(blocks),
+        std::move(handler));
+
+    // Context-free checks (hashing) are independent, so run concurrently.
+    const auto threads = std::max(size_t{ config().node.check_threads }, one);
+    const auto jobs = std::min(threads, batch->blocks.size());
+    batch->pending.store(jobs);
+    for (size_t job = 0; job < jobs; ++job)
+        boost::asio::post(check_pool().service(),
+            std::bind(&CLASS::check_batch, this, batch));
+}
+
+// Virtual
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+code CLASS::check(const Block&) const NOEXCEPT
+{
+    return error::success;
+}
+
 // Properties
 // ----------------------------------------------------------------------------
 
@@ -106,7 +169,8 @@ const typename CLASS::block_tree& CLASS::tree() const NOEXCEPT
 // ----------------------------------------------------------------------------
 
 TEMPLATE
-bool CLASS::handle_event(const code&, chase event_, event_value value) NOEXCEPT
+bool CLASS::handle_event(const code&, chase event_, event_value value,
+    const event_payload&) NOEXCEPT
 {
     using namespace system;
 
@@ -145,6 +209,109 @@ void CLASS::do_organize(typename Block::cptr& block_ptr,
     const organize_handler& handler) NOEXCEPT
 {
     BC_ASSERT(stranded());
+    const auto hash = block_ptr->hash();
+    organize_block(block_ptr, [&](const code& ec, size_t height) NOEXCEPT
+    {
+        filter(hash, ec);
+        handler(ec, height);
+    }, false);
+}
+
+// START WORK UNIT
+// One job per worker (up to one per block), each claims blocks until the
+// batch is exhausted. Slots are read on the strand once the last finishes.
+TEMPLATE
+void CLASS::check_batch(const organization::ptr& batch) NOEXCEPT
+{
+    const auto count = batch->blocks.size();
+    for (auto index = batch->next.fetch_add(one); !closed() && index < count;
+        index = batch->next.fetch_add(one))
+        batch->codes.at(index) = check(*batch->blocks.at(index));
+
+    // FINISH WORK UNIT
+    if (batch->pending.fetch_sub(one) == one)
+        POST(do_organize_batch, batch);
+}
+
+// Duplicates are expected from concurrent peers, so do not end the batch.
+TEMPLATE
+void CLASS::do_organize_batch(const organization::ptr& batch) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (closed())
+    {
+        batch->handler(network::error::service_stopped, {});
+        return;
+    }
+
+    code result{};
+    size_t height{};
+    size_t top{};
+    const organize_handler capture = [&](const code& ec, size_t at) NOEXCEPT
+    {
+        result = ec;
+        height = at;
+    };
+
+    deferred_ = { true };
+    code ec{};
+    for (size_t index = 0; index < batch->blocks.size(); ++index)
+    {
+        if ((ec = batch->codes.at(index)))
+        {
+            height = zero;
+            break;
+        }
+
+        auto block_ptr = batch->blocks.at(index);
+        organize_block(block_ptr, capture, true);
+        filter(block_ptr->hash(), result);
+        if (result && result != error_duplicate())
+        {
+            ec = result;
+            break;
+        }
+
+        top = height;
+    }
+
+    // Blocks organized ahead of a failure are notified as well.
+    const auto deferred = deferred_;
+    deferred_ = {};
+    if (deferred.branch_point != max_size_t)
+        notify_organized(deferred.current, deferred.branch_point,
+            deferred.regressed);
+
+    batch->handler(ec, ec ? height : top);
+}
+
+// Organized and duplicate headers are filtered at the channel, since those are
+// already in the tree or store. Blocks are requested, so are not filtered.
+TEMPLATE
+void CLASS::filter(const system::hash_digest& hash,
+    const code& ec) const NOEXCEPT
+{
+    if constexpr (!is_block())
+    {
+        if (!ec || ec == error_duplicate())
+            seen().insert(hash);
+    }
+}
+
+// An evicted header may be sent again, so must not be dropped at the channel.
+TEMPLATE
+void CLASS::unfilter(const system::hash_digest& hash) const NOEXCEPT
+{
+    if constexpr (!is_block())
+        seen().erase(hash);
+}
+
+TEMPLATE
+void CLASS::organize_block(typename Block::cptr& block_ptr,
+    const organize_handler& handler, bool checked) NOEXCEPT
+{
+    BC_ASSERT(stranded());
 
     using namespace system;
     const auto hash = block_ptr->hash();
@@ -163,7 +330,7 @@ void CLASS::do_organize(typename Block::cptr& block_ptr,
     const auto it = tree_.find(hash);
     if (it != tree_.end())
     {
-        handler(error_duplicate(), it->second.state->height());
+        handler(error_duplicate(), it->second.context.height);
         return;
     }
 
@@ -220,6 +387,9 @@ void CLASS::do_organize(typename Block::cptr& block_ptr,
     }
 
     // Roll chain state forward from archived parent to current header.
+    // The roll-forward copies the parent's sample windows (system chain_state)
+    // so the parent is taken from state_ or a retained tree state where
+    // possible, reconstructing at most state_interval states otherwise.
     const auto state = std::make_shared<chain_state>(*parent, header, settings_);
 
     // Validation and currency.
@@ -232,7 +402,9 @@ void CLASS::do_organize(typename Block::cptr& block_ptr,
         return;
     };
 
-    if (const auto ec = validate(*block_ptr, *state))
+    code ec{};
+    if ((!checked && ((ec = check(*block_ptr)))) ||
+        ((ec = validate(*block_ptr, *state))))
     {
         handler(ec, height);
         return;
@@ -351,9 +523,38 @@ void CLASS::do_organize(typename Block::cptr& block_ptr,
     // Reset top chain state and notify.
     // ........................................................................
 
+    // A batch notifies once for all of its branches, from the lowest.
+    const auto current = is_block() || is_current(header.timestamp());
+    if (deferred_.active)
+    {
+        deferred_.current = deferred_.current || current;
+        deferred_.branch_point = std::min(deferred_.branch_point,
+            branch_point);
+
+        if (branch_point < top_candidate)
+            deferred_.regressed = std::min(deferred_.regressed, branch_point);
+    }
+    else
+    {
+        notify_organized(current, branch_point,
+            branch_point < top_candidate ? branch_point : max_size_t);
+    }
+
+    // Logs from candidate block parent to the candidate (forward sequential).
+    log_state_change(*parent, *state);
+    state_ = state;
+    metrics().set(metrics_registry::gauge::candidate_height, height);
+
+    handler(error::success, height);
+}
+
+TEMPLATE
+void CLASS::notify_organized(bool current, size_t branch_point,
+    size_t regressed) const NOEXCEPT
+{
     // Delay so headers can get current before block download starts.
     // Checking currency before notify also avoids excessive work backlog.
-    if (is_block() || is_current(header.timestamp()))
+    if (current)
     {
         // If at start the fork point is top of both chains, and next candidate
         // is already downloaded, then new header will arrive and download will
@@ -370,16 +571,10 @@ void CLASS::do_organize(typename Block::cptr& block_ptr,
     // Check chaser may be working on any of the blocks, and subsequent until
     // it receives this message. That will reset to the branch point, but the
     // work on the new branch is usable.
-    if (branch_point < top_candidate)
+    if (regressed != max_size_t)
     {
-        notify(error::success, chase::regressed, branch_point);
+        notify(error::success, chase::regressed, regressed);
     }
-
-    // Logs from candidate block parent to the candidate (forward sequential).
-    log_state_change(*parent, *state);
-    state_ = state;
-
-    handler(error::success, height);
 }
 
 TEMPLATE
@@ -500,6 +695,8 @@ void CLASS::do_disorganize(header_t link) NOEXCEPT
     // Logs from previous top candidate to previous fork point (jumps back).
     log_state_change(*state_, *state);
     state_ = state;
+    metrics().set(metrics_registry::gauge::candidate_height,
+        state_->height());
 }
 
 // The archived malleable block was found to be invalid (treat as malleated).
@@ -529,6 +726,14 @@ void CLASS::do_malleated(header_t link) NOEXCEPT
     notify(error::success, chase::header, link);
 }
 
+// Weak branches are evicted oldest first, as when the tree exceeds its bound.
+TEMPLATE
+void CLASS::do_shrink(size_t excess) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    limit(floored_subtract(tree_bytes_.load(), excess));
+}
+
 // Private
 // ----------------------------------------------------------------------------
 
@@ -536,7 +741,124 @@ TEMPLATE
 void CLASS::cache(const typename Block::cptr& block_ptr,
     const chain_state::ptr& state) NOEXCEPT
 {
-    tree_.insert({ block_ptr->hash(), { block_ptr, state } });
+    const auto hash = block_ptr->hash();
+    const auto bytes = footprint(*block_ptr) + state_bytes;
+    if (!tree_.insert({ hash, { block_ptr, state, state->context(), bytes } })
+        .second)
+        return;
+
+    const auto& previous = get_header(*block_ptr).previous_block_hash();
+    children_.emplace(previous, hash);
+    tree_bytes_ += bytes;
+    compact(previous);
+
+    if (!is_zero(maximum_tree_bytes_) || governed_)
+        order_.push_back(hash);
+
+    if (!is_zero(maximum_tree_bytes_))
+        limit(maximum_tree_bytes_);
+}
+
+// Only the tip of a branch and every state_interval height retain state, so
+// that a tree entry costs tens of bytes beyond its Block, not kilobytes.
+TEMPLATE
+void CLASS::compact(const system::hash_digest& parent) NOEXCEPT
+{
+    const auto it = tree_.find(parent);
+    if (it == tree_.end() || !it->second.state ||
+        is_multiple(it->second.context.height, state_interval))
+        return;
+
+    it->second.state.reset();
+    it->second.bytes = floored_subtract(it->second.bytes, state_bytes);
+    tree_bytes_ = floored_subtract(tree_bytes_.load(), state_bytes);
+}
+
+TEMPLATE
+void CLASS::unlink(const system::hash_digest& key,
+    const block_state& value) NOEXCEPT
+{
+    const auto& previous = get_header(*value.block).previous_block_hash();
+    const auto range = children_.equal_range(previous);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == key)
+        {
+            children_.erase(it);
+            break;
+        }
+    }
+
+    tree_bytes_ = floored_subtract(tree_bytes_.load(), value.bytes);
+}
+
+// Descendants are removed iteratively, as a branch may be very long.
+TEMPLATE
+size_t CLASS::evict(const system::hash_digest& key) NOEXCEPT
+{
+    size_t count{};
+    system::hashes pending{ key };
+    while (!pending.empty())
+    {
+        const auto hash = pending.back();
+        pending.pop_back();
+
+        const auto it = tree_.find(hash);
+        if (it == tree_.end())
+            continue;
+
+        const auto range = children_.equal_range(hash);
+        for (auto child = range.first; child != range.second; ++child)
+            pending.push_back(child->second);
+
+        unlink(hash, it->second);
+        tree_.erase(it);
+        unfilter(hash);
+        ++count;
+    }
+
+    return count;
+}
+
+// The oldest entry is the root of the oldest branch, since a parent is always
+// cached before its children. Its descendants cannot remain without it, as
+// branch work is summed from the tree to the store.
+TEMPLATE
+void CLASS::limit(size_t maximum) NOEXCEPT
+{
+    size_t count{};
+    while (tree_bytes_ > maximum && !order_.empty())
+    {
+        count += evict(order_.front());
+        order_.pop_front();
+    }
+
+    if (!is_zero(count))
+    {
+        LOGN("Evicted (" << count << ") weak branch entries, tree ("
+            << tree_.size() << ").");
+    }
+
+    // Drop hashes of entries since pushed or evicted, retaining order.
+    if (order_.size() > two * tree_.size())
+    {
+        std::erase_if(order_, [&](const system::hash_digest& hash) NOEXCEPT
+        {
+            return !tree_.contains(hash);
+        });
+    }
+}
+
+TEMPLATE
+size_t CLASS::footprint(const Block& block) NOEXCEPT
+{
+    constexpr auto overhead = two * sizeof(system::hash_digest) +
+        sizeof(block_state) + sizeof(Block);
+
+    if constexpr (is_block())
+        return overhead + block.serialized_size(true);
+    else
+        return overhead;
 }
 
 TEMPLATE
@@ -553,12 +875,52 @@ CLASS::chain_state::ptr CLASS::get_chain_state(
     // Previous block may be cached because it is not yet strong.
     const auto it = tree_.find(previous_hash);
     if (it != tree_.end())
-        return it->second.state;
+        return it->second.state ? it->second.state :
+            get_tree_state(previous_hash);
 
     // previous_hash may or not exist and/or be a candidate.
     return archive().get_chain_state(settings_, previous_hash);
 }
 
+// A tree entry without state is reconstructed, without caching, by rolling
+// forward from its nearest ancestor that retains state. That is at most
+// state_interval entries, or the tree root's parent (top or store state).
+TEMPLATE
+CLASS::chain_state::ptr CLASS::get_tree_state(
+    const system::hash_digest& hash) const NOEXCEPT
+{
+    chain_state::ptr state{};
+    std::vector<const system::chain::header*> headers{};
+
+    auto key = &hash;
+    for (auto it = tree_.find(*key); it != tree_.end(); it = tree_.find(*key))
+    {
+        if (it->second.state)
+        {
+            state = it->second.state;
+            break;
+        }
+
+        const auto& header = get_header(*it->second.block);
+        key = &header.previous_block_hash();
+        headers.push_back(&header);
+    }
+
+    if (!state)
+    {
+        state = (state_->hash() == *key) ? state_ :
+            archive().get_chain_state(settings_, *key);
+
+        if (!state)
+            return {};
+    }
+
+    for (const auto header: views_reverse(headers))
+        state = std::make_shared<chain_state>(*state, *header, settings_);
+
+    return state;
+}
+
 // Also obtains branch point for work summation termination.
 // Also obtains ordered branch identifiers for subsequent reorg.
 TEMPLATE
@@ -606,6 +968,18 @@ bool CLASS::get_is_strong(bool& strong, const uint256_t& branch_work,
     uint256_t candidate_work{};
     const auto& query = archive();
 
+    // Candidate work above the branch point is the difference of cumulatives.
+    if (work().enabled())
+    {
+        const auto candidate = query.to_candidate(query.get_top_candidate());
+        if (!work().get_work(candidate_work, query, candidate,
+            query.to_candidate(branch_point)))
+            return false;
+
+        strong = branch_work > candidate_work;
+        return true;
+    }
+
     for (auto height = query.get_top_candidate(); height > branch_point;
         --height)
     {
@@ -650,7 +1024,8 @@ bool CLASS::push(const system::hash_digest& key) NOEXCEPT
 
     auto& query = archive();
     const auto& it = value.mapped();
-    const auto link = query.set_link(*it.block, it.state->context());
+    unlink(key, it);
+    const auto link = query.set_link(*it.block, it.context);
     return query.push_candidate(link);
 }
 
@@ -738,6 +1113,85 @@ void CLASS::notify_bypass() const NOEXCEPT
         std::max(active_milestone_height_, top_checkpoint_height_));
 }
 
+// Persistence methods.
+// ----------------------------------------------------------------------------
+
+// Blocks are written in height order so that each parent is organized before
+// its children when restored. Spill is best effort, as the tree only saves
+// the retransmission and revalidation of its Blocks.
+TEMPLATE
+void CLASS::do_stopping(const code&) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (!persist_tree_ || tree_.empty())
+        return;
+
+    std::vector<const block_state*> entries{};
+    entries.reserve(tree_.size());
+    for (const auto& entry: tree_)
+        entries.push_back(&entry.second);
+
+    std::sort(entries.begin(), entries.end(),
+        [](const block_state* left, const block_state* right) NOEXCEPT
+        {
+            return left->context.height < right->context.height;
+        });
+
+    system::ofstream file{ tree_file_, std::ios_base::binary };
+    for (const auto entry: entries)
+    {
+        if constexpr (is_block())
+            entry->block->to_data(file, true);
+        else
+            entry->block->to_data(file);
+    }
+
+    if (!file.good())
+    {
+        LOGN("Failure writing tree to " << tree_file_ << ".");
+        return;
+    }
+
+    LOGN("Saved tree entries (" << entries.size() << ").");
+}
+
+// The file is removed once read, so that a stale tree is never restored.
+// Restored Blocks are organized as if received, so are validated as such.
+TEMPLATE
+void CLASS::load_tree() NOEXCEPT
+{
+    if (!persist_tree_)
+        return;
+
+    size_t count{};
+    {
+        system::ifstream file{ tree_file_, std::ios_base::binary };
+        while (file.good() && file.peek() != std::ifstream::traits_type::eof())
+        {
+            typename Block::cptr block_ptr{};
+            if constexpr (is_block())
+                block_ptr = std::make_shared<const Block>(file, true);
+            else
+                block_ptr = std::make_shared<const Block>(file);
+
+            if (!block_ptr->is_valid())
+                break;
+
+            organize(block_ptr, [](const code&, size_t) NOEXCEPT {});
+            ++count;
+        }
+    }
+
+    std::error_code ec{};
+    std::filesystem::remove(tree_file_, ec);
+
+    if (!is_zero(count))
+    {
+        LOGN("Restored tree entries (" << count << ").");
+    }
+}
+
 // Logging.
 // ----------------------------------------------------------------------------
 
@@ -769,6 +1223,7 @@ void CLASS::log_state_change(const chain_state& from,
     }
 }
 
+BC_POP_WARNING()
 BC_POP_WARNING()
 
 } // namespace node
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_LOOPBACK_ACCEPTOR_HPP
+#define LIBBITCOIN_NODE_LOOPBACK_ACCEPTOR_HPP
+
+#include <functional>
+#include <memory>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Acceptor on the loopback interface, shared by the local servers.
+/// Each accepted socket is handed to the owner on the strand, once the next
+/// accept is pending. Not thread safe, protected by the owner's strand.
+class BCN_API loopback_acceptor
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(loopback_acceptor);
+
+    using tcp = boost::asio::ip::tcp;
+    using handler = std::function<void(tcp::socket&&)>;
+
+    /// Sockets are created on the service, accepts complete on the strand.
+    loopback_acceptor(network::asio::io_context& service,
+        network::asio::strand& strand) NOEXCEPT;
+
+    /// Bind and listen on the loopback port, then accept on the strand.
+    /// Binding is synchronous, so that failure is returned to the caller.
+    bool start(uint16_t port, handler&& accepted) NOEXCEPT;
+
+    /// True if listening.
+    bool is_open() const NOEXCEPT;
+
+    /// Close the acceptor, a pending accept is aborted.
+    void stop() NOEXCEPT;
+
+private:
+    void accept() NOEXCEPT;
+    void handle_accept(const boost::system::error_code& ec,
+        const std::shared_ptr<tcp::socket>& socket) NOEXCEPT;
+
+    // These are protected by strand.
+    network::asio::io_context& service_;
+    network::asio::strand& strand_;
+    tcp::acceptor acceptor_;
+    handler accepted_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
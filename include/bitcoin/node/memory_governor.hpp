@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_MEMORY_GOVERNOR_HPP
+#define LIBBITCOIN_NODE_MEMORY_GOVERNOR_HPP
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe, node-wide bound on the memory of caches and queues.
+/// Each subsystem enrolls a sampler of its (approximate) usage, and those
+/// that can evict enroll a shrinker. Balance samples all usage, and while it
+/// exceeds the maximum asks each shrinker in enrollment order to release the
+/// excess. It then sets the allowance, the percentage of intake (downloads,
+/// pool admission) to permit, falling linearly from 100 at the low watermark
+/// to zero at the maximum. Samplers and shrinkers must be thread safe.
+class BCN_API memory_governor
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(memory_governor);
+
+    /// Approximate bytes used by the subsystem.
+    using sampler = std::function<uint64_t()>;
+
+    /// Release up to excess bytes (may complete asynchronously).
+    using shrinker = std::function<void(uint64_t excess)>;
+
+    /// Zero maximum bytes disables the governor.
+    memory_governor(uint64_t maximum_bytes) NOEXCEPT;
+
+    /// Governor is enabled.
+    bool enabled() const NOEXCEPT;
+
+    /// Enroll a subsystem (ignored if disabled).
+    void enroll(const std::string& name, sampler&& usage,
+        shrinker&& shrink={}) NOEXCEPT;
+
+    /// Sample, shrink if over the maximum, and return the new allowance.
+    size_t balance() NOEXCEPT;
+
+    /// Total usage as of the last balance.
+    uint64_t usage() const NOEXCEPT;
+
+    /// Current usage of the named subsystem (zero if not enrolled).
+    uint64_t usage(const std::string& name) const NOEXCEPT;
+
+    /// Percentage of intake to permit, as of the last balance.
+    size_t allowance() const NOEXCEPT;
+
+    /// Usage was at or above the maximum as of the last balance.
+    bool pressured() const NOEXCEPT;
+
+private:
+    struct subsystem
+    {
+        std::string name;
+        sampler usage;
+        shrinker shrink;
+    };
+
+    uint64_t sample() const NOEXCEPT;
+
+    // These are thread safe.
+    const uint64_t maximum_bytes_;
+    const uint64_t low_bytes_;
+    std::atomic<uint64_t> usage_{};
+    std::atomic_size_t allowance_{ 100 };
+    mutable std::mutex mutex_{};
+
+    // These are protected by mutex.
+    std::vector<subsystem> subsystems_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_METRICS_REGISTRY_HPP
+#define LIBBITCOIN_NODE_METRICS_REGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/events.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Lock-free registry of node metrics, updated on hot paths (thread safe).
+/// Each reporting event is counted as fired, in addition to the explicit
+/// counters, gauges and histograms. The report is OpenMetrics text, so this
+/// is read by scrape without any logger or strand synchronization.
+class BCN_API metrics_registry
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(metrics_registry);
+
+    enum class counter : uint8_t
+    {
+        archived_bytes,
+        snapshot_bytes,
+        count
+    };
+
+    enum class gauge : uint8_t
+    {
+        candidate_height,
+        checked_height,
+        validated_height,
+        confirmed_height,
+        count
+    };
+
+    enum class histogram : uint8_t
+    {
+        archive_microseconds,
+        snapshot_milliseconds,
+        count
+    };
+
+    enum class strand : uint8_t
+    {
+        node,
+        header,
+        block,
+        check,
+        validate,
+        confirm,
+        transaction,
+        template_,
+        snapshot,
+        storage,
+        audit,
+        count
+    };
+
+    /// Instrumentation of handlers posted to a strand (thread safe).
+    /// Depth is handlers posted but not yet started, wait is time from post
+    /// to start, and run is time from start to completion of the handler.
+    class strand_metrics
+    {
+    public:
+        /// Wrap a handler to be posted to the strand.
+        template <typename Handler>
+        auto wrap(Handler&& handler) NOEXCEPT
+        {
+            depth.fetch_add(one, std::memory_order_relaxed);
+            return [this, posted = now(),
+                handler = std::forward<Handler>(handler)]() mutable NOEXCEPT
+            {
+                const auto started = begin(posted);
+                handler();
+                end(started);
+            };
+        }
+
+        std::atomic_uint64_t depth{};
+        std::atomic_uint64_t handled{};
+        std::atomic_uint64_t wait_microseconds{};
+        std::atomic_uint64_t run_microseconds{};
+
+    private:
+        using clock = std::chrono::steady_clock;
+        static clock::time_point now() NOEXCEPT;
+        clock::time_point begin(const clock::time_point& posted) NOEXCEPT;
+        void end(const clock::time_point& started) NOEXCEPT;
+    };
+
+    /// Histogram buckets are powers of two, with the last unbounded.
+    static constexpr size_t buckets = 32;
+
+    metrics_registry() NOEXCEPT;
+
+    /// Count a fired reporting event.
+    void fired(uint8_t event_) NOEXCEPT;
+
+    /// Add to a counter.
+    void add(counter metric, uint64_t value=one) NOEXCEPT;
+
+    /// Set a gauge.
+    void set(gauge metric, uint64_t value) NOEXCEPT;
+
+    /// Record an observation in a histogram.
+    void observe(histogram metric, uint64_t value) NOEXCEPT;
+
+    /// Instrumentation for the given strand.
+    strand_metrics& strand_at(strand id) NOEXCEPT;
+    const strand_metrics& strand_at(strand id) const NOEXCEPT;
+
+    /// Name of the given strand.
+    static const std::string& strand_name(strand id) NOEXCEPT;
+
+    /// Read a metric (for test and console).
+    uint64_t fired_count(uint8_t event_) const NOEXCEPT;
+    uint64_t value(counter metric) const NOEXCEPT;
+    uint64_t value(gauge metric) const NOEXCEPT;
+    uint64_t observations(histogram metric) const NOEXCEPT;
+
+    /// All metrics in OpenMetrics text exposition format.
+    std::string report() const NOEXCEPT;
+
+private:
+    using atomic = std::atomic_uint64_t;
+    static constexpr size_t events_count = add1<size_t>(events::snapshot_span);
+
+    template <typename Enum>
+    static constexpr size_t count() NOEXCEPT
+    {
+        return static_cast<size_t>(Enum::count);
+    }
+
+    struct distribution
+    {
+        std::array<atomic, buckets> counts{};
+        atomic sum{};
+        atomic total{};
+    };
+
+    // These are thread safe.
+    std::array<atomic, events_count> fired_{};
+    std::array<atomic, count<counter>()> counters_{};
+    std::array<atomic, count<gauge>()> gauges_{};
+    std::array<distribution, count<histogram>()> histograms_{};
+    std::array<strand_metrics, count<strand>()> strands_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
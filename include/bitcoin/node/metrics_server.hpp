@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_METRICS_SERVER_HPP
+#define LIBBITCOIN_NODE_METRICS_SERVER_HPP
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/loopback_acceptor.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Minimal HTTP responder for metrics scrape, on the loopback interface.
+/// Any request on a connection is answered with the current report, after
+/// which the connection is closed. No request parsing is performed, as the
+/// sole resource is the report (e.g. GET /metrics).
+class BCN_API metrics_server
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(metrics_server);
+
+    using reporter = std::function<std::string()>;
+
+    /// The reporter is invoked on a service thread for each response.
+    metrics_server(network::asio::io_context& service,
+        reporter&& report) NOEXCEPT;
+
+    /// Listen on the loopback port (zero disables).
+    code start(uint16_t port) NOEXCEPT;
+
+    /// Stop listening (pending connections complete).
+    void stop() NOEXCEPT;
+
+private:
+    using tcp = boost::asio::ip::tcp;
+
+    struct connection
+    {
+        typedef std::shared_ptr<connection> ptr;
+        connection(tcp::socket&& socket) NOEXCEPT;
+
+        tcp::socket socket;
+        std::array<char, 1024> request{};
+        std::string response{};
+    };
+
+    void do_start(uint16_t port) NOEXCEPT;
+    void do_stop() NOEXCEPT;
+    void handle_accept(tcp::socket&& socket) NOEXCEPT;
+    void handle_request(const boost::system::error_code& ec,
+        const connection::ptr& connection) NOEXCEPT;
+    static void handle_response(const boost::system::error_code& ec,
+        const connection::ptr& connection) NOEXCEPT;
+
+    // These are thread safe.
+    const reporter report_;
+
+    // These are protected by strand.
+    network::asio::strand strand_;
+    loopback_acceptor acceptor_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
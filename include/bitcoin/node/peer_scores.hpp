@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_PEER_SCORES_HPP
+#define LIBBITCOIN_NODE_PEER_SCORES_HPP
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe, bounded record of block download performance by peer. This
+/// is persisted across restarts, so that connections can favor peers that
+/// have served blocks quickly. The rate is a moving average of reported bytes
+/// per second, and the score is the rate halved for each stall or slow drop.
+/// Text encoding is one "host port rate drops" record per line.
+class BCN_API peer_scores
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(peer_scores);
+
+    struct score
+    {
+        std::string host{};
+        uint16_t port{};
+        uint64_t rate{};
+        uint32_t drops{};
+    };
+
+    typedef std::vector<score> scores;
+
+    /// Lowest scored peers are evicted above capacity (zero disables).
+    peer_scores(size_t capacity) NOEXCEPT;
+
+    /// Record a measured download rate (bytes per second) of the peer.
+    void record(const std::string& host, uint16_t port,
+        uint64_t rate) NOEXCEPT;
+
+    /// Record that the peer was dropped as stalled or slow.
+    void drop(const std::string& host, uint16_t port) NOEXCEPT;
+
+    /// Up to count peers with nonzero score, highest score first.
+    scores best(size_t count) const NOEXCEPT;
+
+    /// Number of recorded peers.
+    size_t size() const NOEXCEPT;
+
+    /// Encode as text lines.
+    std::string to_string() const NOEXCEPT;
+
+    /// Decode text lines (replacing all), false if any line is malformed.
+    bool from_string(const std::string& text) NOEXCEPT;
+
+    /// Write the scores to the file, false on failure.
+    bool save(const std::filesystem::path& file) const NOEXCEPT;
+
+    /// Read the scores from the file, false if missing or malformed.
+    bool load(const std::filesystem::path& file) NOEXCEPT;
+
+    /// Rate halved for each drop.
+    static uint64_t to_score(const score& peer) NOEXCEPT;
+
+private:
+    // Weight of a new rate in the moving average is one quarter.
+    static constexpr size_t rate_shift = 2;
+
+    static std::string to_key(const std::string& host, uint16_t port) NOEXCEPT;
+    score& find(const std::string& host, uint16_t port) NOEXCEPT;
+    void evict() NOEXCEPT;
+
+    // This is thread safe.
+    const size_t capacity_;
+
+    // These are protected by mutex.
+    std::unordered_map<std::string, score> scores_{};
+    mutable std::mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_PREVOUT_CACHE_HPP
+#define LIBBITCOIN_NODE_PREVOUT_CACHE_HPP
+
+#include <array>
+#include <deque>
+#include <shared_mutex>
+#include <unordered_map>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe, sharded, memory-bounded cache of recently archived outputs.
+/// Outputs are cached as blocks are archived and removed as they are used to
+/// populate a spending input, or evicted (oldest first) upon shard overflow.
+class BCN_API prevout_cache
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(prevout_cache);
+
+    /// Zero maximum bytes disables the cache.
+    prevout_cache(uint64_t maximum_bytes) NOEXCEPT;
+
+    /// Cache is enabled.
+    bool enabled() const NOEXCEPT;
+
+    /// Cache the outputs of all transactions of the block.
+    void put(const system::chain::block& block) NOEXCEPT;
+
+    /// Populate unpopulated non-null inputs from cache, taking the outputs.
+    /// True if all non-null inputs of the transaction are then populated.
+    bool populate(const system::chain::transaction& tx) NOEXCEPT;
+
+    /// Approximate current memory consumption.
+    uint64_t bytes() const NOEXCEPT;
+
+private:
+    static constexpr size_t shard_count = 64;
+
+    struct key
+    {
+        system::hash_digest hash;
+        uint32_t index;
+
+        bool operator==(const key& other) const NOEXCEPT
+        {
+            return index == other.index && hash == other.hash;
+        }
+    };
+
+    struct key_hash
+    {
+        size_t operator()(const key& value) const NOEXCEPT
+        {
+            return std::hash<system::hash_digest>{}(value.hash) ^ value.index;
+        }
+    };
+
+    struct shard
+    {
+        mutable std::shared_mutex mutex{};
+        std::unordered_map<key, system::chain::output::cptr, key_hash> map{};
+        std::deque<key> order{};
+        uint64_t bytes{};
+    };
+
+    static uint64_t footprint(const system::chain::output& output) NOEXCEPT;
+    shard& get_shard(const key& value) NOEXCEPT;
+    void put(shard& to, key&& value,
+        const system::chain::output::cptr& output) NOEXCEPT;
+
+    // These are thread safe.
+    const uint64_t shard_bytes_;
+    std::array<shard, shard_count> shards_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
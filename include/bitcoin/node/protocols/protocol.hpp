@@ -22,6 +22,7 @@
  // Individual session.hpp inclusion to prevent cycle (can't forward declare).
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/flow.hpp>
 #include <bitcoin/node/sessions/session.hpp>
 
 namespace libbitcoin {
@@ -40,7 +41,8 @@ protected:
     // Need template (see session member)?
     template <typename SessionPtr>
     protocol(const SessionPtr& session, const channel_ptr& channel) NOEXCEPT
-      : network::protocol(session, channel), session_(session)
+      : network::protocol(session, channel), session_(session),
+        strand_(channel->strand())
     {
     }
 
@@ -53,17 +55,50 @@ protected:
     virtual void organize(const system::chain::header::cptr& header,
         organize_handler&& handler) NOEXCEPT;
 
+    /// Organize a sequence of headers, handler invoked once.
+    virtual void organize(system::chain::header_cptrs&& headers,
+        organize_handler&& handler) NOEXCEPT;
+
     /// Organize a checked block.
     virtual void organize(const system::chain::block::cptr& block,
         organize_handler&& handler) NOEXCEPT;
 
-    /// Get block hashes for blocks to download.
-    virtual void get_hashes(map_handler&& handler) NOEXCEPT;
+    /// Organize a sequence of blocks, handler invoked once.
+    virtual void organize(system::chain::block_cptrs&& blocks,
+        organize_handler&& handler) NOEXCEPT;
+
+    /// Admit an unconfirmed transaction to the pool.
+    virtual void store(const system::chain::transaction::cptr& tx) NOEXCEPT;
+
+    /// Fill compact block slots from pooled transactions.
+    virtual void reconstruct(const compact_relay::ptr& relay,
+        network::result_handler&& handler) NOEXCEPT;
+
+    /// Pooled transactions by hash, unpooled omitted.
+    virtual void get_transactions(const system::hashes& hashes,
+        transactions_handler&& handler) NOEXCEPT;
+
+    /// Get block hashes for blocks to download, up to count (zero default).
+    /// Latency is the mean time to first block in microseconds (zero unknown).
+    virtual void get_hashes(size_t count, uint64_t latency,
+        map_handler&& handler) NOEXCEPT;
 
     /// Submit block hashes for blocks not downloaded.
     virtual void put_hashes(const map_ptr& map,
         network::result_handler&& handler) NOEXCEPT;
 
+    /// Coroutines.
+    /// -----------------------------------------------------------------------
+
+    /// Await completion of initiate(handler) with Args, within a flow.
+    /// The flow resumes on the channel strand, as would a posted handler.
+    template <typename... Args, typename Initiator>
+    auto await(Initiator&& initiate) const NOEXCEPT
+    {
+        return node::await<Args...>(strand_,
+            std::forward<Initiator>(initiate));
+    }
+
     /// Methods.
     /// -----------------------------------------------------------------------
 
@@ -82,13 +117,20 @@ protected:
     virtual void notify(const code& ec, chase event_,
         event_value value) const NOEXCEPT;
 
+    /// Set a chaser event with payload shared by all subscribers.
+    virtual void notify(const code& ec, chase event_, event_value value,
+        const event_payload& payload) const NOEXCEPT;
+
     /// Set a chaser event.
     virtual void notify_one(object_key key, const code& ec, chase event_,
         event_value value) const NOEXCEPT;
 
-    /// Subscribe to chaser events (only once).
+    /// Fire reporting event, also counted in metrics (hides reporter).
+    void fire(uint8_t event_, uint64_t value) const NOEXCEPT;
+
+    /// Subscribe to chaser events of the given topics (only once).
     virtual void subscribe_events(event_notifier&& handler,
-        event_completer&& complete) NOEXCEPT;
+        event_topics topics, event_completer&& complete) NOEXCEPT;
 
     /// Unsubscribe from chaser events.
     virtual void unsubscribe_events() NOEXCEPT;
@@ -105,6 +147,51 @@ protected:
     /// Configuration settings for all libraries.
     const configuration& config() const NOEXCEPT;
 
+    /// Cache of recently archived outputs (thread safe).
+    prevout_cache& prevouts() const NOEXCEPT;
+
+    /// Pool of threads checking downloaded headers and blocks.
+    network::threadpool& check_pool() const NOEXCEPT;
+
+    /// Partition of the header chain for concurrent download (thread safe).
+    header_ranges& ranges() const NOEXCEPT;
+
+    /// Filter of recently organized header hashes (thread safe).
+    hash_filter& seen() const NOEXCEPT;
+
+    /// Lock-free node metrics (thread safe).
+    metrics_registry& metrics() const NOEXCEPT;
+
+    /// Recorder of pipeline spans for trace export.
+    span_tracer& tracer() const NOEXCEPT;
+
+    /// Cache of script-verified transactions by fork flags (thread safe).
+    script_cache& scripts() const NOEXCEPT;
+
+    /// Cache of recently organized blocks served to peers (thread safe).
+    block_cache& blocks() const NOEXCEPT;
+
+    /// Index of confirmed headers served to peers (thread safe).
+    header_index& confirmed_headers() const NOEXCEPT;
+
+    /// Node-wide block download bandwidth budget (thread safe).
+    download_budget& budget() const NOEXCEPT;
+
+    /// Merged blocks-first inventory of all channels (thread safe).
+    block_inventory& announced_blocks() const NOEXCEPT;
+
+    /// Claims of blocks downloaded by more than one channel (thread safe).
+    block_claims& claims() const NOEXCEPT;
+
+    /// Division of threads between block check and validation (thread safe).
+    worker_shares& shares() const NOEXCEPT;
+
+    /// Checkpointed bip157 filter headers of the confirmed chain (thread safe).
+    filter_checkpoints& checkpointed_filters() const NOEXCEPT;
+
+    /// Download performance by peer, persisted across restarts (thread safe).
+    peer_scores& scores() const NOEXCEPT;
+
     /// The candidate chain is current.
     virtual bool is_current() const NOEXCEPT;
 
@@ -112,8 +199,9 @@ private:
     void handle_subscribe(const code& ec, object_key key,
         const event_completer& complete) NOEXCEPT;
 
-    // This is thread safe.
+    // These are thread safe.
     const session::ptr session_;
+    network::asio::strand& strand_;
 
     // This is protected by singular subscription.
     object_key key_{};
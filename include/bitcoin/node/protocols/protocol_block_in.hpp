@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_BLOCK_IN_HPP
 #define LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_BLOCK_IN_HPP
 
+#include <chrono>
 #include <unordered_set>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/define.hpp>
@@ -27,6 +28,10 @@
 namespace libbitcoin {
 namespace node {
     
+/// Blocks-first download. Otherwise the blocks of each inventory are organized
+/// as one batch, checked concurrently and then organized in order. In parallel
+/// mode the block inventory of all channels is merged, and each channel
+/// requests a share of the merged inventory, organized in announcement order.
 class BCN_API protocol_block_in
   : public node::protocol,
     protected network::tracker<protocol_block_in>
@@ -42,13 +47,17 @@ public:
       : node::protocol(session, channel),
         network::tracker<protocol_block_in>(session->log),
         block_type_(session->config().network.witness_node() ?
-            type_id::witness_block : type_id::block)
+            type_id::witness_block : type_id::block),
+        parallel_(session->config().node.parallel_blocks),
+        retry_timer_(std::make_shared<network::deadline>(session->log,
+            channel->strand()))
     {
     }
     BC_POP_WARNING()
 
     /// Start/stop protocol (strand required).
     void start() NOEXCEPT override;
+    void stopping(const code& ec) NOEXCEPT override;
 
 protected:
     using hashmap = std::unordered_set<system::hash_digest>;
@@ -58,6 +67,8 @@ protected:
         hashmap ids{};
         size_t announced{};
         system::hash_digest last{};
+        system::chain::block_cptrs blocks{};
+        bool organizing{};
     };
 
     /// Accept incoming inventory message.
@@ -67,10 +78,20 @@ protected:
     /// Accept incoming block message.
     virtual bool handle_receive_block(const code& ec,
         const network::messages::block::cptr& message) NOEXCEPT;
-    virtual void handle_organize(const code& ec, size_t height,
-        const system::chain::block::cptr& block_ptr) NOEXCEPT;
+    virtual void handle_organize(const code& ec, size_t height) NOEXCEPT;
+    virtual void do_handle_organize(const code& ec, size_t height) NOEXCEPT;
 
 private:
+    /// Blocks requested at once by a channel in parallel mode.
+    static constexpr size_t parallel_request = 16;
+
+    /// Idle channels poll merged inventory at this interval.
+    static constexpr std::chrono::seconds parallel_retry{ 1 };
+
+    void merge_inventory(const network::messages::inventory& message) NOEXCEPT;
+    void request_blocks() NOEXCEPT;
+    void handle_retry(const code& ec) NOEXCEPT;
+
     static hashmap to_hashes(
         const network::messages::get_data& getter) NOEXCEPT;
 
@@ -86,8 +107,12 @@ private:
     // This is protected by strand.
     track tracker_{};
 
-    // This is thread safe.
+    // These are thread safe.
     const network::messages::inventory::type_id block_type_;
+    const bool parallel_;
+
+    // This is protected by strand.
+    network::deadline::ptr retry_timer_;
 };
 
 } // namespace node
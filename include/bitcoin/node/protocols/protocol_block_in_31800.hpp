@@ -19,6 +19,9 @@
 #ifndef LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_BLOCK_IN_31800_HPP
 #define LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_BLOCK_IN_31800_HPP
 
+#include <deque>
+#include <unordered_set>
+#include <vector>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/chasers/chasers.hpp>
 #include <bitcoin/node/define.hpp>
@@ -28,6 +31,13 @@ namespace libbitcoin {
 namespace node {
     
 /// This does NOT inherit from protocol_block_in.
+/// Downloads are pipelined, a second map of work is requested once the
+/// current map falls to half of its size, so that the peer has further
+/// requests before the current map drains. The second map becomes current
+/// once the current map drains. The time to first block of each unpipelined
+/// request is averaged as the channel latency, which directs the check
+/// chaser to allocate frontier work to lower latency channels. Requests are
+/// held while the node-wide download budget is overdrawn (for bulk work).
 class BCN_API protocol_block_in_31800
   : public protocol_performer
 {
@@ -41,7 +51,14 @@ public:
       : protocol_performer(session, channel),
         block_type_(session->config().network.witness_node() ?
             type_id::witness_block : type_id::block),
-        map_(chaser_check::empty_map())
+        deferred_(session->config().node.defer_witness ?
+            session->config().bitcoin.top_checkpoint().height() : zero),
+        defer_strong_(session->config().node.defer_strong),
+        tip_blocks_(session->config().node.tip_blocks),
+        map_(chaser_check::empty_map()),
+        next_(chaser_check::empty_map()),
+        budget_timer_(std::make_shared<network::deadline>(session->log,
+            channel->strand()))
     {
     }
     BC_POP_WARNING()
@@ -59,11 +76,13 @@ protected:
 
     /// Handle chaser events.
     virtual bool handle_event(const code& ec, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
 
     /// Manage work splitting.
     bool is_idle() const NOEXCEPT override;
-    virtual void do_purge(channel_t) NOEXCEPT;
+    bool is_frontier() const NOEXCEPT override;
+    virtual void do_purge(height_t branch_point) NOEXCEPT;
+    virtual void do_expedite(header_t link) NOEXCEPT;
     virtual void do_split(channel_t) NOEXCEPT;
     virtual void do_report(count_t count) NOEXCEPT;
 
@@ -73,31 +92,80 @@ protected:
 
 private:
     using type_id = network::messages::inventory::type_id;
+    using blocks_t = std::vector<network::messages::block::cptr>;
+    struct request_t
+    {
+        network::messages::get_data getter;
+        bool timed;
+        height_t floor;
+    };
 
     code check(const system::chain::block& block,
         const system::chain::context& ctx, bool bypass) const NOEXCEPT;
 
+    void do_archive_block(network::messages::block::cptr& message,
+        const system::hash_digest& hash, const database::header_link& link,
+        const database::context& ctx, bool bypass) NOEXCEPT;
+    code archive_block(const system::chain::block& block,
+        const system::hash_digest& hash, const database::header_link& link,
+        const database::context& ctx, size_t size, bool bypass) NOEXCEPT;
+    void handle_checked(const code& ec,
+        const network::messages::block::cptr& message,
+        const system::hash_digest& hash, size_t size) NOEXCEPT;
+    void handle_archived(const code& ec, const system::hash_digest& hash,
+        size_t size) NOEXCEPT;
+
     void send_get_data(const map_ptr& map, const job::ptr& job,
         size_t bypass) NOEXCEPT;
-    network::messages::get_data create_get_data(
-        const map_ptr& map) const NOEXCEPT;
-
+    network::messages::get_data create_get_data(const map_ptr& map,
+        const blocks_t& cached) const NOEXCEPT;
+    blocks_t get_cached(const map_ptr& map) const NOEXCEPT;
+    void send_deferred() NOEXCEPT;
+    void handle_budget(const code& ec) NOEXCEPT;
+
+    size_t get_inventory() const NOEXCEPT;
+    size_t get_work() const NOEXCEPT;
+    void erase(const system::hash_digest& hash) NOEXCEPT;
+    void request() NOEXCEPT;
+    void set_latency(const network::steady_clock::duration& elapsed) NOEXCEPT;
+    void advance() NOEXCEPT;
     void restore(const map_ptr& map) NOEXCEPT;
     void do_handle_complete(const code& ec) NOEXCEPT;
     void handle_put_hashes(const code& ec, size_t count) NOEXCEPT;
-    void handle_get_hashes(const code& ec, const map_ptr& map,
-        const job::ptr& job, size_t bypass) NOEXCEPT;
+    flow do_request(ptr self) NOEXCEPT;
 
     void set_bypass(height_t height) NOEXCEPT;
     bool is_bypassed(size_t height) const NOEXCEPT;
+    bool is_deferred(size_t height) const NOEXCEPT;
+    map_ptr get_tip(const system::hash_digest& hash) const NOEXCEPT;
+    bool is_claimable(const system::hash_digest& hash,
+        size_t height) const NOEXCEPT;
+    void release(const system::hash_digest& hash) NOEXCEPT;
 
     // This is thread safe.
     const network::messages::inventory::type_id block_type_;
+    const size_t deferred_;
+    const bool defer_strong_;
+    const size_t tip_blocks_;
 
     // These are protected by strand.
     map_ptr map_;
+    map_ptr next_;
+    network::deadline::ptr budget_timer_;
+    std::deque<request_t> deferred_{};
     job::ptr job_{};
+    job::ptr next_job_{};
+    size_t watermark_{};
+    bool requesting_{};
+    network::steady_clock::time_point sent_{};
+    uint64_t latency_{};
+    bool timing_{};
     size_t bypass_{};
+    size_t blocks_{};
+    uint64_t block_bytes_{};
+    uint64_t awaited_{};
+    std::unordered_set<system::hash_digest> checking_{};
+    std::unordered_set<system::hash_digest> claimed_{};
 };
 
 } // namespace node
@@ -32,17 +32,37 @@ class BCN_API protocol_block_out
 {
 public:
     typedef std::shared_ptr<protocol_block_out> ptr;
+    using type_id = network::messages::inventory::type_id;
 
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
     template <typename SessionPtr>
     protocol_block_out(const SessionPtr& session,
         const channel_ptr& channel) NOEXCEPT
       : node::protocol(session, channel),
-        network::tracker<protocol_block_out>(session->log)
+        network::tracker<protocol_block_out>(session->log),
+        node_witness_(session->config().network.witness_node()),
+        deferred_(session->config().node.defer_witness ?
+            session->config().bitcoin.top_checkpoint().height() : zero)
     {
     }
+    BC_POP_WARNING()
 
     /// Start protocol (strand required).
     void start() NOEXCEPT override;
+
+protected:
+    /// Serve block requests, one block at a time.
+    virtual bool handle_receive_get_data(const code& ec,
+        const network::messages::get_data::cptr& message) NOEXCEPT;
+    virtual void send_block(const code& ec, size_t index,
+        const network::messages::get_data::cptr& message) NOEXCEPT;
+
+private:
+    bool is_deferred(const system::hash_digest& hash) const NOEXCEPT;
+
+    // These are thread safe.
+    const bool node_witness_;
+    const size_t deferred_;
 };
 
 } // namespace node
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_COMPACT_IN_70014_HPP
+#define LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_COMPACT_IN_70014_HPP
+
+#include <deque>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/compact_relay.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// BIP152 compact block reception (witness, version 2).
+/// High-bandwidth announcement is requested of the three channels that most
+/// recently reconstructed a new block first (of all until there are three).
+/// A reconstructed block is cached and its header organized, so that the
+/// block download takes it from the cache instead of requesting it.
+class BCN_API protocol_compact_in_70014
+  : public node::protocol,
+    protected network::tracker<protocol_compact_in_70014>
+{
+public:
+    typedef std::shared_ptr<protocol_compact_in_70014> ptr;
+
+    /// Number of high-bandwidth announcing channels.
+    static constexpr size_t announcers = 3;
+
+    template <typename SessionPtr>
+    protocol_compact_in_70014(const SessionPtr& session,
+        const channel_ptr& channel) NOEXCEPT
+      : node::protocol(session, channel),
+        network::tracker<protocol_compact_in_70014>(session->log)
+    {
+    }
+
+    /// Start/stop protocol (strand required).
+    void start() NOEXCEPT override;
+    void stopping(const code& ec) NOEXCEPT override;
+
+protected:
+    /// Handle chaser events.
+    virtual bool handle_event(const code& ec, chase event_,
+        event_value value, const event_payload& payload) NOEXCEPT;
+    virtual void do_announced(object_t key) NOEXCEPT;
+
+    /// Reconstruct compact blocks.
+    virtual bool handle_receive_compact_block(const code& ec,
+        const network::messages::compact_block::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_compact_transactions(const code& ec,
+        const network::messages::compact_transactions::cptr& message) NOEXCEPT;
+    virtual void handle_organize(const code& ec, size_t height,
+        const system::hash_digest& hash) NOEXCEPT;
+
+private:
+    void handle_complete(const code& ec, object_key key) NOEXCEPT;
+    void do_handle_complete(const code& ec) NOEXCEPT;
+    void handle_reconstruct(const code& ec,
+        const compact_relay::ptr& relay) NOEXCEPT;
+    void do_reconstruct(const code& ec,
+        const compact_relay::ptr& relay) NOEXCEPT;
+    void complete() NOEXCEPT;
+    void set_high_bandwidth(bool enable) NOEXCEPT;
+
+    // These are protected by strand.
+    compact_relay::ptr pending_{};
+    std::deque<object_t> recent_{};
+    bool high_bandwidth_{};
+    bool first_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_COMPACT_OUT_70014_HPP
+#define LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_COMPACT_OUT_70014_HPP
+
+#include <random>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// BIP152 compact block announcement (witness, version 2).
+/// Organized blocks are announced as compact blocks to a peer that requested
+/// high-bandwidth mode, and missing transactions are served upon request.
+class BCN_API protocol_compact_out_70014
+  : public node::protocol,
+    protected network::tracker<protocol_compact_out_70014>
+{
+public:
+    typedef std::shared_ptr<protocol_compact_out_70014> ptr;
+
+    template <typename SessionPtr>
+    protocol_compact_out_70014(const SessionPtr& session,
+        const channel_ptr& channel) NOEXCEPT
+      : node::protocol(session, channel),
+        network::tracker<protocol_compact_out_70014>(session->log),
+        random_(std::random_device{}())
+    {
+    }
+
+    /// Start/stop protocol (strand required).
+    void start() NOEXCEPT override;
+    void stopping(const code& ec) NOEXCEPT override;
+
+protected:
+    /// Handle chaser events.
+    virtual bool handle_event(const code& ec, chase event_,
+        event_value value, const event_payload& payload) NOEXCEPT;
+    virtual void do_organized(header_t link) NOEXCEPT;
+
+    /// Handle peer requests.
+    virtual bool handle_receive_send_compact(const code& ec,
+        const network::messages::send_compact::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_get_compact_transactions(const code& ec,
+        const network::messages::get_compact_transactions::cptr& message)
+        NOEXCEPT;
+
+private:
+    void handle_complete(const code& ec, object_key key) NOEXCEPT;
+    void do_handle_complete(const code& ec) NOEXCEPT;
+    system::chain::block::cptr get_block(
+        const system::hash_digest& hash) const NOEXCEPT;
+
+    // These are protected by strand.
+    std::mt19937_64 random_;
+    bool high_bandwidth_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
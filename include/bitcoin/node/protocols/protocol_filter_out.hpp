@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_FILTER_OUT_HPP
+#define LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_FILTER_OUT_HPP
+
+#include <deque>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/protocols/protocol.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Serve bip157 compact filters of the confirmed chain from the store.
+class BCN_API protocol_filter_out
+  : public node::protocol,
+    protected network::tracker<protocol_filter_out>
+{
+public:
+    typedef std::shared_ptr<protocol_filter_out> ptr;
+
+    template <typename SessionPtr>
+    protocol_filter_out(const SessionPtr& session,
+        const channel_ptr& channel) NOEXCEPT
+      : node::protocol(session, channel),
+        network::tracker<protocol_filter_out>(session->log)
+    {
+    }
+
+    /// Start protocol (strand required).
+    void start() NOEXCEPT override;
+
+protected:
+    /// Stream the filters of a confirmed height range.
+    virtual bool handle_receive_get_filters(const code& ec,
+        const network::messages::get_client_filters::cptr& message) NOEXCEPT;
+
+    /// Serve the filter hashes of a confirmed height range.
+    virtual bool handle_receive_get_filter_headers(const code& ec,
+        const network::messages::get_client_filter_headers::cptr& message)
+        NOEXCEPT;
+
+    /// Serve the checkpointed filter headers up to a confirmed block.
+    virtual bool handle_receive_get_filter_checkpoint(const code& ec,
+        const network::messages::get_client_filter_checkpoint::cptr& message)
+        NOEXCEPT;
+
+private:
+    // bip158: the basic filter type (only type defined).
+    static constexpr uint8_t basic_filter = 0x00;
+
+    // bip157: limits of blocks in a filter or filter header request.
+    static constexpr size_t max_filters = 1'000;
+    static constexpr size_t max_filter_headers = 2'000;
+
+    // Confirmed heights remaining in a filter request.
+    struct span
+    {
+        size_t next;
+        size_t stop;
+    };
+
+    bool get_height(size_t& out,
+        const system::hash_digest& hash) const NOEXCEPT;
+    bool get_span(span& out, uint8_t type, uint32_t start,
+        const system::hash_digest& stop, size_t limit) const NOEXCEPT;
+    void send_filter() NOEXCEPT;
+    void handle_send_filter(const code& ec) NOEXCEPT;
+
+    // This is protected by strand.
+    std::deque<span> spans_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
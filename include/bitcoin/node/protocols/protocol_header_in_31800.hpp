@@ -21,6 +21,7 @@
 
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/header_ranges.hpp>
 #include <bitcoin/node/protocols/protocol.hpp>
 
 namespace libbitcoin {
@@ -32,31 +33,56 @@ class BCN_API protocol_header_in_31800
 {
 public:
     typedef std::shared_ptr<protocol_header_in_31800> ptr;
+    using type_id = network::messages::inventory::type_id;
 
     template <typename SessionPtr>
     protocol_header_in_31800(const SessionPtr& session,
         const channel_ptr& channel) NOEXCEPT
       : node::protocol(session, channel),
-        network::tracker<protocol_header_in_31800>(session->log)
+        network::tracker<protocol_header_in_31800>(session->log),
+        block_type_(session->config().network.witness_node() ?
+            type_id::witness_block : type_id::block),
+        tip_blocks_(session->config().node.tip_blocks)
     {
     }
 
     /// Start protocol (strand required).
     void start() NOEXCEPT override;
 
+    /// Release any incomplete header range.
+    void stopping(const code& ec) NOEXCEPT override;
+
 protected:
     virtual bool handle_receive_headers(const code& ec,
         const network::messages::headers::cptr& message) NOEXCEPT;
+    virtual void handle_receive_range(
+        const network::messages::headers::cptr& message) NOEXCEPT;
     virtual void handle_organize(const code& ec, size_t height,
-        const system::chain::header::cptr& header_ptr) NOEXCEPT;
+        const network::messages::headers::cptr& message) NOEXCEPT;
     virtual void complete() NOEXCEPT;
+    virtual void request_tip(
+        const network::messages::headers::cptr& message) NOEXCEPT;
 
 private:
+    bool claim_range() NOEXCEPT;
+    system::chain::header_cptrs unseen_headers(
+        const system::chain::header_cptrs& headers) NOEXCEPT;
+    network::messages::get_headers create_get_range() const NOEXCEPT;
     network::messages::get_headers create_get_headers() const NOEXCEPT;
     network::messages::get_headers create_get_headers(
         const system::hash_digest& last) const NOEXCEPT;
     network::messages::get_headers create_get_headers(
-        system::hashes&& start_hashes) const NOEXCEPT;
+        system::hashes&& start_hashes,
+        const system::hash_digest& stop=system::null_hash) const NOEXCEPT;
+
+    // These are thread safe.
+    const type_id block_type_;
+    const size_t tip_blocks_;
+
+    // These are protected by strand.
+    header_ranges::range range_{};
+    system::chain::header_cptrs range_headers_{};
+    bool ranged_{};
 };
 
 } // namespace node
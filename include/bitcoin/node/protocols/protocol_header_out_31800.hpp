@@ -43,6 +43,17 @@ public:
 
     /// Start protocol (strand required).
     void start() NOEXCEPT override;
+
+protected:
+    /// Serve confirmed headers following the locator.
+    virtual bool handle_receive_get_headers(const code& ec,
+        const network::messages::get_headers::cptr& message) NOEXCEPT;
+
+private:
+    network::messages::headers create_headers(
+        const network::messages::get_headers& locator) const NOEXCEPT;
+    bool get_height(size_t& out,
+        const system::hash_digest& hash) const NOEXCEPT;
 };
 
 } // namespace node
@@ -51,7 +51,7 @@ protected:
 
     /// Handle chaser events.
     virtual bool handle_event(const code& ec, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
 
 private:
     void do_handle_complete(const code& e) NOEXCEPT;
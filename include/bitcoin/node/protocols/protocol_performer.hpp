@@ -37,6 +37,13 @@ public:
     virtual void stop_performance() NOEXCEPT;
     virtual void count(size_t bytes) NOEXCEPT;
 
+    /// A frontier channel is sampled at this fraction of the sample period.
+    static constexpr size_t frontier_divisor = 8;
+
+    /// A frontier channel is stalled when late by this multiple of the time
+    /// expected to deliver a mean sized block at its last measured rate.
+    static constexpr uint64_t stall_factor = 4;
+
 protected:
     template <typename SessionPtr>
     protocol_performer(const SessionPtr& session,
@@ -45,6 +52,7 @@ protected:
         network::tracker<protocol_performer>(session->log),
         deviation_(session->config().node.allowed_deviation > 0.0),
         enabled_(to_bool(session->config().node.sample_period_seconds)),
+        period_(session->config().node.sample_period()),
         performance_timer_(std::make_shared<network::deadline>(session->log,
             channel->strand(), session->config().node.sample_period()))
     {
@@ -52,20 +60,32 @@ protected:
 
     virtual bool is_idle() const NOEXCEPT = 0;
 
+    /// Channel holds work that validation is waiting on (default false).
+    virtual bool is_frontier() const NOEXCEPT;
+
+    /// Most recently measured rate in bytes/sec (zero if not yet measured).
+    virtual uint64_t rate() const NOEXCEPT;
+
 private:
     void handle_performance_timer(const code& ec) NOEXCEPT;
     void handle_send_performance(const code& ec) NOEXCEPT;
     void do_handle_performance(const code& ec) NOEXCEPT;
 
     void send_performance(uint64_t rate) NOEXCEPT;
+    void start_timer(const network::steady_clock::duration& remaining) NOEXCEPT;
+    bool is_late(const network::steady_clock::time_point& now) const NOEXCEPT;
 
     // These are thread safe.
     const bool deviation_;
     const bool enabled_;
+    const network::steady_clock::duration period_;
 
     // These are protected by strand.
     uint64_t bytes_{ zero };
+    uint64_t rate_{ zero };
+    uint64_t unit_{ zero };
     network::steady_clock::time_point start_{};
+    network::steady_clock::time_point last_{};
     network::deadline::ptr performance_timer_;
 };
 
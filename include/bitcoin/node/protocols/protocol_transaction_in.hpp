@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_TRANSACTION_IN_HPP
 #define LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_TRANSACTION_IN_HPP
 
+#include <unordered_set>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/protocols/protocol.hpp>
@@ -32,17 +33,41 @@ class BCN_API protocol_transaction_in
 {
 public:
     typedef std::shared_ptr<protocol_transaction_in> ptr;
+    using type_id = network::messages::inventory::type_id;
 
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
     template <typename SessionPtr>
     protocol_transaction_in(const SessionPtr& session,
         const channel_ptr& channel) NOEXCEPT
       : node::protocol(session, channel),
-        network::tracker<protocol_transaction_in>(session->log)
+        network::tracker<protocol_transaction_in>(session->log),
+        tx_type_(session->config().network.witness_node() ?
+            type_id::witness_tx : type_id::transaction)
     {
     }
+    BC_POP_WARNING()
 
     /// Start protocol (strand required).
     void start() NOEXCEPT override;
+
+protected:
+    using hashmap = std::unordered_set<system::hash_digest>;
+
+    /// Accept incoming inventory and transaction messages.
+    virtual bool handle_receive_inventory(const code& ec,
+        const network::messages::inventory::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_transaction(const code& ec,
+        const network::messages::transaction::cptr& message) NOEXCEPT;
+
+private:
+    network::messages::get_data create_get_data(
+        const network::messages::inventory& message) const NOEXCEPT;
+
+    // This is thread safe.
+    const type_id tx_type_;
+
+    // This is protected by strand.
+    hashmap requested_{};
 };
 
 } // namespace node
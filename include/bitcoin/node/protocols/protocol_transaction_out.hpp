@@ -19,30 +19,104 @@
 #ifndef LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_TRANSACTION_OUT_HPP
 #define LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_TRANSACTION_OUT_HPP
 
+#include <memory>
+#include <random>
+#include <unordered_map>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/hash_filter.hpp>
 #include <bitcoin/node/protocols/protocol.hpp>
+#include <bitcoin/node/tx_pool.hpp>
 
 namespace libbitcoin {
 namespace node {
-    
+
+/// Pooled transaction announcement and serving.
+/// Pool changes are accumulated per channel and announced in one inventory
+/// message upon a randomized (exponential) interval, so that announcement
+/// timing does not reveal origin and channels do not send per-tx messages.
+/// Announcements are ordered by ancestor count (parents first) and then by
+/// ancestor fee rate. Hashes known to the peer, announced either way, are
+/// suppressed by a fixed memory filter.
 class BCN_API protocol_transaction_out
   : public node::protocol,
     protected network::tracker<protocol_transaction_out>
 {
 public:
     typedef std::shared_ptr<protocol_transaction_out> ptr;
+    using type_id = network::messages::inventory::type_id;
+
+    /// Slots of the filter of hashes known to the peer.
+    static constexpr size_t known_slots = 8'192;
+
+    /// Maximum transactions announced per interval.
+    static constexpr size_t maximum_announcement = 1'000;
 
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
     template <typename SessionPtr>
     protocol_transaction_out(const SessionPtr& session,
         const channel_ptr& channel) NOEXCEPT
       : node::protocol(session, channel),
-        network::tracker<protocol_transaction_out>(session->log)
+        network::tracker<protocol_transaction_out>(session->log),
+        interval_(session->config().node.announcement_milliseconds),
+        timer_(std::make_shared<network::deadline>(session->log,
+            channel->strand())),
+        random_(std::random_device{}()),
+        known_(known_slots)
     {
     }
+    BC_POP_WARNING()
 
-    /// Start protocol (strand required).
+    /// Start/stop protocol (strand required).
     void start() NOEXCEPT override;
+    void stopping(const code& ec) NOEXCEPT override;
+
+protected:
+    /// Handle chaser events.
+    virtual bool handle_event(const code& ec, chase event_,
+        event_value value, const event_payload& payload) NOEXCEPT;
+    virtual void do_transaction(const event_payload& payload) NOEXCEPT;
+
+    /// Hashes announced or sent by the peer are known to it.
+    virtual bool handle_receive_inventory(const code& ec,
+        const network::messages::inventory::cptr& message) NOEXCEPT;
+    virtual bool handle_receive_transaction(const code& ec,
+        const network::messages::transaction::cptr& message) NOEXCEPT;
+
+    /// Serve pooled transactions, one get_data at a time.
+    virtual bool handle_receive_get_data(const code& ec,
+        const network::messages::get_data::cptr& message) NOEXCEPT;
+    virtual void send_transactions(const code& ec, size_t index,
+        const system::chain::transaction_cptrs& txs) NOEXCEPT;
+
+private:
+    struct announcement
+    {
+        size_t ancestors;
+        uint64_t rate;
+    };
+
+    void handle_complete(const code& ec, object_key key) NOEXCEPT;
+    void do_handle_complete(const code& ec) NOEXCEPT;
+    void handle_get_transactions(const code& ec,
+        const system::chain::transaction_cptrs& txs,
+        const network::messages::get_data::cptr& message) NOEXCEPT;
+    void do_get_transactions(const code& ec,
+        const system::chain::transaction_cptrs& txs,
+        const network::messages::get_data::cptr& message) NOEXCEPT;
+    void handle_timer(const code& ec) NOEXCEPT;
+    void schedule() NOEXCEPT;
+    void announce() NOEXCEPT;
+
+    // These are thread safe.
+    const uint32_t interval_;
+    network::deadline::ptr timer_;
+
+    // These are protected by strand.
+    std::mt19937_64 random_;
+    hash_filter known_;
+    std::unordered_map<system::hash_digest, announcement> pending_{};
+    bool scheduled_{};
 };
 
 } // namespace node
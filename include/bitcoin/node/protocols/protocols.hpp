@@ -23,6 +23,9 @@
 #include <bitcoin/node/protocols/protocol_block_in.hpp>
 #include <bitcoin/node/protocols/protocol_block_in_31800.hpp>
 #include <bitcoin/node/protocols/protocol_block_out.hpp>
+#include <bitcoin/node/protocols/protocol_compact_in_70014.hpp>
+#include <bitcoin/node/protocols/protocol_compact_out_70014.hpp>
+#include <bitcoin/node/protocols/protocol_filter_out.hpp>
 #include <bitcoin/node/protocols/protocol_header_in_31800.hpp>
 #include <bitcoin/node/protocols/protocol_header_in_70012.hpp>
 #include <bitcoin/node/protocols/protocol_header_out_31800.hpp>
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_QUERY_SERVER_HPP
+#define LIBBITCOIN_NODE_QUERY_SERVER_HPP
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <bitcoin/database.hpp>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/loopback_acceptor.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Read-only HTTP store query responder on the loopback interface.
+/// Requests are read and answered on the server's own threads, so store reads
+/// never run on node or chaser strands. Hashes are hex in display order.
+///   GET /block/<hash>   : serialized block (with witness), as hex.
+///   GET /tx/<hash>      : serialized transaction (with witness), as hex.
+///   GET /address/<hash> : output tx hash and value per line, for the output
+///                         script hash, streamed in chunks.
+/// Connections above the concurrency limit are answered with 503.
+class BCN_API query_server
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(query_server);
+
+    query_server(query& query, size_t threads,
+        size_t connections) NOEXCEPT;
+
+    /// Listen on the loopback port (zero disables).
+    code start(uint16_t port) NOEXCEPT;
+
+    /// Stop listening and join threads (pending responses are dropped).
+    void stop() NOEXCEPT;
+
+private:
+    using tcp = boost::asio::ip::tcp;
+
+    // Address outputs written per response chunk.
+    static constexpr size_t chunk_outputs = 1'000;
+
+    struct connection
+    {
+        typedef std::shared_ptr<connection> ptr;
+        connection(tcp::socket&& socket, std::atomic_size_t& active) NOEXCEPT;
+        ~connection() NOEXCEPT;
+
+        tcp::socket socket;
+        std::atomic_size_t& active;
+        std::array<char, 1024> request{};
+        std::string response{};
+        database::output_links outputs{};
+        size_t next{};
+    };
+
+    void handle_accept(tcp::socket&& socket) NOEXCEPT;
+    void handle_request(const boost::system::error_code& ec,
+        size_t size, const connection::ptr& connection) NOEXCEPT;
+    void handle_chunk(const boost::system::error_code& ec,
+        const connection::ptr& connection) NOEXCEPT;
+
+    std::string get_block(const std::string& hash) const NOEXCEPT;
+    std::string get_transaction(const std::string& hash) const NOEXCEPT;
+    void send(const connection::ptr& connection,
+        const std::string& status, const std::string& body) NOEXCEPT;
+    static void handle_response(const boost::system::error_code& ec,
+        const connection::ptr& connection) NOEXCEPT;
+
+    // These are thread safe.
+    query& query_;
+    const size_t connections_;
+    std::atomic_size_t active_{};
+    network::threadpool pool_;
+
+    // These are protected by strand.
+    network::asio::strand strand_;
+    loopback_acceptor acceptor_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_SCRIPT_CACHE_HPP
+#define LIBBITCOIN_NODE_SCRIPT_CACHE_HPP
+
+#include <array>
+#include <deque>
+#include <shared_mutex>
+#include <unordered_set>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe, sharded, count-bounded set of transactions with scripts
+/// verified under a given set of fork flags, keyed by (wtxid, flags). Members
+/// are added upon pool admission and evicted (oldest first) upon overflow.
+class BCN_API script_cache
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(script_cache);
+
+    /// Zero maximum entries disables the cache.
+    script_cache(size_t maximum_entries) NOEXCEPT;
+
+    /// Cache is enabled.
+    bool enabled() const NOEXCEPT;
+
+    /// Record that the scripts of the transaction are valid under flags.
+    void insert(const system::hash_digest& wtxid, uint32_t flags) NOEXCEPT;
+
+    /// The scripts of the transaction are known valid under flags.
+    bool contains(const system::hash_digest& wtxid,
+        uint32_t flags) const NOEXCEPT;
+
+    /// Number of cached entries.
+    size_t size() const NOEXCEPT;
+
+private:
+    static constexpr size_t shard_count = 16;
+
+    struct key
+    {
+        system::hash_digest wtxid;
+        uint32_t flags;
+
+        bool operator==(const key& other) const NOEXCEPT
+        {
+            return flags == other.flags && wtxid == other.wtxid;
+        }
+    };
+
+    struct key_hash
+    {
+        size_t operator()(const key& value) const NOEXCEPT
+        {
+            return std::hash<system::hash_digest>{}(value.wtxid) ^
+                value.flags;
+        }
+    };
+
+    struct shard
+    {
+        mutable std::shared_mutex mutex{};
+        std::unordered_set<key, key_hash> set{};
+        std::deque<key> order{};
+    };
+
+    const shard& get_shard(const system::hash_digest& wtxid) const NOEXCEPT;
+    shard& get_shard(const system::hash_digest& wtxid) NOEXCEPT;
+
+    // These are thread safe.
+    const size_t shard_entries_;
+    std::array<shard, shard_count> shards_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -58,6 +58,7 @@ protected:
         const network::channel::ptr& channel) NOEXCEPT override
     {
         constexpr auto bip130 = network::messages::level::bip130;
+        constexpr auto bip152 = network::messages::level::bip152;
         constexpr auto headers = network::messages::level::headers_protocol;
         constexpr auto in = is_same_type<Session, network::session_inbound>;
 
@@ -98,6 +99,24 @@ protected:
         }
 
         channel->attach<protocol_block_out>(self)->start();
+
+        // Compact blocks are relayed by witness hash (version 2).
+        // Reconstructed blocks are stored by headers-first download.
+        if (headers_first && version >= bip152 &&
+            config().network.witness_node())
+        {
+            channel->attach<protocol_compact_in_70014>(self)->start();
+            channel->attach<protocol_compact_out_70014>(self)->start();
+        }
+
+        // Compact filters are served once computed by validation (bip157).
+        if (archive().neutrino_enabled() && !is_zero(
+            config().network.services_maximum &
+                network::messages::service::node_client_filters))
+        {
+            channel->attach<protocol_filter_out>(self)->start();
+        }
+
         channel->attach<protocol_transaction_in>(self)->start();
         channel->attach<protocol_transaction_out>(self)->start();
         channel->attach<protocol_observer>(self)->start();
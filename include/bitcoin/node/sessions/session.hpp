@@ -43,12 +43,33 @@ public:
     virtual void organize(const system::chain::header::cptr& header,
         organize_handler&& handler) NOEXCEPT;
 
+    /// Organize a sequence of headers, handler invoked once.
+    virtual void organize(system::chain::header_cptrs&& headers,
+        organize_handler&& handler) NOEXCEPT;
+
     /// Organize a validated block.
     virtual void organize(const system::chain::block::cptr& block,
         organize_handler&& handler) NOEXCEPT;
 
-    /// Manage download queue.
-    virtual void get_hashes(map_handler&& handler) NOEXCEPT;
+    /// Organize a sequence of blocks, handler invoked once.
+    virtual void organize(system::chain::block_cptrs&& blocks,
+        organize_handler&& handler) NOEXCEPT;
+
+    /// Admit an unconfirmed transaction to the pool.
+    virtual void store(const system::chain::transaction::cptr& tx) NOEXCEPT;
+
+    /// Fill compact block slots from pooled transactions.
+    virtual void reconstruct(const compact_relay::ptr& relay,
+        network::result_handler&& handler) NOEXCEPT;
+
+    /// Pooled transactions by hash, unpooled omitted.
+    virtual void get_transactions(const system::hashes& hashes,
+        transactions_handler&& handler) NOEXCEPT;
+
+    /// Manage download queue, count is a size hint (zero for default).
+    /// Latency is the channel's mean time to first block in microseconds.
+    virtual void get_hashes(size_t count, uint64_t latency,
+        map_handler&& handler) NOEXCEPT;
     virtual void put_hashes(const map_ptr& map,
         network::result_handler&& handler) NOEXCEPT;
 
@@ -59,6 +80,10 @@ public:
     virtual void notify(const code& ec, chase event_,
         event_value value) const NOEXCEPT;
 
+    /// Set a chaser event with payload shared by all subscribers.
+    virtual void notify(const code& ec, chase event_, event_value value,
+        const event_payload& payload) const NOEXCEPT;
+
     /// Set chaser event for the given subscriber only.
     virtual void notify_one(object_key key, const code& ec, chase event_,
         event_value value) const NOEXCEPT;
@@ -66,9 +91,9 @@ public:
     /// Subscribe to chaser events (requires node strand).
     virtual object_key subscribe_events(event_notifier&& handler) NOEXCEPT;
 
-    /// Subscribe to chaser events.
+    /// Subscribe to chaser events of the given topics.
     virtual void subscribe_events(event_notifier&& handler,
-        event_completer&& complete) NOEXCEPT;
+        event_topics topics, event_completer&& complete) NOEXCEPT;
 
     /// Unsubscribe from chaser events.
     virtual void unsubscribe_events(object_key key) NOEXCEPT;
@@ -95,6 +120,51 @@ public:
     /// Configuration settings for all libraries.
     const configuration& config() const NOEXCEPT;
 
+    /// Cache of recently archived outputs (thread safe).
+    prevout_cache& prevouts() const NOEXCEPT;
+
+    /// Pool of threads checking downloaded headers and blocks.
+    network::threadpool& check_pool() const NOEXCEPT;
+
+    /// Partition of the header chain for concurrent download (thread safe).
+    header_ranges& ranges() const NOEXCEPT;
+
+    /// Filter of recently organized header hashes (thread safe).
+    hash_filter& seen() const NOEXCEPT;
+
+    /// Lock-free node metrics (thread safe).
+    metrics_registry& metrics() const NOEXCEPT;
+
+    /// Recorder of pipeline spans for trace export.
+    span_tracer& tracer() const NOEXCEPT;
+
+    /// Cache of script-verified transactions by fork flags (thread safe).
+    script_cache& scripts() const NOEXCEPT;
+
+    /// Cache of recently organized blocks served to peers (thread safe).
+    block_cache& blocks() const NOEXCEPT;
+
+    /// Index of confirmed headers served to peers (thread safe).
+    header_index& confirmed_headers() const NOEXCEPT;
+
+    /// Node-wide block download bandwidth budget.
+    download_budget& budget() const NOEXCEPT;
+
+    /// Merged blocks-first inventory of all channels (thread safe).
+    block_inventory& announced_blocks() const NOEXCEPT;
+
+    /// Claims of blocks downloaded by more than one channel (thread safe).
+    block_claims& claims() const NOEXCEPT;
+
+    /// Division of threads between block check and validation (thread safe).
+    worker_shares& shares() const NOEXCEPT;
+
+    /// Checkpointed bip157 filter headers of the confirmed chain (thread safe).
+    filter_checkpoints& checkpointed_filters() const NOEXCEPT;
+
+    /// Download performance by peer, persisted across restarts (thread safe).
+    peer_scores& scores() const NOEXCEPT;
+
     /// The candidate chain is current.
     virtual bool is_current() const NOEXCEPT;
 
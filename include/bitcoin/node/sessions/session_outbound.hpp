@@ -19,7 +19,9 @@
 #ifndef LIBBITCOIN_NODE_SESSIONS_SESSION_OUTBOUND_HPP
 #define LIBBITCOIN_NODE_SESSIONS_SESSION_OUTBOUND_HPP
 
+#include <map>
 #include <unordered_map>
+#include <vector>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/sessions/attach.hpp>
@@ -42,19 +44,31 @@ public:
 
 protected:
     virtual bool handle_event(const code& ec, chase event_,
-        event_value value) NOEXCEPT;
+        event_value value, const event_payload& payload) NOEXCEPT;
     virtual void do_starved(object_t self) NOEXCEPT;
+    virtual void do_split() NOEXCEPT;
     virtual void do_performance(object_key channel, uint64_t speed,
         const network::result_handler& handler) NOEXCEPT;
 
 private:
     static constexpr size_t minimum_for_standard_deviation = 3;
 
-    // This is thread safe.
-    const float allowed_deviation_;
+    /// Weight of a new report in the moving average rate of its channel.
+    static constexpr double rate_weight = 0.5;
 
-    // This is protected by strand.
-    std::unordered_map<object_key, double> speeds_{};
+    double set_speed(object_key channel, uint64_t speed) NOEXCEPT;
+    void erase_speed(object_key channel) NOEXCEPT;
+
+    // These are protected by strand.
+    float allowed_deviation_;
+    // Channels are indexed by rate, so that the slowest is found first.
+    // Sums of all channel rates are maintained upon each change in a rate.
+    typedef std::multimap<double, object_key> rates;
+    std::unordered_map<object_key, rates::iterator> speeds_{};
+    rates rates_{};
+    double sum_{};
+    double squares_{};
+    std::vector<object_t> starved_{};
 };
 
 } // namespace node
@@ -20,6 +20,7 @@
 #define LIBBITCOIN_NODE_SETTINGS_HPP
 
 #include <filesystem>
+#include <string>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/define.hpp>
 
@@ -45,8 +46,10 @@ public:
     bool quitting;
     bool objects;
     bool verbose;
+    bool binary_events;
 
     uint32_t maximum_size;
+    uint32_t flush_milliseconds;
     std::filesystem::path path;
 
 #if defined (HAVE_MSC)
@@ -56,6 +59,7 @@ public:
     virtual std::filesystem::path log_file1() const NOEXCEPT;
     virtual std::filesystem::path log_file2() const NOEXCEPT;
     virtual std::filesystem::path events_file() const NOEXCEPT;
+    virtual std::filesystem::path trace_file() const NOEXCEPT;
 };
 
 } // namespace log
@@ -73,18 +77,67 @@ public:
 
     /// Properties.
     bool headers_first;
+    bool cumulative_work;
+    bool persist_tree;
+    bool parallel_headers;
+    bool parallel_blocks;
+    bool auto_scale;
+    bool coalesce_events;
+    bool instrument_strands;
+    bool snapshot_concurrent;
+    bool warm_start;
+    bool defer_witness;
+    bool defer_strong;
+    bool validate_candidates;
     float allowed_deviation;
     uint64_t snapshot_bytes;
+    uint64_t prevout_bytes;
+    uint64_t window_bytes;
+    uint64_t tree_bytes;
+    uint64_t preallocate_bytes;
+    uint64_t mempool_bytes;
+    uint64_t block_cache_bytes;
     uint32_t snapshot_valid;
+    uint32_t seen_headers;
     uint32_t maximum_height;
     uint32_t maximum_concurrency;
+    uint32_t maximum_backlog;
     uint16_t sample_period_seconds;
+    uint16_t metrics_port;
+    uint32_t query_connections;
+    uint16_t query_port;
+    uint16_t sibling_port;
+    uint16_t template_port;
+    uint32_t template_connections;
+    uint32_t query_threads;
+    uint32_t preferred_peers;
     uint32_t currency_window_minutes;
     uint32_t threads;
+    uint32_t populate_threads;
+    uint32_t check_threads;
+    uint32_t confirm_threads;
+    uint32_t event_shards;
+    uint32_t trace_spans;
+    uint32_t storage_horizon_minutes;
+    uint32_t prefetch_blocks;
+    uint32_t admission_threads;
+    uint32_t script_cache_entries;
+    uint32_t announcement_milliseconds;
+    uint32_t tip_blocks;
+    uint64_t download_bytes_per_second;
+    uint64_t memory_bytes;
+    uint32_t history_threads;
+    std::filesystem::path bootstrap_path;
+    std::filesystem::path headers_path;
+    std::string sibling_host;
+    std::string serve_address;
+    std::string validate_affinity;
+    std::string network_affinity;
 
     /// Helpers.
     virtual size_t maximum_height_() const NOEXCEPT;
     virtual size_t maximum_concurrency_() const NOEXCEPT;
+    virtual size_t maximum_backlog_() const NOEXCEPT;
     virtual network::steady_clock::duration sample_period() const NOEXCEPT;
     virtual network::wall_clock::duration currency_window() const NOEXCEPT;
 };
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_SPAN_TRACER_HPP
+#define LIBBITCOIN_NODE_SPAN_TRACER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Opt-in recorder of pipeline spans for visual trace analysis (thread safe).
+/// Each thread writes to its own fixed ring of spans, without locks, so the
+/// oldest spans are overwritten. The report is Chrome trace event JSON, which
+/// is also loaded by Perfetto. It is read while spans are still being written,
+/// so it is a recent view of each thread, not an atomic snapshot.
+class BCN_API span_tracer
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(span_tracer);
+
+    enum class span : uint8_t
+    {
+        download,
+        check,
+        archive,
+        populate,
+        validate_tx,
+        confirm,
+        snapshot,
+        count
+    };
+
+    /// Threads beyond this number are not traced.
+    static constexpr size_t threads = 64;
+
+    /// Spans retained per thread, zero disables the tracer.
+    span_tracer(size_t capacity) NOEXCEPT;
+
+    /// Tracer is enabled.
+    bool enabled() const NOEXCEPT;
+
+    /// Microseconds since construction, for use as a span start (or zero).
+    uint64_t now() const NOEXCEPT;
+
+    /// Record a span from start until now, on the calling thread's ring.
+    void record(span kind, uint64_t start, size_t height) NOEXCEPT;
+
+    /// Name of the given span.
+    static const std::string& span_name(span kind) NOEXCEPT;
+
+    /// All retained spans in Chrome trace event JSON format.
+    std::string report() const NOEXCEPT;
+
+private:
+    using clock = std::chrono::steady_clock;
+    using atomic = std::atomic_uint64_t;
+
+    // Entries are atomic so that report may race with record.
+    struct entry
+    {
+        atomic start{};
+        atomic duration{};
+        atomic tag{};
+    };
+
+    struct ring
+    {
+        std::vector<entry> entries{};
+        atomic head{};
+    };
+
+    ring* local() NOEXCEPT;
+
+    // These are thread safe.
+    const size_t capacity_;
+    const uint64_t instance_;
+    const clock::time_point epoch_;
+    std::vector<ring> rings_;
+    std::atomic<size_t> next_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
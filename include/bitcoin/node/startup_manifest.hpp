@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_STARTUP_MANIFEST_HPP
+#define LIBBITCOIN_NODE_STARTUP_MANIFEST_HPP
+
+#include <filesystem>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Chaser positions captured on clean shutdown, so that a subsequent start
+/// can resume without rescanning the store. The manifest is keyed to the top
+/// candidate and top confirmed blocks and is stale if either differs from the
+/// store. Text encoding is one "name value" pair per line.
+class BCN_API startup_manifest
+{
+public:
+    /// Encode as text lines.
+    std::string to_string() const NOEXCEPT;
+
+    /// Decode text lines, false if any value is missing or malformed.
+    static bool from_string(const std::string& text,
+        startup_manifest& out) NOEXCEPT;
+
+    /// Write the manifest to the file, false on failure.
+    bool save(const std::filesystem::path& file) const NOEXCEPT;
+
+    /// Read and remove the manifest, so that it is used for one start only.
+    static bool load(const std::filesystem::path& file,
+        startup_manifest& out) NOEXCEPT;
+
+    /// Identity of the store at shutdown.
+    system::hash_digest candidate_hash{};
+    size_t candidate_height{};
+    size_t confirmed_height{};
+
+    /// Contiguous associated (checked) height at shutdown.
+    size_t checked_height{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
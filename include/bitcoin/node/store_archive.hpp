@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_STORE_ARCHIVE_HPP
+#define LIBBITCOIN_NODE_STORE_ARCHIVE_HPP
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Copy of a closed store directory, with table files copied in parallel.
+/// Files are claimed largest first so that the largest tables overlap, and
+/// each is copied by the platform (in kernel where supported).
+/// A closed store may also be served to and fetched by trusted siblings, with
+/// each file streamed over its own connection in the same order. There is no
+/// authentication or encryption, this is for use within a trusted network.
+class BCN_API store_archive
+{
+public:
+    /// Invoked once for each copied file (serialized).
+    using progress = std::function<void(const std::filesystem::path& file,
+        uint64_t bytes)>;
+
+    /// Copy all files of the source tree into the target, which must not
+    /// exist, using up to the given number of threads (zero is one).
+    static code copy(const std::filesystem::path& from,
+        const std::filesystem::path& to, size_t threads,
+        const progress& handler) NOEXCEPT;
+
+    /// Serve all files of the source tree on the local address and port until
+    /// cancel is set, using up to the given number of threads (zero is one),
+    /// each serving one connection at a time. Handler is invoked once for
+    /// each file served. An idle connection is closed at the io timeout.
+    static code serve(const std::filesystem::path& from,
+        const std::string& address, uint16_t port, size_t threads,
+        const std::atomic_bool& cancel, const progress& handler) NOEXCEPT;
+
+    /// Fetch all files of the tree served by a sibling into the target, which
+    /// must not exist, using up to the given number of connections.
+    static code fetch(const std::string& host, uint16_t port,
+        const std::filesystem::path& to, size_t threads,
+        const progress& handler) NOEXCEPT;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
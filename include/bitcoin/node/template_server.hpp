@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_TEMPLATE_SERVER_HPP
+#define LIBBITCOIN_NODE_TEMPLATE_SERVER_HPP
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/block_template.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/loopback_acceptor.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Block template push to mining clients, on the loopback interface.
+/// Each change is serialized once and written to all clients, as lines:
+///   prevhash <height> <hash>         : new template parent (display order).
+///   update <fees> <removed> <added>  : followed by removed tx hashes, then
+///                                      added txs (with witness) as hex.
+/// Retained txs keep their order and added txs follow, which preserves
+/// parents before children. A new client is sent the parent and all txs.
+/// Client data is ignored, and a client that falls behind is disconnected.
+class BCN_API template_server
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(template_server);
+
+    template_server(query& query, size_t connections) NOEXCEPT;
+
+    /// Listen on the loopback port (zero disables).
+    code start(uint16_t port) NOEXCEPT;
+
+    /// Push the template for the given height (thread safe).
+    void publish(size_t height,
+        const block_template::assembly::cptr& assembly) NOEXCEPT;
+
+    /// Stop listening and join thread (pending writes are dropped).
+    void stop() NOEXCEPT;
+
+private:
+    using tcp = boost::asio::ip::tcp;
+    using message = std::shared_ptr<const std::string>;
+    using hash_set = std::unordered_set<system::hash_digest>;
+
+    // Writes queued to a client beyond which it is disconnected.
+    static constexpr size_t maximum_queue = 16;
+
+    struct connection
+    {
+        typedef std::shared_ptr<connection> ptr;
+        connection(tcp::socket&& socket) NOEXCEPT;
+
+        tcp::socket socket;
+        std::array<char, 256> discard{};
+        std::deque<message> queue{};
+    };
+
+    void handle_accept(tcp::socket&& socket) NOEXCEPT;
+    void handle_read(const boost::system::error_code& ec,
+        const connection::ptr& connection) NOEXCEPT;
+    void handle_write(const boost::system::error_code& ec,
+        const connection::ptr& connection) NOEXCEPT;
+    void do_publish(size_t height,
+        const block_template::assembly::cptr& assembly) NOEXCEPT;
+    void send(const connection::ptr& connection,
+        const message& data) NOEXCEPT;
+    void write(const connection::ptr& connection) NOEXCEPT;
+    void drop(const connection::ptr& connection) NOEXCEPT;
+
+    static std::string to_prevhash(size_t height,
+        const system::hash_digest& hash) NOEXCEPT;
+    static std::string to_update(uint64_t fees,
+        const system::hashes& removed,
+        const system::chain::transaction_cptrs& added) NOEXCEPT;
+
+    // These are thread safe.
+    query& query_;
+    const size_t connections_;
+    network::threadpool pool_;
+
+    // These are protected by strand.
+    network::asio::strand strand_;
+    loopback_acceptor acceptor_;
+    std::unordered_set<connection::ptr> clients_{};
+    block_template::assembly::cptr assembly_{};
+    hash_set hashes_{};
+    system::hash_digest prevhash_{};
+    size_t height_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
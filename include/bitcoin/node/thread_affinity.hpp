@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_THREAD_AFFINITY_HPP
+#define LIBBITCOIN_NODE_THREAD_AFFINITY_HPP
+
+#include <string>
+#include <vector>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Binding of threadpool threads to a set of cores (linux, otherwise false).
+/// A core set is a list of cores and ranges ("0-7,16-23"), or the cores of a
+/// NUMA node ("numa:1"). Pages first touched by a bound thread are placed on
+/// its node by the kernel, so store reads on a bound pool are local to it.
+class BCN_API thread_affinity
+{
+public:
+    using cores = std::vector<size_t>;
+
+    /// Parse a core set, false if invalid (empty text is an empty set).
+    static bool parse(cores& out, const std::string& text) NOEXCEPT;
+
+    /// Bind each of the count threads running the service to the cores.
+    /// Blocks until each thread has taken one binding job, so the service
+    /// must be otherwise idle and must not be run by the calling thread.
+    static bool bind(boost::asio::io_context& service, size_t count,
+        const cores& set) NOEXCEPT;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_TX_POOL_HPP
+#define LIBBITCOIN_NODE_TX_POOL_HPP
+
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Memory-bounded graph of unconfirmed transactions (not thread safe).
+/// Each entry retains the aggregate count, virtual size, fee and sigop cost of
+/// its ancestors and of its descendants (each including itself). Aggregates are
+/// updated incrementally on add and remove, with the walk bounded by package
+/// limits, so that fee-rate orderings are maintained in logarithmic time.
+/// Spent outpoints are indexed for conflict detection.
+class BCN_API tx_pool
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(tx_pool);
+
+    /// Maximum ancestors, or descendants, of an entry (including itself).
+    static constexpr size_t maximum_package = 25;
+
+    using hashes = std::vector<system::hash_digest>;
+
+    struct package
+    {
+        size_t count;
+        uint64_t size;
+        uint64_t fee;
+        size_t sigops;
+    };
+
+    /// Pooled transaction with its pooled parents and ancestor aggregate.
+    struct change
+    {
+        system::chain::transaction::cptr tx;
+        hashes parents;
+        package self;
+        package ancestors;
+    };
+
+    /// Entries added or with modified ancestry, and entries removed.
+    struct changes
+    {
+        std::vector<change> updated;
+        hashes removed;
+    };
+
+    /// Zero maximum bytes disables the pool.
+    tx_pool(uint64_t maximum_bytes) NOEXCEPT;
+
+    /// Pool is enabled.
+    bool enabled() const NOEXCEPT;
+
+    /// Number of pooled transactions.
+    size_t count() const NOEXCEPT;
+
+    /// Approximate current memory consumption.
+    uint64_t bytes() const NOEXCEPT;
+
+    /// Transaction is pooled.
+    bool exists(const system::hash_digest& hash) const NOEXCEPT;
+
+    /// Pooled transaction, null if not pooled.
+    system::chain::transaction::cptr get(
+        const system::hash_digest& hash) const NOEXCEPT;
+
+    /// Pooled transaction spending the outpoint, null_hash if none.
+    system::hash_digest spender(const system::chain::point& point) const NOEXCEPT;
+
+    /// Populate unpopulated non-null inputs from outputs of pooled parents.
+    /// True if all non-null inputs of the transaction are then populated.
+    bool populate(const system::chain::transaction& tx) const NOEXCEPT;
+
+    /// Pool a populated transaction with its fee and sigop cost. The tx is
+    /// rejected if pooled, if it conflicts with a pooled spend, if it exceeds
+    /// package limits, or if it is the lowest fee-rate package upon overflow.
+    code add(const system::chain::transaction::cptr& tx, uint64_t fee,
+        size_t sigops=zero) NOEXCEPT;
+
+    /// Remove a transaction confirmed in a block (descendants are retained),
+    /// along with all other pooled spends of its outpoints (and descendants).
+    /// Returns the number of transactions removed.
+    size_t confirm(const system::chain::transaction& tx) NOEXCEPT;
+
+    /// Remove the transaction and its descendants, returns number removed.
+    size_t remove(const system::hash_digest& hash) NOEXCEPT;
+
+    /// Aggregates of the pooled transaction, zeroed if not pooled.
+    package ancestors(const system::hash_digest& hash) const NOEXCEPT;
+    package descendants(const system::hash_digest& hash) const NOEXCEPT;
+
+    /// Pooled transaction with lowest descendant fee rate (next evicted).
+    system::hash_digest lowest() const NOEXCEPT;
+
+    /// Pooled transaction with highest ancestor fee rate (next mined).
+    system::hash_digest highest() const NOEXCEPT;
+
+    /// Invoke the visitor with each pooled transaction (unordered).
+    template <typename Visitor>
+    void visit(Visitor&& visitor) const NOEXCEPT
+    {
+        for (const auto& item: entries_)
+            visitor(item.second.tx);
+    }
+
+    /// Obtain and reset the changes since the last drain (or construct).
+    changes drain() NOEXCEPT;
+
+    /// Fee rate of package in millisatoshis per virtual byte.
+    static uint64_t rate(const package& value) NOEXCEPT;
+
+private:
+    using hash_set = std::unordered_set<system::hash_digest>;
+
+    struct point_key
+    {
+        system::hash_digest hash;
+        uint32_t index;
+
+        bool operator==(const point_key& other) const NOEXCEPT
+        {
+            return index == other.index && hash == other.hash;
+        }
+    };
+
+    struct point_hash
+    {
+        size_t operator()(const point_key& value) const NOEXCEPT
+        {
+            return std::hash<system::hash_digest>{}(value.hash) ^ value.index;
+        }
+    };
+
+    struct order
+    {
+        uint64_t rate;
+        system::hash_digest hash;
+
+        bool operator<(const order& other) const NOEXCEPT
+        {
+            return rate < other.rate ||
+                (rate == other.rate && hash < other.hash);
+        }
+    };
+
+    struct entry
+    {
+        system::hash_digest hash;
+        system::chain::transaction::cptr tx;
+        package self;
+        uint64_t bytes;
+        hashes parents;
+        hashes children;
+        package ancestors;
+        package descendants;
+    };
+
+    static void add(package& to, const package& value) NOEXCEPT;
+    static void subtract(package& from, const package& value) NOEXCEPT;
+    static uint64_t footprint(const system::chain::transaction& tx) NOEXCEPT;
+
+    hash_set collect(const system::hash_digest& hash,
+        bool ancestors) const NOEXCEPT;
+    void set_ancestors(entry& value, const package& aggregate) NOEXCEPT;
+    void set_descendants(entry& value, const package& aggregate) NOEXCEPT;
+    void erase(const system::hash_digest& hash) NOEXCEPT;
+    size_t remove(const hash_set& package) NOEXCEPT;
+
+    // These are protected by the caller.
+    const uint64_t maximum_bytes_;
+    uint64_t bytes_{};
+    std::unordered_map<system::hash_digest, entry> entries_{};
+    std::unordered_map<point_key, system::hash_digest, point_hash> spends_{};
+    std::set<order> by_descendants_{};
+    std::set<order> by_ancestors_{};
+    hash_set changed_{};
+    hash_set removed_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
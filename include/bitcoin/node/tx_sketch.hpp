@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_TX_SKETCH_HPP
+#define LIBBITCOIN_NODE_TX_SKETCH_HPP
+
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// BIP330 (Erlay) set reconciliation sketch of 32 bit short ids (not thread
+/// safe). The sketch is the odd power sums of its elements in GF(2^32), as in
+/// minisketch, so that the sketch of a symmetric difference is the xor of two
+/// sketches, and a difference of up to capacity elements can be decoded
+/// (Berlekamp-Massey, then Berlekamp trace root finding).
+class BCN_API tx_sketch
+{
+public:
+    DEFAULT_COPY_MOVE_DESTRUCT(tx_sketch);
+
+    using element = uint32_t;
+    using elements = std::vector<element>;
+
+    /// SipHash key from the sorted salts of both peers (tagged sha256).
+    static system::siphash_key to_key(uint64_t salt1,
+        uint64_t salt2) NOEXCEPT;
+
+    /// Nonzero 32 bit short id of the witness hash.
+    static element to_short_id(const system::siphash_key& key,
+        const system::hash_digest& wtxid) NOEXCEPT;
+
+    /// A sketch decodes up to capacity set differences.
+    tx_sketch(size_t capacity) NOEXCEPT;
+
+    /// Maximum decodable difference.
+    size_t capacity() const NOEXCEPT;
+
+    /// Toggle element membership (zero is ignored).
+    void add(element value) NOEXCEPT;
+
+    /// Sketch becomes the sketch of the symmetric difference, false if the
+    /// capacities differ.
+    bool merge(const tx_sketch& other) NOEXCEPT;
+
+    /// Elements of the sketched set, false if more than capacity.
+    bool decode(elements& out) const NOEXCEPT;
+
+    /// Serialization, four bytes (little endian) per unit of capacity.
+    system::data_chunk to_data() const NOEXCEPT;
+    bool from_data(const system::data_slice& data) NOEXCEPT;
+
+private:
+    elements syndromes_;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
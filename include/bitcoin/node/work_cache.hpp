@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_WORK_CACHE_HPP
+#define LIBBITCOIN_NODE_WORK_CACHE_HPP
+
+#include <shared_mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe, in-memory cumulative work by header link, relative to an
+/// anchor header set at the base of the first query (not genesis), so no
+/// walk extends below a fork point. Header work never changes for a link,
+/// so entries are never invalidated. Branch strength comparison becomes a
+/// subtraction of two cached values.
+class BCN_API work_cache
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(work_cache);
+
+    /// Cache can be disabled, in which case get_work is always false.
+    work_cache(bool enable) NOEXCEPT;
+
+    /// Cache is enabled.
+    bool enabled() const NOEXCEPT;
+
+    /// Work of the branch above base (an ancestor) through top, false if
+    /// disabled or not found. The walk is bounded by base, with work of
+    /// uncached headers above a cached base obtained from the store and
+    /// cached. The first query anchors the cache at its base.
+    bool get_work(system::uint256_t& out, const query& query,
+        const database::header_link& top,
+        const database::header_link& base) NOEXCEPT;
+
+    /// Cumulative work through the header, false if disabled or not cached.
+    bool get(system::uint256_t& out,
+        const database::header_link& link) const NOEXCEPT;
+
+    /// Cache header work as that of its parent plus the proof of its bits.
+    /// A terminal parent sets the anchor, allowed once, otherwise the parent
+    /// must be cached.
+    bool put(const database::header_link& link,
+        const database::header_link& parent, uint32_t bits) NOEXCEPT;
+
+private:
+    static bool sum_work(system::uint256_t& out, const query& query,
+        const database::header_link& top,
+        const database::header_link& base) NOEXCEPT;
+    bool find(system::uint256_t& out, size_t index) const NOEXCEPT;
+
+    // This is thread safe.
+    const bool enabled_;
+
+    // These are protected by mutex.
+    // Indexed by link, zero is unset (all headers have non-zero work).
+    std::vector<system::uint256_t> work_{};
+    bool anchored_{};
+    mutable std::shared_mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_WORK_MAP_HPP
+#define LIBBITCOIN_NODE_WORK_MAP_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <bitcoin/database.hpp>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Not thread safe, a download work unit of block associations.
+/// Items are held in a flat vector in height order with a sorted hash key
+/// index. Both are immutable and shared by the parts of a taken (split) map,
+/// each part tracking its own received items in a bitset. So a take of the
+/// lowest items of an unreceived map does not copy or allocate items.
+class BCN_API work_map
+{
+public:
+    typedef database::association item;
+    typedef std::vector<item> items;
+
+    /// Empty map.
+    work_map() NOEXCEPT;
+
+    /// Map of associations obtained from the store.
+    work_map(const database::associations& associations) NOEXCEPT;
+
+    /// Map of items in any order.
+    work_map(items&& items) NOEXCEPT;
+
+    /// Count of outstanding (not received) items.
+    size_t size() const NOEXCEPT;
+    bool empty() const NOEXCEPT;
+
+    /// Lowest outstanding height, zero if empty.
+    size_t floor() const NOEXCEPT;
+
+    /// Highest height of the map, zero if empty.
+    size_t top() const NOEXCEPT;
+
+    /// Outstanding item by block hash, nullptr if not found.
+    /// The item remains valid for the lifetime of the map or any of its parts.
+    const item* find(const system::hash_digest& hash) const NOEXCEPT;
+
+    /// Mark the item received, false if not outstanding.
+    bool erase(const system::hash_digest& hash) NOEXCEPT;
+
+    /// Drop all items.
+    void clear() NOEXCEPT;
+
+    /// Drop outstanding items above height, returns the count dropped.
+    size_t trim(size_t height) NOEXCEPT;
+
+    /// Move the lowest count outstanding items into the returned map.
+    map_ptr take(size_t count) NOEXCEPT;
+
+    /// Move the lowest count outstanding items of other into this map.
+    void merge(work_map& other, size_t count) NOEXCEPT;
+
+    /// Visit outstanding items in height order.
+    template <typename Handler>
+    void for_each(Handler&& handler) const NOEXCEPT
+    {
+        for (auto index = cursor_; index < received_.size(); ++index)
+            if (!received_.at(index))
+                handler(table_->values.at(begin_ + index));
+    }
+
+private:
+    // Hash prefix and item index, sorted for binary search.
+    typedef std::pair<uint64_t, uint32_t> key;
+
+    struct table
+    {
+        work_map::items values{};
+        std::vector<key> keys{};
+    };
+
+    static uint64_t to_prefix(const system::hash_digest& hash) NOEXCEPT;
+    size_t locate(const system::hash_digest& hash) const NOEXCEPT;
+    void advance() NOEXCEPT;
+
+    // Shared by all parts of the map.
+    std::shared_ptr<const table> table_;
+
+    // Range of table items in this part, received bits relative to begin_.
+    size_t begin_{};
+    size_t cursor_{};
+    size_t remaining_{};
+    std::vector<bool> received_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
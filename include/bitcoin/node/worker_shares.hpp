@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_WORKER_SHARES_HPP
+#define LIBBITCOIN_NODE_WORKER_SHARES_HPP
+
+#include <atomic>
+#include <mutex>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe division of worker threads between block check and script
+/// validation. When scaling, both pools are sized to the total and the
+/// shares limit their concurrency. One thread at a time moves to check when
+/// validation is idle and check work is refused, and back to validation when
+/// its backlog is deep and check work is not refused. Refused check work is
+/// performed on the channel strand.
+class BCN_API worker_shares
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(worker_shares);
+
+    /// Shares are fixed at the configured counts unless scaling.
+    worker_shares(size_t validate, size_t check, bool scale) NOEXCEPT;
+
+    /// Threads required of the validation and check pools.
+    size_t validate_capacity() const NOEXCEPT;
+    size_t check_capacity() const NOEXCEPT;
+
+    /// Current share of each pool (at least one).
+    size_t validate() const NOEXCEPT;
+    size_t check() const NOEXCEPT;
+
+    /// Validation queue depth, relative to its maximum.
+    void set_backlog(size_t backlog, size_t maximum) NOEXCEPT;
+
+    /// Claim a check slot, false if the share is in use (always if fixed).
+    bool claim_check() NOEXCEPT;
+    void release_check() NOEXCEPT;
+
+private:
+    void rebalance() NOEXCEPT;
+
+    // These are thread safe.
+    const size_t total_;
+    const size_t check_threads_;
+    const bool scale_;
+    std::atomic_size_t validate_;
+    std::atomic_size_t check_;
+    std::atomic_size_t checking_{};
+    std::atomic_size_t refused_{};
+    std::atomic_size_t backlog_{};
+
+    // This is protected by mutex.
+    network::steady_clock::time_point balanced_{};
+    std::mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
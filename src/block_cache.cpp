@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/block_cache.hpp>
+
+#include <mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Block object overhead relative to its wire size (approximate).
+constexpr uint64_t overhead_factor = 2;
+
+block_cache::block_cache(uint64_t maximum_bytes) NOEXCEPT
+  : maximum_bytes_(maximum_bytes)
+{
+}
+
+bool block_cache::enabled() const NOEXCEPT
+{
+    return !is_zero(maximum_bytes_);
+}
+
+void block_cache::put(const chain::block::cptr& block) NOEXCEPT
+{
+    if (!enabled() || !block)
+        return;
+
+    const auto bytes = overhead_factor * block->serialized_size(true);
+    if (bytes > maximum_bytes_)
+        return;
+
+    const auto hash = block->hash();
+    std::unique_lock lock(mutex_);
+    if (map_.contains(hash))
+        return;
+
+    order_.push_front({ hash, block, bytes });
+    map_.emplace(hash, order_.begin());
+    bytes_ += bytes;
+
+    while (bytes_ > maximum_bytes_)
+    {
+        const auto& last = order_.back();
+        bytes_ -= last.bytes;
+        map_.erase(last.hash);
+        order_.pop_back();
+    }
+}
+
+chain::block::cptr block_cache::get(const hash_digest& hash) NOEXCEPT
+{
+    if (!enabled())
+        return {};
+
+    std::unique_lock lock(mutex_);
+    const auto it = map_.find(hash);
+    if (it == map_.end())
+        return {};
+
+    order_.splice(order_.begin(), order_, it->second);
+    return it->second->block;
+}
+
+void block_cache::trim(uint64_t bytes) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    const auto target = floored_subtract(bytes_, bytes);
+    while (bytes_ > target && !order_.empty())
+    {
+        const auto& last = order_.back();
+        bytes_ -= last.bytes;
+        map_.erase(last.hash);
+        order_.pop_back();
+    }
+}
+
+size_t block_cache::count() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return map_.size();
+}
+
+uint64_t block_cache::bytes() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return bytes_;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/block_claims.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+block_claims::block_claims(size_t capacity) NOEXCEPT
+  : capacity_(std::max(capacity, one))
+{
+}
+
+void block_claims::track(const hash_digest& hash) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    if (!claimed_.contains(hash))
+        insert(hash, false);
+}
+
+bool block_claims::tracked(const hash_digest& hash) const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return claimed_.contains(hash);
+}
+
+bool block_claims::claim(const hash_digest& hash) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    const auto it = claimed_.find(hash);
+    if (it == claimed_.end())
+    {
+        insert(hash, true);
+        return true;
+    }
+
+    if (it->second)
+        return false;
+
+    it->second = true;
+    return true;
+}
+
+void block_claims::release(const hash_digest& hash) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    const auto it = claimed_.find(hash);
+    if (it != claimed_.end())
+        it->second = false;
+}
+
+size_t block_claims::size() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return claimed_.size();
+}
+
+// private
+// A displaced claim is held briefly (during check), far younger than the
+// oldest of capacity hashes, so it is not expected to be displaced.
+void block_claims::insert(const hash_digest& hash, bool claimed) NOEXCEPT
+{
+    if (order_.size() >= capacity_)
+    {
+        claimed_.erase(order_.front());
+        order_.pop_front();
+    }
+
+    claimed_.emplace(hash, claimed);
+    order_.push_back(hash);
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
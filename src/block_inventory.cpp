@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/block_inventory.hpp>
+
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace system::chain;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+block_inventory::block_inventory(size_t window,
+    organizer&& organize) NOEXCEPT
+  : window_(window), organize_(std::move(organize))
+{
+}
+
+size_t block_inventory::merge(const hashes& announced) NOEXCEPT
+{
+    size_t added{};
+    std::unique_lock lock(mutex_);
+    for (const auto& hash: announced)
+    {
+        if (sequence_.emplace(hash, count_).second)
+        {
+            unclaimed_.emplace(count_++, hash);
+            ++added;
+        }
+    }
+
+    return added;
+}
+
+hashes block_inventory::claim(size_t count) NOEXCEPT
+{
+    hashes out{};
+    std::unique_lock lock(mutex_);
+    const auto limit = ceilinged_add(next_, window_);
+    while (out.size() < count && !unclaimed_.empty() &&
+        unclaimed_.begin()->first < limit)
+    {
+        out.push_back(unclaimed_.begin()->second);
+        unclaimed_.erase(unclaimed_.begin());
+    }
+
+    return out;
+}
+
+void block_inventory::release(const hashes& hashes) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    for (const auto& hash: hashes)
+    {
+        const auto it = sequence_.find(hash);
+        if (it != sequence_.end() && !ready_.contains(it->second))
+            unclaimed_.emplace(it->second, hash);
+    }
+}
+
+bool block_inventory::complete(const block::cptr& block) NOEXCEPT
+{
+    {
+        std::unique_lock lock(mutex_);
+        const auto it = sequence_.find(block->hash());
+        if (it == sequence_.end() || unclaimed_.contains(it->second) ||
+            !ready_.emplace(it->second, block).second)
+            return false;
+    }
+
+    organize_next();
+    return true;
+}
+
+size_t block_inventory::pending() const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+    return sequence_.size();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Organization of the next block awaits completion of the previous, as the
+// blocks would otherwise race to the organizer and orphan each other.
+void block_inventory::organize_next() NOEXCEPT
+{
+    block::cptr next{};
+    {
+        std::unique_lock lock(mutex_);
+        const auto it = ready_.find(next_);
+        if (organizing_ || it == ready_.end())
+            return;
+
+        organizing_ = true;
+        next = it->second;
+        ready_.erase(it);
+    }
+
+    organize_(next, std::bind(&block_inventory::handle_organize, this,
+        _1, _2, next));
+}
+
+// A failed block is dropped, as it is invalid or not connected to the chain
+// (so that its descendants also fail). Duplicates are skipped as organized.
+void block_inventory::handle_organize(const code&, size_t,
+    const block::cptr& block) NOEXCEPT
+{
+    {
+        std::unique_lock lock(mutex_);
+        organizing_ = false;
+        sequence_.erase(block->hash());
+        ++next_;
+    }
+
+    organize_next();
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/block_template.hpp>
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/tx_pool.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Smallest possible transaction, below which remaining space is unusable.
+constexpr uint64_t minimum_size = 60;
+
+block_template::block_template(uint64_t maximum_size,
+    size_t maximum_sigops) NOEXCEPT
+  : maximum_size_(maximum_size), maximum_sigops_(maximum_sigops)
+{
+}
+
+size_t block_template::count() const NOEXCEPT
+{
+    return entries_.size();
+}
+
+void block_template::apply(const tx_pool::changes& changes) NOEXCEPT
+{
+    if (changes.updated.empty() && changes.removed.empty())
+        return;
+
+    for (const auto& hash: changes.removed)
+        erase(hash);
+
+    for (const auto& change: changes.updated)
+    {
+        const auto hash = change.tx->hash(false);
+        erase(hash);
+        by_ancestors_.insert({ tx_pool::rate(change.ancestors), hash });
+        entries_.emplace(hash, change);
+    }
+
+    assembly_.reset();
+}
+
+void block_template::clear() NOEXCEPT
+{
+    entries_.clear();
+    by_ancestors_.clear();
+    assembly_.reset();
+}
+
+const block_template::assembly::cptr& block_template::assemble() NOEXCEPT
+{
+    if (assembly_)
+        return assembly_;
+
+    assembly out{};
+    hash_set selected{};
+    for (auto it = by_ancestors_.rbegin(); it != by_ancestors_.rend(); ++it)
+    {
+        if (out.size + minimum_size > maximum_size_ ||
+            out.sigops >= maximum_sigops_)
+            break;
+
+        if (!selected.contains(it->hash))
+            select(it->hash, selected, out);
+    }
+
+    assembly_ = std::make_shared<const assembly>(std::move(out));
+    return assembly_;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+void block_template::erase(const hash_digest& hash) NOEXCEPT
+{
+    const auto it = entries_.find(hash);
+    if (it == entries_.end())
+        return;
+
+    by_ancestors_.erase({ tx_pool::rate(it->second.ancestors), hash });
+    entries_.erase(it);
+}
+
+// Unselected ancestors are ordered depth first so that parents precede
+// children, and the package is selected only if it fits entirely (in both
+// size and sigop cost).
+bool block_template::select(const hash_digest& hash, hash_set& selected,
+    assembly& out) const NOEXCEPT
+{
+    using element = decltype(entries_)::value_type;
+    std::vector<const element*> package{};
+    std::vector<std::pair<const element*, bool>> pending{};
+    pending.emplace_back(&*entries_.find(hash), false);
+
+    hash_set visited{};
+    uint64_t size{};
+    size_t sigops{};
+    while (!pending.empty())
+    {
+        const auto [entry, expanded] = pending.back();
+        pending.pop_back();
+        if (expanded)
+        {
+            package.push_back(entry);
+            size += entry->second.self.size;
+            sigops += entry->second.self.sigops;
+            continue;
+        }
+
+        if (!visited.insert(entry->first).second)
+            continue;
+
+        pending.emplace_back(entry, true);
+        for (const auto& parent: entry->second.parents)
+        {
+            const auto it = entries_.find(parent);
+            if (it != entries_.end() && !selected.contains(parent) &&
+                !visited.contains(parent))
+                pending.emplace_back(&*it, false);
+        }
+    }
+
+    if (out.size + size > maximum_size_ ||
+        out.sigops + sigops > maximum_sigops_)
+        return false;
+
+    for (const auto entry: package)
+    {
+        selected.insert(entry->first);
+        out.txs.push_back(entry->second.tx);
+        out.fees += entry->second.self.fee;
+    }
+
+    out.size += size;
+    out.sigops += sigops;
+    return true;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/buffered_sink.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+buffered_sink::buffered_sink(std::ostream& stream, size_t limit,
+    const std::chrono::milliseconds& period) NOEXCEPT
+  : stream_(stream), limit_(limit), period_(period)
+{
+    if (buffered())
+        writer_ = std::thread(&buffered_sink::run, this);
+}
+
+buffered_sink::~buffered_sink() NOEXCEPT
+{
+    stop();
+}
+
+void buffered_sink::write(const std::string& text) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    if (stopped_)
+        return;
+
+    if (!buffered())
+    {
+        stream_ << text;
+        stream_.flush();
+        return;
+    }
+
+    buffer_.append(text);
+    if (buffer_.size() >= limit_)
+        ready_.notify_one();
+}
+
+void buffered_sink::flush() NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    if (stopped_ || !buffered())
+        return;
+
+    const auto target = ++requested_;
+    ready_.notify_one();
+    drained_.wait(lock, [&]() NOEXCEPT
+    {
+        return stopped_ || completed_ >= target;
+    });
+}
+
+void buffered_sink::stop() NOEXCEPT
+{
+    {
+        std::unique_lock lock(mutex_);
+        if (stopped_)
+            return;
+
+        stopped_ = true;
+        ready_.notify_one();
+    }
+
+    // The writer drains the buffer before it returns.
+    if (writer_.joinable())
+        writer_.join();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+bool buffered_sink::buffered() const NOEXCEPT
+{
+    return period_ > std::chrono::milliseconds::zero();
+}
+
+void buffered_sink::run() NOEXCEPT
+{
+    std::string text{};
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        ready_.wait_for(lock, period_, [&]() NOEXCEPT
+        {
+            return stopped_ || requested_ > completed_ ||
+                buffer_.size() >= limit_;
+        });
+
+        // Stream writes happen outside of the lock, so writers never wait.
+        const auto target = requested_;
+        const auto stopping = stopped_;
+        std::swap(text, buffer_);
+        lock.unlock();
+
+        if (!text.empty())
+        {
+            stream_ << text;
+            stream_.flush();
+            text.clear();
+        }
+
+        lock.lock();
+        completed_ = target;
+        drained_.notify_all();
+
+        // Text cannot be buffered once stopped, so the final pass drains it.
+        if (stopping)
+            return;
+    }
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -45,6 +45,10 @@ void chaser::stopping(const code&) NOEXCEPT
 {
 }
 
+void chaser::stopped() NOEXCEPT
+{
+}
+
 bool chaser::closed() const NOEXCEPT
 {
     return node_.closed();
@@ -76,6 +80,18 @@ code chaser::reload(const store::event_handler& handler) NOEXCEPT
     return node_.reload(handler);
 }
 
+void chaser::set_fees(const database::header_link& link, size_t height,
+    uint64_t fees) NOEXCEPT
+{
+    node_.set_fees(link, height, fees);
+}
+
+bool chaser::take_fees(uint64_t& fees, const database::header_link& link,
+    size_t height) NOEXCEPT
+{
+    return node_.take_fees(fees, link, height);
+}
+
 // Events.
 // ----------------------------------------------------------------------------
 
@@ -90,6 +106,18 @@ void chaser::notify(const code& ec, chase event_,
     node_.notify(ec, event_, value);
 }
 
+void chaser::notify(const code& ec, chase event_, event_value value,
+    const event_payload& payload) const NOEXCEPT
+{
+    node_.notify(ec, event_, value, payload);
+}
+
+void chaser::fire(uint8_t event_, uint64_t value) const NOEXCEPT
+{
+    node_.metrics().fired(event_);
+    reporter::fire(event_, value);
+}
+
 void chaser::notify_one(object_key key, const code& ec, chase event_,
     event_value value) const NOEXCEPT
 {
@@ -109,6 +137,71 @@ query& chaser::archive() const NOEXCEPT
     return node_.archive();
 }
 
+prevout_cache& chaser::prevouts() const NOEXCEPT
+{
+    return node_.prevouts();
+}
+
+script_cache& chaser::scripts() const NOEXCEPT
+{
+    return node_.scripts();
+}
+
+block_cache& chaser::blocks() const NOEXCEPT
+{
+    return node_.blocks();
+}
+
+header_index& chaser::confirmed_headers() const NOEXCEPT
+{
+    return node_.confirmed_headers();
+}
+
+download_budget& chaser::budget() const NOEXCEPT
+{
+    return node_.budget();
+}
+
+memory_governor& chaser::memory() const NOEXCEPT
+{
+    return node_.memory();
+}
+
+block_claims& chaser::claims() const NOEXCEPT
+{
+    return node_.claims();
+}
+
+work_cache& chaser::work() const NOEXCEPT
+{
+    return node_.work();
+}
+
+network::threadpool& chaser::check_pool() const NOEXCEPT
+{
+    return node_.check_pool();
+}
+
+worker_shares& chaser::shares() const NOEXCEPT
+{
+    return node_.shares();
+}
+
+hash_filter& chaser::seen() const NOEXCEPT
+{
+    return node_.seen();
+}
+
+metrics_registry& chaser::metrics() const NOEXCEPT
+{
+    return node_.metrics();
+}
+
+span_tracer& chaser::tracer() const NOEXCEPT
+{
+    return node_.tracer();
+}
+
 asio::strand& chaser::strand() NOEXCEPT
 {
     return strand_;
@@ -129,6 +222,20 @@ bool chaser::is_current(uint32_t timestamp) const NOEXCEPT
     return node_.is_current(timestamp);
 }
 
+system::chain::context chaser::to_chain_context(
+    const database::context& context) NOEXCEPT
+{
+    return
+    {
+        context.flags,  // [accept & connect]
+        {},             // timestamp
+        {},             // mtp
+        context.height, // [accept]
+        {},             // minimum_block_version
+        {}              // work_required
+    };
+}
+
 // Bypass.
 // ----------------------------------------------------------------------------
 
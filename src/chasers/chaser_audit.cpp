@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/chasers/chaser_audit.hpp>
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/chasers/chaser.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/full_node.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+#define CLASS chaser_audit
+
+using namespace system;
+using namespace network;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+chaser_audit::chaser_audit(full_node& node) NOEXCEPT
+  : chaser(node),
+    milestone_(node.config().bitcoin.milestone.height()),
+    enabled_(!node.config().node.bootstrap_path.empty() &&
+        node.config().bitcoin.milestone.hash() != null_hash)
+{
+}
+
+// start
+// ----------------------------------------------------------------------------
+
+// Genesis is not audited, as it is not downloaded.
+code chaser_audit::start() NOEXCEPT
+{
+    if (!enabled_)
+        return error::success;
+
+    LOGN("Audit of bootstrapped blocks to [" << milestone_ << "] started.");
+    POST(do_audit, height_t{ 1 });
+    return error::success;
+}
+
+// audit
+// ----------------------------------------------------------------------------
+
+// Each batch is posted behind strand work queued while it ran.
+void chaser_audit::do_audit(height_t height) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    const auto& query = archive();
+    for (size_t count = 0; count < batch && height <= milestone_; ++count)
+    {
+        if (closed())
+            return;
+
+        const auto block = query.get_block(query.to_confirmed(height));
+        if (!block)
+        {
+            LOGF("Audit of bootstrapped block [" << height << "] unread.");
+            fault(error::store_bootstrap);
+            return;
+        }
+
+        if (const auto ec = block->check(false))
+        {
+            LOGF("Audit of bootstrapped block [" << height << "] failed, "
+                << ec.message());
+            fault(error::store_bootstrap);
+            return;
+        }
+
+        ++height;
+    }
+
+    if (height > milestone_)
+    {
+        LOGN("Audit of bootstrapped blocks to [" << milestone_
+            << "] complete.");
+        return;
+    }
+
+    POST(do_audit, height);
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
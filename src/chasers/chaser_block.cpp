@@ -46,20 +46,24 @@ bool chaser_block::get_block(block::cptr& out, size_t index) const NOEXCEPT
     return !is_null(out);
 }
 
+// header.check is never bypassed.
+// block.check does not invoke header.check.
+// The height is not known here, so block.check is deferred to validate, where
+// it is bypass-aware (header checks of a batch organize remain concurrent).
+code chaser_block::check(const block& block) const NOEXCEPT
+{
+    return block.header().check(
+        settings().timestamp_limit_seconds,
+        settings().proof_of_work_limit,
+        settings().forks.scrypt_proof_of_work);
+}
+
 code chaser_block::validate(const block& block,
     const chain_state& state) const NOEXCEPT
 {
     code ec{};
     const auto& header = block.header();
 
-    // header.check is never bypassed.
-    // block.check does not invoke header.check.
-    if ((ec = header.check(
-        settings().timestamp_limit_seconds,
-        settings().proof_of_work_limit,
-        settings().forks.scrypt_proof_of_work)))
-        return ec;
-
     // header.accept is never bypassed.
     // block.accept does not invoke header.accept.
     if ((ec = header.accept(state.context())))
@@ -42,28 +42,29 @@ BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
 BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
+// Memory of a pending item and its hash key index entry (approximate).
+constexpr uint64_t item_bytes = sizeof(work_map::item) + sizeof(size_t);
+
 chaser_check::chaser_check(full_node& node) NOEXCEPT
   : chaser(node),
-    maximum_concurrency_(node.config().node.maximum_concurrency_()),
     maximum_height_(node.config().node.maximum_height_()),
-    connections_(node.config().network.outbound_connections)
+    connections_(node.config().network.outbound_connections),
+    window_bytes_(node.config().node.window_bytes),
+    endgame_(node.config().node.sample_period()),
+    maximum_concurrency_(node.config().node.maximum_concurrency_())
 {
 }
 
 // static
 map_ptr chaser_check::empty_map() NOEXCEPT
 {
-    return std::make_shared<associations>();
+    return std::make_shared<work_map>();
 }
 
 // static
 map_ptr chaser_check::split(const map_ptr& map) NOEXCEPT
 {
-    const auto half = empty_map();
-    auto& index = map->get<association::pos>();
-    const auto end = std::next(index.begin(), to_half(map->size()));
-    half->merge(index, index.begin(), end);
-    return half;
+    return map->take(to_half(map->size()));
 }
 
 // start/stop
@@ -72,12 +73,20 @@ map_ptr chaser_check::split(const map_ptr& map) NOEXCEPT
 code chaser_check::start() NOEXCEPT
 {
     start_tracking();
-    set_position(archive().get_fork());
+    advanced_ = steady_clock::now();
+    set_position(std::max(archive().get_fork(), restored_));
+    set_checked(position());
     requested_ = position();
     const auto added = set_unassociated();
     LOGN("Fork point (" << requested_ << ") unassociated (" << added << ").");
 
-    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3);
+    // Pending work is not shrunk, its intake is throttled by the allowance.
+    memory().enroll("maps", [this]() NOEXCEPT
+    {
+        return item_bytes * queued_.load();
+    });
+
+    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3, _4);
     return error::success;
 }
 
@@ -88,8 +97,25 @@ void chaser_check::stopping(const code& ec) NOEXCEPT
     chaser::stopping(ec);
 }
 
+void chaser_check::restore(size_t height) NOEXCEPT
+{
+    restored_ = height;
+}
+
+size_t chaser_check::checked_height() const NOEXCEPT
+{
+    return checked_height_.load();
+}
+
+// The checked height is the frontier of the download budget.
+void chaser_check::set_checked(size_t height) NOEXCEPT
+{
+    checked_height_.store(height);
+    budget().set_frontier(height);
+}
+
 bool chaser_check::handle_event(const code&, chase event_,
-    event_value value) NOEXCEPT
+    event_value value, const event_payload& payload) NOEXCEPT
 {
     if (closed())
         return false;
@@ -106,7 +132,7 @@ bool chaser_check::handle_event(const code&, chase event_,
         }
         case chase::checked:
         {
-            POST(do_checked, possible_narrow_cast<height_t>(value));
+            POST(do_checked, possible_narrow_cast<height_t>(value), payload);
             break;
         }
         case chase::regressed:
@@ -135,6 +161,20 @@ bool chaser_check::handle_event(const code&, chase event_,
             POST(do_headers, possible_narrow_cast<height_t>(value));
             break;
         }
+        case chase::throttle:
+        {
+            POST(do_throttle, possible_narrow_cast<count_t>(value));
+            break;
+        }
+        case chase::tune:
+        {
+            if (payload)
+            {
+                POST(do_tune, *payload_cast<tuning>(payload));
+            }
+
+            break;
+        }
         case chase::stop:
         {
             return false;
@@ -148,6 +188,36 @@ bool chaser_check::handle_event(const code&, chase event_,
     return true;
 }
 
+// throttle
+// ----------------------------------------------------------------------------
+
+// A reduced window takes effect as the window next advances.
+void chaser_check::do_throttle(count_t percent) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    const auto throttle = std::min(percent, size_t{ 100 });
+    if (throttle != throttle_)
+        LOGN("Download window throttled to [" << throttle << "%].");
+
+    throttle_ = throttle;
+}
+
+// An increased window is filled at once, a reduced window takes effect as
+// the window next advances (outstanding work is retained).
+void chaser_check::do_tune(const tuning& setting) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    size_t value{};
+    if (setting.name != "maximum_concurrency" || !setting.integral(value))
+        return;
+
+    maximum_concurrency_ = is_zero(value) ? max_size_t : value;
+    LOGN("Download concurrency tuned to (" << value << ").");
+    do_bump(height_t{});
+}
+
 // regression
 // ----------------------------------------------------------------------------
 
@@ -156,13 +226,37 @@ void chaser_check::do_regressed(height_t branch_point) NOEXCEPT
     BC_ASSERT(stranded());
 
     // Inconsequential regression, work isn't there yet.
-    if (branch_point >= position())
+    if (branch_point >= std::max(position(), requested_))
         return;
 
-    // Update position, purge outstanding work, and wait on track completion.
-    set_position(branch_point);
-    stop_tracking();
-    maps_.clear();
+    if (branch_point < position())
+    {
+        set_position(branch_point);
+        set_checked(branch_point);
+        metrics().set(metrics_registry::gauge::checked_height, branch_point);
+    }
+
+    // Revoke only work above the branch point, work below remains in flight.
+    // Pending maps are keyed by floor, so those above are dropped entirely.
+    checked_.erase(checked_.upper_bound(branch_point), checked_.end());
+    maps_.erase(maps_.upper_bound(branch_point), maps_.end());
+    for (const auto& map: maps_)
+        map.second->trim(branch_point);
+
+    urgent_->trim(branch_point);
+
+    size_t queued{};
+    for (const auto& map: maps_)
+        queued += map.second->size();
+
+    queued_ = queued;
+
+    // Work above the branch point is rescanned once position reaches it.
+    requested_ = std::min(requested_, branch_point);
+    regressed_ = branch_point;
+    if (raced_ > branch_point)
+        raced_ = {};
+
     notify(error::success, chase::purge, branch_point);
 }
 
@@ -207,11 +301,40 @@ void chaser_check::do_handle_purged(const code&) NOEXCEPT
 // track downloaded in order (to move download window)
 // ----------------------------------------------------------------------------
 
-void chaser_check::do_checked(height_t height) NOEXCEPT
+void chaser_check::do_checked(height_t height,
+    const event_payload& payload) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    // Candidate block was checked at the given height, advance.
+    // Checked heights above position are retained until position reaches.
+    if (height <= position())
+        return;
+
+    const auto& query = archive();
+    const auto block = payload_cast<checked_block>(payload);
+    const auto link = query.to_candidate(height);
+
+    // A block archived before a regression may no longer be the candidate at
+    // its height, in which case the height remains to be downloaded.
+    if (block && link.value != block->link)
+        return;
+
+    // Moving average of checked block sizes, estimates the window in bytes.
+    // The size is provided by the issuing channel, otherwise read from store.
+    if (!is_zero(window_bytes_))
+    {
+        const auto size = possible_wide_cast<uint64_t>(block ? block->size :
+            query.get_block_size(link));
+
+        block_bytes_ = is_zero(block_bytes_) ? size :
+            floored_divide(ceilinged_add(block_bytes_ * 7u, size), 8u);
+    }
+
+    // Candidate block was checked at the given height, so it is tracked.
+    // Without the link the height is not tracked, and the store is searched.
+    if (block)
+        checked_.insert(height);
+
     if (height == add1(position()))
         do_bump(height);
 }
@@ -222,13 +345,18 @@ void chaser_check::do_bump(height_t) NOEXCEPT
     if (purging())
         return;
 
-    const auto& query = archive();
-
-    // TODO: query.is_associated() is expensive (hashmap search).
     // Skip checked blocks starting immediately after last checked.
-    while (!closed() && query.is_associated(
-        query.to_candidate(add1(position()))))
-            set_position(add1(position()));
+    const auto start = position();
+    while (!closed() && is_associated(add1(position())))
+        set_position(add1(position()));
+
+    // Age of the gap at the frontier determines endgame racing.
+    if (position() != start)
+    {
+        advanced_ = steady_clock::now();
+        set_checked(position());
+        metrics().set(metrics_registry::gauge::checked_height, position());
+    }
 
     set_unassociated();
 }
@@ -258,9 +386,19 @@ void chaser_check::do_header(header_t link) NOEXCEPT
     }
 
     // Add even if purging, as this header applies to the subsequent rage.
-    const auto map = std::make_shared<associations>(associations{ out });
-    if (set_map(map) && !purging())
-        notify(error::success, chase::download, one);
+    // The redownload holds the validation frontier, so it is issued ahead of
+    // all other work, and channels with capacity are directed to request now.
+    auto map = std::make_shared<work_map>(work_map::items{ out });
+    if (urgent_->empty())
+        urgent_ = map;
+    else
+        urgent_->merge(*map, one);
+
+    if (purging())
+        return;
+
+    notify(error::success, chase::download, one);
+    notify(error::success, chase::expedite, link);
 }
 
 // get/put hashes
@@ -271,14 +409,15 @@ bool chaser_check::purging() const NOEXCEPT
     return !job_;
 }
 
-void chaser_check::get_hashes(map_handler&& handler) NOEXCEPT
+void chaser_check::get_hashes(size_t count, uint64_t latency,
+    map_handler&& handler) NOEXCEPT
 {
     if (closed())
         return;
 
     boost::asio::post(strand(),
         std::bind(&chaser_check::do_get_hashes,
-            this, std::move(handler)));
+            this, count, latency, std::move(handler)));
 }
 
 void chaser_check::put_hashes(const map_ptr& map,
@@ -292,18 +431,33 @@ void chaser_check::put_hashes(const map_ptr& map,
             this, map, std::move(handler)));
 }
 
-void chaser_check::do_get_hashes(const map_handler& handler) NOEXCEPT
+void chaser_check::do_get_hashes(size_t count, uint64_t latency,
+    const map_handler& handler) NOEXCEPT
 {
     BC_ASSERT(stranded());
     if (closed() || purging())
         return;
 
-    const auto map = get_map();
+    // Expedited work is issued alone, so its request is not deferred.
+    if (!urgent_->empty())
+    {
+        const auto map = urgent_;
+        urgent_ = empty_map();
+        handler(error::success, map, job_, bypass());
+        return;
+    }
+
+    auto map = get_map(count, is_frontier(latency));
+    if (map->empty())
+        map = get_race();
+
     handler(error::success, map, job_, bypass());
 }
 
 // It is possible that this call can be made before a purge has been sent and
 // received after. This may result in unnecessary work and incorrect bypass.
+// Returned work above the last branch point may have been revoked, so items
+// that are no longer candidates are dropped before the work is reissued.
 void chaser_check::do_put_hashes(const map_ptr& map,
     const result_handler& handler) NOEXCEPT
 {
@@ -312,6 +466,9 @@ void chaser_check::do_put_hashes(const map_ptr& map,
     if (closed() || purging())
         return;
 
+    if (map->top() > regressed_)
+        set_candidates(*map);
+
     if (set_map(map))
         notify(error::success, chase::download, map->size());
 
@@ -321,11 +478,128 @@ void chaser_check::do_put_hashes(const map_ptr& map,
 // utilities
 // ----------------------------------------------------------------------------
 
-map_ptr chaser_check::get_map() NOEXCEPT
+// Heights are tracked from chase::checked, so the store is searched only at a
+// gap. This covers blocks associated before start or checked while purging.
+bool chaser_check::is_associated(height_t height) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    // Heights at or below position are no longer required.
+    checked_.erase(checked_.begin(), checked_.lower_bound(height));
+    if (!checked_.empty() && *checked_.begin() == height)
+    {
+        checked_.erase(checked_.begin());
+        return true;
+    }
+
+    // query.is_associated() is expensive (hashmap search).
+    const auto& query = archive();
+    return query.is_associated(query.to_candidate(height));
+}
+
+// Latency reports are averaged across channels, and a channel with more than
+// twice the average latency is considered remote from the frontier (where a
+// late block delays validation). Unmeasured channels are given the frontier.
+bool chaser_check::is_frontier(uint64_t latency) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    return maps_.empty() ? empty_map() : pop_front(maps_);
+    if (is_zero(latency))
+        return true;
+
+    // Moving average of reports, each weighted one eighth.
+    latency_ = is_zero(latency_) ? latency :
+        latency_ - (latency_ >> 3u) + (latency >> 3u);
+
+    return latency <= (latency_ << 1u);
+}
+
+// Maps are issued in order, merged up to count for a fast channel or with
+// the excess returned to the front for a slow one. Zero count takes one map.
+// Frontier maps are the lowest, others are the highest (bulk of the window).
+map_ptr chaser_check::get_map(size_t count, bool frontier) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (maps_.empty())
+        return empty_map();
+
+    auto map = pop_map(frontier);
+    if (is_zero(count))
+        return map;
+
+    const auto limit = std::min(count, messages::max_inventory);
+    while (map->size() < limit && !maps_.empty())
+    {
+        const auto next = pop_map(frontier);
+        map->merge(*next, limit - map->size());
+        set_map(next);
+    }
+
+    if (map->size() > limit)
+    {
+        const auto part = map->take(limit);
+        set_map(map);
+        map = part;
+    }
+
+    return map;
+}
+
+// Endgame: when the block at the frontier has been outstanding for a sample
+// period, it is also issued once to a starved channel. The first arrival is
+// archived and the other is dropped by its channel upon receipt.
+map_ptr chaser_check::get_race() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    const auto height = add1(position());
+    if (is_zero(endgame_.count()) || raced_ == height ||
+        height > requested_ || (steady_clock::now() - advanced_) < endgame_)
+        return empty_map();
+
+    association out{};
+    const auto& query = archive();
+    const auto link = query.to_candidate(height);
+    if (link.is_terminal() || !query.get_unassociated(out, link))
+        return empty_map();
+
+    // The raced block is claimed by the first channel to receive it.
+    raced_ = height;
+    claims().track(out.hash);
+    LOGV("Race block (" << height << ") after ("
+        << duration_cast<seconds>(steady_clock::now() - advanced_).count()
+        << ") secs.");
+
+    return std::make_shared<work_map>(work_map::items{ out });
+}
+
+map_ptr chaser_check::pop_map(bool frontier) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    BC_ASSERT(!maps_.empty());
+
+    const auto it = frontier ? maps_.begin() : std::prev(maps_.end());
+    const auto map = it->second;
+    maps_.erase(it);
+    queued_ = floored_subtract(queued_.load(), map->size());
+    return map;
+}
+
+void chaser_check::set_candidates(work_map& map) const NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    work_map::items out{};
+    const auto& query = archive();
+    map.for_each([&](const work_map::item& item) NOEXCEPT
+    {
+        if (query.to_candidate(item.context.height) == item.link)
+            out.push_back(item);
+    });
+
+    if (out.size() != map.size())
+        map = work_map{ std::move(out) };
 }
 
 bool chaser_check::set_map(const map_ptr& map) NOEXCEPT
@@ -336,7 +610,8 @@ bool chaser_check::set_map(const map_ptr& map) NOEXCEPT
     if (map->empty())
         return false;
 
-    maps_.push_back(map);
+    maps_.emplace(map->floor(), map);
+    queued_ += map->size();
     return true;
 }
 
@@ -354,12 +629,11 @@ size_t chaser_check::set_unassociated() NOEXCEPT
     if (position() < requested_ || requested_ >= maximum_height_)
         return {};
 
-    // Inventory size gets set only once.
+    // Inventory size follows the remaining candidate span, which shrinks as
+    // the chain becomes current. Channels then resize by their own rates.
+    inventory_ = get_inventory_size();
     if (is_zero(inventory_))
-    {
-        inventory_ = get_inventory_size();
-        if (is_zero(inventory_)) return zero;
-    }
+        return zero;
 
     // Due to previous downloads, validation can race ahead of last request.
     // The last request (requested_) stops at the last gap in the window, but
@@ -367,25 +641,25 @@ size_t chaser_check::set_unassociated() NOEXCEPT
     // not last requested, since all between are already downloaded.
     const auto& query = archive();
     const auto requested = requested_;
-    const auto step = ceilinged_add(position(), maximum_concurrency_);
+    const auto step = ceilinged_add(position(), get_window());
     const auto stop = std::min(step, maximum_height_);
     size_t count{};
 
     while (true)
     {
         // Calls query.is_associated() per block, expensive (hashmap search).
-        const auto map = std::make_shared<associations>(
+        const auto map = std::make_shared<work_map>(
             query.get_unassociated_above(requested_, inventory_, stop));
 
         if (!set_map(map))
             break;
 
-        requested_ = map->top().height;
+        requested_ = map->top();
         count += map->size();
     }
 
     LOGN("Advance by ("
-        << maximum_concurrency_ << ") above ("
+        << get_window() << ") above ("
         << requested << ") from ("
         << position() << ") stop ("
         << stop << ") found ("
@@ -402,14 +676,39 @@ size_t chaser_check::get_inventory_size() const NOEXCEPT
     if (is_zero(peers) || !is_current())
         return zero;
 
-    const auto step = config().node.maximum_concurrency_();
-    const auto fork = archive().get_fork();
-    const auto scan = archive().get_unassociated_count_above(fork, step);
+    // Top candidate is a cheap bound on unassociated above position.
+    const auto step = get_window();
+    const auto scan = floored_subtract(archive().get_top_candidate(),
+        position());
     const auto span = std::min(step, scan);
     const auto inventory = std::min(span, messages::max_inventory);
     return system::ceilinged_divide(inventory, peers);
 }
 
+// Block count of the download window, bounded by estimated bytes. The estimate
+// follows recently checked blocks, so window memory is roughly constant.
+// A storage throttle or memory allowance (the lesser) then scales the window,
+// to no less than one block.
+size_t chaser_check::get_window() const NOEXCEPT
+{
+    auto window = maximum_concurrency_;
+    if (!is_zero(window_bytes_) && !is_zero(block_bytes_))
+    {
+        const auto count = greater(floored_divide(window_bytes_,
+            block_bytes_), 1_u64);
+
+        window = possible_narrow_cast<size_t>(std::min(count,
+            possible_wide_cast<uint64_t>(maximum_concurrency_)));
+    }
+
+    const auto throttle = std::min(throttle_, memory().allowance());
+    if (throttle == 100u)
+        return window;
+
+    const auto scaled = ceilinged_multiply(window, throttle);
+    return std::max(floored_divide(scaled, size_t{ 100 }), one);
+}
+
 BC_POP_WARNING()
 BC_POP_WARNING()
 BC_POP_WARNING()
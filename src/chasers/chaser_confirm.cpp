@@ -32,24 +32,44 @@ using namespace system;
 using namespace database;
 using namespace std::placeholders;
 
+// Shared pointer is required to keep the batch object alive in bind closure.
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
 chaser_confirm::chaser_confirm(full_node& node) NOEXCEPT
-  : chaser(node)
+  : chaser(node),
+    workers_(node.config().node.confirm_threads),
+    defer_strong_(node.config().node.defer_strong),
+    threadpool_(std::max(workers_, one))
 {
 }
 
 code chaser_confirm::start() NOEXCEPT
 {
-    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3);
+    // Confirmed headers are indexed in memory for serving to peers.
+    if (!set_headers())
+    {
+        LOGN("Confirmed header index not loaded, headers served from store.");
+        confirmed_headers().clear();
+    }
+
+    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3, _4);
     return error::success;
 }
 
+// Queued confirmability queries may not outlive the store.
+void chaser_confirm::stopped() NOEXCEPT
+{
+    threadpool_.stop();
+    threadpool_.join();
+}
+
 // Protected
 // ----------------------------------------------------------------------------
 
 bool chaser_confirm::handle_event(const code&, chase event_,
-    event_value value) NOEXCEPT
+    event_value value, const event_payload&) NOEXCEPT
 {
     if (closed())
         return false;
@@ -104,6 +124,8 @@ bool chaser_confirm::handle_event(const code&, chase event_,
 // The scans are extremely fast and tiny in all typical scnearios, so it may
 // not improve performance or be worth spending 32 bytes per header to store
 // work, especially since individual header work is obtained from 4 bytes.
+// Validated heights are coalesced, so that all notifications queued ahead of
+// the confirmation pass are confirmed as one contiguous range.
 void chaser_confirm::do_validated(height_t height) NOEXCEPT
 {
     BC_ASSERT(stranded());
@@ -111,6 +133,30 @@ void chaser_confirm::do_validated(height_t height) NOEXCEPT
     if (closed())
         return;
 
+    pending_ = std::max(pending_, height);
+    if (confirming_)
+    {
+        deferred_ = true;
+        return;
+    }
+
+    confirming_ = true;
+    POST(do_confirm, height_t{});
+}
+
+void chaser_confirm::do_confirm(height_t) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (closed())
+        return;
+
+    // A candidate regression may have lowered the top of the range.
+    auto& query = archive();
+    const auto height = std::min(pending_, query.get_top_candidate());
+    pending_ = zero;
+    deferred_ = false;
+
     // TODO: update specialized fault codes.
 
     // Compute relative work.
@@ -126,19 +172,21 @@ void chaser_confirm::do_validated(height_t height) NOEXCEPT
         return;
     }
 
-    if (!get_is_strong(strong, work, height))
+    if (!get_is_strong(strong, work, height - fork.size()))
     {
         fault(error::get_is_strong);
         return;
     }
 
     if (!strong)
+    {
+        complete();
         return;
+    }
 
     // Reorganize confirmed chain.
     // ........................................................................
 
-    auto& query = archive();
     const auto top = query.get_top_confirmed();
     const auto fork_point = height - fork.size();
     if (top < fork_point)
@@ -147,6 +195,24 @@ void chaser_confirm::do_validated(height_t height) NOEXCEPT
         return;
     }
 
+    // A reorganization is not begun across a gap, since the popped branch
+    // would otherwise be left for a partial (possibly weaker) one.
+    if (top > fork_point)
+    {
+        auto next = fork_point;
+        for (const auto& link: views_reverse(fork))
+        {
+            const auto bypass = is_bypassed(++next) &&
+                !query.is_malleable64(link);
+            if (is_gap(query.get_block_state(link), bypass))
+            {
+                pending_ = std::max(pending_, height);
+                complete();
+                return;
+            }
+        }
+    }
+
     // Pop down to the fork point.
     auto index = top;
     header_links popped{};
@@ -167,14 +233,106 @@ void chaser_confirm::do_validated(height_t height) NOEXCEPT
 
         notify(error::success, chase::reorganized, popped.back());
         fire(events::block_reorganized, index--);
+        metrics().set(metrics_registry::gauge::confirmed_height, index);
+    }
+
+    // Popped blocks are no longer strong, so deferred strong is reset to the
+    // fork point, and blocks of the new branch above it are set strong.
+    if (!popped.empty())
+        strong_ = std::min(strong_, fork_point);
+
+    // Candidate headers are pushed in height order from fork_point + 1.
+    std::reverse(fork.begin(), fork.end());
+    const auto batch = std::make_shared<confirmation>(height, fork_point,
+        std::move(popped), std::move(fork));
+
+    // Confirmability of the batch is checked in parallel, pushed in order.
+    if (!is_zero(workers_) && set_checks(*batch))
+    {
+        distribute(batch);
+        return;
+    }
+
+    do_push(batch);
+}
+
+// Blocks already valid and not bypassed require the confirmability query.
+bool chaser_confirm::set_checks(confirmation& batch) const NOEXCEPT
+{
+    const auto& query = archive();
+    auto index = add1(batch.fork_point);
+    auto any = false;
+
+    for (size_t at = 0; at < batch.fork.size(); ++at, ++index)
+    {
+        const auto& link = batch.fork.at(at);
+        if (query.get_block_state(link) == database::error::block_valid &&
+            !(is_bypassed(index) && !query.is_malleable64(link)))
+        {
+            batch.checks.at(at) = true;
+            any = true;
+        }
+    }
+
+    return any;
+}
+
+// One job per worker (up to one per checked block), each claims blocks until
+// the batch is exhausted.
+void chaser_confirm::distribute(const confirmation::ptr& batch) NOEXCEPT
+{
+    const auto jobs = std::min(workers_, batch->fork.size());
+    batch->pending.store(jobs);
+
+    for (size_t job = 0; !closed() && job < jobs; ++job)
+        boost::asio::post(threadpool_.service(),
+            std::bind(&chaser_confirm::check_batch, this, batch));
+}
+
+// START WORK UNIT
+// Each slot is written by its claiming worker only, and read on the strand
+// once the last worker has finished.
+void chaser_confirm::check_batch(const confirmation::ptr& batch) NOEXCEPT
+{
+    const auto& query = archive();
+    const auto count = batch->fork.size();
+
+    for (auto at = batch->next.fetch_add(one); !closed() && at < count;
+        at = batch->next.fetch_add(one))
+    {
+        const auto& link = batch->fork.at(at);
+        if (batch->checks.at(at))
+            batch->results.at(at) = query.block_confirmable(link);
+
+        // Spends are compared on the strand with those of predecessors.
+        if (const auto block = query.get_block(link))
+            batch->set_spends(at, *block);
+        else
+            batch->partial.store(true);
     }
 
-    // fork_point + 1
-    ++index;
+    // FINISH WORK UNIT
+    if (batch->pending.fetch_sub(one) == one)
+        POST(do_push, batch);
+}
+
+void chaser_confirm::do_push(const confirmation::ptr& batch) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (closed())
+        return;
+
+    auto& query = archive();
+    const auto height = batch->height;
+    auto index = add1(batch->fork_point);
 
     // Push candidate headers to confirmed chain.
-    for (const auto& link: views_reverse(fork))
+    for (size_t at = 0; at < batch->fork.size(); ++at)
     {
+        const auto start = tracer().now();
+        const auto& link = batch->fork.at(at);
+
         // TODO: skip under bypass and not malleable?
         auto ec = query.get_block_state(link);
         if (ec == database::error::integrity)
@@ -188,22 +346,53 @@ void chaser_confirm::do_validated(height_t height) NOEXCEPT
         {
             notify(ec, chase::unconfirmable, link);
             fire(events::block_unconfirmable, index);
+            complete();
             return;
         }
 
         const auto malleable64 = query.is_malleable64(link);
+        const auto bypass = is_bypassed(index) && !malleable64;
+
+        // Validation completes out of order, so stop at the first gap in the
+        // range and resume from the same top once the gap is validated.
+        if (is_gap(ec, bypass))
+        {
+            pending_ = std::max(pending_, height);
+            complete();
+            return;
+        }
 
         // TODO: set organized.
         // error::confirmation_bypass is not used.
-        if (ec == database::error::block_confirmable ||
-            (is_bypassed(index) && !malleable64))
+        if (ec == database::error::block_confirmable || bypass)
         {
+            // Bypassed txs not set strong upon archive are set here in order.
+            if (bypass && defer_strong_ && index > strong_)
+            {
+                if (!query.set_strong(link))
+                {
+                    fault(error::set_confirmed);
+                    return;
+                }
+
+                strong_ = index;
+            }
+
+            batch->spend(at);
             notify(ec, chase::confirmable, index);
             fire(events::confirm_bypassed, index);
             continue;
         }
 
-        ec = query.block_confirmable(link);
+        // A parallel check could not observe its predecessors in the batch,
+        // so it is repeated here if it failed (a prevout may be created by a
+        // predecessor) or if a predecessor spent any of the same outpoints.
+        if (!batch->checks.at(at) || batch->results.at(at) ||
+            batch->conflicts(at))
+            ec = query.block_confirmable(link);
+        else
+            ec = batch->results.at(at);
+
         if (ec == database::error::integrity)
         {
             fault(error::node_confirm);
@@ -220,6 +409,7 @@ void chaser_confirm::do_validated(height_t height) NOEXCEPT
                 LOGR("Malleated64 block [" << index << "] " << ec.message());
                 notify(ec, chase::malleated, link);
                 fire(events::block_malleated, index);
+                complete();
                 return;
             }
 
@@ -235,18 +425,21 @@ void chaser_confirm::do_validated(height_t height) NOEXCEPT
 
             // chase::reorganized & events::block_reorganized
             // chase::organized & events::block_organized
-            if (!roll_back(popped, fork_point, index))
+            if (!roll_back(*batch))
             {
                 fault(error::node_roll_back);
                 return;
             }
 
+            complete();
             return;
         }
 
-        // TODO: compute fees from validation records.
+        // Fees are retained by validation, zero if validated before startup.
+        uint64_t fees{};
+        take_fees(fees, link, index);
 
-        if (!query.set_block_confirmable(link, uint64_t{}))
+        if (!query.set_block_confirmable(link, fees))
         {
             fault(error::block_confirmable);
             return;
@@ -262,9 +455,28 @@ void chaser_confirm::do_validated(height_t height) NOEXCEPT
             return;
         }
 
+        batch->spend(at);
+        batch->pushed.push_back(link);
+        tracer().record(span_tracer::span::confirm, start, index);
         LOGV("Block confirmed and organized: " << index);
         ++index;
     }
+
+    complete();
+}
+
+// Validations received while the pass was outstanding require another pass.
+void chaser_confirm::complete() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    confirming_ = false;
+    if (!deferred_)
+        return;
+
+    deferred_ = false;
+    confirming_ = true;
+    POST(do_confirm, height_t{});
 }
 
 // Private
@@ -276,8 +488,17 @@ bool chaser_confirm::set_organized(header_t link, height_t height) NOEXCEPT
     if (!query.push_confirmed(link))
         return false;
 
+    const auto header = query.get_header(link);
+    if (header)
+        confirmed_headers().push(*header, height);
+
+    // Peers request a new block at the current tip, read once for all.
+    if (blocks().enabled() && is_current())
+        blocks().put(query.get_block(link));
+
     notify(error::success, chase::organized, link);
     fire(events::block_organized, height);
+    metrics().set(metrics_registry::gauge::confirmed_height, height);
     return true;
 }
 
@@ -287,21 +508,47 @@ bool chaser_confirm::set_reorganized(header_t link, height_t height) NOEXCEPT
     if (!query.set_unstrong(link) || !query.pop_confirmed())
         return false;
 
+    confirmed_headers().pop(height);
+
     notify(error::success, chase::reorganized, link);
     fire(events::block_reorganized, height);
+    metrics().set(metrics_registry::gauge::confirmed_height, sub1(height));
     return true;
 }
 
-bool chaser_confirm::roll_back(const header_links& popped,
-    size_t fork_point, size_t top) NOEXCEPT
+// Deferred strong writes also wait on a gap in the bypassed range.
+bool chaser_confirm::is_gap(const code& ec, bool bypass) const NOEXCEPT
+{
+    return (!bypass && ec == database::error::unvalidated) ||
+        ((!bypass || defer_strong_) && ec == database::error::unassociated);
+}
+
+bool chaser_confirm::set_headers() NOEXCEPT
+{
+    const auto& query = archive();
+    const auto top = query.get_top_confirmed();
+    for (auto height = confirmed_headers().count(); height <= top; ++height)
+    {
+        const auto header = query.get_header(query.to_confirmed(height));
+        if (!header || !confirmed_headers().push(*header, height))
+            return false;
+    }
+
+    return true;
+}
+
+// The journal of the pass is undone in reverse, so no confirmed index reads
+// are required and the unconfirmable (unpushed) top is not popped.
+bool chaser_confirm::roll_back(const confirmation& batch) NOEXCEPT
 {
     auto& query = archive();
-    for (auto height = top; height > fork_point; --height)
-        if (!set_reorganized(query.to_confirmed(height), height))
+    auto height = batch.fork_point + batch.pushed.size();
+    for (const auto& link: views_reverse(batch.pushed))
+        if (!set_reorganized(link, height--))
             return false;
 
-    for (const auto& link: views_reverse(popped))
-        if (!query.set_strong(link) || !set_organized(link, ++fork_point))
+    for (const auto& link: views_reverse(batch.popped))
+        if (!query.set_strong(link) || !set_organized(link, ++height))
             return false;
 
     return true;
@@ -343,6 +590,18 @@ bool chaser_confirm::get_is_strong(bool& strong, const uint256_t& fork_work,
     uint256_t confirmed_work{};
     const auto& query = archive();
 
+    // Confirmed work above the fork point is the difference of cumulatives.
+    if (work().enabled())
+    {
+        const auto confirmed = query.to_confirmed(query.get_top_confirmed());
+        if (!work().get_work(confirmed_work, query, confirmed,
+            query.to_confirmed(fork_point)))
+            return false;
+
+        strong = fork_work > confirmed_work;
+        return true;
+    }
+
     for (auto height = query.get_top_confirmed(); height > fork_point;
         --height)
     {
@@ -363,6 +622,8 @@ bool chaser_confirm::get_is_strong(bool& strong, const uint256_t& fork_work,
     return true;
 }
 
+BC_POP_WARNING()
+BC_POP_WARNING()
 BC_POP_WARNING()
 
 } // namespace node
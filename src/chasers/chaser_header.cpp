@@ -45,18 +45,20 @@ bool chaser_header::get_block(system::chain::header::cptr& out,
     return !is_null(out);
 }
 
+// header.check is never bypassed.
+code chaser_header::check(const system::chain::header& header) const NOEXCEPT
+{
+    return header.check(
+        settings().timestamp_limit_seconds,
+        settings().proof_of_work_limit,
+        settings().forks.scrypt_proof_of_work);
+}
+
 code chaser_header::validate(const system::chain::header& header,
     const chain_state& state) const NOEXCEPT
 {
     code ec{ error::success };
 
-    // header.check is never bypassed.
-    if ((ec = header.check(
-        settings().timestamp_limit_seconds,
-        settings().proof_of_work_limit,
-        settings().forks.scrypt_proof_of_work)))
-        return ec;
-
     // header.accept is never bypassed.
     if ((ec = header.accept(state.context())))
         return ec;
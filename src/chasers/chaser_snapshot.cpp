@@ -18,6 +18,9 @@
  */
 #include <bitcoin/node/chasers/chaser_snapshot.hpp>
 
+#include <array>
+#include <sstream>
+#include <string>
 #include <bitcoin/system.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
@@ -34,13 +37,33 @@ using namespace std::placeholders;
 
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
+static const std::array<std::string, 15> table_names
+{
+    "header",
+    "txs",
+    "tx",
+    "point",
+    "input",
+    "output",
+    "puts",
+    "candidate",
+    "confirmed",
+    "spend",
+    "strong_tx",
+    "valid_tx",
+    "valid_bk",
+    "address",
+    "neutrino"
+};
+
 chaser_snapshot::chaser_snapshot(full_node& node) NOEXCEPT
   : chaser(node),
     top_checkpoint_(node.config().bitcoin.top_checkpoint().height()),
+    concurrent_(node.config().node.snapshot_concurrent),
+    enabled_valid_(to_bool(node.config().node.snapshot_valid)),
+    enabled_bytes_(to_bool(node.config().node.snapshot_bytes)),
     snapshot_valid_(node.config().node.snapshot_valid),
-    snapshot_bytes_(node.config().node.snapshot_bytes),
-    enabled_valid_(to_bool(snapshot_valid_)),
-    enabled_bytes_(to_bool(snapshot_bytes_))
+    snapshot_bytes_(node.config().node.snapshot_bytes)
 {
 }
 
@@ -57,11 +80,9 @@ code chaser_snapshot::start() NOEXCEPT
     if (enabled_valid_)
         valid_ = std::max(archive().get_top_confirmed(), top_checkpoint_);
 
-    if (enabled_bytes_ || enabled_valid_)
-    {
-        SUBSCRIBE_EVENTS(handle_event, _1, _2, _3);
-    }
-
+    // Subscribed even if disabled, as either may be enabled by tuning.
+    sizes_ = get_sizes();
+    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3, _4);
     return error::success;
 }
 
@@ -69,7 +90,7 @@ code chaser_snapshot::start() NOEXCEPT
 // ----------------------------------------------------------------------------
 
 bool chaser_snapshot::handle_event(const code& ec, chase event_,
-    event_value value) NOEXCEPT
+    event_value value, const event_payload& payload) NOEXCEPT
 {
     if (closed())
         return false;
@@ -94,6 +115,15 @@ bool chaser_snapshot::handle_event(const code& ec, chase event_,
             POST(do_confirm, possible_narrow_cast<height_t>(value));
             break;
         }
+        case chase::tune:
+        {
+            if (payload)
+            {
+                POST(do_tune, *payload_cast<tuning>(payload));
+            }
+
+            break;
+        }
         default:
         {
             break;
@@ -128,6 +158,39 @@ void chaser_snapshot::do_confirm(size_t height) NOEXCEPT
     do_snapshot(height);
 }
 
+// A threshold is measured from the time it is enabled (zero disables).
+void chaser_snapshot::do_tune(const tuning& setting) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    uint64_t value{};
+    if (!setting.integral(value))
+        return;
+
+    if (setting.name == "snapshot_bytes")
+    {
+        if (!enabled_bytes_ && to_bool(value))
+            bytes_ = archive().store_body_size();
+
+        snapshot_bytes_ = value;
+        enabled_bytes_ = to_bool(value);
+    }
+    else if (setting.name == "snapshot_valid")
+    {
+        if (!enabled_valid_ && to_bool(value))
+            valid_ = std::max(archive().get_top_confirmed(), top_checkpoint_);
+
+        snapshot_valid_ = possible_narrow_cast<size_t>(value);
+        enabled_valid_ = to_bool(value);
+    }
+    else
+    {
+        return;
+    }
+
+    LOGN("Snapshot " << setting.name << " tuned to (" << value << ").");
+}
+
 // utility
 // ----------------------------------------------------------------------------
 
@@ -136,8 +199,10 @@ void chaser_snapshot::do_snapshot(size_t height) NOEXCEPT
     BC_ASSERT(stranded());
 
     const auto& query = archive();
-    const auto running = !suspended();
+    // A concurrent snapshot does not suspend, so there is nothing to resume.
+    const auto resumable = !concurrent_ && !suspended();
     const auto start = logger::now();
+    const auto traced = tracer().now();
     if (const auto ec = snapshot([this](auto event_, auto table) NOEXCEPT
     {
         LOGN("snapshot::" << full_node::store::events.at(event_)
@@ -150,14 +215,18 @@ void chaser_snapshot::do_snapshot(size_t height) NOEXCEPT
     else
     {
         span(events::snapshot_span, start);
+        tracer().record(span_tracer::span::snapshot, traced, height);
+        report_growth(get_sizes());
 
         // Could become full before snapshot start (and it could still succeed).
-        if (running && !archive().is_full())
+        if (resumable && !archive().is_full())
             resume();
 
-        const auto span = duration_cast<seconds>(logger::now() - start);
+        const auto span = duration_cast<milliseconds>(logger::now() - start);
+        metrics().observe(metrics_registry::histogram::snapshot_milliseconds,
+            to_unsigned(span.count()));
         LOGN("Snapshot at height [" << height << "] complete in "
-            << span.count() << " secs.");
+            << duration_cast<seconds>(span).count() << " secs.");
     }
 
     // Current values may have raced ahead but this is sufficient.
@@ -170,6 +239,52 @@ void chaser_snapshot::do_snapshot(size_t height) NOEXCEPT
         valid_ = std::max(query.get_top_confirmed(), top_checkpoint_);
 }
 
+// Table bodies in the order of table_names.
+chaser_snapshot::sizes chaser_snapshot::get_sizes() const NOEXCEPT
+{
+    const auto& query = archive();
+    return
+    {
+        query.header_body_size(),
+        query.txs_body_size(),
+        query.tx_body_size(),
+        query.point_body_size(),
+        query.input_body_size(),
+        query.output_body_size(),
+        query.puts_body_size(),
+        query.candidate_body_size(),
+        query.confirmed_body_size(),
+        query.spend_body_size(),
+        query.strong_tx_body_size(),
+        query.validated_tx_body_size(),
+        query.validated_bk_body_size(),
+        query.address_body_size(),
+        query.neutrino_body_size()
+    };
+}
+
+// Bodies are memory mapped, so that a snapshot flush writes only the pages
+// dirtied since the prior flush. Table growth is the bulk of those pages.
+void chaser_snapshot::report_growth(const sizes& current) NOEXCEPT
+{
+    uint64_t total{};
+    std::ostringstream growth{};
+    for (size_t table = 0; table < current.size(); ++table)
+    {
+        const auto grown = floored_subtract(current.at(table),
+            sizes_.at(table));
+
+        if (!is_zero(grown))
+            growth << " " << table_names.at(table) << ":" << grown;
+
+        total += grown;
+    }
+
+    sizes_ = current;
+    metrics().add(metrics_registry::counter::snapshot_bytes, total);
+    LOGN("Snapshot growth [" << total << "] bytes," << growth.str());
+}
+
 bool chaser_snapshot::update_bytes() NOEXCEPT
 {
     // This is the most costly, sizing for every download, but is just a sum.
@@ -18,12 +18,20 @@
  */
 #include <bitcoin/node/chasers/chaser_storage.hpp>
 
+#include <filesystem>
 #include <memory>
+#include <system_error>
 #include <bitcoin/system.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/full_node.hpp>
 
+#if defined(HAVE_LINUX)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <linux/falloc.h>
+#endif
+
 namespace libbitcoin {
 namespace node {
 
@@ -38,7 +46,9 @@ BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
 chaser_storage::chaser_storage(full_node& node) NOEXCEPT
   : chaser(node),
-    store_(node.config().database.path)
+    store_(node.config().database.path),
+    horizon_(node.config().node.storage_horizon_minutes * 60_u64),
+    preallocate_(node.config().node.preallocate_bytes)
 {
 }
 
@@ -50,7 +60,27 @@ code chaser_storage::start() NOEXCEPT
     // Construct is too early to create the unstarted timer.
     disk_timer_ = std::make_shared<deadline>(log, strand(), seconds{1});
 
-    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3);
+    if (!is_zero(horizon_))
+    {
+        forecast_timer_ = std::make_shared<deadline>(log, strand(),
+            minutes{1});
+        POST(do_forecast, count_t{});
+    }
+
+    if (!is_zero(preallocate_))
+    {
+        allocate_timer_ = std::make_shared<deadline>(log, strand(),
+            seconds{10});
+        POST(do_preallocate, count_t{});
+    }
+
+    if (memory().enabled())
+    {
+        memory_timer_ = std::make_shared<deadline>(log, strand(), seconds{1});
+        POST(do_govern, count_t{});
+    }
+
+    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3, _4);
     return error::success;
 }
 
@@ -65,13 +95,31 @@ void chaser_storage::do_stopping(const code&) NOEXCEPT
     BC_ASSERT(stranded());
     disk_timer_->stop();
     disk_timer_.reset();
+
+    if (forecast_timer_)
+    {
+        forecast_timer_->stop();
+        forecast_timer_.reset();
+    }
+
+    if (allocate_timer_)
+    {
+        allocate_timer_->stop();
+        allocate_timer_.reset();
+    }
+
+    if (memory_timer_)
+    {
+        memory_timer_->stop();
+        memory_timer_.reset();
+    }
 }
 
 // event handlers
 // ----------------------------------------------------------------------------
 
 bool chaser_storage::handle_event(const code&, chase event_,
-    event_value) NOEXCEPT
+    event_value, const event_payload&) NOEXCEPT
 {
     if (closed())
         return false;
@@ -108,6 +156,188 @@ void chaser_storage::do_space(size_t) NOEXCEPT
     handle_timer(error::success);
 }
 
+// forecast space
+// ----------------------------------------------------------------------------
+
+void chaser_storage::do_forecast(count_t) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed())
+        return;
+
+    sampled_ = steady_clock::now();
+    sampled_bytes_ = archive().store_body_size();
+    forecast_timer_->start(BIND(handle_forecast, _1));
+}
+
+void chaser_storage::handle_forecast(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed() || !forecast_timer_ ||
+        ec == network::error::operation_canceled)
+        return;
+
+    if (ec && ec != network::error::operation_timeout)
+    {
+        LOGF("Storage chaser forecast fault, " << ec.message());
+        return;
+    }
+
+    // The disk full condition is handled by monitor and reload.
+    if (!suspended())
+    {
+        const auto throttle = get_throttle();
+        if (throttle != throttle_)
+        {
+            throttle_ = throttle;
+            notify(error::success, chase::throttle, throttle_);
+        }
+    }
+
+    forecast_timer_->start(BIND(handle_forecast, _1));
+}
+
+// Percentage of the download window to allow, given the time remaining until
+// free space is consumed at the rate of store growth since the last sample.
+size_t chaser_storage::get_throttle() NOEXCEPT
+{
+    const auto now = steady_clock::now();
+    const auto bytes = archive().store_body_size();
+    const auto elapsed = to_unsigned(duration_cast<seconds>(now -
+        sampled_).count());
+    const auto growth = floored_subtract(bytes, sampled_bytes_);
+    sampled_ = now;
+    sampled_bytes_ = bytes;
+
+    size_t have{};
+    if (is_zero(elapsed) || is_zero(growth) || !file::space(have, store_))
+        return 100;
+
+    const auto remaining = floored_divide(ceilinged_multiply(
+        possible_wide_cast<uint64_t>(have), elapsed), growth);
+
+    if (remaining >= horizon_)
+        return 100;
+
+    const auto percent = std::max(floored_divide(remaining * 100_u64,
+        horizon_), 1_u64);
+
+    LOGN("Disk projected full in [" << remaining / 60_u64 << "] minutes, "
+        << "download window at [" << percent << "%].");
+
+    return possible_narrow_cast<size_t>(percent);
+}
+
+// preallocate space
+// ----------------------------------------------------------------------------
+
+void chaser_storage::do_preallocate(count_t) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed())
+        return;
+
+    preallocate();
+    allocate_timer_->start(BIND(handle_preallocate, _1));
+}
+
+void chaser_storage::handle_preallocate(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed() || !allocate_timer_ ||
+        ec == network::error::operation_canceled)
+        return;
+
+    if (ec && ec != network::error::operation_timeout)
+    {
+        LOGF("Storage chaser preallocate fault, " << ec.message());
+        return;
+    }
+
+    if (!suspended())
+        preallocate();
+
+    allocate_timer_->start(BIND(handle_preallocate, _1));
+}
+
+// Files of at least the reserve size (large table bodies) are reserved disk
+// blocks beyond their end, without changing their size. Repeated reservation
+// of an allocated extent is inexpensive, so each pass covers every file.
+void chaser_storage::preallocate() const NOEXCEPT
+{
+#if defined(HAVE_LINUX)
+    std::error_code ec{};
+    for (const auto& entry: std::filesystem::directory_iterator(store_, ec))
+    {
+        if (!entry.is_regular_file(ec))
+            continue;
+
+        const auto size = entry.file_size(ec);
+        if (ec || size < preallocate_)
+            continue;
+
+        const auto descriptor = ::open(entry.path().c_str(), O_RDWR);
+        if (descriptor < 0)
+            continue;
+
+        if (::fallocate(descriptor, FALLOC_FL_KEEP_SIZE,
+            possible_sign_cast<off_t>(size),
+            possible_sign_cast<off_t>(preallocate_)) != 0)
+        {
+            LOGV("Preallocate failed for [" << entry.path() << "].");
+        }
+
+        ::close(descriptor);
+    }
+#endif
+}
+
+// govern memory
+// ----------------------------------------------------------------------------
+
+void chaser_storage::do_govern(count_t) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed())
+        return;
+
+    govern();
+    memory_timer_->start(BIND(handle_govern, _1));
+}
+
+void chaser_storage::handle_govern(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed() || !memory_timer_ ||
+        ec == network::error::operation_canceled)
+        return;
+
+    if (ec && ec != network::error::operation_timeout)
+    {
+        LOGF("Storage chaser memory fault, " << ec.message());
+        return;
+    }
+
+    govern();
+    memory_timer_->start(BIND(handle_govern, _1));
+}
+
+// Downloads are bumped as the allowance rises, since the window is larger.
+void chaser_storage::govern() NOEXCEPT
+{
+    const auto allowance = memory().balance();
+    if (allowance == allowance_)
+        return;
+
+    LOGN("Memory at (" << memory().usage() << ") bytes, intake at ["
+        << allowance << "%].");
+
+    if (allowance > allowance_)
+        notify(error::success, chase::bump, {});
+
+    allowance_ = allowance;
+}
+
 // utility
 // ----------------------------------------------------------------------------
 
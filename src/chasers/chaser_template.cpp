@@ -19,6 +19,7 @@
 #include <bitcoin/node/chasers/chaser_template.hpp>
 
 #include <bitcoin/system.hpp>
+#include <bitcoin/node/block_template.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/full_node.hpp>
@@ -33,18 +34,29 @@ using namespace std::placeholders;
 
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
+// Virtual size is a quarter of weight (bip141), less space for the coinbase.
+constexpr uint64_t coinbase_reserve = 1'000;
+constexpr auto maximum_size = uint64_t{ chain::max_block_weight } / 4u -
+    coinbase_reserve;
+
+// Sigop cost is scaled by four (bip141), less cost for the coinbase.
+constexpr size_t coinbase_sigops_reserve = 400;
+constexpr auto maximum_sigops = chain::max_block_sigops * 4u -
+    coinbase_sigops_reserve;
+
 chaser_template::chaser_template(full_node& node) NOEXCEPT
-  : chaser(node)
+  : chaser(node),
+    template_(maximum_size, maximum_sigops)
 {
 }
 
 // start
 // ----------------------------------------------------------------------------
 
-// TODO: initialize template state.
 code chaser_template::start() NOEXCEPT
 {
-    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3);
+    set_height();
+    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3, _4);
     return error::success;
 }
 
@@ -52,17 +64,23 @@ code chaser_template::start() NOEXCEPT
 // ----------------------------------------------------------------------------
 
 bool chaser_template::handle_event(const code&, chase event_,
-    event_value value) NOEXCEPT
+    event_value value, const event_payload& payload) NOEXCEPT
 {
     if (closed())
         return false;
 
-    // TODO: also handle confirmed/unconfirmed.
     switch (event_)
     {
         case chase::transaction:
         {
-            POST(do_transaction, possible_narrow_cast<transaction_t>(value));
+            POST(do_transaction, possible_narrow_cast<transaction_t>(value),
+                payload);
+            break;
+        }
+        case chase::organized:
+        case chase::reorganized:
+        {
+            POST(do_organized, possible_narrow_cast<header_t>(value));
             break;
         }
         case chase::stop:
@@ -78,10 +96,45 @@ bool chaser_template::handle_event(const code&, chase event_,
     return true;
 }
 
-// TODO: handle transaction graph change (may issue 'candidate').
-void chaser_template::do_transaction(transaction_t) NOEXCEPT
+// Pool changes are applied to the template index, so that the template is
+// reassembled from the sorted mirror without copying or resorting the pool.
+void chaser_template::do_transaction(transaction_t,
+    const event_payload& payload) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed() || !payload)
+        return;
+
+    template_.apply(*payload_cast<tx_pool::changes>(payload));
+    issue();
+}
+
+// The confirmed top changes the template parent. A non-empty pool publishes
+// its change upon confirmation (removing confirmed txs and their conflicts),
+// so a template is issued here only if it cannot contain a confirmed tx.
+void chaser_template::do_organized(header_t) NOEXCEPT
 {
     BC_ASSERT(stranded());
+    if (closed())
+        return;
+
+    set_height();
+    if (is_zero(template_.count()))
+        issue();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+void chaser_template::set_height() NOEXCEPT
+{
+    height_ = add1(archive().get_top_confirmed());
+}
+
+// The assembly is shared with all subscribers as the event payload.
+void chaser_template::issue() NOEXCEPT
+{
+    notify(error::success, chase::template_, height_, template_.assemble());
 }
 
 BC_POP_WARNING()
@@ -18,6 +18,9 @@
  */
 #include <bitcoin/node/chasers/chaser_transaction.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
@@ -28,13 +31,16 @@ namespace node {
 
 #define CLASS chaser_transaction
     
+using namespace system;
 using namespace system::chain;
 using namespace std::placeholders;
 
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
 chaser_transaction::chaser_transaction(full_node& node) NOEXCEPT
-  : chaser(node)
+  : chaser(node),
+    pool_(node.config().node.mempool_bytes),
+    admission_pool_(std::max(node.config().node.admission_threads, 1_u32))
 {
 }
 
@@ -44,21 +50,46 @@ chaser_transaction::chaser_transaction(full_node& node) NOEXCEPT
 // TODO: initialize tx graph from store, log and stop on error.
 code chaser_transaction::start() NOEXCEPT
 {
-    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3);
+    set_context();
+
+    // The pool is not shrunk, its admission is paused under pressure.
+    memory().enroll("pool", [this]() NOEXCEPT
+    {
+        return pool_bytes_.load();
+    });
+
+    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3, _4);
     return error::success;
 }
 
+// Queued admission queries may not outlive the store.
+void chaser_transaction::stopped() NOEXCEPT
+{
+    admission_pool_.stop();
+    admission_pool_.join();
+}
+
 // event handlers
 // ----------------------------------------------------------------------------
 
 bool chaser_transaction::handle_event(const code&, chase event_,
-    event_value) NOEXCEPT
+    event_value value, const event_payload&) NOEXCEPT
 {
     if (closed())
         return false;
 
     switch (event_)
     {
+        case chase::organized:
+        {
+            POST(do_confirmed, possible_narrow_cast<header_t>(value));
+            break;
+        }
+        case chase::reorganized:
+        {
+            POST(do_reorganized, possible_narrow_cast<header_t>(value));
+            break;
+        }
         case chase::stop:
         {
             return false;
@@ -72,29 +103,266 @@ bool chaser_transaction::handle_event(const code&, chase event_,
     return true;
 }
 
-// TODO: handle the new confirmed blocks (may issue 'transaction').
-void chaser_transaction::do_confirmed(header_t) NOEXCEPT
+// Confirmed txs and their conflicts leave the pool, which changes templates.
+// The block is not read when the pool is empty (such as during sync).
+void chaser_transaction::do_confirmed(header_t link) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    set_context();
+    if (is_zero(pool_.count()))
+        return;
+
+    const auto block = archive().get_block(link);
+    if (!block)
+    {
+        fault(error::get_block);
+        return;
+    }
+
+    // Published even if unchanged, as the template awaits it for a new top.
+    for (const auto& tx: *block->transactions_ptr())
+        pool_.confirm(*tx);
+
+    publish();
+}
+
+// Txs of an unconfirmed block return to the pool by full admission, under the
+// context of the new top. Those confirmed by the new branch are then rejected
+// as spent, or leave the pool as the branch is organized.
+void chaser_transaction::do_reorganized(header_t link) NOEXCEPT
 {
     BC_ASSERT(stranded());
+    set_context();
+    if (!pool_.enabled())
+        return;
+
+    const auto block = archive().get_block(link);
+    if (!block)
+    {
+        fault(error::get_block);
+        return;
+    }
+
+    for (const auto& tx: *block->transactions_ptr())
+        store(tx);
+}
 
-    notify(error::success, chase::transaction, transaction_t{});
+// Changes are drained with each event, so the template applies each once.
+void chaser_transaction::publish() NOEXCEPT
+{
+    pool_bytes_ = pool_.bytes();
+    notify(error::success, chase::transaction, transaction_t{},
+        make_payload<tx_pool::changes>(pool_.drain()));
+}
+
+// Pooled txs are connected under the context of the next confirmed block.
+void chaser_transaction::set_context() NOEXCEPT
+{
+    const auto& query = archive();
+    const auto link = query.to_confirmed(query.get_top_confirmed());
+    if (!query.get_context(context_, link))
+    {
+        fault(error::store_integrity);
+        return;
+    }
+
+    context_.height = add1(context_.height);
 }
 
 // methods
 // ----------------------------------------------------------------------------
 
-void chaser_transaction::store(const transaction::cptr&) NOEXCEPT
+// Admission is a pipeline, with context-free checks and script connection on
+// the admission pool and only pool lookups and insertion on the strand.
+void chaser_transaction::store(const transaction::cptr& tx) NOEXCEPT
 {
-    // Push new checked tx into store and update DAG. Issue transaction event
-    // so that candidate may construct a new template.
+    if (tx && pool_.enabled() && !closed() && !memory().pressured())
+        boost::asio::post(admission_pool_.service(),
+            std::bind(&chaser_transaction::check_tx, this, tx));
+}
+
+// private (admission pool)
+void chaser_transaction::check_tx(const transaction::cptr& tx) NOEXCEPT
+{
+    if (closed() || tx->is_coinbase())
+        return;
+
+    if (const auto ec = tx->check())
+    {
+        LOGR("Invalid pool tx [" << encode_hash(tx->hash(false)) << "] "
+            << ec.message());
+        return;
+    }
+
+    POST(do_admit, tx);
 }
 
-// private
-void chaser_transaction::do_store(const transaction::cptr&) NOEXCEPT
+// Duplicates and conflicts are rejected before the expensive stage.
+void chaser_transaction::do_admit(const transaction::cptr& tx) NOEXCEPT
 {
     BC_ASSERT(stranded());
+    if (closed() || pool_.exists(tx->hash(false)))
+        return;
+
+    hashes parents{};
+    for (const auto& in: *tx->inputs_ptr())
+    {
+        const auto& point = in->point();
+        if (pool_.spender(point) != null_hash)
+            return;
+
+        if (pool_.exists(point.hash()))
+            parents.push_back(point.hash());
+    }
+
+    // Prevouts are obtained from pooled parents and then from the store.
+    const auto populated = pool_.populate(*tx);
+    boost::asio::post(admission_pool_.service(),
+        std::bind(&chaser_transaction::connect_tx,
+            this, tx, context_, std::move(parents), populated));
+}
+
+// private (admission pool)
+void chaser_transaction::connect_tx(const transaction::cptr& tx,
+    const database::context& context, const hashes& parents,
+    bool populated) NOEXCEPT
+{
+    if (closed())
+        return;
+
+    // Prevouts from the store carry their confirmation metadata.
+    if ((!populated && !archive().populate_with_metadata(*tx)) ||
+        tx->is_overspent())
+        return;
+
+    if (const auto ec = accept_tx(*tx, context))
+    {
+        LOGR("Unacceptable pool tx [" << encode_hash(tx->hash(false)) << "] "
+            << ec.message());
+        return;
+    }
+
+    // Script verification is skipped for txs verified under the same flags.
+    const auto witness = tx->hash(true);
+    if (!scripts().contains(witness, context.flags))
+    {
+        if (const auto ec = tx->connect(to_chain_context(context)))
+        {
+            LOGR("Invalid pool tx [" << encode_hash(tx->hash(false)) << "] "
+                << ec.message());
+            return;
+        }
+
+        scripts().insert(witness, context.flags);
+    }
+
+    // Sigop cost is computed once, as with fee, for template assembly.
+    const auto ctx = to_chain_context(context);
+    const auto sigops = tx->signature_operations(
+        ctx.is_enabled(chain::flags::bip16_rule),
+        ctx.is_enabled(chain::flags::bip141_rule));
+
+    POST(do_store, tx, parents, sigops);
+}
+
+// private (admission pool)
+// Contextual checks against the next block, as a confirmed block would apply
+// them: finality (locktime), relative locktime (bip68), coinbase maturity and
+// confirmed spends of prevouts. Prevouts of pooled parents are unconfirmed.
+code chaser_transaction::accept_tx(const transaction& tx,
+    const database::context& context) const NOEXCEPT
+{
+    auto ctx = to_chain_context(context);
+    ctx.median_time_past = context.mtp;
+
+    code ec{};
+    if ((ec = tx.accept(ctx)) || (ec = tx.confirm(ctx)))
+        return ec;
+
+    // Under bip113 finality is measured against median time past, which is
+    // also the lower bound of the timestamp of the next block.
+    if (tx.is_absolute_locked(ctx.height, ctx.median_time_past,
+        ctx.median_time_past, ctx.is_enabled(chain::flags::bip113_rule)))
+        return system::error::absolute_time_locked;
+
+    for (const auto& in: *tx.inputs_ptr())
+        if (in->metadata.spent)
+            return system::error::confirmed_double_spend;
+
+    return error::success;
+}
+
+// Issue transaction event so that template may construct a new template.
+void chaser_transaction::do_store(const transaction::cptr& tx,
+    const hashes& parents, size_t sigops) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed())
+        return;
+
+    // Parents may have been confirmed or evicted during connection.
+    for (const auto& parent: parents)
+        if (!pool_.exists(parent))
+            return;
+
+    if (const auto ec = pool_.add(tx, tx->fee(), sigops))
+    {
+        LOGV("Unpooled tx [" << encode_hash(tx->hash(false)) << "] "
+            << ec.message());
+        return;
+    }
+
+    publish();
+}
+
+void chaser_transaction::reconstruct(const compact_relay::ptr& relay,
+    network::result_handler&& handler) NOEXCEPT
+{
+    POST(do_reconstruct, relay, std::move(handler));
+}
+
+// Each pooled tx is matched by short id (which is keyed to the block).
+void chaser_transaction::do_reconstruct(const compact_relay::ptr& relay,
+    const network::result_handler& handler) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed())
+    {
+        handler(network::error::service_stopped);
+        return;
+    }
+
+    pool_.visit([&](const transaction::cptr& tx) NOEXCEPT
+    {
+        relay->match(tx);
+    });
+
+    handler(error::success);
+}
+
+void chaser_transaction::get_transactions(const hashes& hashes,
+    transactions_handler&& handler) NOEXCEPT
+{
+    POST(do_get_transactions, hashes, std::move(handler));
+}
+
+void chaser_transaction::do_get_transactions(const hashes& hashes,
+    const transactions_handler& handler) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed())
+    {
+        handler(network::error::service_stopped, {});
+        return;
+    }
+
+    transaction_cptrs txs{};
+    txs.reserve(hashes.size());
+    for (const auto& hash: hashes)
+        if (const auto tx = pool_.get(hash))
+            txs.push_back(tx);
 
-    // TODO: validate and store transaction.
+    handler(error::success, txs);
 }
 
 BC_POP_WARNING()
@@ -18,12 +18,14 @@
  */
 #include <bitcoin/node/chasers/chaser_validate.hpp>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <bitcoin/system.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/full_node.hpp>
+#include <bitcoin/node/thread_affinity.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -36,7 +38,10 @@ using namespace system::neutrino;
 using namespace database;
 using namespace std::placeholders;
 
-// Shared pointer is required to keep the race object alive in bind closure.
+// Transactions claimed by a worker at each visit to the block batch.
+constexpr size_t chunk = 16;
+
+// Shared pointer is required to keep the batch object alive in bind closure.
 BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
 BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
@@ -45,19 +50,74 @@ chaser_validate::chaser_validate(full_node& node) NOEXCEPT
   : chaser(node),
     initial_subsidy_(node.config().bitcoin.initial_subsidy()),
     subsidy_interval_blocks_(node.config().bitcoin.subsidy_interval_blocks),
-    threadpool_(std::max(node.config().node.threads, 1_u32))
+    maximum_backlog_(node.config().node.maximum_backlog_()),
+    workers_(std::max(node.config().node.threads, 1_u32)),
+    populators_(node.config().node.populate_threads),
+    prefetch_(node.config().node.prefetch_blocks),
+    historians_(std::min(size_t{ node.config().node.history_threads },
+        workers_)),
+    candidates_(node.config().node.validate_candidates),
+    threadpool_(node.shares().validate_capacity()),
+    populate_pool_(std::max(populators_, one)),
+    prefetch_pool_(one),
+    history_pool_(std::max(historians_, one))
 {
 }
 
 code chaser_validate::start() NOEXCEPT
 {
-    update_position(archive().get_fork());
-    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3);
+    bind_pools();
+    const auto fork = archive().get_fork();
+    set_position(fork);
+    reset_neutrino(fork);
+    SUBSCRIBE_EVENTS(handle_event, _1, _2, _3, _4);
     return error::success;
 }
 
+// Queued populate, validate and filter work may not outlive the store.
+void chaser_validate::stopped() NOEXCEPT
+{
+    threadpool_.stop();
+    populate_pool_.stop();
+    prefetch_pool_.stop();
+    history_pool_.stop();
+    threadpool_.join();
+    populate_pool_.join();
+    prefetch_pool_.join();
+    history_pool_.join();
+}
+
+// Pools are idle until the first bump, so each thread takes one binding.
+void chaser_validate::bind_pools() NOEXCEPT
+{
+    const auto& text = config().node.validate_affinity;
+    thread_affinity::cores cores{};
+    if (!thread_affinity::parse(cores, text))
+    {
+        LOGN("Invalid validation affinity [" << text << "].");
+        return;
+    }
+
+    if (cores.empty())
+        return;
+
+    if (!thread_affinity::bind(threadpool_.service(),
+            shares().validate_capacity(), cores) ||
+        !thread_affinity::bind(populate_pool_.service(),
+            std::max(populators_, one), cores) ||
+        !thread_affinity::bind(prefetch_pool_.service(), one, cores) ||
+        !thread_affinity::bind(history_pool_.service(),
+            std::max(historians_, one), cores))
+    {
+        LOGN("Validation threads not bound to cores [" << text << "].");
+        return;
+    }
+
+    LOGN("Validation threads bound to cores [" << text << "].");
+}
+
 bool chaser_validate::handle_event(const code&, chase event_,
-    event_value value) NOEXCEPT
+    event_value value, const event_payload&) NOEXCEPT
 {
     if (closed())
         return false;
@@ -72,31 +132,37 @@ bool chaser_validate::handle_event(const code&, chase event_,
     {
         // Track downloaded.
         // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        ////case chase::start:
-        ////case chase::bump:
-        ////{
-        ////    POST(do_bump, height_t{});
-        ////    break;
-        ////}
-        ////case chase::checked:
-        ////{
-        ////    POST(do_checked, possible_narrow_cast<height_t>(value));
-        ////    break;
-        ////}
-        ////case chase::regressed:
-        ////{
-        ////    POST(do_regressed, possible_narrow_cast<height_t>(value));
-        ////    break;
-        ////}
-        ////case chase::disorganized:
-        ////{
-        ////    POST(do_regressed, possible_narrow_cast<height_t>(value));
-        ////    break;
-        ////}
+        // Candidate (tip lane) validation is enabled by configuration.
+        case chase::start:
+        case chase::bump:
+        {
+            if (candidates_)
+                POST(do_bump, height_t{});
+
+            break;
+        }
+        case chase::checked:
+        {
+            if (candidates_)
+                POST(do_checked, possible_narrow_cast<height_t>(value));
+
+            break;
+        }
+        case chase::regressed:
+        case chase::disorganized:
+        {
+            if (candidates_)
+                POST(do_regressed, possible_narrow_cast<height_t>(value));
+
+            break;
+        }
         // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
         case chase::bypass:
         {
             POST(set_bypass, possible_narrow_cast<height_t>(value));
+            if (!is_zero(historians_))
+                POST(do_history, height_t{});
+
             break;
         }
         case chase::stop:
@@ -123,7 +189,12 @@ void chaser_validate::do_regressed(height_t branch_point) NOEXCEPT
         return;
 
     // Update position and wait.
-    update_position(branch_point);
+    set_position(branch_point);
+    prefetched_ = std::min(prefetched_, branch_point);
+
+    // Filters above the branch point are no longer chained.
+    if (branch_point < filtered_)
+        reset_neutrino(branch_point);
 }
 
 void chaser_validate::do_checked(height_t height) NOEXCEPT
@@ -177,169 +248,452 @@ void chaser_validate::do_bump(height_t) NOEXCEPT
             ec == database::error::block_confirmable ||
             (is_bypassed(height) && !query.is_malleable64(link)))
         {
-            update_position(height);
+            set_position(height);
+            chain_neutrino(height, link, {});
             notify(ec, chase::valid, height);
             fire(events::validate_bypassed, height);
             continue;
         }
 
-        // TODO: the quantity of work must be throttled.
-        // This will very rapidly pump all outstanding work into asio queue.
+        // Wait until outstanding work drains below the backlog limit. A block
+        // is always accepted when nothing is outstanding, regardless of size.
+        if (backlog_ >= maximum_backlog_)
+            return;
+
         if (!enqueue_block(link))
         {
             fault(error::node_validate);
             return;
         }
 
-        // Retain last height in validation sequence, update neutrino.
-        update_position(height);
+        // Retain last height in validation sequence.
+        set_position(height);
+        prefetch(height);
+    }
+}
+
+// Bypassed blocks are validated in order from genesis, in the history lane.
+// Its backlog is independent of the tip lane, so neither blocks the other.
+void chaser_validate::do_history(height_t) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    const auto& query = archive();
+
+    for (auto height = add1(historical_); !closed() && is_bypassed(height);
+        ++height)
+    {
+        const auto link = query.to_candidate(height);
+        const auto ec = query.get_block_state(link);
+        if (ec == database::error::unassociated)
+            return;
+
+        if (ec == database::error::integrity)
+        {
+            fault(error::node_validate);
+            return;
+        }
+
+        // Validated by either lane (or a prior run).
+        if (ec == database::error::block_valid ||
+            ec == database::error::block_confirmable)
+        {
+            historical_ = height;
+            continue;
+        }
+
+        if (history_backlog_ >= maximum_backlog_)
+            return;
+
+        if (!enqueue_block(link, true))
+        {
+            fault(error::node_validate);
+            return;
+        }
+
+        historical_ = height;
+    }
+}
+
+// Associated blocks ahead of validation are read on the prefetch thread, so
+// that store pages of the block and its prevouts are resident once enqueued.
+// This matters when the store is cold (restart) or larger than memory.
+void chaser_validate::prefetch(height_t height) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (is_zero(prefetch_))
+        return;
+
+    const auto& query = archive();
+    const auto last = ceilinged_add(height, prefetch_);
+    for (auto next = add1(std::max(height, prefetched_)); !closed() &&
+        next <= last; ++next)
+    {
+        const auto link = query.to_candidate(next);
+        if (link.is_terminal() || !query.is_associated(link))
+            return;
+
+        boost::asio::post(prefetch_pool_.service(),
+            std::bind(&chaser_validate::prefetch_block, this, link));
+
+        prefetched_ = next;
     }
 }
 
+// The block is discarded, only the page faults of reading it matter.
+void chaser_validate::prefetch_block(const header_link& link) NOEXCEPT
+{
+    if (closed())
+        return;
+
+    const auto& query = archive();
+    if (const auto block = query.get_block(link))
+        query.populate(*block);
+}
+
 // DISTRUBUTE WORK UNITS
-bool chaser_validate::enqueue_block(const header_link& link) NOEXCEPT
+bool chaser_validate::enqueue_block(const header_link& link,
+    bool history) NOEXCEPT
 {
     BC_ASSERT(stranded());
     const auto& query = archive();
 
     database::context context{};
-    const auto txs = query.to_txs(link);
+    auto txs = query.to_txs(link);
     if (txs.empty() || !query.get_context(context, link))
         return false;
 
-    // race_unity: last to finish with success, or first error code.
-    const auto racer = std::make_shared<race>(txs.size());
-    racer->start(BIND(handle_txs, _1, _2, link, context));
+    // Txs already connected under the context are skipped by the workers,
+    // which read each tx state in parallel (not here on the strand).
+    // Filters of the bypassed range are chained by the tip lane (from store).
+    const auto neutrino = !history && query.neutrino_enabled();
+    const auto work = std::make_shared<batch>(link, context, std::move(txs),
+        neutrino, history);
 
+    // The history lane runs both stages on its own threadpool.
+    if (history)
+    {
+        history_backlog_ += work->txs.size();
+        distribute(history_pool_, work, &chaser_validate::populate_batch);
+        return true;
+    }
+
+    backlog_ += work->txs.size();
+    shares().set_backlog(backlog_, maximum_backlog_);
     fire(events::block_buffered, context.height);
-    for (auto tx = txs.begin(); !closed() && tx != txs.end(); ++tx)
-        boost::asio::post(threadpool_.service(),
-            std::bind(&chaser_validate::validate_tx,
-                this, context, *tx, racer));
+
+    // Prevouts of the backlog are populated ahead of script validation, so
+    // that store reads for later blocks overlap scripts of earlier blocks.
+    if (is_zero(populators_))
+        distribute(threadpool_, work, &chaser_validate::validate_batch);
+    else
+        distribute(populate_pool_, work, &chaser_validate::populate_batch);
 
     return true;
 }
 
-// START WORK UNIT
-void chaser_validate::validate_tx(const database::context& context,
-    const tx_link& link, const race::ptr& racer) NOEXCEPT
+// One job per worker (up to one per chunk), each claims chunks until the
+// batch is exhausted. This balances load without a job per transaction.
+void chaser_validate::distribute(network::threadpool& pool,
+    const batch::ptr& work, stage method) NOEXCEPT
 {
-    if (closed())
+    const auto workers = (&pool == &threadpool_) ? shares().validate() :
+        ((&pool == &history_pool_) ? historians_ : populators_);
+    const auto jobs = std::min(workers,
+        ceilinged_divide(work->txs.size(), chunk));
+
+    // Stage completion (or enqueue) happens-before these posts.
+    work->next.store(zero);
+    work->pending.store(jobs);
+
+    for (size_t job = 0; !closed() && job < jobs; ++job)
+        boost::asio::post(pool.service(), std::bind(method, this, work));
+}
+
+network::threadpool& chaser_validate::script_pool(const batch& work) NOEXCEPT
+{
+    return work.history ? history_pool_ : threadpool_;
+}
+
+// static
+void chaser_validate::set_failure(batch& work, const code& ec,
+    const tx_link& link) NOEXCEPT
+{
+    // Non-validation codes must not be lost behind the first error.
+    if (ec == error::store_integrity || ec == database::error::integrity)
+        work.faulted.store(true);
+
+    // Capture the first error only, visible to the last finisher.
+    if (!work.failed.exchange(true))
     {
-        POST(handle_tx, network::error::service_stopped, link, racer);
-        return;
+        work.ec = ec;
+        work.tx = link;
+    }
+
+    // A failed batch is no longer worth claiming by other workers.
+    work.next.store(work.txs.size());
+}
+
+// START WORK UNIT (populate stage)
+void chaser_validate::populate_batch(const batch::ptr& work) NOEXCEPT
+{
+    code ec{};
+    tx_link link{};
+    const auto count = work->txs.size();
+    const auto start = tracer().now();
+
+    for (auto index = work->next.fetch_add(chunk); !ec && index < count;
+        index = work->next.fetch_add(chunk))
+    {
+        const auto end = std::min(index + chunk, count);
+        for (; !ec && index < end; ++index)
+        {
+            link = work->txs.at(index);
+            auto& tx = work->transactions.at(index);
+            ec = populate_tx(work->context, link, tx);
+        }
+    }
+
+    tracer().record(span_tracer::span::populate, start,
+        work->context.height);
+
+    if (ec)
+        set_failure(*work, ec, link);
+
+    // The last populator starts script validation, unless failed.
+    if (work->pending.fetch_sub(one) == one)
+    {
+        if (work->failed.load())
+            POST(handle_txs, work);
+        else
+            distribute(script_pool(*work), work,
+                &chaser_validate::validate_batch);
+    }
+}
+
+// START WORK UNIT (script stage)
+void chaser_validate::validate_batch(const batch::ptr& work) NOEXCEPT
+{
+    code ec{};
+    tx_link link{};
+    uint64_t fees{};
+    size_t sigops{};
+    auto partial = false;
+    const auto count = work->txs.size();
+    const auto pipelined = work->history || !is_zero(populators_);
+    const auto start = tracer().now();
+
+    for (auto index = work->next.fetch_add(chunk); !ec && index < count;
+        index = work->next.fetch_add(chunk))
+    {
+        const auto end = std::min(index + chunk, count);
+
+        // Accept the whole chunk before connecting any of it, so that cheap
+        // contextual failures precede signature verification and the script
+        // checks of the chunk execute as one contiguous pass.
+        for (auto at = index; !ec && at < end; ++at)
+        {
+            link = work->txs.at(at);
+            auto& tx = work->transactions.at(at);
+            if (!pipelined && ((ec = populate_tx(work->context, link, tx))))
+                continue;
+
+            if (tx)
+                ec = accept_tx(*work, link, *tx);
+        }
+
+        for (auto at = index; !ec && at < end; ++at)
+        {
+            link = work->txs.at(at);
+            auto& tx = work->transactions.at(at);
+
+            // A tx connected before this validation has no cached totals.
+            if (!tx)
+            {
+                partial = true;
+                continue;
+            }
+
+            uint64_t fee{};
+            size_t tx_sigops{};
+            if (!((ec = connect_tx(*work, link, *tx, fee, tx_sigops))))
+            {
+                fees = ceilinged_add(fees, fee);
+                sigops = ceilinged_add(sigops, tx_sigops);
+            }
+
+            // Release the populated tx as soon as it is validated, unless it
+            // is retained for computation of the block's neutrino filter.
+            if (!work->neutrino)
+                tx.reset();
+        }
+    }
+
+    // One atomic update per job, not per tx.
+    work->fees.fetch_add(fees);
+    work->sigops.fetch_add(sigops);
+    if (partial)
+        work->partial.store(true);
+
+    tracer().record(span_tracer::span::validate_tx, start,
+        work->context.height);
+
+    if (ec)
+        set_failure(*work, ec, link);
+
+    // FINISH WORK UNIT
+    // The last worker to finish completes the block on the strand. The filter
+    // body is independent of other blocks so is computed here, off strand.
+    if (work->pending.fetch_sub(one) == one)
+    {
+        if (work->neutrino && !work->failed.load() &&
+            !compute_neutrino(*work))
+            set_failure(*work, error::store_integrity, {});
+
+        POST(handle_txs, work);
     }
+}
+
+// Obtains the tx with populated prevouts, or null if already connected.
+code chaser_validate::populate_tx(const database::context& context,
+    const tx_link& link, transaction::cptr& tx) NOEXCEPT
+{
+    if (closed())
+        return network::error::service_stopped;
 
     auto& query = archive();
-    auto ec = query.get_tx_state(link, context);
+    const auto ec = query.get_tx_state(link, context);
 
     // These states bypass validation.
+    if (ec == database::error::tx_connected)
+        return error::success;
+
     if (ec == database::error::integrity ||
-        ec == database::error::tx_connected ||
         ec == database::error::tx_disconnected)
-    {
-        POST(handle_tx, ec, link, racer);
-        return;
-    }
+        return ec;
 
     // These other states imply validation is required.
     //// database::error::tx_preconnected
     //// database::error::unknown_state
     //// database::error::unvalidated
 
-    const chain::context ctx
-    {
-        context.flags,  // [accept & connect]
-        {},             // timestamp
-        {},             // mtp
-        context.height, // [accept]
-        {},             // minimum_block_version
-        {}              // work_required
-    };
-
-    const auto set_connected = [&query, &ctx, &link, &context](
-        const transaction& tx) NOEXCEPT
+    const auto ptr = query.get_transaction(link);
+    if (!ptr)
+        return error::store_integrity;
+
+    // Recently archived outputs avoid store lookups, remainder from store.
+    if (!prevouts().populate(*ptr) && !query.populate(*ptr))
     {
-        const auto bip16 = ctx.is_enabled(flags::bip16_rule);
-        const auto bip141 = ctx.is_enabled(flags::bip141_rule);
-        const auto sigops = tx.signature_operations(bip16, bip141);
+        fire(events::tx_invalidated, context.height);
+        return query.set_tx_disconnected(link, context) ?
+            system::error::missing_previous_output : error::store_integrity;
+    }
 
-        // TODO: cache fee and sigops from validation stage.
-        return query.set_tx_connected(link, context, tx.fee(), sigops) ?
-            error::success : error::store_integrity;
-    };
+    tx = ptr;
+    return error::success;
+}
 
-    const auto set_disconnected = [&query, &link, &context](
-        const code& invalid) NOEXCEPT
-    {
-        return query.set_tx_disconnected(link, context) ? invalid :
-            error::store_integrity;
-    };
+code chaser_validate::accept_tx(const batch& work, const tx_link& link,
+    const transaction& tx) NOEXCEPT
+{
+    if (closed())
+        return network::error::service_stopped;
 
-    code invalid{};
-    const auto tx = query.get_transaction(link);
-    if (!tx)
-    {
-        ec = error::store_integrity;
-    }
-    else if (!query.populate(*tx))
-    {
-        ec = set_disconnected(system::error::missing_previous_output);
-        fire(events::tx_invalidated, ctx.height);
-    }
-    else if (((invalid = tx->accept(ctx))) || ((invalid = tx->connect(ctx))))
-    {
-        ec = set_disconnected(invalid);
-        fire(events::tx_invalidated, ctx.height);
+    const auto invalid = tx.accept(work.rules);
+    return invalid ? set_invalid(work.context, link, tx, invalid) : invalid;
+}
 
-        LOGR("Invalid tx [" << encode_hash(tx->hash(false)) << "] in block ("
-            << ctx .height << ") " << invalid.message());
-    }
-    else
+// Fee and sigops are computed once, stored and returned for block totals.
+// Scripts of txs verified by pool admission under the same flags are not
+// executed again, which is most of a block at the current chain tip.
+code chaser_validate::connect_tx(const batch& work, const tx_link& link,
+    const transaction& tx, uint64_t& fee, size_t& sigops) NOEXCEPT
+{
+    if (closed())
+        return network::error::service_stopped;
+
+    const auto& context = work.context;
+    const auto& cache = scripts();
+    if (!cache.enabled() || !cache.contains(tx.hash(true), context.flags))
     {
-        ec = set_connected(*tx);
+        if (const auto invalid = tx.connect(work.rules))
+            return set_invalid(context, link, tx, invalid);
     }
 
-    POST(handle_tx, ec, link, racer);
+    sigops = tx.signature_operations(work.bip16, work.bip141);
+    fee = tx.fee();
+
+    return archive().set_tx_connected(link, context, fee, sigops) ?
+        error::success : error::store_integrity;
 }
 
-// FINISH WORK UNIT
-void chaser_validate::handle_tx(const code& ec, const tx_link& tx,
-    const race::ptr& racer) NOEXCEPT
+code chaser_validate::set_invalid(const database::context& context,
+    const tx_link& link, const transaction& LOG_ONLY(tx),
+    const code& invalid) NOEXCEPT
 {
-    BC_ASSERT(stranded());
+    fire(events::tx_invalidated, context.height);
+    LOGR("Invalid tx [" << encode_hash(tx.hash(false)) << "] in block ("
+        << context.height << ") " << invalid.message());
 
-    // handle_txs will only get invoked once, with a first error code, so
-    // invoke fault here ensure that non-validation codes are not lost.
-    if (ec == error::store_integrity || ec == database::error::integrity)
-        fault(error::node_validate);
-
-    // TODO: need to sort out bypass, validity, and fault codes.
-    // Always allow the racer to finish, invokes handle_txs exactly once.
-    racer->finish(ec, tx);
+    return archive().set_tx_disconnected(link, context) ? invalid :
+        error::store_integrity;
 }
 
 // SYNCHRONIZE WORK UNITS
-void chaser_validate::handle_txs(const code& ec, const tx_link& tx,
-    const header_link& link, const database::context& ctx) NOEXCEPT
+void chaser_validate::handle_txs(const batch::ptr& work) NOEXCEPT
 {
     BC_ASSERT(stranded());
+
+    if (work->history)
+    {
+        const auto resume = (history_backlog_ >= maximum_backlog_);
+        history_backlog_ -= work->txs.size();
+
+        if (work->faulted.load())
+            fault(error::node_validate);
+
+        if (closed())
+            return;
+
+        validate_history(work->ec, work->link, work->context);
+        if (resume && history_backlog_ < maximum_backlog_)
+            do_history(height_t{});
+
+        return;
+    }
+
+    // Resume bump only if it was suspended by the backlog limit.
+    const auto resume = (backlog_ >= maximum_backlog_);
+    backlog_ -= work->txs.size();
+    shares().set_backlog(backlog_, maximum_backlog_);
+
+    if (work->faulted.load())
+        fault(error::node_validate);
+
     if (closed())
         return;
 
+    // TODO: need to sort out bypass, validity, and fault codes.
+    const auto& ec = work->ec;
     if (ec)
     {
         // Log tx here as it's the first failed one.
-        LOG_ONLY(const auto hash = encode_hash(archive().get_tx_key(tx));)
+        LOG_ONLY(const auto hash = encode_hash(archive().get_tx_key(work->tx));)
         LOGR("Error validating tx [" << hash << "] " << ec.message());
     }
 
-    validate_block(ec, link, ctx);
+    validate_block(ec, work->link, work->context,
+        work->partial.load() ? max_uint64 : work->fees.load(),
+        work->sigops.load(), std::move(work->filter));
+
+    if (resume && backlog_ < maximum_backlog_)
+        do_bump(height_t{});
 }
 
 // SUMMARIZE WORK
+// Fees are max_uint64 if any tx was validated before the block.
 void chaser_validate::validate_block(const code& ec,
-    const header_link& link, const database::context& ctx) NOEXCEPT
+    const header_link& link, const database::context& ctx, uint64_t fees,
+    size_t LOG_ONLY(sigops), data_chunk&& filter) NOEXCEPT
 {
     BC_ASSERT(stranded());
     auto& query = archive();
@@ -374,13 +728,43 @@ void chaser_validate::validate_block(const code& ec,
         return;
     }
 
-    // TODO: collect fees and sigops for block validate with no block.
+    // Retain fees for confirmation, before notifying valid.
+    if (fees != max_uint64)
+        set_fees(link, ctx.height, fees);
+
+    // Filter headers are chained in height order as validations complete.
+    chain_neutrino(ctx.height, link, std::move(filter));
 
     // fire event first so that log is ordered.
     fire(events::block_validated, ctx.height);
+    metrics().set(metrics_registry::gauge::validated_height, ctx.height);
     notify(ec, chase::valid, ctx.height);
 
-    LOGV("Block.txs accepted and connected: " << ctx.height);
+    LOGV("Block.txs accepted and connected: " << ctx.height << " fees ("
+        << fees << ") sigops (" << sigops << ")");
+}
+
+// A bypassed block is confirmed on the strength of the milestone (or
+// checkpoint), so its failure implies the configured commitment is invalid.
+void chaser_validate::validate_history(const code& ec,
+    const header_link& link, const database::context& ctx) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (ec)
+    {
+        LOGF("Invalid bypassed block [" << ctx.height << "] " << ec.message());
+        fault(error::node_validate);
+        return;
+    }
+
+    if (!archive().set_block_valid(link))
+    {
+        fault(error::set_block_valid);
+        return;
+    }
+
+    LOGV("Bypassed block validated: " << ctx.height);
 }
 
 // neutrino
@@ -401,48 +785,92 @@ hash_digest chaser_validate::get_neutrino(size_t height) const NOEXCEPT
     return neutrino;
 }
 
-// This can only fail if block missing or prevouts are not fully populated.
-bool chaser_validate::update_neutrino(const header_link& link) NOEXCEPT
+// Computes the filter body from the validated (populated) transactions.
+// Txs that were connected before this validation are populated here.
+bool chaser_validate::compute_neutrino(batch& work) NOEXCEPT
 {
-    const auto& query = archive();
-    if (!query.neutrino_enabled())
-        return true;
+    auto& query = archive();
+    for (size_t index = 0; index < work.txs.size(); ++index)
+    {
+        auto& tx = work.transactions.at(index);
+        if (!tx)
+        {
+            tx = query.get_transaction(work.txs.at(index));
+            if (!tx || (!prevouts().populate(*tx) && !query.populate(*tx)))
+                return false;
+        }
+    }
 
-    // Avoid computing the filter if already stored.
-    if (!query.to_filter(link).is_terminal())
-        return true;
+    const auto header = query.get_header(work.link);
+    if (!header)
+        return false;
 
+    const auto txs = to_shared<transaction_cptrs>(std::move(work.transactions));
+    return compute_filter(work.filter, chain::block{ header, txs });
+}
+
+// Computes the filter body from the store (block not validated here).
+bool chaser_validate::compute_neutrino(data_chunk& body,
+    const header_link& link) NOEXCEPT
+{
+    const auto& query = archive();
     const auto block_ptr = query.get_block(link);
     if (!block_ptr)
         return false;
 
     const auto& block = *block_ptr;
-    return query.populate(block) && update_neutrino(link, block);
+    return query.populate(block) && compute_filter(body, block);
 }
 
-// This can only fail if prevouts are not fully populated.
-bool chaser_validate::update_neutrino(const header_link& link,
-    const chain::block& block) NOEXCEPT
+// Also called from start, before subscription (not stranded).
+void chaser_validate::reset_neutrino(height_t height) NOEXCEPT
 {
-    auto& query = archive();
-    if (!query.neutrino_enabled())
-        return true;
-
-    data_chunk filter{};
-    if (!compute_filter(filter, block))
-        return false;
-
-    neutrino_ = compute_filter_header(neutrino_, filter);
-    return query.set_filter(link, neutrino_, filter);
+    filters_.erase(filters_.upper_bound(height), filters_.end());
+    neutrino_ = get_neutrino(height);
+    filtered_ = height;
 }
 
-// position
-// ----------------------------------------------------------------------------
-
-void chaser_validate::update_position(size_t height) NOEXCEPT
+// Filter bodies arrive out of order, headers are chained in order (cheap).
+void chaser_validate::chain_neutrino(height_t height, const header_link& link,
+    data_chunk&& body) NOEXCEPT
 {
-    set_position(height);
-    neutrino_ = get_neutrino(position());
+    BC_ASSERT(stranded());
+    auto& query = archive();
+    if (!query.neutrino_enabled() || height <= filtered_)
+        return;
+
+    filters_[height] = { link, std::move(body) };
+    for (auto it = filters_.begin(); it != filters_.end() &&
+        it->first == add1(filtered_); it = filters_.erase(it))
+    {
+        auto& next = it->second;
+        if (!query.to_filter(next.link).is_terminal())
+        {
+            // Avoid computing the filter if already stored.
+            if (!query.get_filter_head(neutrino_, next.link))
+            {
+                fault(error::node_validate);
+                return;
+            }
+        }
+        else
+        {
+            if (next.body.empty() && !compute_neutrino(next.body, next.link))
+            {
+                fault(error::node_validate);
+                return;
+            }
+
+            neutrino_ = compute_filter_header(neutrino_, next.body);
+            if (!query.set_filter(next.link, neutrino_, next.body))
+            {
+                fault(error::node_validate);
+                return;
+            }
+        }
+
+        ++filtered_;
+    }
 }
 
 BC_POP_WARNING()
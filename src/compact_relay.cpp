@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/compact_relay.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace system::chain;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+constexpr auto short_id_size = array_count<compact_relay::short_id>;
+constexpr auto short_id_mask = sub1(power2<uint64_t>(to_bits(short_id_size)));
+
+siphash_key compact_relay::to_key(const header& header,
+    uint64_t nonce) NOEXCEPT
+{
+    const auto digest = sha256_hash(splice(header.to_data(),
+        to_little_endian(nonce)));
+
+    half_hash half{};
+    std::copy_n(digest.begin(), half.size(), half.begin());
+    return to_siphash_key(half);
+}
+
+compact_relay::short_id compact_relay::to_short_id(const siphash_key& key,
+    const hash_digest& wtxid) NOEXCEPT
+{
+    const auto value = to_little_endian(siphash(key, wtxid) & short_id_mask);
+
+    short_id out{};
+    std::copy_n(value.begin(), out.size(), out.begin());
+    return out;
+}
+
+compact_relay::short_ids compact_relay::to_short_ids(const block& block,
+    uint64_t nonce) NOEXCEPT
+{
+    const auto& txs = *block.transactions_ptr();
+    if (txs.empty())
+        return {};
+
+    short_ids out{};
+    out.reserve(sub1(txs.size()));
+    const auto key = to_key(block.header(), nonce);
+    std::for_each(std::next(txs.begin()), txs.end(),
+        [&](const auto& tx) NOEXCEPT
+        {
+            out.push_back(to_short_id(key, tx->hash(true)));
+        });
+
+    return out;
+}
+
+compact_relay::compact_relay(const header::cptr& header, uint64_t nonce,
+    const short_ids& ids, const prefills& prefilled) NOEXCEPT
+  : header_(header),
+    hash_(header->hash()),
+    key_(to_key(*header, nonce)),
+    txs_(ids.size() + prefilled.size())
+{
+    collided_.resize(txs_.size());
+    for (const auto& [index, tx]: prefilled)
+    {
+        if (index >= txs_.size() || !tx || txs_.at(index))
+            return;
+
+        txs_.at(index) = tx;
+    }
+
+    // Short ids fill remaining slots in order.
+    size_t slot{};
+    for (const auto& id: ids)
+    {
+        while (txs_.at(slot))
+            ++slot;
+
+        if (!slots_.emplace(to_number(id), slot++).second)
+            return;
+    }
+
+    valid_ = true;
+}
+
+bool compact_relay::is_valid() const NOEXCEPT
+{
+    return valid_;
+}
+
+const hash_digest& compact_relay::hash() const NOEXCEPT
+{
+    return hash_;
+}
+
+void compact_relay::match(const transaction::cptr& tx) NOEXCEPT
+{
+    const auto it = slots_.find(to_number(to_short_id(key_, tx->hash(true))));
+    if (it == slots_.end() || collided_.at(it->second))
+        return;
+
+    auto& slot = txs_.at(it->second);
+    if (!slot)
+    {
+        slot = tx;
+        return;
+    }
+
+    // Two candidates for one short id, the slot must be requested.
+    if (slot->hash(true) != tx->hash(true))
+    {
+        slot.reset();
+        collided_.at(it->second) = true;
+    }
+}
+
+compact_relay::indexes compact_relay::missing() const NOEXCEPT
+{
+    indexes out{};
+    for (size_t index = 0; index < txs_.size(); ++index)
+        if (!txs_.at(index))
+            out.push_back(index);
+
+    return out;
+}
+
+bool compact_relay::fill(const transaction_cptrs& txs) NOEXCEPT
+{
+    const auto unfilled = missing();
+    if (unfilled.size() != txs.size())
+        return false;
+
+    for (size_t index = 0; index < txs.size(); ++index)
+    {
+        if (!txs.at(index))
+            return false;
+
+        txs_.at(unfilled.at(index)) = txs.at(index);
+    }
+
+    return true;
+}
+
+block::cptr compact_relay::to_block() const NOEXCEPT
+{
+    if (!valid_ || std::any_of(txs_.begin(), txs_.end(),
+        [](const auto& tx) NOEXCEPT { return !tx; }))
+        return {};
+
+    return std::make_shared<const block>(header_,
+        std::make_shared<const transaction_cptrs>(txs_));
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+uint64_t compact_relay::to_number(const short_id& id) NOEXCEPT
+{
+    uint64_t value{};
+    for (size_t byte = 0; byte < id.size(); ++byte)
+        value |= uint64_t{ id.at(byte) } << to_bits(byte);
+
+    return value;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/download_budget.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace network;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_STATIC_CAST)
+
+// The bucket holds one second of budget, which is also the frontier overdraft.
+download_budget::download_budget(uint64_t bytes_per_second) NOEXCEPT
+  : rate_(static_cast<double>(bytes_per_second)),
+    balance_(rate_),
+    updated_(steady_clock::now())
+{
+}
+
+bool download_budget::enabled() const NOEXCEPT
+{
+    return rate_ > 0.0;
+}
+
+void download_budget::set_frontier(size_t height) NOEXCEPT
+{
+    frontier_.store(height, std::memory_order_relaxed);
+}
+
+size_t download_budget::frontier() const NOEXCEPT
+{
+    return frontier_.load(std::memory_order_relaxed);
+}
+
+void download_budget::consume(uint64_t bytes) NOEXCEPT
+{
+    if (!enabled())
+        return;
+
+    std::unique_lock lock(mutex_);
+    refill();
+    balance_ -= static_cast<double>(bytes);
+}
+
+steady_clock::duration download_budget::delay(size_t height) NOEXCEPT
+{
+    if (!enabled())
+        return {};
+
+    const auto frontier = frontier_.load(std::memory_order_relaxed);
+    const auto floor = height <= ceilinged_add(frontier, frontier_blocks) ?
+        -rate_ : 0.0;
+
+    std::unique_lock lock(mutex_);
+    refill();
+    if (balance_ >= floor)
+        return {};
+
+    return std::chrono::duration_cast<steady_clock::duration>(
+        std::chrono::duration<double>((floor - balance_) / rate_));
+}
+
+// private
+void download_budget::refill() NOEXCEPT
+{
+    const auto now = steady_clock::now();
+    const std::chrono::duration<double> elapsed{ now - updated_ };
+    balance_ = std::min(rate_, balance_ + elapsed.count() * rate_);
+    updated_ = now;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
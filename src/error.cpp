@@ -36,6 +36,17 @@ DEFINE_ERROR_T_MESSAGE_MAP(error)
     { store_uninitialized, "store not initialized" },
     { store_reload, "store reload" },
     { store_snapshot, "store snapshot" },
+    { store_archive, "store archive" },
+    { store_bootstrap, "store bootstrap" },
+    { store_sibling, "store sibling" },
+    { header_archive, "header archive" },
+    { header_commitment, "header commitment" },
+
+    // mempool
+    { pool_duplicate, "pool duplicate" },
+    { pool_conflict, "pool conflict" },
+    { pool_package, "pool package limit" },
+    { pool_full, "pool full" },
 
     // network
     { slow_channel, "slow channel" },
@@ -44,6 +55,9 @@ DEFINE_ERROR_T_MESSAGE_MAP(error)
     { sacrificed_channel, "sacrificed channel" },
     { suspended_channel, "sacrificed channel" },
     { suspended_service, "sacrificed service" },
+    { metrics_bind, "metrics bind" },
+    { query_bind, "query bind" },
+    { template_bind, "template bind" },
 
     // blockchain
     { orphan_block, "orphan block" },
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/event_bus.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+
+event_bus::shard::shard(network::asio::io_context& service) NOEXCEPT
+  : strand(service.get_executor()),
+    subscriber(strand)
+{
+}
+
+event_bus::event_bus(network::asio::io_context& service,
+    size_t shards) NOEXCEPT
+  : shards_(make_shards(service, std::max(shards, one)))
+{
+}
+
+void event_bus::subscribe(event_notifier&& handler, event_topics topics,
+    object_key key, event_completer&& complete) NOEXCEPT
+{
+    auto& to = to_shard(key);
+    to.topics.fetch_or(topics, std::memory_order_relaxed);
+    boost::asio::post(to.strand,
+        std::bind(&event_bus::do_subscribe, std::ref(to),
+            std::move(handler), topics, key, std::move(complete)));
+}
+
+// A shard without a subscriber to the topic is not visited.
+void event_bus::notify(const code& ec, chase event_, event_value value,
+    const event_payload& payload) NOEXCEPT
+{
+    for (const auto& to: shards_)
+    {
+        if (is_topic(to->topics.load(std::memory_order_relaxed), event_))
+        {
+            boost::asio::post(to->strand,
+                std::bind(&event_bus::do_notify, std::ref(*to),
+                    ec, event_, value, payload));
+        }
+    }
+}
+
+void event_bus::notify_one(object_key key, const code& ec, chase event_,
+    event_value value) NOEXCEPT
+{
+    auto& to = to_shard(key);
+    boost::asio::post(to.strand,
+        std::bind(&event_bus::do_notify_one, std::ref(to),
+            key, ec, event_, value));
+}
+
+void event_bus::stop(const code& ec) NOEXCEPT
+{
+    for (const auto& to: shards_)
+    {
+        boost::asio::post(to->strand,
+            std::bind(&event_bus::do_stop, std::ref(*to), ec));
+    }
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+event_bus::shards event_bus::make_shards(network::asio::io_context& service,
+    size_t count) NOEXCEPT
+{
+    shards out{};
+    out.reserve(count);
+    for (size_t index = 0; index < count; ++index)
+        out.push_back(std::make_unique<shard>(service));
+
+    return out;
+}
+
+event_bus::shard& event_bus::to_shard(object_key key) const NOEXCEPT
+{
+    return *shards_.at(key % shards_.size());
+}
+
+// Events outside of the subscribed topics are skipped, retaining the handler.
+void event_bus::do_subscribe(shard& to, const event_notifier& handler,
+    event_topics topics, object_key key,
+    const event_completer& complete) NOEXCEPT
+{
+    BC_ASSERT(to.strand.running_in_this_thread());
+
+    auto filtered = [topics, handler](const code& ec, chase event_,
+        event_value value, const event_payload& payload) NOEXCEPT
+    {
+        if (event_ != chase::stop && !is_topic(topics, event_))
+            return true;
+
+        return handler(ec, event_, value, payload);
+    };
+
+    complete(to.subscriber.subscribe(std::move(filtered), key), key);
+}
+
+void event_bus::do_notify(shard& to, const code& ec, chase event_,
+    event_value value, const event_payload& payload) NOEXCEPT
+{
+    BC_ASSERT(to.strand.running_in_this_thread());
+    to.subscriber.notify(ec, event_, value, payload);
+}
+
+void event_bus::do_notify_one(shard& to, object_key key, const code& ec,
+    chase event_, event_value value) NOEXCEPT
+{
+    BC_ASSERT(to.strand.running_in_this_thread());
+    to.subscriber.notify_one(key, ec, event_, value, {});
+}
+
+void event_bus::do_stop(shard& to, const code& ec) NOEXCEPT
+{
+    BC_ASSERT(to.strand.running_in_this_thread());
+    to.subscriber.stop(ec, chase::stop, {}, {});
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/event_log.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+using buffer = std::array<uint8_t, event_log::record_size>;
+constexpr size_t value_offset = 0;
+constexpr size_t time_offset = sizeof(uint64_t);
+constexpr size_t event_offset = time_offset + sizeof(uint32_t);
+
+template <typename Integer>
+static void put(buffer& out, size_t offset, Integer value) NOEXCEPT
+{
+    for (size_t byte = 0; byte < sizeof(Integer); ++byte)
+        out[offset + byte] = narrow_cast<uint8_t>(value >> to_bits(byte));
+}
+
+template <typename Integer>
+static Integer get(const buffer& in, size_t offset) NOEXCEPT
+{
+    Integer value{};
+    for (size_t byte = 0; byte < sizeof(Integer); ++byte)
+        value |= static_cast<Integer>(Integer{ in[offset + byte] } <<
+            to_bits(byte));
+
+    return value;
+}
+
+void event_log::write(std::ostream& sink, const record& record) NOEXCEPT
+{
+    buffer out{};
+    put(out, value_offset, record.value);
+    put(out, time_offset, record.milliseconds);
+    out[event_offset] = record.event;
+    sink.write(pointer_cast<const char>(out.data()), out.size());
+}
+
+bool event_log::read(std::istream& source, record& out) NOEXCEPT
+{
+    buffer in{};
+    source.read(pointer_cast<char>(in.data()), in.size());
+    if (source.gcount() != static_cast<std::streamsize>(in.size()))
+        return false;
+
+    out.value = get<uint64_t>(in, value_offset);
+    out.milliseconds = get<uint32_t>(in, time_offset);
+    out.event = in[event_offset];
+    return true;
+}
+
+event_log::rates event_log::aggregate(std::istream& source,
+    uint32_t period) NOEXCEPT
+{
+    rates out{};
+    record record{};
+    const auto divisor = std::max(period, 1_u32);
+    while (read(source, record))
+    {
+        const size_t interval = record.milliseconds / divisor;
+        auto& counts = out[record.event];
+        if (counts.size() <= interval)
+            counts.resize(add1(interval));
+
+        ++counts[interval];
+    }
+
+    return out;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/filter_checkpoints.hpp>
+
+#include <mutex>
+#include <bitcoin/database.hpp>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+filter_checkpoints::filter_checkpoints(query& query) NOEXCEPT
+  : query_(query)
+{
+}
+
+bool filter_checkpoints::get(hashes& out, size_t height) NOEXCEPT
+{
+    const auto count = height / interval;
+
+    std::unique_lock lock(mutex_);
+    while (!entries_.empty() &&
+        !query_.is_confirmed_block(entries_.back().link))
+        entries_.pop_back();
+
+    while (entries_.size() < count)
+    {
+        entry next{ query_.to_confirmed(add1(entries_.size()) * interval), {} };
+        if (next.link.is_terminal() ||
+            !query_.get_filter_head(next.head, next.link))
+            return false;
+
+        entries_.push_back(std::move(next));
+    }
+
+    out.clear();
+    out.reserve(count);
+    for (size_t index = 0; index < count; ++index)
+        out.push_back(entries_.at(index).head);
+
+    return true;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
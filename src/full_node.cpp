@@ -18,25 +18,80 @@
  */
 #include <bitcoin/node/full_node.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/chasers/chasers.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/sessions/sessions.hpp>
+#include <bitcoin/node/startup_manifest.hpp>
+#include <bitcoin/node/thread_affinity.hpp>
 
 namespace libbitcoin {
 namespace node {
 
 using namespace system;
 using namespace network;
+using namespace std::chrono;
+using namespace std::placeholders;
 
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
+// Header download ranges are bounded by checkpoints and a higher milestone.
+static chain::checkpoints range_bounds(const system::settings& settings)
+{
+    auto bounds = settings.sorted_checkpoints();
+    const auto& milestone = settings.milestone;
+    if (milestone.hash() != null_hash && (bounds.empty() ||
+        milestone.height() > bounds.back().height()))
+        bounds.push_back(milestone);
+
+    return bounds;
+}
+
 // p2p::strand() is safe to call from constructor (non-virtual).
 full_node::full_node(query& query, const configuration& configuration,
     const logger& log) NOEXCEPT
   : p2p(configuration.network, log),
     config_(configuration),
     query_(query),
+    prevouts_(configuration.node.prevout_bytes),
+    blocks_(configuration.node.block_cache_bytes),
+    headers_(),
+    checkpointed_filters_(query),
+    scores_(configuration.network.host_pool_capacity),
+    budget_(configuration.node.download_bytes_per_second),
+    memory_(configuration.node.memory_bytes),
+    scripts_(configuration.node.script_cache_entries),
+    work_(configuration.node.cumulative_work),
+    shares_(configuration.node.threads, configuration.node.check_threads,
+        configuration.node.auto_scale),
+    check_pool_(shares_.check_capacity()),
+    ranges_(range_bounds(configuration.bitcoin),
+        [this](chain::header_cptrs&& headers,
+            organize_handler&& handler) NOEXCEPT
+        {
+            organize(std::move(headers), std::move(handler));
+        }),
+    announced_blocks_(two * network::messages::max_get_blocks,
+        [this](const chain::block::cptr& block,
+            organize_handler&& handler) NOEXCEPT
+        {
+            organize(block, std::move(handler));
+        }),
+    claims_(network::messages::max_inventory),
+    seen_(configuration.node.seen_headers),
+    bus_(service(), configuration.node.event_shards),
+    metrics_server_(service(), [this]() NOEXCEPT
+    {
+        return metrics_.report();
+    }),
+    query_server_(query, configuration.node.query_threads,
+        configuration.node.query_connections),
+    template_server_(query, configuration.node.template_connections),
+    tracer_(configuration.node.trace_spans),
     chaser_block_(*this),
     chaser_header_(*this),
     chaser_check_(*this),
@@ -46,8 +101,30 @@ full_node::full_node(query& query, const configuration& configuration,
     chaser_template_(*this),
     chaser_snapshot_(*this),
     chaser_storage_(*this),
+    chaser_audit_(*this),
     event_subscriber_(strand())
 {
+    // Chasers are friends of full_node, so each is assigned its monitor.
+    if (config_.node.instrument_strands)
+    {
+        using strand = metrics_registry::strand;
+        monitor_ = &metrics_.strand_at(strand::node);
+        chaser_header_.monitor_ = &metrics_.strand_at(strand::header);
+        chaser_block_.monitor_ = &metrics_.strand_at(strand::block);
+        chaser_check_.monitor_ = &metrics_.strand_at(strand::check);
+        chaser_validate_.monitor_ = &metrics_.strand_at(strand::validate);
+        chaser_confirm_.monitor_ = &metrics_.strand_at(strand::confirm);
+        chaser_transaction_.monitor_ = &metrics_.strand_at(strand::transaction);
+        chaser_template_.monitor_ = &metrics_.strand_at(strand::template_);
+        chaser_snapshot_.monitor_ = &metrics_.strand_at(strand::snapshot);
+        chaser_storage_.monitor_ = &metrics_.strand_at(strand::storage);
+        chaser_audit_.monitor_ = &metrics_.strand_at(strand::audit);
+    }
+
+    // Caches are enrolled first, so they are the first to be shrunk.
+    memory_.enroll("blocks", [this]() NOEXCEPT { return blocks_.bytes(); },
+        [this](uint64_t excess) NOEXCEPT { blocks_.trim(excess); });
+    memory_.enroll("prevouts", [this]() NOEXCEPT { return prevouts_.bytes(); });
 }
 
 full_node::~full_node() NOEXCEPT
@@ -65,6 +142,8 @@ void full_node::start(result_handler&& handler) NOEXCEPT
         return;
     }
 
+    bind_pools();
+
     // Base (p2p) invokes do_start().
     p2p::start(std::move(handler));
 }
@@ -85,10 +164,31 @@ void full_node::do_start(const result_handler& handler) NOEXCEPT
         chaser_template_.stopping(ec);
         chaser_snapshot_.stopping(ec);
         chaser_storage_.stopping(ec);
+        chaser_audit_.stopping(ec);
         return false;
     });
 
-    if (((ec = (config().node.headers_first ?
+    // Headers between checkpoints are partitioned across channels.
+    if (config().node.headers_first && config().node.parallel_headers)
+    {
+        const auto top = query_.get_top_candidate();
+        const auto hash = query_.get_header_key(query_.to_candidate(top));
+        ranges_.start({ hash, top });
+    }
+
+    // Chaser positions saved on clean shutdown avoid rescanning the store.
+    if (config().node.warm_start)
+        load_manifest();
+
+    // Peer scores are retained across restarts (missing on first start).
+    if (!config().network.path.empty())
+        scores_.load(scores_file());
+
+    const auto start = logger::now();
+    if (((ec = metrics_server_.start(config().node.metrics_port))) ||
+        ((ec = query_server_.start(config().node.query_port))) ||
+        ((ec = template_server_.start(config().node.template_port))) ||
+        ((ec = (config().node.headers_first ?
             chaser_header_.start() :
             chaser_block_.start()))) ||
         ((ec = chaser_check_.start())) ||
@@ -97,12 +197,23 @@ void full_node::do_start(const result_handler& handler) NOEXCEPT
         ((ec = chaser_transaction_.start())) ||
         ((ec = chaser_template_.start())) ||
         ((ec = chaser_snapshot_.start())) ||
-        ((ec = chaser_storage_.start())))
+        ((ec = chaser_storage_.start())) ||
+        ((ec = chaser_audit_.start())))
     {
         handler(ec);
         return;
     }
 
+    // Templates are pushed from the event bus, not the node strand.
+    if (!is_zero(config().node.template_port))
+        do_subscribe_events(
+            std::bind(&full_node::handle_template, this, _1, _2, _3, _4),
+            to_topics(chase::template_),
+            [](const code&, object_key) NOEXCEPT {});
+
+    // Chaser start scans the store, which delays the first connection.
+    const auto span = duration_cast<milliseconds>(logger::now() - start);
+    LOGN("Chasers started in " << span.count() << " ms.");
     p2p::do_start(handler);
 }
 
@@ -124,22 +235,54 @@ void full_node::do_run(const result_handler& handler) NOEXCEPT
 
     // Bump sequential chasers to their starting heights.
     // This will kick off lagging validations even if not current.
-    do_notify(error::success, chase::start, height_t{});
+    do_notify(error::success, chase::start, height_t{}, {});
 
     p2p::do_run(handler);
+    connect_preferred();
 }
 
 void full_node::close() NOEXCEPT
 {
     // Base (p2p) invokes do_close().
     p2p::close();
+
+    // Blocks posted for check and archive are written before the store is
+    // closed, and none is written after.
+    check_pool_.stop();
+    check_pool_.join();
+
+    // Chaser work posted to chaser threads reads or writes the store.
+    chaser_header_.stopped();
+    chaser_block_.stopped();
+    chaser_check_.stopped();
+    chaser_validate_.stopped();
+    chaser_confirm_.stopped();
+    chaser_transaction_.stopped();
+    chaser_template_.stopped();
+    chaser_snapshot_.stopped();
+    chaser_storage_.stopped();
+    chaser_audit_.stopped();
+
+    // Store reads complete before the store is closed by the caller.
+    query_server_.stop();
+    template_server_.stop();
+
+    if (!config().network.path.empty() && !scores_.save(scores_file()))
+        LOGF("Failed to save peer scores.");
+
+    // Network, check and chaser threads are joined, so positions are final.
+    if (config().node.warm_start)
+        save_manifest();
 }
 
 // Base (p2p) invokes do_close().
 void full_node::do_close() NOEXCEPT
 {
     BC_ASSERT(stranded());
-    event_subscriber_.stop(network::error::service_stopped, chase::stop, {});
+    event_subscriber_.stop(network::error::service_stopped, chase::stop, {},
+        {});
+    bus_.stop(network::error::service_stopped);
+    metrics_server_.stop();
     p2p::do_close();
 }
 
@@ -152,15 +295,45 @@ void full_node::organize(const system::chain::header::cptr& header,
     chaser_header_.organize(header, std::move(handler));
 }
 
+void full_node::organize(system::chain::header_cptrs&& headers,
+    organize_handler&& handler) NOEXCEPT
+{
+    chaser_header_.organize(std::move(headers), std::move(handler));
+}
+
 void full_node::organize(const system::chain::block::cptr& block,
     organize_handler&& handler) NOEXCEPT
 {
     chaser_block_.organize(block, std::move(handler));
 }
 
-void full_node::get_hashes(map_handler&& handler) NOEXCEPT
+void full_node::organize(system::chain::block_cptrs&& blocks,
+    organize_handler&& handler) NOEXCEPT
+{
+    chaser_block_.organize(std::move(blocks), std::move(handler));
+}
+
+void full_node::store(const system::chain::transaction::cptr& tx) NOEXCEPT
+{
+    chaser_transaction_.store(tx);
+}
+
+void full_node::reconstruct(const compact_relay::ptr& relay,
+    network::result_handler&& handler) NOEXCEPT
+{
+    chaser_transaction_.reconstruct(relay, std::move(handler));
+}
+
+void full_node::get_transactions(const system::hashes& hashes,
+    transactions_handler&& handler) NOEXCEPT
+{
+    chaser_transaction_.get_transactions(hashes, std::move(handler));
+}
+
+void full_node::get_hashes(size_t count, uint64_t latency,
+    map_handler&& handler) NOEXCEPT
 {
-    chaser_check_.get_hashes(std::move(handler));
+    chaser_check_.get_hashes(count, latency, std::move(handler));
 }
 
 void full_node::put_hashes(const map_ptr& map,
@@ -169,29 +342,143 @@ void full_node::put_hashes(const map_ptr& map,
     chaser_check_.put_hashes(map, std::move(handler));
 }
 
+// Validation results.
+// ----------------------------------------------------------------------------
+
+void full_node::set_fees(const database::header_link& link, size_t height,
+    uint64_t fees) NOEXCEPT
+{
+    std::unique_lock lock(fees_mutex_);
+    fees_.emplace(height, std::make_pair(link.value, fees));
+}
+
+// Blocks are confirmed in height order, so retained fees at or below the
+// height will not be taken, and are released with the taken (or absent) fees.
+bool full_node::take_fees(uint64_t& fees, const database::header_link& link,
+    size_t height) NOEXCEPT
+{
+    std::unique_lock lock(fees_mutex_);
+    const auto [begin, end] = fees_.equal_range(height);
+    const auto it = std::find_if(begin, end, [&](const auto& value) NOEXCEPT
+    {
+        return value.second.first == link.value;
+    });
+
+    const auto found = it != end;
+    if (found)
+        fees = it->second.second;
+
+    fees_.erase(fees_.begin(), end);
+    return found;
+}
+
 // Events.
 // ----------------------------------------------------------------------------
 
+// Chasers (and sessions) are notified on the node strand, channels by the bus.
 void full_node::notify(const code& ec, chase event_,
     event_value value) NOEXCEPT
 {
-    boost::asio::post(strand(),
+    notify(ec, event_, value, {});
+}
+
+// An event with payload is not coalesced, as the payload would be lost.
+void full_node::notify(const code& ec, chase event_, event_value value,
+    const event_payload& payload) NOEXCEPT
+{
+    if (!ec && !payload && coalesce(event_, value))
+        return;
+
+    bus_.notify(ec, event_, value, payload);
+    post_strand(
         std::bind(&full_node::do_notify,
-            this, ec, event_, value));
+            this, ec, event_, value, payload));
+}
+
+// private
+// These events are handled as "up to" the value (or disregard it), so a burst
+// is delivered once at its maximum value. Others (e.g. chase::checked, whose
+// heights are tracked individually) are not merged. A coalesced event may be
+// delivered ahead of events issued after its first instance, which is no
+// different than the unordered arrival of events from concurrent issuers.
+bool full_node::coalesce(chase event_, event_value value) NOEXCEPT
+{
+    if (!config_.node.coalesce_events)
+        return false;
+
+    switch (event_)
+    {
+        case chase::download:
+        case chase::valid:
+        case chase::confirmable:
+            break;
+        default:
+            return false;
+    }
+
+    // Zero is reserved for no pending value.
+    auto& slot = coalesced_.at(static_cast<size_t>(event_));
+    auto pending = slot.value.load(std::memory_order_relaxed);
+    while (pending <= value)
+        if (slot.value.compare_exchange_weak(pending, add1(value),
+            std::memory_order_relaxed))
+            break;
+
+    if (!slot.posted.exchange(true, std::memory_order_acq_rel))
+    {
+        post_strand(
+            std::bind(&full_node::do_notify_coalesced,
+                this, event_));
+    }
+
+    return true;
+}
+
+// private
+// The flag is cleared before the value is taken, so a concurrent value is
+// either taken here or posted anew (which then may find no pending value).
+void full_node::do_notify_coalesced(chase event_) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    auto& slot = coalesced_.at(static_cast<size_t>(event_));
+    slot.posted.store(false, std::memory_order_release);
+    const auto pending = slot.value.exchange(zero, std::memory_order_acq_rel);
+    if (is_zero(pending))
+        return;
+
+    bus_.notify(error::success, event_, sub1(pending), {});
+    do_notify(error::success, event_, sub1(pending), {});
 }
 
 // private
 void full_node::do_notify(const code& ec, chase event_,
-    event_value value) NOEXCEPT
+    event_value value, const event_payload& payload) NOEXCEPT
 {
     BC_ASSERT(stranded());
-    event_subscriber_.notify(ec, event_, value);
+    event_subscriber_.notify(ec, event_, value, payload);
+}
+
+// private
+bool full_node::handle_template(const code&, chase event_, event_value value,
+    const event_payload& payload) NOEXCEPT
+{
+    if (event_ == chase::stop)
+        return false;
+
+    if (event_ == chase::template_ && payload)
+        template_server_.publish(possible_narrow_cast<size_t>(value),
+            payload_cast<block_template::assembly>(payload));
+
+    return true;
 }
 
+// The key is unique across node and bus, so only its subscriber is notified.
 void full_node::notify_one(object_key key, const code& ec, chase event_,
     event_value value) NOEXCEPT
 {
-    boost::asio::post(strand(),
+    bus_.notify_one(key, ec, event_, value);
+    post_strand(
         std::bind(&full_node::do_notify_one,
             this, key, ec, event_, value));
 }
@@ -201,7 +488,7 @@ void full_node::do_notify_one(object_key key, const code& ec, chase event_,
     event_value value) NOEXCEPT
 {
     BC_ASSERT(stranded());
-    event_subscriber_.notify_one(key, ec, event_, value);
+    event_subscriber_.notify_one(key, ec, event_, value, {});
 }
 
 object_key full_node::subscribe_events(event_notifier&& handler) NOEXCEPT
@@ -213,20 +500,21 @@ object_key full_node::subscribe_events(event_notifier&& handler) NOEXCEPT
 }
 
 void full_node::subscribe_events(event_notifier&& handler,
-    event_completer&& complete) NOEXCEPT
+    event_topics topics, event_completer&& complete) NOEXCEPT
 {
-    boost::asio::post(strand(),
+    post_strand(
         std::bind(&full_node::do_subscribe_events,
-            this, std::move(handler), std::move(complete)));
+            this, std::move(handler), topics, std::move(complete)));
 }
 
 // private
+// The key is created on the node strand, the subscription is made by the bus.
 void full_node::do_subscribe_events(const event_notifier& handler,
-    const event_completer& complete) NOEXCEPT
+    event_topics topics, const event_completer& complete) NOEXCEPT
 {
     BC_ASSERT(stranded());
-    const auto key = create_key();
-    complete(event_subscriber_.subscribe(move_copy(handler), key), key);
+    bus_.subscribe(move_copy(handler), topics, create_key(),
+        move_copy(complete));
 }
 
 void full_node::unsubscribe_events(object_key key) NOEXCEPT
@@ -250,6 +538,113 @@ object_key full_node::create_key() NOEXCEPT
     return keys_;
 }
 
+// Warm start.
+// ----------------------------------------------------------------------------
+
+// private
+// Called before the network starts, so each pool thread takes one binding.
+// Block check threads share the validation core set.
+void full_node::bind_pools() NOEXCEPT
+{
+    const auto bind = [this](const std::string& text, const char* name,
+        boost::asio::io_context& service, size_t count) NOEXCEPT
+    {
+        thread_affinity::cores cores{};
+        if (!thread_affinity::parse(cores, text))
+        {
+            LOGN("Invalid " << name << " affinity [" << text << "].");
+        }
+        else if (!cores.empty())
+        {
+            if (thread_affinity::bind(service, count, cores))
+            {
+                LOGN("The " << name << " threads bound to cores [" << text
+                    << "].");
+            }
+            else
+            {
+                LOGN("The " << name << " threads not bound to cores [" << text
+                    << "].");
+            }
+        }
+    };
+
+    bind(config().node.network_affinity, "network", service(),
+        std::max(size_t{ config().network.threads }, one));
+    bind(config().node.validate_affinity, "check", check_pool_.service(),
+        shares_.check_capacity());
+}
+
+// private
+std::filesystem::path full_node::manifest_file() const NOEXCEPT
+{
+    return config().database.path / "startup.manifest";
+}
+
+// private
+std::filesystem::path full_node::scores_file() const NOEXCEPT
+{
+    return config().network.path / "peers.scores";
+}
+
+// private
+// Historically fastest peers are maintained as manual connections, which are
+// reconnected when dropped, in addition to outbound connections from the pool.
+void full_node::connect_preferred() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    const auto count = config().node.preferred_peers;
+    if (is_zero(count))
+        return;
+
+    for (const auto& peer: scores_.best(count))
+    {
+        LOGN("Preferred peer [" << peer.host << ":" << peer.port << "] ("
+            << peer.rate << ") bytes/sec.");
+        connect({ peer.host, peer.port });
+    }
+}
+
+// private
+// The manifest is removed when read, so an unclean shutdown leaves none. It
+// is also stale if the candidate or confirmed chain has changed since saved.
+void full_node::load_manifest() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    startup_manifest manifest{};
+    if (!startup_manifest::load(manifest_file(), manifest))
+        return;
+
+    const auto top = query_.get_top_candidate();
+    const auto hash = query_.get_header_key(query_.to_candidate(top));
+    if (manifest.candidate_height != top || manifest.candidate_hash != hash ||
+        manifest.confirmed_height != query_.get_top_confirmed() ||
+        manifest.checked_height > top)
+    {
+        LOGN("Startup manifest is stale, scanning store.");
+        return;
+    }
+
+    chaser_check_.restore(manifest.checked_height);
+    LOGN("Startup manifest checked (" << manifest.checked_height << ").");
+}
+
+// private
+void full_node::save_manifest() const NOEXCEPT
+{
+    if (!query_.is_initialized() || query_.is_fault())
+        return;
+
+    startup_manifest manifest{};
+    manifest.candidate_height = query_.get_top_candidate();
+    manifest.candidate_hash = query_.get_header_key(
+        query_.to_candidate(manifest.candidate_height));
+    manifest.confirmed_height = query_.get_top_confirmed();
+    manifest.checked_height = chaser_check_.checked_height();
+    if (!manifest.save(manifest_file()))
+        LOGF("Failed to save startup manifest.");
+}
+
 // Suspensions.
 // ----------------------------------------------------------------------------
 
@@ -293,11 +688,16 @@ void full_node::fault(const code& ec) NOEXCEPT
 }
 
 // Leaves store suspended, caller may want to resume upon success.
+// Concurrent snapshot does not suspend, so channels and chasers continue and
+// only their store writes wait, for the duration of the exclusive flush.
 code full_node::snapshot(const store::event_handler& handler) NOEXCEPT
 {
     if (query_.is_fault())
         return query_.get_code();
 
+    if (config_.node.snapshot_concurrent)
+        return query_.snapshot(handler);
+
     suspend(error::store_snapshot);
     const auto ec = query_.snapshot([&](auto event, auto table) NOEXCEPT
     {
@@ -343,6 +743,91 @@ const configuration& full_node::config() const NOEXCEPT
     return config_;
 }
 
+prevout_cache& full_node::prevouts() NOEXCEPT
+{
+    return prevouts_;
+}
+
+network::threadpool& full_node::check_pool() NOEXCEPT
+{
+    return check_pool_;
+}
+
+work_cache& full_node::work() NOEXCEPT
+{
+    return work_;
+}
+
+header_ranges& full_node::ranges() NOEXCEPT
+{
+    return ranges_;
+}
+
+hash_filter& full_node::seen() NOEXCEPT
+{
+    return seen_;
+}
+
+metrics_registry& full_node::metrics() NOEXCEPT
+{
+    return metrics_;
+}
+
+span_tracer& full_node::tracer() NOEXCEPT
+{
+    return tracer_;
+}
+
+script_cache& full_node::scripts() NOEXCEPT
+{
+    return scripts_;
+}
+
+block_cache& full_node::blocks() NOEXCEPT
+{
+    return blocks_;
+}
+
+header_index& full_node::confirmed_headers() NOEXCEPT
+{
+    return headers_;
+}
+
+download_budget& full_node::budget() NOEXCEPT
+{
+    return budget_;
+}
+
+memory_governor& full_node::memory() NOEXCEPT
+{
+    return memory_;
+}
+
+block_inventory& full_node::announced_blocks() NOEXCEPT
+{
+    return announced_blocks_;
+}
+
+block_claims& full_node::claims() NOEXCEPT
+{
+    return claims_;
+}
+
+worker_shares& full_node::shares() NOEXCEPT
+{
+    return shares_;
+}
+
+filter_checkpoints& full_node::checkpointed_filters() NOEXCEPT
+{
+    return checkpointed_filters_;
+}
+
+peer_scores& full_node::scores() NOEXCEPT
+{
+    return scores_;
+}
+
 bool full_node::is_current() const NOEXCEPT
 {
     if (is_zero(config_.node.currency_window_minutes))
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/hash_filter.hpp>
+
+#include <atomic>
+#include <bit>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+// Hash bytes are uniformly distributed, so are used directly as slot and tag.
+constexpr size_t slot_offset = 0;
+constexpr size_t tag_offset = sizeof(uint64_t);
+
+static uint64_t to_integer(const hash_digest& hash, size_t offset) NOEXCEPT
+{
+    uint64_t value{};
+    for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+        value |= uint64_t{ hash[offset + byte] } << to_bits(byte);
+
+    return value;
+}
+
+hash_filter::hash_filter(size_t slots) NOEXCEPT
+  : mask_(is_zero(slots) ? zero : sub1(std::bit_ceil(slots))),
+    slots_(is_zero(slots) ? zero : add1(mask_))
+{
+}
+
+bool hash_filter::enabled() const NOEXCEPT
+{
+    return !slots_.empty();
+}
+
+void hash_filter::insert(const hash_digest& hash) NOEXCEPT
+{
+    if (enabled())
+        slots_[to_slot(hash)].store(to_tag(hash), std::memory_order_relaxed);
+}
+
+void hash_filter::erase(const hash_digest& hash) NOEXCEPT
+{
+    if (!enabled())
+        return;
+
+    auto tag = to_tag(hash);
+    slots_[to_slot(hash)].compare_exchange_strong(tag, zero,
+        std::memory_order_relaxed);
+}
+
+bool hash_filter::contains(const hash_digest& hash) const NOEXCEPT
+{
+    return enabled() && slots_[to_slot(hash)].load(
+        std::memory_order_relaxed) == to_tag(hash);
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Zero represents an empty slot, so is never a tag.
+uint64_t hash_filter::to_tag(const hash_digest& hash) NOEXCEPT
+{
+    const auto tag = to_integer(hash, tag_offset);
+    return is_zero(tag) ? one : tag;
+}
+
+size_t hash_filter::to_slot(const hash_digest& hash) const NOEXCEPT
+{
+    return possible_narrow_cast<size_t>(to_integer(hash, slot_offset)) &
+        mask_;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/header_archive.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+constexpr auto version_size = sizeof(uint32_t);
+constexpr auto previous_end = version_size + hash_size;
+constexpr auto header_size = chain::header::serialized_size();
+static_assert(header_archive::record_size == header_size - hash_size);
+
+// The record is the serialized header without its previous block hash.
+static void encode(data_chunk& out, const chain::header& header) NOEXCEPT
+{
+    const auto data = header.to_data();
+    out.insert(out.end(), data.begin(), std::next(data.begin(),
+        version_size));
+    out.insert(out.end(), std::next(data.begin(), previous_end), data.end());
+}
+
+static chain::header decode(data_chunk::const_iterator record,
+    const hash_digest& previous) NOEXCEPT
+{
+    data_array<header_size> data{};
+    const auto rest = std::next(record, version_size);
+    const auto end = std::next(record, header_archive::record_size);
+    std::copy(record, rest, data.begin());
+    std::copy(previous.begin(), previous.end(), std::next(data.begin(),
+        version_size));
+    std::copy(rest, end, std::next(data.begin(), previous_end));
+    return chain::header{ data };
+}
+
+code header_archive::write(const std::filesystem::path& file, size_t top,
+    const source& get) NOEXCEPT
+{
+    std::ofstream sink{ file, std::ios::binary | std::ios::trunc };
+    if (!sink)
+        return error::header_archive;
+
+    data_chunk record{};
+    record.reserve(record_size);
+    for (auto height = one; height <= top; ++height)
+    {
+        const auto header = get(height);
+        if (!header)
+            return error::header_archive;
+
+        record.clear();
+        encode(record, *header);
+        sink.write(pointer_cast<const char>(record.data()), record_size);
+        if (!sink)
+            return error::header_archive;
+    }
+
+    sink.flush();
+    return sink ? error::success : error::header_archive;
+}
+
+// The file is hashed twice, so that no header is passed before it is
+// committed, without holding the decoded chain in memory.
+code header_archive::read(const std::filesystem::path& file,
+    const hash_digest& genesis, const chain::checkpoint& commitment,
+    const sink& put) NOEXCEPT
+{
+    std::ifstream source{ file, std::ios::binary };
+    if (!source)
+        return error::header_archive;
+
+    const data_chunk data{ std::istreambuf_iterator<char>(source),
+        std::istreambuf_iterator<char>() };
+
+    if (data.size() != commitment.height() * record_size)
+        return error::header_commitment;
+
+    const auto chain = [&](bool verify) NOEXCEPT
+    {
+        auto previous = genesis;
+        auto record = data.begin();
+        for (auto height = one; height <= commitment.height(); ++height)
+        {
+            const auto header = decode(record, previous);
+            if (!header.is_valid() || (!verify && !put(header)))
+                return false;
+
+            previous = header.hash();
+            std::advance(record, record_size);
+        }
+
+        return previous == commitment.hash();
+    };
+
+    if (!chain(true))
+        return error::header_commitment;
+
+    return chain(false) ? error::success : error::header_archive;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/header_index.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+header_index::header_index() NOEXCEPT
+{
+}
+
+bool header_index::push(const chain::header& header, size_t height) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    if (height != (headers_.size() / header_size))
+        return false;
+
+    const auto data = header.to_data();
+    headers_.insert(headers_.end(), data.begin(), data.end());
+    return true;
+}
+
+void header_index::pop(size_t height) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    const auto size = height * header_size;
+    if (size < headers_.size())
+        headers_.resize(size);
+}
+
+void header_index::clear() NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    headers_.clear();
+    headers_.shrink_to_fit();
+}
+
+size_t header_index::count() const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+    return headers_.size() / header_size;
+}
+
+chain::header_cptrs header_index::get(size_t start,
+    size_t maximum) const NOEXCEPT
+{
+    data_chunk data{};
+    {
+        std::shared_lock lock(mutex_);
+        const auto count = headers_.size() / header_size;
+        if (start >= count)
+            return {};
+
+        // One contiguous copy, deserialized once the lock is released.
+        const auto begin = std::next(headers_.begin(), start * header_size);
+        const auto end = std::next(begin,
+            std::min(maximum, count - start) * header_size);
+        data.assign(begin, end);
+    }
+
+    chain::header_cptrs out{};
+    out.reserve(data.size() / header_size);
+    for (auto it = data.begin(); it != data.end();
+        it = std::next(it, header_size))
+        out.push_back(std::make_shared<const chain::header>(
+            data_slice{ it, std::next(it, header_size) }));
+
+    return out;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
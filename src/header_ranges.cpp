@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/header_ranges.hpp>
+
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace system::chain;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+header_ranges::header_ranges(const checkpoints& checkpoints,
+    organizer&& organize) NOEXCEPT
+  : checkpoints_(checkpoints), organize_(std::move(organize))
+{
+}
+
+void header_ranges::start(const checkpoint& top) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    ranges_.clear();
+    ready_.clear();
+    next_ = zero;
+    organizing_ = false;
+
+    auto from = top;
+    for (const auto& stop: checkpoints_)
+    {
+        if (stop.height() <= from.height())
+            continue;
+
+        ranges_.push_back({ ranges_.size(), from, stop });
+        from = stop;
+    }
+
+    claimed_.assign(ranges_.size(), false);
+}
+
+bool header_ranges::claim(range& out) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    for (auto index = next_; index < ranges_.size(); ++index)
+    {
+        if (!claimed_.at(index))
+        {
+            claimed_.at(index) = true;
+            out = ranges_.at(index);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void header_ranges::release(const range& range) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    if (range.index < claimed_.size() && !ready_.contains(range.index))
+        claimed_.at(range.index) = false;
+}
+
+// The range is bounded by checkpoints, so its count and last hash are fixed.
+bool header_ranges::complete(const range& range,
+    header_cptrs&& headers) NOEXCEPT
+{
+    const auto count = range.stop.height() - range.start.height();
+    if (headers.size() != count ||
+        headers.back()->hash() != range.stop.hash())
+    {
+        release(range);
+        return false;
+    }
+
+    {
+        std::unique_lock lock(mutex_);
+        ready_.emplace(range.index, std::move(headers));
+    }
+
+    organize_next();
+    return true;
+}
+
+bool header_ranges::done() const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+    return next_ == ranges_.size();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Organization of the next range awaits completion of the previous, as the
+// batches would otherwise race to the organizer and orphan each other.
+void header_ranges::organize_next() NOEXCEPT
+{
+    size_t index{};
+    header_cptrs batch{};
+    {
+        std::unique_lock lock(mutex_);
+        const auto it = ready_.find(next_);
+        if (organizing_ || it == ready_.end())
+            return;
+
+        organizing_ = true;
+        index = next_;
+        batch = std::move(it->second);
+        ready_.erase(it);
+    }
+
+    organize_(std::move(batch), std::bind(&header_ranges::handle_organize, this,
+        _1, _2, index));
+}
+
+// A failed range is released for download from another channel.
+void header_ranges::handle_organize(const code& ec, size_t,
+    size_t index) NOEXCEPT
+{
+    {
+        std::unique_lock lock(mutex_);
+        organizing_ = false;
+        if (ec)
+        {
+            claimed_.at(index) = false;
+            return;
+        }
+
+        ++next_;
+    }
+
+    organize_next();
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/loopback_acceptor.hpp>
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+
+loopback_acceptor::loopback_acceptor(network::asio::io_context& service,
+    network::asio::strand& strand) NOEXCEPT
+  : service_(service),
+    strand_(strand),
+    acceptor_(strand)
+{
+}
+
+bool loopback_acceptor::start(uint16_t port, handler&& accepted) NOEXCEPT
+{
+    boost::system::error_code ec{};
+    const tcp::endpoint endpoint{ boost::asio::ip::address_v4::loopback(),
+        port };
+
+    acceptor_.open(endpoint.protocol(), ec);
+    if (!ec)
+        acceptor_.set_option(tcp::acceptor::reuse_address(true), ec);
+    if (!ec)
+        acceptor_.bind(endpoint, ec);
+    if (!ec)
+        acceptor_.listen(boost::asio::socket_base::max_listen_connections,
+            ec);
+    if (ec)
+        return false;
+
+    accepted_ = std::move(accepted);
+    boost::asio::post(strand_,
+        std::bind(&loopback_acceptor::accept, this));
+
+    return true;
+}
+
+bool loopback_acceptor::is_open() const NOEXCEPT
+{
+    return acceptor_.is_open();
+}
+
+void loopback_acceptor::stop() NOEXCEPT
+{
+    boost::system::error_code ignore{};
+    acceptor_.close(ignore);
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+void loopback_acceptor::accept() NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    if (!acceptor_.is_open())
+        return;
+
+    const auto socket = std::make_shared<tcp::socket>(service_);
+    acceptor_.async_accept(*socket,
+        boost::asio::bind_executor(strand_,
+            std::bind(&loopback_acceptor::handle_accept, this, _1, socket)));
+}
+
+// Accept the next connection before handing over this one.
+void loopback_acceptor::handle_accept(const boost::system::error_code& ec,
+    const std::shared_ptr<tcp::socket>& socket) NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    if (ec == boost::asio::error::operation_aborted || !acceptor_.is_open())
+        return;
+
+    accept();
+    if (!ec)
+        accepted_(std::move(*socket));
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
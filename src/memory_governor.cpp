@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/memory_governor.hpp>
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+constexpr size_t full_allowance = 100;
+
+// The low watermark is three quarters of the maximum.
+memory_governor::memory_governor(uint64_t maximum_bytes) NOEXCEPT
+  : maximum_bytes_(maximum_bytes),
+    low_bytes_(maximum_bytes - to_half(to_half(maximum_bytes)))
+{
+}
+
+bool memory_governor::enabled() const NOEXCEPT
+{
+    return !is_zero(maximum_bytes_);
+}
+
+void memory_governor::enroll(const std::string& name, sampler&& usage,
+    shrinker&& shrink) NOEXCEPT
+{
+    if (!enabled() || !usage)
+        return;
+
+    std::unique_lock lock(mutex_);
+    subsystems_.push_back({ name, std::move(usage), std::move(shrink) });
+}
+
+size_t memory_governor::balance() NOEXCEPT
+{
+    if (!enabled())
+        return full_allowance;
+
+    std::unique_lock lock(mutex_);
+    auto total = sample();
+    for (const auto& subsystem: subsystems_)
+    {
+        if (total <= maximum_bytes_)
+            break;
+
+        if (!subsystem.shrink)
+            continue;
+
+        const auto before = subsystem.usage();
+        subsystem.shrink(total - maximum_bytes_);
+        total = floored_subtract(total, floored_subtract(before,
+            subsystem.usage()));
+    }
+
+    size_t allowance{};
+    if (total <= low_bytes_)
+        allowance = full_allowance;
+    else if (total < maximum_bytes_)
+        allowance = possible_narrow_cast<size_t>(
+            ((maximum_bytes_ - total) * full_allowance) /
+            (maximum_bytes_ - low_bytes_));
+
+    usage_.store(total, std::memory_order_relaxed);
+    allowance_.store(allowance, std::memory_order_relaxed);
+    return allowance;
+}
+
+uint64_t memory_governor::usage() const NOEXCEPT
+{
+    return usage_.load(std::memory_order_relaxed);
+}
+
+uint64_t memory_governor::usage(const std::string& name) const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    for (const auto& subsystem: subsystems_)
+        if (subsystem.name == name)
+            return subsystem.usage();
+
+    return {};
+}
+
+size_t memory_governor::allowance() const NOEXCEPT
+{
+    return allowance_.load(std::memory_order_relaxed);
+}
+
+bool memory_governor::pressured() const NOEXCEPT
+{
+    return enabled() && usage() >= maximum_bytes_;
+}
+
+// private
+uint64_t memory_governor::sample() const NOEXCEPT
+{
+    uint64_t total{};
+    for (const auto& subsystem: subsystems_)
+        total = ceilinged_add(total, subsystem.usage());
+
+    return total;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
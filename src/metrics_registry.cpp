@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/metrics_registry.hpp>
+
+#include <atomic>
+#include <bit>
+#include <sstream>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/events.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+constexpr auto relaxed = std::memory_order_relaxed;
+
+// Indexed by events (names are OpenMetrics label values).
+static const std::array<std::string, add1<size_t>(events::snapshot_span)>
+    event_names
+{
+    "header_archived",
+    "header_organized",
+    "header_reorganized",
+    "block_archived",
+    "block_buffered",
+    "block_validated",
+    "block_confirmed",
+    "block_unconfirmable",
+    "block_malleated",
+    "validate_bypassed",
+    "confirm_bypassed",
+    "tx_archived",
+    "tx_validated",
+    "tx_invalidated",
+    "block_organized",
+    "block_reorganized",
+    "template_issued",
+    "snapshot_span"
+};
+
+// Indexed by metrics_registry::counter (OpenMetrics appends _total).
+static const std::array<std::string, 2> counter_names
+{
+    "bn_archived_bytes",
+    "bn_snapshot_bytes"
+};
+
+// Indexed by metrics_registry::gauge.
+static const std::array<std::string, 4> gauge_names
+{
+    "bn_candidate_height",
+    "bn_checked_height",
+    "bn_validated_height",
+    "bn_confirmed_height"
+};
+
+// Indexed by metrics_registry::histogram.
+static const std::array<std::string, 2> histogram_names
+{
+    "bn_archive_microseconds",
+    "bn_snapshot_milliseconds"
+};
+
+// Indexed by metrics_registry::strand (OpenMetrics label values).
+static const std::array<std::string, 11> strand_names
+{
+    "node",
+    "header",
+    "block",
+    "check",
+    "validate",
+    "confirm",
+    "transaction",
+    "template",
+    "snapshot",
+    "storage",
+    "audit"
+};
+
+metrics_registry::metrics_registry() NOEXCEPT
+{
+    static_assert(strand_names.size() == count<strand>());
+    static_assert(counter_names.size() == count<counter>());
+    static_assert(gauge_names.size() == count<gauge>());
+    static_assert(histogram_names.size() == count<histogram>());
+}
+
+void metrics_registry::fired(uint8_t event_) NOEXCEPT
+{
+    if (event_ < events_count)
+        fired_[event_].fetch_add(one, relaxed);
+}
+
+void metrics_registry::add(counter metric, uint64_t value) NOEXCEPT
+{
+    counters_[static_cast<size_t>(metric)].fetch_add(value, relaxed);
+}
+
+void metrics_registry::set(gauge metric, uint64_t value) NOEXCEPT
+{
+    gauges_[static_cast<size_t>(metric)].store(value, relaxed);
+}
+
+// Bucket index is the bit width of the value, so bucket n is < 2^n.
+void metrics_registry::observe(histogram metric, uint64_t value) NOEXCEPT
+{
+    auto& to = histograms_[static_cast<size_t>(metric)];
+    const auto bucket = std::min(possible_narrow_cast<size_t>(
+        std::bit_width(value)), sub1(buckets));
+
+    to.counts[bucket].fetch_add(one, relaxed);
+    to.sum.fetch_add(value, relaxed);
+    to.total.fetch_add(one, relaxed);
+}
+
+metrics_registry::strand_metrics& metrics_registry::strand_at(
+    strand id) NOEXCEPT
+{
+    return strands_[static_cast<size_t>(id)];
+}
+
+const metrics_registry::strand_metrics& metrics_registry::strand_at(
+    strand id) const NOEXCEPT
+{
+    return strands_[static_cast<size_t>(id)];
+}
+
+const std::string& metrics_registry::strand_name(strand id) NOEXCEPT
+{
+    return strand_names[static_cast<size_t>(id)];
+}
+
+uint64_t metrics_registry::fired_count(uint8_t event_) const NOEXCEPT
+{
+    return event_ < events_count ? fired_[event_].load(relaxed) : zero;
+}
+
+uint64_t metrics_registry::value(counter metric) const NOEXCEPT
+{
+    return counters_[static_cast<size_t>(metric)].load(relaxed);
+}
+
+uint64_t metrics_registry::value(gauge metric) const NOEXCEPT
+{
+    return gauges_[static_cast<size_t>(metric)].load(relaxed);
+}
+
+uint64_t metrics_registry::observations(histogram metric) const NOEXCEPT
+{
+    return histograms_[static_cast<size_t>(metric)].total.load(relaxed);
+}
+
+// Values are read individually, so a report is not an atomic snapshot.
+std::string metrics_registry::report() const NOEXCEPT
+{
+    std::ostringstream out{};
+
+    out << "# TYPE bn_events counter\n";
+    for (size_t event_ = 0; event_ < events_count; ++event_)
+        out << "bn_events_total{event=\"" << event_names[event_] << "\"} "
+            << fired_[event_].load(relaxed) << "\n";
+
+    for (size_t index = 0; index < count<counter>(); ++index)
+        out << "# TYPE " << counter_names[index] << " counter\n"
+            << counter_names[index] << "_total "
+            << counters_[index].load(relaxed) << "\n";
+
+    for (size_t index = 0; index < count<gauge>(); ++index)
+        out << "# TYPE " << gauge_names[index] << " gauge\n"
+            << gauge_names[index] << " "
+            << gauges_[index].load(relaxed) << "\n";
+
+    for (size_t index = 0; index < count<histogram>(); ++index)
+    {
+        const auto& name = histogram_names[index];
+        const auto& from = histograms_[index];
+        out << "# TYPE " << name << " histogram\n";
+
+        // Buckets are cumulative and bounded by their (inclusive) upper value.
+        uint64_t cumulative{};
+        for (size_t bucket = 0; bucket < sub1(buckets); ++bucket)
+        {
+            cumulative += from.counts[bucket].load(relaxed);
+            out << name << "_bucket{le=\"" << sub1(power2<uint64_t>(bucket))
+                << "\"} " << cumulative << "\n";
+        }
+
+        cumulative += from.counts[sub1(buckets)].load(relaxed);
+        out << name << "_bucket{le=\"+Inf\"} " << cumulative << "\n"
+            << name << "_sum " << from.sum.load(relaxed) << "\n"
+            << name << "_count " << from.total.load(relaxed) << "\n";
+    }
+
+    const auto strands = [&](const std::string& name, const std::string& type,
+        const std::string& suffix, auto member) NOEXCEPT
+    {
+        out << "# TYPE " << name << " " << type << "\n";
+        for (size_t index = 0; index < count<strand>(); ++index)
+            out << name << suffix << "{strand=\"" << strand_names[index]
+                << "\"} " << (strands_[index].*member).load(relaxed) << "\n";
+    };
+
+    strands("bn_strand_depth", "gauge", "", &strand_metrics::depth);
+    strands("bn_strand_handled", "counter", "_total",
+        &strand_metrics::handled);
+    strands("bn_strand_wait_microseconds", "counter", "_total",
+        &strand_metrics::wait_microseconds);
+    strands("bn_strand_run_microseconds", "counter", "_total",
+        &strand_metrics::run_microseconds);
+
+    out << "# EOF\n";
+    return out.str();
+}
+
+// strand_metrics
+// ----------------------------------------------------------------------------
+
+metrics_registry::strand_metrics::clock::time_point
+metrics_registry::strand_metrics::now() NOEXCEPT
+{
+    return clock::now();
+}
+
+metrics_registry::strand_metrics::clock::time_point
+metrics_registry::strand_metrics::begin(
+    const clock::time_point& posted) NOEXCEPT
+{
+    using namespace std::chrono;
+    const auto started = now();
+    const auto waited = duration_cast<microseconds>(started - posted);
+    depth.fetch_sub(one, relaxed);
+    wait_microseconds.fetch_add(to_unsigned(waited.count()), relaxed);
+    return started;
+}
+
+void metrics_registry::strand_metrics::end(
+    const clock::time_point& started) NOEXCEPT
+{
+    using namespace std::chrono;
+    const auto ran = duration_cast<microseconds>(now() - started);
+    run_microseconds.fetch_add(to_unsigned(ran.count()), relaxed);
+    handled.fetch_add(one, relaxed);
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
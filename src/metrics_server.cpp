@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/metrics_server.hpp>
+
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+
+metrics_server::connection::connection(tcp::socket&& socket) NOEXCEPT
+  : socket(std::move(socket))
+{
+}
+
+metrics_server::metrics_server(network::asio::io_context& service,
+    reporter&& report) NOEXCEPT
+  : report_(std::move(report)),
+    strand_(service.get_executor()),
+    acceptor_(service, strand_)
+{
+}
+
+code metrics_server::start(uint16_t port) NOEXCEPT
+{
+    if (is_zero(port))
+        return error::success;
+
+    return acceptor_.start(port,
+        std::bind(&metrics_server::handle_accept, this, _1)) ?
+            error::success : error::metrics_bind;
+}
+
+void metrics_server::stop() NOEXCEPT
+{
+    boost::asio::post(strand_,
+        std::bind(&metrics_server::do_stop, this));
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+void metrics_server::do_stop() NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+    acceptor_.stop();
+}
+
+void metrics_server::handle_accept(tcp::socket&& socket) NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    const auto client = std::make_shared<connection>(std::move(socket));
+    client->socket.async_read_some(boost::asio::buffer(client->request),
+        std::bind(&metrics_server::handle_request, this, _1, client));
+}
+
+void metrics_server::handle_request(const boost::system::error_code& ec,
+    const connection::ptr& connection) NOEXCEPT
+{
+    if (ec)
+        return;
+
+    const auto body = report_();
+    std::ostringstream response{};
+    response
+        << "HTTP/1.1 200 OK\r\n"
+        << "Content-Type: application/openmetrics-text; version=1.0.0; "
+           "charset=utf-8\r\n"
+        << "Content-Length: " << body.size() << "\r\n"
+        << "Connection: close\r\n\r\n"
+        << body;
+
+    connection->response = response.str();
+    boost::asio::async_write(connection->socket,
+        boost::asio::buffer(connection->response),
+            std::bind(&metrics_server::handle_response, _1, connection));
+}
+
+// The connection is released (closed) when this handler returns.
+void metrics_server::handle_response(const boost::system::error_code&,
+    const connection::ptr& connection) NOEXCEPT
+{
+    boost::system::error_code ignore{};
+    connection->socket.shutdown(tcp::socket::shutdown_both, ignore);
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
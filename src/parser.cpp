@@ -185,6 +185,26 @@ options_metadata parser::load_options() THROWS
             default_value(false)->zero_tokens(),
         "Restore from most recent snapshot."
     )
+    (
+        BN_ARCHIVE_VARIABLE,
+        value<std::filesystem::path>(&configured.archive),
+        "Copy the closed store to a new directory, tables in parallel."
+    )
+    (
+        BN_EXTRACT_VARIABLE,
+        value<std::filesystem::path>(&configured.extract),
+        "Copy an archived store into the configured (new) directory."
+    )
+    (
+        BN_SERVE_VARIABLE,
+        value<uint16_t>(&configured.serve),
+        "Serve the closed store to trusted siblings on the port until stopped."
+    )
+    (
+        BN_HEADERS_VARIABLE,
+        value<std::filesystem::path>(&configured.headers),
+        "Write the confirmed header chain to the milestone into a compressed file."
+    )
     // Chain scans.
     (
         BN_FLAGS_VARIABLE ",f",
@@ -216,6 +236,18 @@ options_metadata parser::load_options() THROWS
             default_value(false)->zero_tokens(),
         "Scan and display store information."
     )
+    (
+        BN_SIZING_VARIABLE,
+        value<bool>(&configured.sizing)->
+            default_value(false)->zero_tokens(),
+        "Display recommended hashmap buckets, from records and projected height."
+    )
+    (
+        BN_SIZING_HEIGHT_VARIABLE,
+        value<uint32_t>(&configured.sizing_height)->
+            default_value(0),
+        "Projected height of sizing, defaults to 0 (confirmed height)."
+    )
     // Ad-hoc Testing.
     (
         BN_READ_VARIABLE ",t",
@@ -228,6 +260,78 @@ options_metadata parser::load_options() THROWS
         value<bool>(&configured.write)->
             default_value(false)->zero_tokens(),
         "Run built-in write test and display."
+    )
+    // Benchmark.
+    (
+        BN_BENCHMARK_VARIABLE ",m",
+        value<bool>(&configured.benchmark)->
+            default_value(false)->zero_tokens(),
+        "Validate candidate block range from store and display throughput."
+    )
+    (
+        BN_BENCHMARK_START_VARIABLE,
+        value<uint32_t>(&configured.benchmark_start)->
+            default_value(1),
+        "First candidate height of benchmark, defaults to 1."
+    )
+    (
+        BN_BENCHMARK_COUNT_VARIABLE,
+        value<uint32_t>(&configured.benchmark_count)->
+            default_value(10'000),
+        "Number of blocks in benchmark, defaults to 10000."
+    )
+    (
+        BN_RECORD_VARIABLE,
+        value<std::filesystem::path>(&configured.record),
+        "Write the benchmark range of confirmed blocks to a replay file."
+    )
+    (
+        BN_REPLAY_VARIABLE,
+        value<std::filesystem::path>(&configured.replay),
+        "Run the node without peers, organizing blocks from a replay file."
+    )
+    // Synthetic chain.
+    (
+        BN_GENERATE_VARIABLE,
+        value<std::filesystem::path>(&configured.generate),
+        "Write a synthetic chain above the configured genesis to a replay file."
+    )
+    (
+        BN_GENERATE_COUNT_VARIABLE,
+        value<uint32_t>(&configured.generate_count)->
+            default_value(1'000),
+        "Number of blocks in synthetic chain, defaults to 1000."
+    )
+    (
+        BN_GENERATE_TXS_VARIABLE,
+        value<uint32_t>(&configured.generate_txs)->
+            default_value(100),
+        "Maximum spending txs per synthetic block, defaults to 100."
+    )
+    (
+        BN_GENERATE_FANOUT_VARIABLE,
+        value<uint32_t>(&configured.generate_fanout)->
+            default_value(2),
+        "Inputs and outputs per synthetic tx, defaults to 2."
+    )
+    (
+        BN_GENERATE_FORK_VARIABLE,
+        value<uint32_t>(&configured.generate_fork)->
+            default_value(0),
+        "Depth of a stronger synthetic branch that follows the chain (reorg)."
+    )
+    // Events analysis.
+    (
+        BN_EVENTS_VARIABLE ",e",
+        value<bool>(&configured.events)->
+            default_value(false)->zero_tokens(),
+        "Aggregate the binary events file and display rates per event."
+    )
+    (
+        BN_EVENTS_PERIOD_VARIABLE,
+        value<uint32_t>(&configured.events_period)->
+            default_value(60),
+        "Seconds per interval of events aggregation, defaults to 60."
     );
 
     return description;
@@ -887,16 +991,86 @@ options_metadata parser::load_settings() THROWS
         value<uint32_t>(&configured.node.threads),
         "The number of threads in the validation threadpool, defaults to 16."
     )
+    (
+        "node.populate_threads",
+        value<uint32_t>(&configured.node.populate_threads),
+        "The number of threads populating prevouts ahead of validation, defaults to 0 (populated inline by validation threads)."
+    )
+    (
+        "node.check_threads",
+        value<uint32_t>(&configured.node.check_threads),
+        "The number of threads checking and archiving downloaded blocks, defaults to 4 (0 disables)."
+    )
+    (
+        "node.confirm_threads",
+        value<uint32_t>(&configured.node.confirm_threads),
+        "The number of threads checking confirmability of validated blocks, defaults to 0 (0 disables)."
+    )
+    (
+        "node.event_shards",
+        value<uint32_t>(&configured.node.event_shards),
+        "The number of strands delivering events to channels, defaults to 4."
+    )
     (
         "node.headers_first",
         value<bool>(&configured.node.headers_first),
         "Obtain current header chain before obtaining associated blocks, defaults to true."
     )
+    (
+        "node.cumulative_work",
+        value<bool>(&configured.node.cumulative_work),
+        "Cache cumulative work by header for fork comparison, defaults to true."
+    )
+    (
+        "node.persist_tree",
+        value<bool>(&configured.node.persist_tree),
+        "Save weak and unstored headers (or blocks) across restarts, defaults to false."
+    )
+    (
+        "node.parallel_headers",
+        value<bool>(&configured.node.parallel_headers),
+        "Partition headers between checkpoints across channels, defaults to false."
+    )
+    (
+        "node.parallel_blocks",
+        value<bool>(&configured.node.parallel_blocks),
+        "Merge blocks-first inventory and split block requests across channels, defaults to false."
+    )
+    (
+        "node.auto_scale",
+        value<bool>(&configured.node.auto_scale),
+        "Move threads between block check and validation by their queue depths, defaults to false."
+    )
+    (
+        "node.coalesce_events",
+        value<bool>(&configured.node.coalesce_events),
+        "Merge bursts of download, valid and confirmable events, defaults to false."
+    )
+    (
+        "node.instrument_strands",
+        value<bool>(&configured.node.instrument_strands),
+        "Record queue depth, wait and run time of chaser strands, defaults to false."
+    )
+    (
+        "node.storage_horizon_minutes",
+        value<uint32_t>(&configured.node.storage_horizon_minutes),
+        "Minutes of projected disk space below which downloads are throttled, defaults to 0 (disabled)."
+    )
+    (
+        "node.trace_spans",
+        value<uint32_t>(&configured.node.trace_spans),
+        "Spans retained per thread for trace export, defaults to 0 (disabled)."
+    )
     (
         "node.allowed_deviation",
         value<float>(&configured.node.allowed_deviation),
         "Allowable underperformance standard deviation, defaults to 1.5 (0 disables)."
     )
+    (
+        "node.seen_headers",
+        value<uint32_t>(&configured.node.seen_headers),
+        "Recently organized header hashes filtered at the channel, defaults to '65536' (0 disables)."
+    )
     (
         "node.maximum_height",
         value<uint32_t>(&configured.node.maximum_height),
@@ -907,11 +1081,181 @@ options_metadata parser::load_settings() THROWS
         value<uint32_t>(&configured.node.maximum_concurrency),
         "Maximum number of blocks to download concurrently, defaults to '50000' (0 disables)."
     )
+    (
+        "node.metrics_port",
+        value<uint16_t>(&configured.node.metrics_port),
+        "Loopback port serving OpenMetrics for scrape, defaults to 0 (0 disables)."
+    )
+    (
+        "node.query_threads",
+        value<uint32_t>(&configured.node.query_threads),
+        "Threads serving store queries, defaults to '2'."
+    )
+    (
+        "node.query_port",
+        value<uint16_t>(&configured.node.query_port),
+        "Loopback port serving store queries, defaults to 0 (0 disables)."
+    )
+    (
+        "node.sibling_port",
+        value<uint16_t>(&configured.node.sibling_port),
+        "Port of the trusted sibling serving its store, defaults to 0 (disabled)."
+    )
+    (
+        "node.template_port",
+        value<uint16_t>(&configured.node.template_port),
+        "Loopback port pushing block templates to mining clients, defaults to 0 (0 disables)."
+    )
+    (
+        "node.template_connections",
+        value<uint32_t>(&configured.node.template_connections),
+        "Maximum concurrent block template connections, defaults to '8'."
+    )
+    (
+        "node.preferred_peers",
+        value<uint32_t>(&configured.node.preferred_peers),
+        "Peers with the best download history to keep connected, defaults to 0 (disabled)."
+    )
+    (
+        "node.query_connections",
+        value<uint32_t>(&configured.node.query_connections),
+        "Maximum concurrent store query connections, defaults to '16'."
+    )
+    (
+        "node.maximum_backlog",
+        value<uint32_t>(&configured.node.maximum_backlog),
+        "Maximum number of transactions outstanding for validation, defaults to '100000' (0 disables)."
+    )
     (
         "node.snapshot_bytes",
         value<uint64_t>(&configured.node.snapshot_bytes),
         "Downloaded bytes that triggers snapshot, defaults to '107374182400' (0 disables)."
     )
+    (
+        "node.prevout_bytes",
+        value<uint64_t>(&configured.node.prevout_bytes),
+        "Memory budget for recently archived outputs used in validation, defaults to '1073741824' (0 disables)."
+    )
+    (
+        "node.mempool_bytes",
+        value<uint64_t>(&configured.node.mempool_bytes),
+        "Memory bound for unconfirmed transactions, defaults to '314572800' (0 disables)."
+    )
+    (
+        "node.block_cache_bytes",
+        value<uint64_t>(&configured.node.block_cache_bytes),
+        "Memory bound for recently organized blocks served to peers, defaults to '67108864' (0 disables)."
+    )
+    (
+        "node.window_bytes",
+        value<uint64_t>(&configured.node.window_bytes),
+        "Estimated bytes of blocks to download concurrently, defaults to '4294967296' (0 disables)."
+    )
+    (
+        "node.admission_threads",
+        value<uint32_t>(&configured.node.admission_threads),
+        "The number of threads checking and connecting unconfirmed transactions, defaults to 4."
+    )
+    (
+        "node.script_cache_entries",
+        value<uint32_t>(&configured.node.script_cache_entries),
+        "Transactions retained as script-verified under fork flags, defaults to '100000' (0 disables)."
+    )
+    (
+        "node.announcement_milliseconds",
+        value<uint32_t>(&configured.node.announcement_milliseconds),
+        "Mean interval of randomized transaction announcement to each peer, defaults to '5000' (0 announces immediately)."
+    )
+    (
+        "node.tip_blocks",
+        value<uint32_t>(&configured.node.tip_blocks),
+        "Announced blocks within this many of the top candidate requested from the announcing peer and archived on receipt, defaults to 0 (disabled)."
+    )
+    (
+        "node.download_bytes_per_second",
+        value<uint64_t>(&configured.node.download_bytes_per_second),
+        "Node-wide block download bandwidth budget in bytes per second, defaults to 0 (disabled)."
+    )
+    (
+        "node.memory_bytes",
+        value<uint64_t>(&configured.node.memory_bytes),
+        "Node-wide bound on memory of caches and queues, which are shrunk and intake throttled as it is approached, defaults to 0 (disabled)."
+    )
+    (
+        "node.bootstrap_path",
+        value<std::filesystem::path>(&configured.node.bootstrap_path),
+        "Store archive extracted in place of an absent store, committed by the milestone, defaults to empty (disabled)."
+    )
+    (
+        "node.headers_path",
+        value<std::filesystem::path>(&configured.node.headers_path),
+        "Compressed header chain to the milestone, loaded into a new store in place of header sync, defaults to empty (disabled)."
+    )
+    (
+        "node.sibling_host",
+        value<std::string>(&configured.node.sibling_host),
+        "Trusted sibling whose store is fetched in place of an absent store, checked against checkpoints, defaults to empty (disabled)."
+    )
+    (
+        "node.serve_address",
+        value<std::string>(&configured.node.serve_address),
+        "Local address on which the closed store is served to trusted siblings, defaults to '127.0.0.1' (loopback)."
+    )
+    (
+        "node.validate_affinity",
+        value<std::string>(&configured.node.validate_affinity),
+        "Cores ('0-7,16-23') or NUMA node ('numa:0') of the validation threads (linux), defaults to empty (unbound)."
+    )
+    (
+        "node.network_affinity",
+        value<std::string>(&configured.node.network_affinity),
+        "Cores ('0-7,16-23') or NUMA node ('numa:0') of the network threads (linux), defaults to empty (unbound)."
+    )
+    (
+        "node.history_threads",
+        value<uint32_t>(&configured.node.history_threads),
+        "The number of threads validating the bypassed history in the background, defaults to 0 (disabled)."
+    )
+    (
+        "node.prefetch_blocks",
+        value<uint32_t>(&configured.node.prefetch_blocks),
+        "Blocks ahead of validation read into memory on a background thread, defaults to 0 (disabled)."
+    )
+    (
+        "node.preallocate_bytes",
+        value<uint64_t>(&configured.node.preallocate_bytes),
+        "Disk space reserved ahead of each large store file (linux), defaults to 0 (disabled)."
+    )
+    (
+        "node.tree_bytes",
+        value<uint64_t>(&configured.node.tree_bytes),
+        "Memory bound for weak and unstored headers (or blocks), defaults to '268435456' (0 disables)."
+    )
+    (
+        "node.snapshot_concurrent",
+        value<bool>(&configured.node.snapshot_concurrent),
+        "Snapshot without suspending the network, defaults to false."
+    )
+    (
+        "node.warm_start",
+        value<bool>(&configured.node.warm_start),
+        "Resume chaser positions from the manifest saved on clean shutdown, defaults to false."
+    )
+    (
+        "node.defer_witness",
+        value<bool>(&configured.node.defer_witness),
+        "Download blocks without witness data under checkpoint (witness blocks are not served there, incompatible with history_threads), defaults to 'false'."
+    )
+    (
+        "node.defer_strong",
+        value<bool>(&configured.node.defer_strong),
+        "Mark transactions of bypassed blocks strong in height order upon confirmation, not upon archive, defaults to 'false'."
+    )
+    (
+        "node.validate_candidates",
+        value<bool>(&configured.node.validate_candidates),
+        "Validate checked candidate blocks in order in the validation chaser (headers first), defaults to 'false'."
+    )
     (
         "node.snapshot_valid",
         value<uint32_t>(&configured.node.snapshot_valid),
@@ -1020,6 +1364,16 @@ options_metadata parser::load_settings() THROWS
         "Enable verbose logging, defaults to false."
 #endif
         )
+    (
+        "log.binary_events",
+        value<bool>(&configured.log.binary_events),
+        "Write fixed-width binary events to events.bin, defaults to false."
+    )
+    (
+        "log.flush_milliseconds",
+        value<uint32_t>(&configured.log.flush_milliseconds),
+        "Milliseconds between background log writes, defaults to 0 (write on each message)."
+    )
     (
         "log.maximum_size",
         value<uint32_t>(&configured.log.maximum_size),
@@ -1065,6 +1419,16 @@ bool parser::parse(int argc, const char* argv[], std::ostream& error) THROWS
         // Clear the config file path if it wasn't used.
         if (!file)
             configured.file.clear();
+
+        // Witness-stripped blocks cannot be script validated by history.
+        if (configured.node.defer_witness &&
+            !is_zero(configured.node.history_threads))
+        {
+            error << format_invalid_parameter(
+                "node.defer_witness is incompatible with node.history_threads")
+                << std::endl;
+            return false;
+        }
     }
     catch (const boost::program_options::error& e)
     {
@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/peer_scores.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+peer_scores::peer_scores(size_t capacity) NOEXCEPT
+  : capacity_(capacity)
+{
+}
+
+void peer_scores::record(const std::string& host, uint16_t port,
+    uint64_t rate) NOEXCEPT
+{
+    if (is_zero(capacity_) || is_zero(rate))
+        return;
+
+    std::unique_lock lock(mutex_);
+    auto& peer = find(host, port);
+    peer.rate = is_zero(peer.rate) ? rate : peer.rate -
+        (peer.rate >> rate_shift) + (rate >> rate_shift);
+    evict();
+}
+
+void peer_scores::drop(const std::string& host, uint16_t port) NOEXCEPT
+{
+    if (is_zero(capacity_))
+        return;
+
+    std::unique_lock lock(mutex_);
+    auto& peer = find(host, port);
+    peer.drops = ceilinged_add(peer.drops, 1_u32);
+    evict();
+}
+
+peer_scores::scores peer_scores::best(size_t count) const NOEXCEPT
+{
+    scores out{};
+    {
+        std::unique_lock lock(mutex_);
+        out.reserve(scores_.size());
+        for (const auto& entry: scores_)
+            if (!is_zero(to_score(entry.second)))
+                out.push_back(entry.second);
+    }
+
+    const auto size = std::min(count, out.size());
+    const auto middle = std::next(out.begin(), size);
+    std::partial_sort(out.begin(), middle, out.end(),
+        [](const score& left, const score& right) NOEXCEPT
+        {
+            return to_score(left) > to_score(right);
+        });
+
+    out.resize(size);
+    return out;
+}
+
+size_t peer_scores::size() const NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    return scores_.size();
+}
+
+std::string peer_scores::to_string() const NOEXCEPT
+{
+    std::ostringstream out{};
+    std::unique_lock lock(mutex_);
+    for (const auto& entry: scores_)
+    {
+        const auto& peer = entry.second;
+        out << peer.host << " " << peer.port << " " << peer.rate << " "
+            << peer.drops << "\n";
+    }
+
+    return out.str();
+}
+
+bool peer_scores::from_string(const std::string& text) NOEXCEPT
+{
+    std::istringstream in{ text };
+    std::unordered_map<std::string, score> scores{};
+    std::string line{};
+    while (std::getline(in, line))
+    {
+        score peer{};
+        std::istringstream fields{ line };
+        if (!(fields >> peer.host >> peer.port >> peer.rate >> peer.drops))
+            return false;
+
+        scores[to_key(peer.host, peer.port)] = std::move(peer);
+    }
+
+    std::unique_lock lock(mutex_);
+    scores_ = std::move(scores);
+    evict();
+    return true;
+}
+
+bool peer_scores::save(const std::filesystem::path& file) const NOEXCEPT
+{
+    system::ofstream sink{ file };
+    sink << to_string();
+    sink.flush();
+    return sink.good();
+}
+
+bool peer_scores::load(const std::filesystem::path& file) NOEXCEPT
+{
+    system::ifstream source{ file };
+    if (!source.good())
+        return false;
+
+    std::ostringstream buffer{};
+    buffer << source.rdbuf();
+    return from_string(buffer.str());
+}
+
+uint64_t peer_scores::to_score(const score& peer) NOEXCEPT
+{
+    return peer.drops < bits<uint64_t> ? peer.rate >> peer.drops : 0_u64;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+std::string peer_scores::to_key(const std::string& host,
+    uint16_t port) NOEXCEPT
+{
+    return host + ":" + std::to_string(port);
+}
+
+peer_scores::score& peer_scores::find(const std::string& host,
+    uint16_t port) NOEXCEPT
+{
+    auto& peer = scores_[to_key(host, port)];
+    if (peer.host.empty())
+    {
+        peer.host = host;
+        peer.port = port;
+    }
+
+    return peer;
+}
+
+// Unmeasured and repeatedly dropped peers score lowest, so are evicted first.
+void peer_scores::evict() NOEXCEPT
+{
+    while (scores_.size() > capacity_)
+        scores_.erase(std::min_element(scores_.begin(), scores_.end(),
+            [](const auto& left, const auto& right) NOEXCEPT
+            {
+                return to_score(left.second) < to_score(right.second);
+            }));
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/prevout_cache.hpp>
+
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace system::chain;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Map node, key, deque entry and shared pointer control block (approximate).
+constexpr uint64_t entry_overhead = 128;
+
+prevout_cache::prevout_cache(uint64_t maximum_bytes) NOEXCEPT
+  : shard_bytes_(maximum_bytes / shard_count)
+{
+}
+
+bool prevout_cache::enabled() const NOEXCEPT
+{
+    return !is_zero(shard_bytes_);
+}
+
+void prevout_cache::put(const block& block) NOEXCEPT
+{
+    if (!enabled())
+        return;
+
+    for (const auto& tx: *block.transactions_ptr())
+    {
+        const auto hash = tx->hash(false);
+        const auto& outs = *tx->outputs_ptr();
+        for (uint32_t index = 0; index < outs.size(); ++index)
+        {
+            key value{ hash, index };
+            put(get_shard(value), std::move(value), outs.at(index));
+        }
+    }
+}
+
+bool prevout_cache::populate(const transaction& tx) NOEXCEPT
+{
+    if (!enabled())
+        return false;
+
+    auto complete = true;
+    for (const auto& in: *tx.inputs_ptr())
+    {
+        const auto& point = in->point();
+        if (in->prevout || point.is_null())
+            continue;
+
+        const key value{ point.hash(), point.index() };
+        auto& from = get_shard(value);
+
+        // Outputs are spent once, so a hit is removed from the cache.
+        std::unique_lock lock(from.mutex);
+        const auto it = from.map.find(value);
+        if (it == from.map.end())
+        {
+            complete = false;
+            continue;
+        }
+
+        // The key remains queued (and accounted) until reaching eviction.
+        in->prevout = it->second;
+        from.bytes -= (footprint(*it->second) - sizeof(key));
+        from.map.erase(it);
+    }
+
+    return complete;
+}
+
+uint64_t prevout_cache::bytes() const NOEXCEPT
+{
+    uint64_t total{};
+    for (const auto& shard: shards_)
+    {
+        std::shared_lock lock(shard.mutex);
+        total += shard.bytes;
+    }
+
+    return total;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+uint64_t prevout_cache::footprint(const output& output) NOEXCEPT
+{
+    return entry_overhead + output.serialized_size();
+}
+
+prevout_cache::shard& prevout_cache::get_shard(const key& value) NOEXCEPT
+{
+    // The point hash is uniformly distributed, so low bits select the shard.
+    return shards_.at(value.hash.front() % shard_count);
+}
+
+void prevout_cache::put(shard& to, key&& value,
+    const output::cptr& output) NOEXCEPT
+{
+    std::unique_lock lock(to.mutex);
+    if (!to.map.emplace(value, output).second)
+        return;
+
+    to.bytes += footprint(*output);
+    to.order.push_back(std::move(value));
+
+    // Evict oldest entries, including keys of those taken by populate.
+    while (to.bytes > shard_bytes_ && !to.order.empty())
+    {
+        const auto it = to.map.find(to.order.front());
+        to.order.pop_front();
+        if (it == to.map.end())
+        {
+            to.bytes -= sizeof(key);
+            continue;
+        }
+
+        to.bytes -= footprint(*it->second);
+        to.map.erase(it);
+    }
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -43,15 +43,45 @@ void protocol::organize(const system::chain::header::cptr& header,
     session_->organize(header, std::move(handler));
 }
 
+void protocol::organize(system::chain::header_cptrs&& headers,
+    organize_handler&& handler) NOEXCEPT
+{
+    session_->organize(std::move(headers), std::move(handler));
+}
+
 void protocol::organize(const system::chain::block::cptr& block,
     organize_handler&& handler) NOEXCEPT
 {
     session_->organize(block, std::move(handler));
 }
 
-void protocol::get_hashes(map_handler&& handler) NOEXCEPT
+void protocol::organize(system::chain::block_cptrs&& blocks,
+    organize_handler&& handler) NOEXCEPT
+{
+    session_->organize(std::move(blocks), std::move(handler));
+}
+
+void protocol::store(const system::chain::transaction::cptr& tx) NOEXCEPT
+{
+    session_->store(tx);
+}
+
+void protocol::reconstruct(const compact_relay::ptr& relay,
+    network::result_handler&& handler) NOEXCEPT
+{
+    session_->reconstruct(relay, std::move(handler));
+}
+
+void protocol::get_transactions(const system::hashes& hashes,
+    transactions_handler&& handler) NOEXCEPT
+{
+    session_->get_transactions(hashes, std::move(handler));
+}
+
+void protocol::get_hashes(size_t count, uint64_t latency,
+    map_handler&& handler) NOEXCEPT
 {
-    session_->get_hashes(std::move(handler));
+    session_->get_hashes(count, latency, std::move(handler));
 }
 
 void protocol::put_hashes(const map_ptr& map,
@@ -69,6 +99,18 @@ void protocol::notify(const code& ec, chase event_,
     session_->notify(ec, event_, value);
 }
 
+void protocol::notify(const code& ec, chase event_, event_value value,
+    const event_payload& payload) const NOEXCEPT
+{
+    session_->notify(ec, event_, value, payload);
+}
+
+void protocol::fire(uint8_t event_, uint64_t value) const NOEXCEPT
+{
+    metrics().fired(event_);
+    network::protocol::fire(event_, value);
+}
+
 void protocol::notify_one(object_key key, const code& ec, chase event_,
     event_value value) const NOEXCEPT
 {
@@ -76,9 +118,9 @@ void protocol::notify_one(object_key key, const code& ec, chase event_,
 }
 
 void protocol::subscribe_events(event_notifier&& handler,
-    event_completer&& complete) NOEXCEPT
+    event_topics topics, event_completer&& complete) NOEXCEPT
 {
-    session_->subscribe_events(std::move(handler),
+    session_->subscribe_events(std::move(handler), topics,
         BIND(handle_subscribe, _1, _2, std::move(complete)));
 }
 
@@ -141,6 +183,81 @@ const configuration& protocol::config() const NOEXCEPT
     return session_->config();
 }
 
+prevout_cache& protocol::prevouts() const NOEXCEPT
+{
+    return session_->prevouts();
+}
+
+network::threadpool& protocol::check_pool() const NOEXCEPT
+{
+    return session_->check_pool();
+}
+
+header_ranges& protocol::ranges() const NOEXCEPT
+{
+    return session_->ranges();
+}
+
+hash_filter& protocol::seen() const NOEXCEPT
+{
+    return session_->seen();
+}
+
+metrics_registry& protocol::metrics() const NOEXCEPT
+{
+    return session_->metrics();
+}
+
+span_tracer& protocol::tracer() const NOEXCEPT
+{
+    return session_->tracer();
+}
+
+script_cache& protocol::scripts() const NOEXCEPT
+{
+    return session_->scripts();
+}
+
+block_cache& protocol::blocks() const NOEXCEPT
+{
+    return session_->blocks();
+}
+
+header_index& protocol::confirmed_headers() const NOEXCEPT
+{
+    return session_->confirmed_headers();
+}
+
+download_budget& protocol::budget() const NOEXCEPT
+{
+    return session_->budget();
+}
+
+block_inventory& protocol::announced_blocks() const NOEXCEPT
+{
+    return session_->announced_blocks();
+}
+
+block_claims& protocol::claims() const NOEXCEPT
+{
+    return session_->claims();
+}
+
+worker_shares& protocol::shares() const NOEXCEPT
+{
+    return session_->shares();
+}
+
+filter_checkpoints& protocol::checkpointed_filters() const NOEXCEPT
+{
+    return session_->checkpointed_filters();
+}
+
+peer_scores& protocol::scores() const NOEXCEPT
+{
+    return session_->scores();
+}
+
 bool protocol::is_current() const NOEXCEPT
 {
     return session_->is_current();
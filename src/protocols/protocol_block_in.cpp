@@ -61,6 +61,21 @@ void protocol_block_in::start() NOEXCEPT
     protocol::start();
 }
 
+// Claimed blocks not received are returned for claim by another channel.
+void protocol_block_in::stopping(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    retry_timer_->stop();
+    if (parallel_)
+    {
+        announced_blocks().release({ tracker_.ids.begin(),
+            tracker_.ids.end() });
+        tracker_.ids.clear();
+    }
+
+    protocol::stopping(ec);
+}
+
 // accept inventory
 // ----------------------------------------------------------------------------
 
@@ -78,8 +93,14 @@ bool protocol_block_in::handle_receive_inventory(const code& ec,
     if (is_zero(block_count))
         return true;
 
+    if (parallel_)
+    {
+        merge_inventory(*message);
+        return true;
+    }
+
     // Work on only one block inventory at a time.
-    if (!tracker_.ids.empty())
+    if (!tracker_.ids.empty() || tracker_.organizing)
     {
         LOGP("Unrequested (" << block_count
             << ") block inventory from [" << authority() << "] with ("
@@ -141,25 +162,51 @@ bool protocol_block_in::handle_receive_block(const code& ec,
         return true;
     }
 
-    // Inventory backlog is limited to 500 per channel.
-    organize(block_ptr, BIND(handle_organize, _1, _2, block_ptr));
+    // Organized in order of announcement, once all prior blocks are received.
+    if (parallel_)
+    {
+        tracker_.ids.erase(block_ptr->hash());
+        if (!announced_blocks().complete(block_ptr))
+        {
+            LOGP("Unclaimed block [" << encode_hash(block_ptr->hash())
+                << "] from [" << authority() << "].");
+        }
+
+        request_blocks();
+        return true;
+    }
 
+    // Inventory backlog is limited to 500 per channel, organized as a batch
+    // (in order of receipt) once all are received.
+    tracker_.ids.erase(block_ptr->hash());
+    tracker_.blocks.push_back(block_ptr);
+    if (!tracker_.ids.empty())
+        return true;
+
+    tracker_.organizing = true;
+    organize(std::move(tracker_.blocks), BIND(handle_organize, _1, _2));
+    tracker_.blocks = {};
     return true;
 }
 
-void protocol_block_in::handle_organize(const code& ec, size_t height,
-    const chain::block::cptr& block_ptr) NOEXCEPT
+// The batch completes on the chaser strand, so tracking resumes on this one.
+void protocol_block_in::handle_organize(const code& ec,
+    size_t height) NOEXCEPT
 {
+    POST(do_handle_organize, ec, height);
+}
+
+// Height is of the failed block (zero if unknown) or of the last organized.
+void protocol_block_in::do_handle_organize(const code& ec,
+    size_t height) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
     // Chaser may be stopped before protocol.
     if (stopped() || ec == network::error::service_stopped)
         return;
 
-    // Order is enforced by organize.
-    tracker_.ids.erase(block_ptr->hash());
-
-    // Must erase duplicates, handled above.
-    if (ec == error::duplicate_block)
-        return;
+    tracker_.organizing = false;
 
     // Assuming no store failure this is an orphan or consensus failure.
     if (ec)
@@ -168,38 +215,110 @@ void protocol_block_in::handle_organize(const code& ec, size_t height,
         {
             // Many peers blindly broadcast blocks even at/above v31800, ugh.
             // If we are not caught up on headers this is useless information.
-            LOGP("Block [" << encode_hash(block_ptr->hash()) << "] from ["
-                << authority() << "] " << ec.message());
+            LOGP("Blocks from [" << authority() << "] " << ec.message());
         }
         else
         {
-            LOGR("Block [" << encode_hash(block_ptr->hash()) << ":" << height
-                << "] from [" << authority() << "] " << ec.message());
+            LOGR("Block [" << height << "] from [" << authority() << "] "
+                << ec.message());
         }
 
         stop(ec);
         return;
     }
 
-    LOGP("Block [" << encode_hash(block_ptr->hash()) << ":" << height
-        << "] from [" << authority() << "].");
+    LOGP("Blocks to [" << height << "] from [" << authority() << "].");
 
-    // Completion of tracked inventory.
-    if (tracker_.ids.empty())
+    // Protocol presumes max_get_blocks unless complete.
+    if (tracker_.announced == max_get_blocks)
     {
-        // Protocol presumes max_get_blocks unless complete.
-        if (tracker_.announced == max_get_blocks)
-        {
-            SEND(create_get_inventory(tracker_.last), handle_send, _1);
-        }
-        else
-        {
-            // Completeness stalls if on 500 as empty message is ambiguous.
-            // This is ok, since complete is not used for anything essential.
-            LOGP("Completed blocks from [" << authority() << "] with ("
-                << tracker_.announced << ") announced.");
-        }
+        SEND(create_get_inventory(tracker_.last), handle_send, _1);
+    }
+    else
+    {
+        // Completeness stalls if on 500 as empty message is ambiguous.
+        // This is ok, since complete is not used for anything essential.
+        LOGP("Completed blocks from [" << authority() << "] with ("
+            << tracker_.announced << ") announced.");
+    }
+}
+
+// parallel
+// ----------------------------------------------------------------------------
+
+// The channel that extends the merged inventory continues to request it.
+void protocol_block_in::merge_inventory(const inventory& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    const auto block_count = message.count(type_id::block);
+    const auto getter = create_get_data(message);
+
+    hashes announced{};
+    announced.reserve(getter.items.size());
+    for (const messages::inventory_item& item: getter.items)
+        announced.push_back(item.hash);
+
+    const auto added = announced_blocks().merge(announced);
+    LOGP("Merged (" << added << ") of (" << block_count
+        << ") block inventory from [" << authority() << "].");
+
+    // The inventory response to get_blocks is limited to max_get_blocks.
+    if (block_count == max_get_blocks &&
+        (!is_zero(added) || getter.items.empty()))
+    {
+        const auto& last = message.items.back().hash;
+        SEND(create_get_inventory(last), handle_send, _1);
     }
+
+    request_blocks();
+}
+
+void protocol_block_in::request_blocks() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (stopped() || !tracker_.ids.empty())
+        return;
+
+    // Nothing claimable, poll until inventory is merged or the window moves.
+    const auto claimed = announced_blocks().claim(parallel_request);
+    if (claimed.empty())
+    {
+        retry_timer_->start(BIND(handle_retry, _1), parallel_retry);
+        return;
+    }
+
+    get_data getter{};
+    getter.items.reserve(claimed.size());
+    for (const auto& hash: claimed)
+    {
+        getter.items.push_back({ block_type_, hash });
+        tracker_.ids.insert(hash);
+    }
+
+    LOGP("Requested (" << getter.items.size() << ") merged blocks from ["
+        << authority() << "].");
+
+    SEND(getter, handle_send, _1);
+}
+
+void protocol_block_in::handle_retry(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (ec == network::error::operation_canceled ||
+        ec == network::error::service_stopped)
+        return;
+
+    if (stopped())
+        return;
+
+    if (ec)
+    {
+        LOGF("Block retry timer failure, " << ec.message());
+        stop(ec);
+        return;
+    }
+
+    request_blocks();
 }
 
 // utilities
@@ -19,6 +19,7 @@
 #include <bitcoin/node/protocols/protocol_block_in_31800.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <bitcoin/database.hpp>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/chasers/chasers.hpp>
@@ -46,8 +47,9 @@ void protocol_block_in_31800::start() NOEXCEPT
         return;
 
     // Events subscription is asynchronous, events may be missed.
-    subscribe_events(BIND(handle_event, _1, _2, _3),
-        BIND(handle_complete, _1, _2));
+    subscribe_events(BIND(handle_event, _1, _2, _3, _4),
+        to_topics(chase::split, chase::stall, chase::purge, chase::expedite,
+            chase::download, chase::report), BIND(handle_complete, _1, _2));
 
     SUBSCRIBE_CHANNEL(block, handle_receive_block, _1, _2);
     protocol::start();
@@ -80,7 +82,7 @@ void protocol_block_in_31800::do_handle_complete(const code& ec) NOEXCEPT
     if (is_current())
     {
         start_performance();
-        get_hashes(BIND(handle_get_hashes, _1, _2, _3, _4));
+        request();
     }
 }
 
@@ -89,7 +91,15 @@ void protocol_block_in_31800::stopping(const code& ec) NOEXCEPT
 {
     BC_ASSERT(stranded());
     restore(map_);
+    restore(next_);
     map_ = chaser_check::empty_map();
+    next_ = chaser_check::empty_map();
+    budget_timer_->stop();
+    deferred_.clear();
+    for (const auto& hash: claimed_)
+        claims().release(hash);
+
+    claimed_.clear();
     stop_performance();
     unsubscribe_events();
     protocol::stopping(ec);
@@ -100,11 +110,17 @@ void protocol_block_in_31800::stopping(const code& ec) NOEXCEPT
 
 bool protocol_block_in_31800::is_idle() const NOEXCEPT
 {
-    return map_->empty();
+    return map_->empty() && next_->empty();
+}
+
+// The lowest block outstanding is the next to be checked.
+bool protocol_block_in_31800::is_frontier() const NOEXCEPT
+{
+    return !map_->empty() && map_->floor() == add1(budget().frontier());
 }
 
 bool protocol_block_in_31800::handle_event(const code&, chase event_,
-    event_value value) NOEXCEPT
+    event_value value, const event_payload&) NOEXCEPT
 {
     // Do not pass ec to stopped as it is not a call status.
     if (stopped())
@@ -124,7 +140,7 @@ bool protocol_block_in_31800::handle_event(const code&, chase event_,
             // If this channel has divisible work, split it and stop.
             // There are no channels reporting work, either stalled or done.
             // This is initiated by any channel notifying chase::starved.
-            if (map_->size() > one)
+            if (get_work() > one)
             {
                 POST(do_split, channel_t{});
             }
@@ -133,11 +149,22 @@ bool protocol_block_in_31800::handle_event(const code&, chase event_,
         }
         case chase::purge:
         {
-            // If have work clear it and stop.
+            // If have work above the branch point drop it and continue.
             // This is initiated by chase::regressed/disorganized.
-            if (map_->size() > one)
+            if (!is_idle())
             {
-                POST(do_purge, channel_t{});
+                POST(do_purge, possible_narrow_cast<height_t>(value));
+            }
+
+            break;
+        }
+        case chase::expedite:
+        {
+            // Malleated block redownload is pending, request it now.
+            // Idle channels request it in response to chase::download.
+            if (!is_idle())
+            {
+                POST(do_expedite, possible_narrow_cast<header_t>(value));
             }
 
             break;
@@ -179,20 +206,37 @@ void protocol_block_in_31800::do_get_downloads(count_t) NOEXCEPT
     {
         // Assume performance was stopped due to exhaustion.
         start_performance();
-        get_hashes(BIND(handle_get_hashes, _1, _2, _3, _4));
+        request();
     }
 }
 
-void protocol_block_in_31800::do_purge(channel_t) NOEXCEPT
+// Blocks already requested above the branch point arrive as unrequested.
+void protocol_block_in_31800::do_purge(height_t branch_point) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    if (!map_->empty())
-    {
-        LOGV("Purge work (" << map_->size() << ") from [" << authority() << "].");
-        map_->clear();
-        stop(error::sacrificed_channel);
-    }
+    if (stopped())
+        return;
+
+    const auto count = map_->trim(branch_point) + next_->trim(branch_point);
+    if (is_zero(count))
+        return;
+
+    LOGV("Purge work (" << count << ") above (" << branch_point << ") from ["
+        << authority() << "].");
+
+    advance();
+}
+
+// Only one map is pipelined, so a channel without capacity does not request.
+void protocol_block_in_31800::do_expedite(header_t) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped())
+        return;
+
+    request();
 }
 
 void protocol_block_in_31800::do_split(channel_t) NOEXCEPT
@@ -202,10 +246,12 @@ void protocol_block_in_31800::do_split(channel_t) NOEXCEPT
     if (stopped())
         return;
 
-    LOGV("Divide work (" << map_->size() << ") from [" << authority() << "].");
+    LOGV("Divide work (" << get_work() << ") from [" << authority() << "].");
     restore(chaser_check::split(map_));
     restore(map_);
+    restore(next_);
     map_ = chaser_check::empty_map();
+    next_ = chaser_check::empty_map();
     stop(error::sacrificed_channel);
 }
 
@@ -214,7 +260,7 @@ void protocol_block_in_31800::do_report(count_t sequence) NOEXCEPT
     BC_ASSERT(stranded());
 
     // Uses application logging since it outputs to a runtime option.
-    LOGA("Work report [" << sequence << "] is (" << map_->size() << ") for ["
+    LOGA("Work report [" << sequence << "] is (" << get_work() << ") for ["
         << authority() << "].");
 }
 
@@ -225,6 +271,7 @@ void protocol_block_in_31800::send_get_data(const map_ptr& map,
     const job::ptr& job, size_t bypass) NOEXCEPT
 {
     BC_ASSERT(stranded());
+    requesting_ = false;
 
     if (stopped())
     {
@@ -234,37 +281,143 @@ void protocol_block_in_31800::send_get_data(const map_ptr& map,
 
     set_bypass(bypass);
     if (map->empty())
+    {
+        // Pipelined work may be unavailable while current work remains.
+        if (is_idle())
+            notify(error::success, chase::starved, events_key());
+
         return;
+    }
 
     // There are two populated maps, return new and leave old in place.
-    if (!is_idle())
+    if (!next_->empty())
     {
         restore(map);
         return;
     }
 
-    job_ = job;
-    map_ = map;
-    SEND(create_get_data(map_), handle_send, _1);
+    const auto idle = is_idle();
+    if (idle)
+    {
+        job_ = job;
+        map_ = map;
+        watermark_ = to_half(map->size());
+        awaited_ = tracer().now();
+    }
+    else
+    {
+        next_job_ = job;
+        next_ = map;
+    }
+
+    // Blocks reconstructed by compact relay are not requested, but are taken
+    // from the block cache and handled as if received.
+    const auto cached = get_cached(map);
+    const auto getter = create_get_data(map, cached);
+    if (!getter.items.empty())
+    {
+        // Pipelined requests queue behind the current map, so are not timed.
+        deferred_.push_back({ getter, idle, map->floor() });
+        if (is_one(deferred_.size()))
+            send_deferred();
+    }
+
+    for (const auto& message: cached)
+        if (stopped() || !handle_receive_block(error::success, message))
+            return;
 }
 
-get_data protocol_block_in_31800::create_get_data(
-    const map_ptr& map) const NOEXCEPT
+get_data protocol_block_in_31800::create_get_data(const map_ptr& map,
+    const blocks_t& cached) const NOEXCEPT
 {
     get_data getter{};
     getter.items.reserve(map->size());
 
+    std::unordered_set<hash_digest> excluded{};
+    for (const auto& message: cached)
+        excluded.insert(message->block_ptr->hash());
+
     // bip144: get_data uses witness constant but inventory does not.
     // clang emplace_back bug (no matching constructor), using push_back.
-    std::for_each(map->pos_begin(), map->pos_end(),
-        [&](const auto& item) NOEXCEPT
-        {
-            getter.items.push_back({ block_type_, item.hash });
-        });
+    // Witness is not validated under checkpoint, so may be deferred (not
+    // stored). A milestone bypass can be lowered by reorganization, so its
+    // blocks are witnessed.
+    map->for_each([&](const auto& item) NOEXCEPT
+    {
+        const auto type = is_deferred(item.context.height) ?
+            type_id::block : block_type_;
+
+        if (!excluded.contains(item.hash))
+            getter.items.push_back({ type, item.hash });
+    });
 
     return getter;
 }
 
+// Requests are sent in order, each once the download budget allows it.
+void protocol_block_in_31800::send_deferred() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    while (!deferred_.empty())
+    {
+        const auto delay = budget().delay(deferred_.front().floor);
+        if (delay > steady_clock::duration::zero())
+        {
+            budget_timer_->start(BIND(handle_budget, _1), delay);
+            return;
+        }
+
+        const auto request = std::move(deferred_.front());
+        deferred_.pop_front();
+        timing_ = request.timed;
+        sent_ = steady_clock::now();
+        SEND(request.getter, handle_send, _1);
+    }
+}
+
+void protocol_block_in_31800::handle_budget(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (ec == network::error::operation_canceled ||
+        ec == network::error::service_stopped)
+        return;
+
+    if (stopped())
+        return;
+
+    if (ec)
+    {
+        LOGF("Download budget timer failure, " << ec.message());
+        stop(ec);
+        return;
+    }
+
+    send_deferred();
+}
+
+// Only a current chain can have reconstructed blocks.
+protocol_block_in_31800::blocks_t protocol_block_in_31800::get_cached(
+    const map_ptr& map) const NOEXCEPT
+{
+    auto& cache = blocks();
+    if (!cache.enabled() || !is_current())
+        return {};
+
+    blocks_t out{};
+    map->for_each([&](const auto& item) NOEXCEPT
+    {
+        // The wire size is not cached, so it is computed for the archive.
+        if (const auto ptr = cache.get(item.hash))
+        {
+            block message{ ptr };
+            message.cached_size = ptr->serialized_size(true);
+            out.push_back(std::make_shared<const block>(std::move(message)));
+        }
+    });
+
+    return out;
+}
+
 // check block
 // ----------------------------------------------------------------------------
 
@@ -282,9 +435,22 @@ bool protocol_block_in_31800::handle_receive_block(const code& ec,
     auto& query = archive();
     const chain::block::cptr block_ptr{ message->block_ptr };
     const auto hash = block_ptr->hash();
-    const auto it = map_->find(hash);
+    auto map = map_;
+    auto item = map->find(hash);
+    if (is_null(item))
+    {
+        map = next_;
+        item = map->find(hash);
+    }
+
+    // A tip block requested by the header protocol is archived as if mapped.
+    if (is_null(item))
+    {
+        map = get_tip(hash);
+        item = map->find(hash);
+    }
 
-    if (it == map_->end())
+    if (is_null(item))
     {
         // Allow unrequested block, not counted toward performance.
         LOGR("Unrequested block [" << encode_hash(hash) << "] from ["
@@ -303,40 +469,138 @@ bool protocol_block_in_31800::handle_receive_block(const code& ec,
         return false;
     }
 
-    const auto& link = it->link;
-    const auto& ctx = it->context;
+    // Block is being checked on the check pool, ignore redundant copy.
+    if (checking_.contains(hash))
+    {
+        LOGR("Redundant block [" << encode_hash(hash) << "] from ["
+            << authority() << "].");
+        return true;
+    }
+
+    const auto& link = item->link;
+    const auto& ctx = item->context;
+
+    // Each download span is the wait for this block, since request or prior.
+    tracer().record(span_tracer::span::download, awaited_, ctx.height);
+    awaited_ = tracer().now();
+
+    // The first requested block of an unpipelined request times the channel.
+    if (timing_ && map == map_)
+    {
+        timing_ = false;
+        set_latency(steady_clock::now() - sent_);
+    }
+
+    // Only a raced, tip or frontier block may also be issued to another
+    // channel, so only these are claimed and probed for prior archival.
+    if (is_claimable(hash, ctx.height))
+    {
+        // Duplicate claimed or already archived by another channel, drop it.
+        if (!claims().claim(hash))
+        {
+            LOGV("Duplicate block [" << encode_hash(hash) << ":" << ctx.height
+                << "] from [" << authority() << "].");
+
+            map->erase(hash);
+            advance();
+            return true;
+        }
 
-    // Check block.
+        if (query.is_associated(link))
+        {
+            LOGV("Duplicate block [" << encode_hash(hash) << ":" << ctx.height
+                << "] from [" << authority() << "].");
+
+            claims().release(hash);
+            map->erase(hash);
+            advance();
+            return true;
+        }
+
+        claimed_.insert(hash);
+    }
+
+    // Check and archive block.
     // ........................................................................
 
     // Transaction/witness commitments are required under checkpoint.
     // This ensures that the block/header hash represents expected txs.
     const auto bypass = is_bypassed(ctx.height) && !malleable64;
 
+    // Hashing and archival run in parallel across channels on the check pool,
+    // so that this strand continues to read messages during the check. When
+    // the check share is in use (scaling) the block is checked on strand.
+    if (!is_zero(config().node.check_threads) && shares().claim_check())
+    {
+        checking_.insert(hash);
+        boost::asio::post(check_pool().service(),
+            BIND(do_archive_block, message, hash, link, ctx, bypass));
+        return true;
+    }
+
+    const auto size = message->cached_size;
+    const auto result = archive_block(*block_ptr, hash, link, ctx, size,
+        bypass);
+
+    handle_archived(result, hash, size);
+    return !result;
+}
+
+// private (check pool)
+void protocol_block_in_31800::do_archive_block(block::cptr& message,
+    const hash_digest& hash, const database::header_link& link,
+    const database::context& ctx, bool bypass) NOEXCEPT
+{
+    // The channel may have stopped while the block was queued, and the store
+    // may be closing, so it is not archived.
+    if (stopped())
+    {
+        shares().release_check();
+        return;
+    }
+
+    const auto size = message->cached_size;
+    const auto ec = archive_block(*message->block_ptr, hash, link, ctx, size,
+        bypass);
+
+    // The block graph was allocated on a network thread, and is released
+    // there (on the strand) rather than churning the check pool's allocator.
+    shares().release_check();
+    POST(handle_checked, ec, std::move(message), hash, size);
+}
+
+// private (thread safe)
+code protocol_block_in_31800::archive_block(const chain::block& block,
+    const hash_digest& hash, const database::header_link& link,
+    const database::context& ctx, size_t size, bool bypass) NOEXCEPT
+{
+    auto& query = archive();
+
     // Performs full check if block is mally64 (mally32 caught either way).
-    if (const auto code = check(*block_ptr, ctx, bypass))
+    const auto checking = tracer().now();
+    const auto ec = check(block, ctx, bypass);
+    tracer().record(span_tracer::span::check, checking, ctx.height);
+    if (ec)
     {
         // Malleated32 is never associated, so drop peer and continue.
         // Cannot mark unconfirmable as confirmable with same hash may exist.
         // Do not rely on return code because does not catch non-bypass mally.
-        if (block_ptr->is_malleated32())
+        if (block.is_malleated32())
         {
             LOGR("Malleated32 block [" << encode_hash(hash) << ":"
                 << ctx.height << "] from [" << authority() << "] "
-                << code.message());
-            stop(code);
-            return false;
+                << ec.message());
+            return ec;
         }
 
         // Malleable64 has not been associated, so drop peer and continue.
         // Cannot mark unconfirmable as confirmable with same hash may exist.
-        if (block_ptr->is_malleable64())
+        if (block.is_malleable64())
         {
             LOGR("Malleable64 block failed check [" << encode_hash(hash) << ":"
                 << ctx.height << "] from [" << authority() << "] "
-                << code.message());
-            stop(code);
-            return false;
+                << ec.message());
+            return ec;
         }
 
         // Set invalid non-malleable header to unconfirmable state.
@@ -345,54 +609,142 @@ bool protocol_block_in_31800::handle_receive_block(const code& ec,
         {
             LOGF("Failure setting block unconfirmable [" << encode_hash(hash)
                 << ":" << ctx.height << "] from [" << authority() << "].");
-            fault(error::set_block_unconfirmable);
-            return false;
+            return fault(error::set_block_unconfirmable);
         }
 
         // Non-malleable block failed block check and was set unconfirmable. 
         LOGR("Block failed check [" << encode_hash(hash) << ":" << ctx.height
-            << "] from [" << authority() << "] " << code.message());
+            << "] from [" << authority() << "] " << ec.message());
         notify(error::success, chase::unchecked, link);
         fire(events::block_unconfirmable, ctx.height);
-        stop(code);
-        return false;
+        return ec;
     }
 
     // Commit block.txs.
     // ........................................................................
 
-    const auto size = block_ptr->serialized_size(true);
-    const chain::transactions_cptr txs_ptr{ block_ptr->transactions_ptr() };
-
-    // Transactions are set_strong here when bypass is true.
-    if (const auto code = query.set_code(*txs_ptr, link, size, bypass))
+    // The wire size is the full (witness if requested) serialized size, so
+    // this avoids a walk of all txs to recompute the size for the store.
+    BC_ASSERT(size == block.serialized_size(true));
+    const chain::transactions_cptr txs_ptr{ block.transactions_ptr() };
+
+    // Transactions are set_strong here when bypass is true, unless deferred
+    // to confirmation, which sets them strong in height order.
+    const auto strong = bypass && !defer_strong_;
+    const auto archiving = tracer().now();
+    const auto started = std::chrono::steady_clock::now();
+    if (const auto code = query.set_code(*txs_ptr, link, size, strong))
     {
         LOGF("Failure storing block [" << encode_hash(hash) << ":"
             << ctx.height << "] from [" << authority() << "] "
             << code.message());
 
-        stop(fault(code));
-        return false;
+        return fault(code);
     }
 
-    // Advance.
-    // ........................................................................
+    // Store write latency and volume.
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - started);
+    metrics().add(metrics_registry::counter::archived_bytes, size);
+    metrics().observe(metrics_registry::histogram::archive_microseconds,
+        to_unsigned(elapsed.count()));
+    tracer().record(span_tracer::span::archive, archiving, ctx.height);
+
+    // Cache outputs for validation of spends in subsequent blocks.
+    if (!bypass)
+        prevouts().put(block);
 
     LOGP("Downloaded block [" << encode_hash(hash) << ":" << ctx.height
         << "] from [" << authority() << "].");
 
-    notify(error::success, chase::checked, ctx.height);
+    // The link identifies the candidate archived at the height, and the wire
+    // size is handed to the check chaser, avoiding its store read.
+    notify(error::success, chase::checked, ctx.height,
+        make_payload<checked_block>(checked_block{ link.value, size }));
     fire(events::block_archived, ctx.height);
+    return error::success;
+}
 
-    count(message->cached_size);
-    map_->erase(it);
-    if (is_idle())
+// An unassociated candidate within tip_blocks of the top, while current.
+// Weak branch blocks are not candidates, and are left to the organizer.
+// Only tracked (requested tip) blocks are searched, other unrequested blocks
+// are dropped without a store read.
+map_ptr protocol_block_in_31800::get_tip(
+    const hash_digest& hash) const NOEXCEPT
+{
+    if (is_zero(tip_blocks_) || !is_current() || !claims().tracked(hash))
+        return chaser_check::empty_map();
+
+    const auto& query = archive();
+    const auto link = query.to_header(hash);
+    database::association out{};
+    if (link.is_terminal() || !query.get_unassociated(out, link))
+        return chaser_check::empty_map();
+
+    const auto height = out.context.height;
+    if (query.to_candidate(height) != link ||
+        ceilinged_add(height, tip_blocks_) <= query.get_top_candidate())
+        return chaser_check::empty_map();
+
+    return std::make_shared<work_map>(work_map::items{ out });
+}
+
+// Claims.
+// ----------------------------------------------------------------------------
+
+// A block tracked by a race or tip request, or the next block to be checked.
+bool protocol_block_in_31800::is_claimable(const hash_digest& hash,
+    size_t height) const NOEXCEPT
+{
+    return height == add1(budget().frontier()) || claims().tracked(hash);
+}
+
+// Released once archived (or failed), so that a competing copy is dropped by
+// the store probe, or once stopped, so that another channel may archive it.
+void protocol_block_in_31800::release(const hash_digest& hash) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (!is_zero(claimed_.erase(hash)))
+        claims().release(hash);
+}
+
+// Advance.
+// ----------------------------------------------------------------------------
+
+// private
+void protocol_block_in_31800::handle_checked(const code& ec,
+    const block::cptr&, const hash_digest& hash, size_t size) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    handle_archived(ec, hash, size);
+}
+
+// private
+void protocol_block_in_31800::handle_archived(const code& ec,
+    const hash_digest& hash, size_t size) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    checking_.erase(hash);
+    release(hash);
+
+    if (stopped())
+        return;
+
+    if (ec)
     {
-        job_.reset();
-        get_hashes(BIND(handle_get_hashes, _1, _2, _3, _4));
+        stop(ec);
+        return;
     }
 
-    return true;
+    count(size);
+    budget().consume(size);
+    block_bytes_ = ceilinged_add(block_bytes_,
+        possible_wide_cast<uint64_t>(size));
+    ++blocks_;
+
+    // The map may have been split or purged during the check.
+    erase(hash);
+    advance();
 }
 
 code protocol_block_in_31800::check(const chain::block& block,
@@ -404,6 +756,11 @@ code protocol_block_in_31800::check(const chain::block& block,
     if ((ec = block.check(bypass)))
         return ec;
 
+    // A block without witness data is fully committed by its merkle root, so
+    // the witness commitment is unverifiable and unnecessary (deferred).
+    if (is_deferred(ctx.height) && !block.is_segregated())
+        return system::error::block_success;
+
     // Witnessed tx commitments are checked under bypass (if bip141).
     if ((ec = block.check(ctx, bypass)))
         return ec;
@@ -414,48 +771,130 @@ code protocol_block_in_31800::check(const chain::block& block,
 // get/put hashes
 // ----------------------------------------------------------------------------
 
-void protocol_block_in_31800::restore(const map_ptr& map) NOEXCEPT
+// Blocks this channel is expected to deliver in one sample period, based on
+// its measured rate and the mean size of its blocks (zero if not measured).
+size_t protocol_block_in_31800::get_inventory() const NOEXCEPT
 {
-    if (!map->empty())
-        put_hashes(map, BIND(handle_put_hashes, _1, map->size()));
+    BC_ASSERT(stranded());
+
+    const auto bytes = rate();
+    if (is_zero(bytes) || bytes == max_uint64 || is_zero(blocks_))
+        return zero;
+
+    const auto period = config().node.sample_period_seconds;
+    const auto size = greater(floored_divide(block_bytes_,
+        possible_wide_cast<uint64_t>(blocks_)), one);
+    const auto count = ceilinged_divide(ceilinged_multiply(bytes,
+        possible_wide_cast<uint64_t>(period)), size);
+
+    return possible_narrow_cast<size_t>(std::min(count,
+        possible_wide_cast<uint64_t>(messages::max_inventory)));
 }
 
-void protocol_block_in_31800::handle_put_hashes(const code& ec,
-    size_t count) NOEXCEPT
+size_t protocol_block_in_31800::get_work() const NOEXCEPT
 {
-    LOGV("Put (" << count << ") work for [" << authority() << "].");
+    BC_ASSERT(stranded());
+    return map_->size() + next_->size();
+}
 
-    if (ec)
-    {
-        LOGF("Error putting work for [" << authority() << "] " << ec.message());
-    }
+void protocol_block_in_31800::erase(const hash_digest& hash) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (!map_->erase(hash))
+        next_->erase(hash);
 }
 
-void protocol_block_in_31800::handle_get_hashes(const code& ec,
-    const map_ptr& map, const job::ptr& job, size_t bypass) NOEXCEPT
+// Time to first block (request round trip) moving average, in microseconds.
+void protocol_block_in_31800::set_latency(
+    const steady_clock::duration& elapsed) NOEXCEPT
 {
+    BC_ASSERT(stranded());
+
+    const auto sample = to_unsigned(std::chrono::duration_cast<
+        std::chrono::microseconds>(elapsed).count());
+
+    latency_ = is_zero(latency_) ? sample : to_half(latency_ + sample);
+    LOGV("Latency (" << latency_ << ") usecs for [" << authority() << "].");
+}
+
+// Only one request is outstanding, and only one map is pipelined.
+void protocol_block_in_31800::request() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (requesting_ || !next_->empty())
+        return;
+
+    requesting_ = true;
+    do_request(shared_from_base<protocol_block_in_31800>());
+}
+
+// The request and its response are a single frame which holds the protocol
+// (parameter) and resumes on the strand, in place of bound and posted handlers.
+flow protocol_block_in_31800::do_request(ptr) NOEXCEPT
+{
+    const auto [ec, map, job, bypass] =
+        co_await await<code, map_ptr, job::ptr, size_t>(
+            [this](map_handler&& handler) NOEXCEPT
+            {
+                get_hashes(get_inventory(), latency_, std::move(handler));
+            });
+
+    BC_ASSERT(stranded());
     LOGV("Got (" << map->size() << ") work for [" << authority() << "].");
 
     if (stopped())
     {
         restore(map);
-        return;
+        co_return;
     }
 
     if (ec)
     {
         LOGF("Error getting work for [" << authority() << "] " << ec.message());
         stop(ec);
-        return;
+        co_return;
     }
 
-    if (map->empty())
+    // An empty map is sent to clear the request (and possibly starve).
+    send_get_data(map, job, bypass);
+}
+
+// The pipelined map becomes current once the current map drains, and work is
+// requested once the current map falls to its low watermark (or drains).
+void protocol_block_in_31800::advance() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (map_->empty())
     {
-        notify(error::success, chase::starved, events_key());
-        return;
+        job_ = next_job_;
+        map_ = next_;
+        watermark_ = to_half(map_->size());
+        next_job_.reset();
+        next_ = chaser_check::empty_map();
     }
 
-    POST(send_get_data, map, job, bypass);
+    if (map_->size() <= watermark_)
+        request();
+}
+
+void protocol_block_in_31800::restore(const map_ptr& map) NOEXCEPT
+{
+    if (!map->empty())
+        put_hashes(map, BIND(handle_put_hashes, _1, map->size()));
+}
+
+void protocol_block_in_31800::handle_put_hashes(const code& ec,
+    size_t count) NOEXCEPT
+{
+    LOGV("Put (" << count << ") work for [" << authority() << "].");
+
+    if (ec)
+    {
+        LOGF("Error putting work for [" << authority() << "] " << ec.message());
+    }
 }
 
 // bypass
@@ -473,6 +912,11 @@ bool protocol_block_in_31800::is_bypassed(size_t height) const NOEXCEPT
     return height <= bypass_;
 }
 
+bool protocol_block_in_31800::is_deferred(size_t height) const NOEXCEPT
+{
+    return !is_zero(deferred_) && height <= deferred_;
+}
+
 BC_POP_WARNING()
 
 } // namespace node
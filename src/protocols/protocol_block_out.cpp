@@ -32,6 +32,10 @@ using namespace network;
 using namespace network::messages;
 using namespace std::placeholders;
 
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+
 // Start.
 // ----------------------------------------------------------------------------
 
@@ -42,11 +46,107 @@ void protocol_block_out::start() NOEXCEPT
     if (started())
         return;
 
+    SUBSCRIBE_CHANNEL(get_data, handle_receive_get_data, _1, _2);
     protocol::start();
 }
 
 // Outbound.
 // ----------------------------------------------------------------------------
 
+// Requests are not accepted while serving, so that a peer cannot queue more
+// than one get_data of blocks (up to the inventory limit) in memory. Each
+// block is read from the store only once the prior block has been sent.
+bool protocol_block_out::handle_receive_get_data(const code& ec,
+    const get_data::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    if (is_zero(message->count(type_id::block) +
+        message->count(type_id::witness_block)))
+        return true;
+
+    // Desubscribe until served.
+    send_block(error::success, zero, message);
+    return false;
+}
+
+void protocol_block_out::send_block(const code& ec, size_t index,
+    const get_data::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return;
+
+    // Skip over non-block inventory.
+    const auto& items = message->items;
+    for (; index < items.size(); ++index)
+        if (items.at(index).type == type_id::block ||
+            items.at(index).type == type_id::witness_block)
+            break;
+
+    if (index >= items.size())
+    {
+        SUBSCRIBE_CHANNEL(get_data, handle_receive_get_data, _1, _2);
+        return;
+    }
+
+    const auto& item = items.at(index);
+    if (!node_witness_ && item.type == type_id::witness_block)
+    {
+        LOGR("Unsupported witness get_data from [" << authority() << "].");
+        stop(network::error::protocol_violation);
+        return;
+    }
+
+    // Blocks archived without witness data cannot be served as witness.
+    if (item.type == type_id::witness_block && is_deferred(item.hash))
+    {
+        LOGR("Deferred witness block [" << encode_hash(item.hash) << "] for ["
+            << authority() << "] not found.");
+        SEND(not_found{ { item } }, send_block, _1, add1(index), message);
+        return;
+    }
+
+    // Blocks near the tip are usually cached, as requested by many peers.
+    auto ptr = blocks().get(item.hash);
+    if (!ptr)
+    {
+        const auto& query = archive();
+        ptr = query.get_block(query.to_header(item.hash));
+    }
+
+    if (!ptr)
+    {
+        LOGR("Requested block [" << encode_hash(item.hash) << "] from ["
+            << authority() << "] not found.");
+
+        // This block could not have been announced to the peer.
+        stop(network::error::protocol_violation);
+        return;
+    }
+
+    SEND(block{ ptr }, send_block, _1, add1(index), message);
+}
+
+// Witness is deferred at and below the configured top checkpoint.
+bool protocol_block_out::is_deferred(const hash_digest& hash) const NOEXCEPT
+{
+    if (is_zero(deferred_))
+        return false;
+
+    size_t height{};
+    const auto& query = archive();
+    return query.get_height(height, query.to_header(hash)) &&
+        height <= deferred_;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
 } // namespace node
 } // namespace libbitcoin
@@ -0,0 +1,316 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/protocols/protocol_compact_in_70014.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <bitcoin/database.hpp>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/compact_relay.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+#define CLASS protocol_compact_in_70014
+
+using namespace system;
+using namespace network;
+using namespace network::messages;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+
+// start/stop
+// ----------------------------------------------------------------------------
+
+void protocol_compact_in_70014::start() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (started())
+        return;
+
+    // Events subscription is asynchronous, events may be missed.
+    subscribe_events(BIND(handle_event, _1, _2, _3, _4),
+        to_topics(chase::announced), BIND(handle_complete, _1, _2));
+
+    SUBSCRIBE_CHANNEL(compact_block, handle_receive_compact_block, _1, _2);
+    SUBSCRIBE_CHANNEL(compact_transactions,
+        handle_receive_compact_transactions, _1, _2);
+    protocol::start();
+}
+
+// private
+void protocol_compact_in_70014::handle_complete(const code& ec,
+    object_key) NOEXCEPT
+{
+    if (stopped(ec))
+        return;
+
+    POST(do_handle_complete, ec);
+}
+
+// private
+void protocol_compact_in_70014::do_handle_complete(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+    {
+        unsubscribe_events();
+        return;
+    }
+
+    // All channels announce until there are enough first announcers.
+    set_high_bandwidth(true);
+}
+
+void protocol_compact_in_70014::stopping(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    pending_.reset();
+    unsubscribe_events();
+    protocol::stopping(ec);
+}
+
+// handle events (announced)
+// ----------------------------------------------------------------------------
+
+bool protocol_compact_in_70014::handle_event(const code&, chase event_,
+    event_value value, const event_payload&) NOEXCEPT
+{
+    if (stopped())
+        return false;
+
+    switch (event_)
+    {
+        case chase::announced:
+        {
+            POST(do_announced, possible_narrow_cast<object_t>(value));
+            break;
+        }
+        case chase::stop:
+        {
+            return false;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return true;
+}
+
+// Each channel observes the same announcer sequence, so each channel derives
+// the same set of high-bandwidth announcers without shared state.
+void protocol_compact_in_70014::do_announced(object_t key) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped())
+        return;
+
+    std::erase(recent_, key);
+    recent_.push_front(key);
+    if (recent_.size() > announcers)
+        recent_.pop_back();
+
+    set_high_bandwidth(recent_.size() < announcers ||
+        std::find(recent_.begin(), recent_.end(), events_key()) !=
+            recent_.end());
+}
+
+// private
+void protocol_compact_in_70014::set_high_bandwidth(bool enable) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (enable == high_bandwidth_)
+        return;
+
+    high_bandwidth_ = enable;
+    LOGP("Compact high-bandwidth " << (enable ? "on" : "off") << " for ["
+        << authority() << "].");
+
+    SEND(send_compact{ enable, compact_relay::version }, handle_send, _1);
+}
+
+// reconstruct
+// ----------------------------------------------------------------------------
+
+// One block is reconstructed at a time, others are obtained by download.
+bool protocol_compact_in_70014::handle_receive_compact_block(const code& ec,
+    const compact_block::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    const auto& query = archive();
+    const auto& header = message->header_ptr;
+    const auto hash = header->hash();
+    if (pending_ || !is_current() || query.is_block(hash))
+        return true;
+
+    // Prefilled indexes are differentially encoded (bip152).
+    compact_relay::prefills prefilled{};
+    size_t index{};
+    for (const auto& item: message->transactions)
+    {
+        index += item.index;
+        prefilled.emplace_back(index++, item.transaction_ptr);
+    }
+
+    const auto relay = std::make_shared<compact_relay>(header,
+        message->nonce, message->short_ids, prefilled);
+
+    if (!relay->is_valid())
+    {
+        LOGR("Invalid compact block [" << encode_hash(hash) << "] from ["
+            << authority() << "].");
+        stop(network::error::protocol_violation);
+        return false;
+    }
+
+    pending_ = relay;
+    first_ = !query.is_header(hash);
+    reconstruct(relay, BIND(handle_reconstruct, _1, relay));
+    return true;
+}
+
+// private
+void protocol_compact_in_70014::handle_reconstruct(const code& ec,
+    const compact_relay::ptr& relay) NOEXCEPT
+{
+    POST(do_reconstruct, ec, relay);
+}
+
+// private
+void protocol_compact_in_70014::do_reconstruct(const code& ec,
+    const compact_relay::ptr& relay) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec) || relay != pending_)
+        return;
+
+    const auto missing = relay->missing();
+    if (missing.empty())
+    {
+        complete();
+        return;
+    }
+
+    // Requested indexes are differentially encoded (bip152).
+    get_compact_transactions request{ relay->hash(), {} };
+    request.indexes.reserve(missing.size());
+    uint64_t next{};
+    for (const auto index: missing)
+    {
+        request.indexes.push_back(index - next);
+        next = add1(index);
+    }
+
+    LOGP("Compact block [" << encode_hash(relay->hash()) << "] missing ("
+        << missing.size() << ") txs from [" << authority() << "].");
+
+    SEND(request, handle_send, _1);
+}
+
+bool protocol_compact_in_70014::handle_receive_compact_transactions(
+    const code& ec, const compact_transactions::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    if (!pending_ || message->block_hash != pending_->hash())
+    {
+        LOGP("Unrequested compact transactions from [" << authority()
+            << "].");
+        return true;
+    }
+
+    if (!pending_->fill(message->transactions))
+    {
+        LOGR("Invalid compact transactions [" << encode_hash(pending_->hash())
+            << "] from [" << authority() << "].");
+        stop(network::error::protocol_violation);
+        return false;
+    }
+
+    complete();
+    return true;
+}
+
+// private
+// A block that fails check (short id collision) is obtained by download.
+void protocol_compact_in_70014::complete() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    const auto block = pending_->to_block();
+    const auto hash = pending_->hash();
+    pending_.reset();
+
+    if (!block || block->check())
+    {
+        LOGP("Compact block [" << encode_hash(hash) << "] from ["
+            << authority() << "] not reconstructed.");
+        return;
+    }
+
+    if (first_)
+        notify(error::success, chase::announced, events_key());
+
+    blocks().put(block);
+    organize(block->header_ptr(), BIND(handle_organize, _1, _2, hash));
+}
+
+void protocol_compact_in_70014::handle_organize(const code& ec,
+    size_t LOG_ONLY(height), const hash_digest& LOG_ONLY(hash)) NOEXCEPT
+{
+    // Chaser may be stopped before protocol.
+    if (stopped() || ec == network::error::service_stopped)
+        return;
+
+    // The header may have been organized by another channel.
+    if (ec && ec != error::duplicate_header)
+    {
+        LOGR("Compact block [" << encode_hash(hash) << ":" << height
+            << "] from [" << authority() << "] " << ec.message());
+        return;
+    }
+
+    LOGP("Compact block [" << encode_hash(hash) << ":" << height
+        << "] from [" << authority() << "].");
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/protocols/protocol_compact_out_70014.hpp>
+
+#include <bitcoin/database.hpp>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/compact_relay.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+#define CLASS protocol_compact_out_70014
+
+using namespace system;
+using namespace network;
+using namespace network::messages;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+
+// start/stop
+// ----------------------------------------------------------------------------
+
+void protocol_compact_out_70014::start() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (started())
+        return;
+
+    // Events subscription is asynchronous, events may be missed.
+    subscribe_events(BIND(handle_event, _1, _2, _3, _4),
+        to_topics(chase::organized), BIND(handle_complete, _1, _2));
+
+    SUBSCRIBE_CHANNEL(send_compact, handle_receive_send_compact, _1, _2);
+    SUBSCRIBE_CHANNEL(get_compact_transactions,
+        handle_receive_get_compact_transactions, _1, _2);
+    protocol::start();
+}
+
+// private
+void protocol_compact_out_70014::handle_complete(const code& ec,
+    object_key) NOEXCEPT
+{
+    POST(do_handle_complete, ec);
+}
+
+// private
+// Subscription may complete after stop, which does not then unsubscribe.
+void protocol_compact_out_70014::do_handle_complete(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        unsubscribe_events();
+}
+
+void protocol_compact_out_70014::stopping(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    unsubscribe_events();
+    protocol::stopping(ec);
+}
+
+// handle events (organized)
+// ----------------------------------------------------------------------------
+
+bool protocol_compact_out_70014::handle_event(const code&, chase event_,
+    event_value value, const event_payload&) NOEXCEPT
+{
+    if (stopped())
+        return false;
+
+    switch (event_)
+    {
+        case chase::organized:
+        {
+            POST(do_organized, possible_narrow_cast<header_t>(value));
+            break;
+        }
+        case chase::stop:
+        {
+            return false;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return true;
+}
+
+// The coinbase is prefilled, as it is never pooled.
+void protocol_compact_out_70014::do_organized(header_t link) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped() || !high_bandwidth_ || !is_current())
+        return;
+
+    const auto block = get_block(archive().get_header_key(link));
+    if (!block || block->transactions_ptr()->empty())
+        return;
+
+    const auto nonce = random_();
+    compact_block announcement
+    {
+        block->header_ptr(),
+        nonce,
+        compact_relay::to_short_ids(*block, nonce),
+        { { zero, block->transactions_ptr()->front() } }
+    };
+
+    SEND(announcement, handle_send, _1);
+}
+
+// handle requests
+// ----------------------------------------------------------------------------
+
+// Low-bandwidth mode is not announced, the peer requests by get_data.
+bool protocol_compact_out_70014::handle_receive_send_compact(const code& ec,
+    const send_compact::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    if (message->compact_version != compact_relay::version)
+        return true;
+
+    high_bandwidth_ = message->high_bandwidth;
+    LOGP("Compact announcement " << (high_bandwidth_ ? "on" : "off")
+        << " for [" << authority() << "].");
+
+    return true;
+}
+
+// Requested indexes are differentially encoded (bip152).
+bool protocol_compact_out_70014::handle_receive_get_compact_transactions(
+    const code& ec, const get_compact_transactions::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    const auto block = get_block(message->block_hash);
+    if (!block)
+    {
+        LOGR("Requested compact block [" << encode_hash(message->block_hash)
+            << "] from [" << authority() << "] not found.");
+        stop(network::error::protocol_violation);
+        return false;
+    }
+
+    const auto& txs = *block->transactions_ptr();
+    compact_transactions response{ message->block_hash, {} };
+    response.transactions.reserve(message->indexes.size());
+
+    uint64_t index{};
+    for (const auto differential: message->indexes)
+    {
+        index += differential;
+        if (index >= txs.size())
+        {
+            LOGR("Invalid compact transactions request from ["
+                << authority() << "].");
+            stop(network::error::protocol_violation);
+            return false;
+        }
+
+        response.transactions.push_back(txs.at(index++));
+    }
+
+    SEND(response, handle_send, _1);
+    return true;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Announced blocks are usually cached, as they are recently organized.
+chain::block::cptr protocol_compact_out_70014::get_block(
+    const hash_digest& hash) const NOEXCEPT
+{
+    if (const auto block = blocks().get(hash))
+        return block;
+
+    const auto& query = archive();
+    return query.get_block(query.to_header(hash));
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/protocols/protocol_filter_out.hpp>
+
+#include <utility>
+#include <bitcoin/database.hpp>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+#define CLASS protocol_filter_out
+
+using namespace system;
+using namespace network;
+using namespace network::messages;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+
+// Start.
+// ----------------------------------------------------------------------------
+
+void protocol_filter_out::start() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (started())
+        return;
+
+    SUBSCRIBE_CHANNEL(get_client_filters, handle_receive_get_filters, _1, _2);
+    SUBSCRIBE_CHANNEL(get_client_filter_headers,
+        handle_receive_get_filter_headers, _1, _2);
+    SUBSCRIBE_CHANNEL(get_client_filter_checkpoint,
+        handle_receive_get_filter_checkpoint, _1, _2);
+    protocol::start();
+}
+
+// Outbound (get_client_filters).
+// ----------------------------------------------------------------------------
+
+// Requests are served in order, a request received while another is being
+// streamed is queued behind it.
+bool protocol_filter_out::handle_receive_get_filters(const code& ec,
+    const get_client_filters::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    span range{};
+    if (!get_span(range, message->filter_type, message->start_height,
+        message->stop_hash, max_filters))
+    {
+        LOGR("Invalid filters request from [" << authority() << "].");
+        stop(network::error::protocol_violation);
+        return false;
+    }
+
+    spans_.push_back(range);
+    if (is_one(spans_.size()))
+        send_filter();
+
+    return true;
+}
+
+// Filters are sent one at a time, each upon completion of the previous, so a
+// request of large filters does not accumulate in the channel's write queue.
+void protocol_filter_out::send_filter() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (spans_.empty())
+        return;
+
+    const auto& query = archive();
+    const auto height = spans_.front().next;
+    const auto link = query.to_confirmed(height);
+
+    data_chunk body{};
+    if (link.is_terminal() || !query.get_filter_body(body, link))
+    {
+        // The filter is not yet computed, or the block has been reorganized.
+        LOGR("Filter (" << height << ") unavailable for [" << authority()
+            << "].");
+        spans_.clear();
+        return;
+    }
+
+    const client_filter response{ basic_filter, query.get_header_key(link),
+        std::move(body) };
+    SEND(response, handle_send_filter, _1);
+}
+
+void protocol_filter_out::handle_send_filter(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec) || spans_.empty())
+        return;
+
+    auto& range = spans_.front();
+    if (range.next++ == range.stop)
+        spans_.pop_front();
+
+    send_filter();
+}
+
+// Outbound (get_client_filter_headers).
+// ----------------------------------------------------------------------------
+
+bool protocol_filter_out::handle_receive_get_filter_headers(
+    const code& ec, const get_client_filter_headers::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    span range{};
+    if (!get_span(range, message->filter_type, message->start_height,
+        message->stop_hash, max_filter_headers))
+    {
+        LOGR("Invalid filter headers request from [" << authority() << "].");
+        stop(network::error::protocol_violation);
+        return false;
+    }
+
+    const auto& query = archive();
+    client_filter_headers response{ basic_filter, message->stop_hash, {}, {} };
+    if (!is_zero(range.next) && !query.get_filter_head(
+        response.previous_filter_header, query.to_confirmed(sub1(range.next))))
+    {
+        LOGR("Filter header (" << sub1(range.next) << ") unavailable for ["
+            << authority() << "].");
+        return true;
+    }
+
+    data_chunk body{};
+    response.filter_hashes.reserve(add1(range.stop - range.next));
+    for (auto height = range.next; height <= range.stop; ++height)
+    {
+        if (!query.get_filter_body(body, query.to_confirmed(height)))
+        {
+            LOGR("Filter (" << height << ") unavailable for [" << authority()
+                << "].");
+            return true;
+        }
+
+        response.filter_hashes.push_back(bitcoin_hash(body));
+    }
+
+    SEND(response, handle_send, _1);
+    return true;
+}
+
+// Outbound (get_client_filter_checkpoint).
+// ----------------------------------------------------------------------------
+
+bool protocol_filter_out::handle_receive_get_filter_checkpoint(
+    const code& ec, const get_client_filter_checkpoint::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    size_t height{};
+    if (message->filter_type != basic_filter ||
+        !get_height(height, message->stop_hash))
+    {
+        LOGR("Invalid filter checkpoint request from [" << authority()
+            << "].");
+        stop(network::error::protocol_violation);
+        return false;
+    }
+
+    client_filter_checkpoint response{ basic_filter, message->stop_hash, {} };
+    if (!checkpointed_filters().get(response.filter_headers, height))
+    {
+        LOGR("Filter checkpoint (" << height << ") unavailable for ["
+            << authority() << "].");
+        return true;
+    }
+
+    SEND(response, handle_send, _1);
+    return true;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+bool protocol_filter_out::get_height(size_t& out,
+    const hash_digest& hash) const NOEXCEPT
+{
+    const auto& query = archive();
+    const auto link = query.to_header(hash);
+    return query.is_confirmed_block(link) && query.get_height(out, link);
+}
+
+// The range is of the confirmed chain, ending at the stop block (bip157).
+bool protocol_filter_out::get_span(span& out, uint8_t type,
+    uint32_t start, const hash_digest& stop, size_t limit) const NOEXCEPT
+{
+    if (type != basic_filter || !get_height(out.stop, stop) ||
+        start > out.stop || (out.stop - start) >= limit)
+        return false;
+
+    out.next = start;
+    return true;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
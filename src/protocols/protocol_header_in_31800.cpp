@@ -47,10 +47,25 @@ void protocol_header_in_31800::start() NOEXCEPT
         return;
 
     SUBSCRIBE_CHANNEL(headers, handle_receive_headers, _1, _2);
-    SEND(create_get_headers(), handle_send, _1);
+    SEND(claim_range() ? create_get_range() : create_get_headers(),
+        handle_send, _1);
+
     protocol::start();
 }
 
+void protocol_header_in_31800::stopping(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (ranged_)
+    {
+        ranges().release(range_);
+        ranged_ = false;
+    }
+
+    protocol::stopping(ec);
+}
+
 // Inbound (headers).
 // ----------------------------------------------------------------------------
 
@@ -67,17 +82,23 @@ bool protocol_header_in_31800::handle_receive_headers(const code& ec,
     LOGP("Headers (" << message->header_ptrs.size() << ") from ["
         << authority() << "].");
 
-    // Store each header, drop channel if invalid.
-    for (const auto& header_ptr: message->header_ptrs)
+    if (ranged_)
     {
-        if (stopped())
-            return false;
-
-        // A job backlog will occur when organize is slower than download.
-        // This is not likely with headers-first even for high channel count.
-        organize(header_ptr, BIND(handle_organize, _1, _2, header_ptr));
+        handle_receive_range(message);
+        return true;
     }
 
+    // Store all headers in one organizer visit, drop channel if any invalid.
+    // Headers are checked concurrently and then organized in message order.
+    // A job backlog will occur when organize is slower than download.
+    // This is not likely with headers-first even for high channel count.
+    // Headers recently organized (from any channel) are dropped here, which
+    // avoids their lookup on the organizer strand. So if all headers are
+    // dropped the organizer is not visited.
+    auto unseen = unseen_headers(message->header_ptrs);
+    if (!unseen.empty())
+        organize(std::move(unseen), BIND(handle_organize, _1, _2, message));
+
     // The headers response to get_headers is limited to max_get_headers.
     if (message->header_ptrs.size() == max_get_headers)
     {
@@ -96,11 +117,10 @@ bool protocol_header_in_31800::handle_receive_headers(const code& ec,
 }
 
 void protocol_header_in_31800::handle_organize(const code& ec,
-    size_t height, const chain::header::cptr& LOG_ONLY(header_ptr)) NOEXCEPT
+    size_t height, const headers::cptr& message) NOEXCEPT
 {
     // Chaser may be stopped before protocol.
-    if (stopped() || ec == network::error::service_stopped ||
-        ec == error::duplicate_header)
+    if (stopped() || ec == network::error::service_stopped)
         return;
 
     // Assuming no store failure this is an orphan or consensus failure.
@@ -108,21 +128,108 @@ void protocol_header_in_31800::handle_organize(const code& ec,
     {
         if (is_zero(height))
         {
-            LOGP("Header [" << encode_hash(header_ptr->hash()) << "] from ["
+            LOGP("Headers (" << message->header_ptrs.size() << ") from ["
                 << authority() << "] " << ec.message());
         }
         else
         {
-            LOGR("Header [" << encode_hash(header_ptr->hash()) << ":" << height
-                << "] from [" << authority() << "] " << ec.message());
+            LOGR("Headers (" << message->header_ptrs.size() << ") at ["
+                << height << "] from [" << authority() << "] "
+                << ec.message());
         }
 
         stop(ec);
         return;
     }
 
-    LOGP("Header [" << encode_hash(header_ptr->hash()) << ":" << height
+    LOGP("Headers (" << message->header_ptrs.size() << ") to [" << height
         << "] from [" << authority() << "] " << ec.message());
+
+    // An announcement at the tip is fetched from its peer without waiting on
+    // the check chaser to distribute it, so it is not queued behind others.
+    if (!is_zero(tip_blocks_) && message->header_ptrs.size() <= tip_blocks_ &&
+        is_current())
+        POST(request_tip, message);
+}
+
+// The block protocol of this channel archives the tip block upon receipt.
+// Tip blocks are tracked, as these may also be announced by other channels.
+void protocol_header_in_31800::request_tip(
+    const headers::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped())
+        return;
+
+    get_data getter{};
+    getter.items.reserve(message->header_ptrs.size());
+    for (const auto& header: message->header_ptrs)
+    {
+        const auto hash = header->hash();
+        claims().track(hash);
+        getter.items.push_back({ block_type_, hash });
+    }
+
+    LOGP("Requested (" << getter.items.size() << ") tip blocks from ["
+        << authority() << "].");
+
+    SEND(getter, handle_send, _1);
+}
+
+// Headers of a claimed range are accumulated until the stop checkpoint, and
+// then deposited for organization in range order. A peer that does not have
+// the range (a short response) is left to the sequential sync below. Headers
+// must chain from the range start and not exceed the range stop, otherwise
+// the claim is released and the channel is dropped.
+void protocol_header_in_31800::handle_receive_range(
+    const headers::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    const auto& headers = message->header_ptrs;
+    const auto count = range_.stop.height() - range_.start.height();
+    auto previous = range_headers_.empty() ? range_.start.hash() :
+        range_headers_.back()->hash();
+
+    for (const auto& header: headers)
+    {
+        if (range_headers_.size() == count ||
+            header->previous_block_hash() != previous)
+        {
+            LOGR("Invalid header range [" << range_.start.height() << "-"
+                << range_.stop.height() << "] from [" << authority() << "].");
+            ranges().release(range_);
+            range_headers_.clear();
+            ranged_ = false;
+            stop(network::error::protocol_violation);
+            return;
+        }
+
+        previous = header->hash();
+        range_headers_.push_back(header);
+    }
+
+    if (range_headers_.size() < count && headers.size() == max_get_headers)
+    {
+        SEND(create_get_headers({ headers.back()->hash() },
+            range_.stop.hash()), handle_send, _1);
+        return;
+    }
+
+    ranged_ = false;
+    if (!ranges().complete(range_, std::move(range_headers_)))
+    {
+        LOGP("Incomplete header range [" << range_.start.height() << "-"
+            << range_.stop.height() << "] from [" << authority() << "].");
+        range_headers_.clear();
+        SEND(create_get_headers(), handle_send, _1);
+        return;
+    }
+
+    range_headers_.clear();
+    SEND(claim_range() ? create_get_range() : create_get_headers(),
+        handle_send, _1);
 }
 
 // This could be the end of a catch-up sequence, or a singleton announcement.
@@ -135,6 +242,34 @@ void protocol_header_in_31800::complete() NOEXCEPT
 // utilities
 // ----------------------------------------------------------------------------
 
+bool protocol_header_in_31800::claim_range() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    ranged_ = config().node.parallel_headers && ranges().claim(range_);
+    if (ranged_)
+        range_headers_.reserve(range_.stop.height() - range_.start.height());
+
+    return ranged_;
+}
+
+chain::header_cptrs protocol_header_in_31800::unseen_headers(
+    const chain::header_cptrs& headers) NOEXCEPT
+{
+    chain::header_cptrs unseen{};
+    unseen.reserve(headers.size());
+    for (const auto& header: headers)
+        if (!seen().contains(header->hash()))
+            unseen.push_back(header);
+
+    return unseen;
+}
+
+get_headers protocol_header_in_31800::create_get_range() const NOEXCEPT
+{
+    return create_get_headers({ range_.start.hash() }, range_.stop.hash());
+}
+
 get_headers protocol_header_in_31800::create_get_headers() const NOEXCEPT
 {
     // Header sync is from the archived (strong) candidate chain.
@@ -152,7 +287,7 @@ get_headers protocol_header_in_31800::create_get_headers(
 }
 
 get_headers protocol_header_in_31800::create_get_headers(
-    hashes&& hashes) const NOEXCEPT
+    hashes&& hashes, const hash_digest& stop) const NOEXCEPT
 {
     if (hashes.empty())
         return {};
@@ -169,7 +304,7 @@ get_headers protocol_header_in_31800::create_get_headers(
             << authority() << "].");
     }
 
-    return { std::move(hashes) };
+    return { std::move(hashes), stop };
 }
 
 BC_POP_WARNING()
@@ -18,6 +18,8 @@
  */
 #include <bitcoin/node/protocols/protocol_header_out_31800.hpp>
 
+#include <algorithm>
+#include <utility>
 #include <bitcoin/database.hpp>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/define.hpp>
@@ -32,6 +34,10 @@ using namespace network;
 using namespace network::messages;
 using namespace std::placeholders;
 
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+
 // Start.
 // ----------------------------------------------------------------------------
 
@@ -42,11 +48,97 @@ void protocol_header_out_31800::start() NOEXCEPT
     if (started())
         return;
 
+    SUBSCRIBE_CHANNEL(get_headers, handle_receive_get_headers, _1, _2);
     protocol::start();
 }
 
 // Outbound (get_headers).
 // ----------------------------------------------------------------------------
 
+bool protocol_header_out_31800::handle_receive_get_headers(const code& ec,
+    const get_headers::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    const auto response = create_headers(*message);
+    LOGP("Headers (" << response.header_ptrs.size() << ") to ["
+        << authority() << "].");
+
+    SEND(response, handle_send, _1);
+    return true;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Headers follow the first confirmed locator hash (or genesis), up to the stop
+// hash or max_get_headers. An empty locator requests only the stop header.
+headers protocol_header_out_31800::create_headers(
+    const get_headers& locator) const NOEXCEPT
+{
+    const auto& query = archive();
+    size_t stop{};
+    const auto limited = get_height(stop, locator.stop_hash);
+
+    if (locator.start_hashes.empty())
+    {
+        const auto header = limited ?
+            query.get_header(query.to_confirmed(stop)) : nullptr;
+
+        if (!header)
+            return {};
+
+        return { { header } };
+    }
+
+    size_t fork{};
+    for (const auto& hash: locator.start_hashes)
+        if (get_height(fork, hash))
+            break;
+
+    const auto top = query.get_top_confirmed();
+    if (fork >= top)
+        return {};
+
+    auto limit = std::min(top - fork, max_get_headers);
+    if (limited && stop > fork)
+        limit = std::min(limit, stop - fork);
+
+    // The index is contiguous, so it either covers the range or starts above.
+    const auto start = add1(fork);
+    auto out = confirmed_headers().get(start, limit);
+    if (out.size() == limit)
+        return { std::move(out) };
+
+    // The index is not loaded, read from the store.
+    out.clear();
+    out.reserve(limit);
+    for (auto height = start; height < start + limit; ++height)
+    {
+        const auto header = query.get_header(query.to_confirmed(height));
+        if (!header)
+            break;
+
+        out.push_back(header);
+    }
+
+    return { std::move(out) };
+}
+
+bool protocol_header_out_31800::get_height(size_t& out,
+    const hash_digest& hash) const NOEXCEPT
+{
+    const auto& query = archive();
+    const auto link = query.to_header(hash);
+    return query.is_confirmed_block(link) && query.get_height(out, link);
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
 } // namespace node
 } // namespace libbitcoin
@@ -36,8 +36,8 @@ void protocol_observer::start() NOEXCEPT
         return;
 
     // Events subscription is asynchronous, events may be missed.
-    subscribe_events(BIND(handle_event, _1, _2, _3),
-        BIND(handle_complete, _1, _2));
+    subscribe_events(BIND(handle_event, _1, _2, _3, _4),
+        to_topics(chase::suspend), BIND(handle_complete, _1, _2));
 
     protocol::start();
 }
@@ -66,7 +66,7 @@ void protocol_observer::stopping(const code& ec) NOEXCEPT
 }
 
 bool protocol_observer::handle_event(const code&, chase event_,
-    event_value) NOEXCEPT
+    event_value, const event_payload&) NOEXCEPT
 {
     // Do not pass ec to stopped as it is not a call status.
     if (stopped())
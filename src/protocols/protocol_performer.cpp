@@ -18,6 +18,8 @@
  */
 #include <bitcoin/node/protocols/protocol_performer.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/protocols/protocol.hpp>
 #include <bitcoin/node/define.hpp>
@@ -40,7 +42,8 @@ void protocol_performer::start_performance() NOEXCEPT
     {
         bytes_ = zero;
         start_ = steady_clock::now();
-        performance_timer_->start(BIND(handle_performance_timer, _1));
+        last_ = start_;
+        start_timer(period_);
     }
 }
 
@@ -69,9 +72,65 @@ void protocol_performer::handle_performance_timer(const code& ec) NOEXCEPT
         return;
     }
 
+    // Frontier channels are checked within the period, for late delivery.
+    const auto now = steady_clock::now();
+    const auto elapsed = now - start_;
+    if (elapsed < period_)
+    {
+        if (is_late(now))
+        {
+            LOGP("Frontier delivery late for [" << authority() << "].");
+            send_performance(zero);
+            return;
+        }
+
+        start_timer(period_ - elapsed);
+        return;
+    }
+
     // Submit performance to (outbound session) aggregate monitor in bytes/sec.
-    send_performance(floored_divide(bytes_, greater(sign_cast<uint64_t>(
-        duration_cast<seconds>(steady_clock::now() - start_).count()), one)));
+    const auto micro = greater(sign_cast<uint64_t>(std::chrono::duration_cast<
+        std::chrono::microseconds>(elapsed).count()), one);
+    rate_ = floored_divide(ceilinged_multiply(bytes_, 1'000'000_u64), micro);
+    send_performance(rate_);
+}
+
+bool protocol_performer::is_frontier() const NOEXCEPT
+{
+    return false;
+}
+
+// private
+void protocol_performer::start_timer(
+    const steady_clock::duration& remaining) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    const auto interval = is_frontier() ?
+        std::min(remaining, period_ / frontier_divisor) : remaining;
+
+    performance_timer_->start(BIND(handle_performance_timer, _1), interval);
+}
+
+// private
+// Expected delivery time is the mean counted size at the last measured rate,
+// so late is relative to both block size and peer speed (unknown if either
+// is unmeasured). A frontier channel below the period is not otherwise late.
+bool protocol_performer::is_late(const steady_clock::time_point& now) const
+    NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (!is_frontier() || is_zero(unit_) || is_zero(rate_) ||
+        rate_ == max_uint64)
+        return false;
+
+    const auto expected = floored_divide(ceilinged_multiply(unit_,
+        1'000'000_u64), rate_);
+    const auto waited = sign_cast<uint64_t>(std::chrono::duration_cast<
+        std::chrono::microseconds>(now - last_).count());
+
+    return waited > ceilinged_multiply(expected, stall_factor);
 }
 
 void protocol_performer::pause_performance() NOEXCEPT
@@ -90,6 +149,10 @@ void protocol_performer::send_performance(uint64_t rate) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
+    // Measured rates are retained by peer, independent of the manager.
+    if (!is_zero(rate) && rate != max_uint64)
+        scores().record(authority().to_host(), authority().port(), rate);
+
     if (enabled_)
     {
         // Must come first as this takes priority as per configuration.
@@ -134,6 +197,7 @@ void protocol_performer::do_handle_performance(const code& ec) NOEXCEPT
     // Caused only by performance(zero|xxx) - had outstanding work.
     if (ec == error::stalled_channel || ec == error::slow_channel)
     {
+        scores().drop(authority().to_host(), authority().port());
         LOGP("Channel dropped [" << authority() << "] " << ec.message());
         stop(ec);
         return;
@@ -150,10 +214,21 @@ void protocol_performer::do_handle_performance(const code& ec) NOEXCEPT
     start_performance();
 }
 
+uint64_t protocol_performer::rate() const NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    return rate_;
+}
+
 void protocol_performer::count(size_t bytes) NOEXCEPT
 {
     BC_ASSERT(stranded());
-    bytes_ = ceilinged_add(bytes_, possible_wide_cast<uint64_t>(bytes));
+    const auto size = possible_wide_cast<uint64_t>(bytes);
+    bytes_ = ceilinged_add(bytes_, size);
+    last_ = steady_clock::now();
+
+    // Moving average of counted sizes, each weighted one eighth.
+    unit_ = is_zero(unit_) ? size : unit_ - (unit_ >> 3u) + (size >> 3u);
 }
 
 } // namespace node
@@ -32,6 +32,10 @@ using namespace network;
 using namespace network::messages;
 using namespace std::placeholders;
 
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+
 // Start.
 // ----------------------------------------------------------------------------
 
@@ -42,11 +46,88 @@ void protocol_transaction_in::start() NOEXCEPT
     if (started())
         return;
 
+    SUBSCRIBE_CHANNEL(inventory, handle_receive_inventory, _1, _2);
+    SUBSCRIBE_CHANNEL(transaction, handle_receive_transaction, _1, _2);
     protocol::start();
 }
 
 // Inbound.
 // ----------------------------------------------------------------------------
 
+// Transactions are not requested until the chain is current, as they cannot
+// be connected against a stale confirmed chain.
+bool protocol_transaction_in::handle_receive_inventory(const code& ec,
+    const inventory::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    if (!is_current() || is_zero(message->count(type_id::transaction)))
+        return true;
+
+    const auto getter = create_get_data(*message);
+    if (getter.items.empty())
+        return true;
+
+    for (const inventory_item& item: getter.items)
+        requested_.insert(item.hash);
+
+    SEND(getter, handle_send, _1);
+    return true;
+}
+
+// Unrequested transactions are ignored, admission is asynchronous.
+bool protocol_transaction_in::handle_receive_transaction(const code& ec,
+    const transaction::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    const auto& tx = message->transaction_ptr;
+    if (is_zero(requested_.erase(tx->hash(false))))
+    {
+        LOGP("Unrequested tx [" << encode_hash(tx->hash(false))
+            << "] from [" << authority() << "].");
+        return true;
+    }
+
+    store(tx);
+    return true;
+}
+
+// Outstanding requests are bounded by the inventory limit.
+get_data protocol_transaction_in::create_get_data(
+    const inventory& message) const NOEXCEPT
+{
+    // clang emplace_back bug (no matching constructor), using push_back.
+    // bip144: get_data uses witness constant but inventory does not.
+
+    get_data getter{};
+    const auto& query = archive();
+    auto space = floored_subtract(max_inventory, requested_.size());
+    for (const inventory_item& item: message.items)
+    {
+        if (is_zero(space))
+            break;
+
+        if ((item.type == type_id::transaction) &&
+            !requested_.contains(item.hash) && !query.is_tx(item.hash))
+        {
+            getter.items.push_back({ tx_type_, item.hash });
+            --space;
+        }
+    }
+
+    return getter;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
 } // namespace node
 } // namespace libbitcoin
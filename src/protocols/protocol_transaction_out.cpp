@@ -18,9 +18,14 @@
  */
 #include <bitcoin/node/protocols/protocol_transaction_out.hpp>
 
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+#include <utility>
 #include <bitcoin/database.hpp>
 #include <bitcoin/network.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/tx_pool.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -32,7 +37,11 @@ using namespace network;
 using namespace network::messages;
 using namespace std::placeholders;
 
-// Start.
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+
+// start/stop
 // ----------------------------------------------------------------------------
 
 void protocol_transaction_out::start() NOEXCEPT
@@ -42,11 +51,313 @@ void protocol_transaction_out::start() NOEXCEPT
     if (started())
         return;
 
+    // Events subscription is asynchronous, events may be missed.
+    subscribe_events(BIND(handle_event, _1, _2, _3, _4),
+        to_topics(chase::transaction), BIND(handle_complete, _1, _2));
+
+    SUBSCRIBE_CHANNEL(inventory, handle_receive_inventory, _1, _2);
+    SUBSCRIBE_CHANNEL(transaction, handle_receive_transaction, _1, _2);
+    SUBSCRIBE_CHANNEL(get_data, handle_receive_get_data, _1, _2);
     protocol::start();
 }
 
-// Outbound.
+// private
+void protocol_transaction_out::handle_complete(const code& ec,
+    object_key) NOEXCEPT
+{
+    if (stopped(ec))
+        return;
+
+    POST(do_handle_complete, ec);
+}
+
+// private
+void protocol_transaction_out::do_handle_complete(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        unsubscribe_events();
+}
+
+void protocol_transaction_out::stopping(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    timer_->stop();
+    pending_.clear();
+    unsubscribe_events();
+    protocol::stopping(ec);
+}
+
+// handle events (transaction)
 // ----------------------------------------------------------------------------
 
+bool protocol_transaction_out::handle_event(const code&, chase event_,
+    event_value, const event_payload& payload) NOEXCEPT
+{
+    if (stopped())
+        return false;
+
+    switch (event_)
+    {
+        case chase::transaction:
+        {
+            POST(do_transaction, payload);
+            break;
+        }
+        case chase::stop:
+        {
+            return false;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return true;
+}
+
+// Pool changes are shared by all channels, each retains only unknown hashes.
+void protocol_transaction_out::do_transaction(
+    const event_payload& payload) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped())
+        return;
+
+    const auto changes = payload_cast<tx_pool::changes>(payload);
+    if (!changes || !is_current())
+        return;
+
+    for (const auto& hash: changes->removed)
+        pending_.erase(hash);
+
+    for (const auto& change: changes->updated)
+    {
+        const auto hash = change.tx->hash(false);
+        if (known_.contains(hash))
+            continue;
+
+        // Ancestry changes update the order of a pending announcement.
+        if (pending_.size() < max_inventory || pending_.contains(hash))
+            pending_[hash] = { change.ancestors.count,
+                tx_pool::rate(change.ancestors) };
+    }
+
+    schedule();
+}
+
+// Announce.
+// ----------------------------------------------------------------------------
+
+// private
+void protocol_transaction_out::schedule() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (scheduled_ || pending_.empty())
+        return;
+
+    if (is_zero(interval_))
+    {
+        announce();
+        return;
+    }
+
+    // Poisson process, exponentially distributed interval about the mean.
+    std::exponential_distribution<double> delay{ 1.0 / interval_ };
+    const milliseconds timeout{ static_cast<int64_t>(delay(random_)) };
+
+    scheduled_ = true;
+    timer_->start(BIND(handle_timer, _1), timeout);
+}
+
+// private
+void protocol_transaction_out::handle_timer(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    scheduled_ = false;
+
+    if (ec == network::error::operation_canceled ||
+        ec == network::error::service_stopped)
+        return;
+
+    if (stopped())
+        return;
+
+    if (ec)
+    {
+        LOGF("Announcement timer failure, " << ec.message());
+        stop(ec);
+        return;
+    }
+
+    announce();
+    schedule();
+}
+
+// private
+void protocol_transaction_out::announce() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    using item = std::pair<hash_digest, announcement>;
+    std::vector<item> items(pending_.begin(), pending_.end());
+    const auto count = std::min(items.size(), maximum_announcement);
+
+    // Parents precede children, so that the peer need not orphan them.
+    std::partial_sort(items.begin(), std::next(items.begin(), count),
+        items.end(), [](const item& left, const item& right) NOEXCEPT
+        {
+            return left.second.ancestors < right.second.ancestors ||
+                (left.second.ancestors == right.second.ancestors &&
+                    left.second.rate > right.second.rate);
+        });
+
+    inventory message{};
+    message.items.reserve(count);
+    for (auto it = items.begin(); it != std::next(items.begin(), count); ++it)
+    {
+        known_.insert(it->first);
+        pending_.erase(it->first);
+        message.items.push_back({ type_id::transaction, it->first });
+    }
+
+    LOGP("Announce transactions (" << count << ") to [" << authority()
+        << "].");
+
+    SEND(message, handle_send, _1);
+}
+
+// Inbound (inventory, transaction).
+// ----------------------------------------------------------------------------
+
+bool protocol_transaction_out::handle_receive_inventory(const code& ec,
+    const inventory::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    for (const auto& item: message->items)
+    {
+        if (item.type == type_id::transaction ||
+            item.type == type_id::witness_transaction)
+        {
+            known_.insert(item.hash);
+            pending_.erase(item.hash);
+        }
+    }
+
+    return true;
+}
+
+bool protocol_transaction_out::handle_receive_transaction(const code& ec,
+    const transaction::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    const auto hash = message->transaction_ptr->hash(false);
+    known_.insert(hash);
+    pending_.erase(hash);
+    return true;
+}
+
+// Outbound (get_data).
+// ----------------------------------------------------------------------------
+
+// Requests are not accepted while serving, so that a peer cannot queue more
+// than one get_data of transactions in memory.
+bool protocol_transaction_out::handle_receive_get_data(const code& ec,
+    const get_data::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return false;
+
+    hashes requested{};
+    for (const auto& item: message->items)
+        if (item.type == type_id::transaction ||
+            item.type == type_id::witness_transaction)
+            requested.push_back(item.hash);
+
+    if (requested.empty())
+        return true;
+
+    // Desubscribe until served.
+    get_transactions(requested,
+        BIND(handle_get_transactions, _1, _2, message));
+    return false;
+}
+
+// private
+void protocol_transaction_out::handle_get_transactions(const code& ec,
+    const chain::transaction_cptrs& txs,
+    const get_data::cptr& message) NOEXCEPT
+{
+    POST(do_get_transactions, ec, txs, message);
+}
+
+// private
+void protocol_transaction_out::do_get_transactions(const code& ec,
+    const chain::transaction_cptrs& txs,
+    const get_data::cptr& message) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return;
+
+    std::unordered_set<hash_digest> found{};
+    for (const auto& tx: txs)
+        found.insert(tx->hash(false));
+
+    not_found missing{};
+    for (const auto& item: message->items)
+        if ((item.type == type_id::transaction ||
+            item.type == type_id::witness_transaction) &&
+            !found.contains(item.hash))
+            missing.items.push_back(item);
+
+    if (!missing.items.empty())
+    {
+        LOGP("Transactions (" << missing.items.size() << ") not found for ["
+            << authority() << "].");
+        SEND(missing, handle_send, _1);
+    }
+
+    send_transactions(error::success, zero, txs);
+}
+
+void protocol_transaction_out::send_transactions(const code& ec,
+    size_t index, const chain::transaction_cptrs& txs) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped(ec))
+        return;
+
+    if (index >= txs.size())
+    {
+        SUBSCRIBE_CHANNEL(get_data, handle_receive_get_data, _1, _2);
+        return;
+    }
+
+    known_.insert(txs.at(index)->hash(false));
+    SEND(transaction{ txs.at(index) }, send_transactions, _1, add1(index),
+        txs);
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
 } // namespace node
 } // namespace libbitcoin
@@ -0,0 +1,252 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/query_server.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <bitcoin/database.hpp>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+
+constexpr auto not_found = "404 Not Found";
+constexpr auto unavailable = "503 Service Unavailable";
+
+query_server::connection::connection(tcp::socket&& socket,
+    std::atomic_size_t& active) NOEXCEPT
+  : socket(std::move(socket)), active(active)
+{
+    active.fetch_add(one, std::memory_order_relaxed);
+}
+
+query_server::connection::~connection() NOEXCEPT
+{
+    active.fetch_sub(one, std::memory_order_relaxed);
+}
+
+query_server::query_server(query& query, size_t threads,
+    size_t connections) NOEXCEPT
+  : query_(query),
+    connections_(std::max(connections, one)),
+    pool_(std::max(threads, one)),
+    strand_(pool_.service().get_executor()),
+    acceptor_(pool_.service(), strand_)
+{
+}
+
+code query_server::start(uint16_t port) NOEXCEPT
+{
+    if (is_zero(port))
+        return error::success;
+
+    return acceptor_.start(port,
+        std::bind(&query_server::handle_accept, this, _1)) ?
+            error::success : error::query_bind;
+}
+
+// Reads must complete before the store is closed, so threads are joined.
+// The acceptor is closed once no thread remains to run its handlers.
+void query_server::stop() NOEXCEPT
+{
+    pool_.stop();
+    pool_.join();
+    acceptor_.stop();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Connections are counted from acceptance, including this one.
+void query_server::handle_accept(tcp::socket&& socket) NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    const auto client = std::make_shared<connection>(std::move(socket),
+        active_);
+
+    if (active_.load(std::memory_order_relaxed) > connections_)
+    {
+        send(client, unavailable, {});
+        return;
+    }
+
+    client->socket.async_read_some(boost::asio::buffer(client->request),
+        std::bind(&query_server::handle_request, this, _1, _2, client));
+}
+
+// Only the request line is parsed (e.g. GET /tx/<hash> HTTP/1.1).
+void query_server::handle_request(const boost::system::error_code& ec,
+    size_t size, const connection::ptr& connection) NOEXCEPT
+{
+    if (ec)
+        return;
+
+    const std::string_view line{ connection->request.data(), size };
+    const auto end = line.find(' ', 4);
+    if (!line.starts_with("GET /") || end == std::string_view::npos)
+    {
+        send(connection, not_found, {});
+        return;
+    }
+
+    const std::string path{ line.substr(4, end - 4) };
+    if (path.starts_with("/block/"))
+    {
+        const auto body = get_block(path.substr(7));
+        send(connection, body.empty() ? not_found : "200 OK", body);
+        return;
+    }
+
+    if (path.starts_with("/tx/"))
+    {
+        const auto body = get_transaction(path.substr(4));
+        send(connection, body.empty() ? not_found : "200 OK", body);
+        return;
+    }
+
+    hash_digest key{};
+    if (!path.starts_with("/address/") || !decode_hash(key, path.substr(9)) ||
+        !query_.to_address_outputs(connection->outputs, key))
+    {
+        send(connection, not_found, {});
+        return;
+    }
+
+    connection->response =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/plain; charset=utf-8\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "Connection: close\r\n\r\n";
+
+    boost::asio::async_write(connection->socket,
+        boost::asio::buffer(connection->response),
+            std::bind(&query_server::handle_chunk, this, _1, connection));
+}
+
+// Address outputs are read and written one chunk at a time, so that a large
+// result is not buffered as a whole and each write yields the thread.
+void query_server::handle_chunk(const boost::system::error_code& ec,
+    const connection::ptr& connection) NOEXCEPT
+{
+    if (ec)
+        return;
+
+    auto& outputs = connection->outputs;
+    if (connection->next > outputs.size())
+    {
+        handle_response(ec, connection);
+        return;
+    }
+
+    std::ostringstream chunk{};
+    const auto end = std::min(connection->next + chunk_outputs,
+        outputs.size());
+
+    for (auto index = connection->next; index < end; ++index)
+    {
+        const auto& link = outputs.at(index);
+        if (const auto output = query_.get_output(link))
+            chunk << encode_hash(query_.get_tx_key(query_.to_output_tx(link)))
+                << " " << output->value() << "\n";
+    }
+
+    // The terminating (empty) chunk follows the last, after which next is
+    // past the end of outputs.
+    const auto body = chunk.str();
+    connection->next = (end == outputs.size()) ? add1(end) : end;
+
+    std::ostringstream framed{};
+    if (!body.empty())
+        framed << std::hex << body.size() << "\r\n" << body << "\r\n";
+
+    if (connection->next > outputs.size())
+        framed << "0\r\n\r\n";
+
+    connection->response = framed.str();
+    boost::asio::async_write(connection->socket,
+        boost::asio::buffer(connection->response),
+            std::bind(&query_server::handle_chunk, this, _1, connection));
+}
+
+std::string query_server::get_block(const std::string& hash) const NOEXCEPT
+{
+    hash_digest key{};
+    if (!decode_hash(key, hash))
+        return {};
+
+    const auto block = query_.get_block(query_.to_header(key));
+    return block ? encode_base16(block->to_data(true)) : std::string{};
+}
+
+std::string query_server::get_transaction(
+    const std::string& hash) const NOEXCEPT
+{
+    hash_digest key{};
+    if (!decode_hash(key, hash))
+        return {};
+
+    const auto tx = query_.get_transaction(query_.to_tx(key));
+    return tx ? encode_base16(tx->to_data(true)) : std::string{};
+}
+
+void query_server::send(const connection::ptr& connection,
+    const std::string& status, const std::string& body) NOEXCEPT
+{
+    std::ostringstream response{};
+    response
+        << "HTTP/1.1 " << status << "\r\n"
+        << "Content-Type: text/plain; charset=utf-8\r\n"
+        << "Content-Length: " << body.size() << "\r\n"
+        << "Connection: close\r\n\r\n"
+        << body;
+
+    connection->response = response.str();
+    boost::asio::async_write(connection->socket,
+        boost::asio::buffer(connection->response),
+            std::bind(&query_server::handle_response, _1, connection));
+}
+
+// The connection is released (closed) when this handler returns.
+void query_server::handle_response(const boost::system::error_code&,
+    const connection::ptr& connection) NOEXCEPT
+{
+    boost::system::error_code ignore{};
+    connection->socket.shutdown(tcp::socket::shutdown_both, ignore);
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
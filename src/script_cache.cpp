@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/script_cache.hpp>
+
+#include <mutex>
+#include <shared_mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+script_cache::script_cache(size_t maximum_entries) NOEXCEPT
+  : shard_entries_(ceilinged_divide(maximum_entries, shard_count))
+{
+}
+
+bool script_cache::enabled() const NOEXCEPT
+{
+    return !is_zero(shard_entries_);
+}
+
+void script_cache::insert(const hash_digest& wtxid, uint32_t flags) NOEXCEPT
+{
+    if (!enabled())
+        return;
+
+    auto& to = get_shard(wtxid);
+    std::unique_lock lock(to.mutex);
+    if (!to.set.insert({ wtxid, flags }).second)
+        return;
+
+    to.order.push_back({ wtxid, flags });
+    if (to.order.size() > shard_entries_)
+    {
+        to.set.erase(to.order.front());
+        to.order.pop_front();
+    }
+}
+
+bool script_cache::contains(const hash_digest& wtxid,
+    uint32_t flags) const NOEXCEPT
+{
+    if (!enabled())
+        return false;
+
+    const auto& from = get_shard(wtxid);
+    std::shared_lock lock(from.mutex);
+    return from.set.contains({ wtxid, flags });
+}
+
+size_t script_cache::size() const NOEXCEPT
+{
+    size_t total{};
+    for (const auto& shard: shards_)
+    {
+        std::shared_lock lock(shard.mutex);
+        total += shard.set.size();
+    }
+
+    return total;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// The wtxid is uniformly distributed, so low bits select the shard.
+const script_cache::shard& script_cache::get_shard(
+    const hash_digest& wtxid) const NOEXCEPT
+{
+    return shards_.at(wtxid.front() % shard_count);
+}
+
+script_cache::shard& script_cache::get_shard(const hash_digest& wtxid) NOEXCEPT
+{
+    return shards_.at(wtxid.front() % shard_count);
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -51,15 +51,45 @@ void session::organize(const header::cptr& header,
     node_.organize(header, std::move(handler));
 }
 
+void session::organize(header_cptrs&& headers,
+    organize_handler&& handler) NOEXCEPT
+{
+    node_.organize(std::move(headers), std::move(handler));
+}
+
 void session::organize(const block::cptr& block,
     organize_handler&& handler) NOEXCEPT
 {
     node_.organize(block, std::move(handler));
 }
 
-void session::get_hashes(map_handler&& handler) NOEXCEPT
+void session::organize(block_cptrs&& blocks,
+    organize_handler&& handler) NOEXCEPT
 {
-    node_.get_hashes(std::move(handler));
+    node_.organize(std::move(blocks), std::move(handler));
+}
+
+void session::store(const transaction::cptr& tx) NOEXCEPT
+{
+    node_.store(tx);
+}
+
+void session::reconstruct(const compact_relay::ptr& relay,
+    network::result_handler&& handler) NOEXCEPT
+{
+    node_.reconstruct(relay, std::move(handler));
+}
+
+void session::get_transactions(const system::hashes& hashes,
+    transactions_handler&& handler) NOEXCEPT
+{
+    node_.get_transactions(hashes, std::move(handler));
+}
+
+void session::get_hashes(size_t count, uint64_t latency,
+    map_handler&& handler) NOEXCEPT
+{
+    node_.get_hashes(count, latency, std::move(handler));
 }
 
 void session::put_hashes(const map_ptr& map,
@@ -77,6 +107,12 @@ void session::notify(const code& ec, chase event_,
     node_.notify(ec, event_, value);
 }
 
+void session::notify(const code& ec, chase event_, event_value value,
+    const event_payload& payload) const NOEXCEPT
+{
+    node_.notify(ec, event_, value, payload);
+}
+
 void session::notify_one(object_key key, const code& ec, chase event_,
     event_value value) const NOEXCEPT
 {
@@ -89,9 +125,9 @@ object_key session::subscribe_events(event_notifier&& handler) NOEXCEPT
 }
 
 void session::subscribe_events(event_notifier&& handler,
-    event_completer&& complete) NOEXCEPT
+    event_topics topics, event_completer&& complete) NOEXCEPT
 {
-    node_.subscribe_events(std::move(handler), std::move(complete));
+    node_.subscribe_events(std::move(handler), topics, std::move(complete));
 }
 
 void session::unsubscribe_events(object_key key) NOEXCEPT
@@ -133,6 +169,81 @@ const configuration& session::config() const NOEXCEPT
     return node_.config();
 }
 
+prevout_cache& session::prevouts() const NOEXCEPT
+{
+    return node_.prevouts();
+}
+
+network::threadpool& session::check_pool() const NOEXCEPT
+{
+    return node_.check_pool();
+}
+
+header_ranges& session::ranges() const NOEXCEPT
+{
+    return node_.ranges();
+}
+
+hash_filter& session::seen() const NOEXCEPT
+{
+    return node_.seen();
+}
+
+metrics_registry& session::metrics() const NOEXCEPT
+{
+    return node_.metrics();
+}
+
+span_tracer& session::tracer() const NOEXCEPT
+{
+    return node_.tracer();
+}
+
+script_cache& session::scripts() const NOEXCEPT
+{
+    return node_.scripts();
+}
+
+block_cache& session::blocks() const NOEXCEPT
+{
+    return node_.blocks();
+}
+
+header_index& session::confirmed_headers() const NOEXCEPT
+{
+    return node_.confirmed_headers();
+}
+
+download_budget& session::budget() const NOEXCEPT
+{
+    return node_.budget();
+}
+
+block_inventory& session::announced_blocks() const NOEXCEPT
+{
+    return node_.announced_blocks();
+}
+
+block_claims& session::claims() const NOEXCEPT
+{
+    return node_.claims();
+}
+
+worker_shares& session::shares() const NOEXCEPT
+{
+    return node_.shares();
+}
+
+filter_checkpoints& session::checkpointed_filters() const NOEXCEPT
+{
+    return node_.checkpointed_filters();
+}
+
+peer_scores& session::scores() const NOEXCEPT
+{
+    return node_.scores();
+}
+
 bool session::is_current() const NOEXCEPT
 {
     return node_.is_current();
@@ -63,14 +63,14 @@ session_outbound::session_outbound(full_node& node,
 void session_outbound::start(result_handler&& handler) NOEXCEPT
 {
     // Events subscription is synchronous (session).
-    subscribe_events(BIND(handle_event, _1, _2, _3));
+    subscribe_events(BIND(handle_event, _1, _2, _3, _4));
 
     network::session_outbound::start(std::move(handler));
 }
 
 // Event subscriber operates on the network strand (session).
 bool session_outbound::handle_event(const code&, chase event_,
-    event_value value) NOEXCEPT
+    event_value value, const event_payload& payload) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
@@ -85,6 +85,18 @@ bool session_outbound::handle_event(const code&, chase event_,
             do_starved(possible_narrow_cast<object_t>(value));
             break;
         }
+        case chase::tune:
+        {
+            if (!payload)
+                break;
+
+            const auto& setting = *payload_cast<tuning>(payload);
+            float value{};
+            if (setting.name == "allowed_deviation" && setting.real(value))
+                allowed_deviation_ = value;
+
+            break;
+        }
         case chase::stop:
         {
             return false;
@@ -104,31 +116,43 @@ void session_outbound::do_starved(object_t self) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    // Remove the starved channel to prevent self-selection.
-    if (speeds_.find(self) != speeds_.end())
-        speeds_.erase(self);
+    // Starvation arrives in bursts, which are split together once posted.
+    starved_.push_back(self);
+    if (starved_.size() == one)
+        boost::asio::post(strand(), BIND(do_split));
+}
 
-    // Find the slowest reporting channel.
-    const auto slowest = std::min_element(speeds_.begin(), speeds_.end(),
-        [](const auto& left, const auto& right) NOEXCEPT
-        {
-            return left.second < right.second;
-        });
+void session_outbound::do_split() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped())
+        return;
+
+    const auto starved = std::move(starved_);
+    starved_.clear();
 
-    // Direct the slowest channel to split work and stop.
-    if (slowest != speeds_.end())
+    // Remove the starved channels to prevent self-selection.
+    for (const auto self: starved)
+        erase_speed(self);
+
+    // Direct the slowest channel to split work and stop, for each starved.
+    for (const auto self: starved)
     {
-        // Erase entry so less likely to be claimed again before stopping.
-        const auto slow = slowest->first;
-        speeds_.erase(slowest);
+        if (rates_.empty())
+        {
+            // With no speeds recorded there may still be channels with work.
+            node::session::notify(error::success, chase::stall, self);
+            return;
+        }
+
+        // Erase entry so not claimed again before stopping.
+        const auto slow = rates_.begin()->second;
+        erase_speed(slow);
 
         // Notify slow channel to split itself (in favor of 'self' channel).
         node::session::notify_one(slow, error::success, chase::split, self);
-        return;
     }
-
-    // With no speeds recorded there may still be channels with work.
-    node::session::notify(error::success, chase::stall, self);
 }
 
 // performance
@@ -154,7 +178,7 @@ void session_outbound::do_performance(object_key channel, uint64_t speed,
 
     if (speed == max_uint64)
     {
-        speeds_.erase(channel);
+        erase_speed(channel);
         handler(error::exhausted_channel);
         return;
     }
@@ -162,15 +186,13 @@ void session_outbound::do_performance(object_key channel, uint64_t speed,
     // Always remove record on stalled channel (and channel close).
     if (is_zero(speed))
     {
-        speeds_.erase(channel);
+        erase_speed(channel);
         handler(error::stalled_channel);
         return;
     }
 
-    // Floating point conversion.
-    BC_PUSH_WARNING(NO_STATIC_CAST)
-    speeds_[channel] = static_cast<double>(speed);
-    BC_POP_WARNING()
+    // The channel is judged by its moving average, which damps noise.
+    const auto average = set_speed(channel, speed);
 
     // Three elements are required to measure deviation, don't drop below.
     const auto count = speeds_.size();
@@ -180,34 +202,27 @@ void session_outbound::do_performance(object_key channel, uint64_t speed,
         return;
     }
 
-    const auto rate = std::accumulate(speeds_.begin(), speeds_.end(), 0.0,
-        [](double sum, const auto& element) NOEXCEPT
-        {
-            return sum + element.second;
-        });
-
+    const auto rate = sum_;
     const auto mean = rate / count;
-    if (speed >= mean)
+    if (average >= mean)
     {
         handler(error::success);
         return;
     }
 
-    const auto variance = std::accumulate(speeds_.begin(), speeds_.end(), 0.0,
-        [mean](double sum, const auto& element) NOEXCEPT
-        {
-            return sum + std::pow(element.second - mean, two);
-        }) / (sub1(count));
+    // Sample variance from maintained sums, clamped for rounding error.
+    const auto variance = std::max(0.0,
+        (squares_ - (rate * mean)) / sub1(count));
 
     const auto sdev = std::sqrt(variance);
-    const auto slow = (mean - speed) > (allowed_deviation_ * sdev);
+    const auto slow = (mean - average) > (allowed_deviation_ * sdev);
 
     // Only speed < mean channels are logged.
     LOGV("Below average channel (" << count << ") rate ("
         << to_kilobits_per_second(rate) << ") mean ("
         << to_kilobits_per_second(mean) << ") sdev ("
         << to_kilobits_per_second(sdev) << ") Kbps [" << (slow ? "*" : "")
-        << to_kilobits_per_second(speed) << "].");
+        << to_kilobits_per_second(average) << "].");
 
     if (slow)
     {
@@ -218,6 +233,59 @@ void session_outbound::do_performance(object_key channel, uint64_t speed,
     handler(error::success);
 }
 
+// Returns the updated moving average rate of the channel.
+double session_outbound::set_speed(object_key channel,
+    uint64_t speed) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    // Floating point conversion.
+    BC_PUSH_WARNING(NO_STATIC_CAST)
+    const auto value = static_cast<double>(speed);
+    BC_POP_WARNING()
+
+    const auto it = speeds_.find(channel);
+    if (it == speeds_.end())
+    {
+        speeds_.emplace(channel, rates_.emplace(value, channel));
+        sum_ += value;
+        squares_ += value * value;
+        return value;
+    }
+
+    const auto prior = it->second->first;
+    const auto average = prior + rate_weight * (value - prior);
+    rates_.erase(it->second);
+    it->second = rates_.emplace(average, channel);
+    sum_ += average - prior;
+    squares_ += average * average - prior * prior;
+    return average;
+}
+
+void session_outbound::erase_speed(object_key channel) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    const auto it = speeds_.find(channel);
+    if (it == speeds_.end())
+        return;
+
+    const auto prior = it->second->first;
+    rates_.erase(it->second);
+    speeds_.erase(it);
+
+    // Reset sums when empty, which clears accumulated rounding error.
+    if (speeds_.empty())
+    {
+        sum_ = {};
+        squares_ = {};
+        return;
+    }
+
+    sum_ -= prior;
+    squares_ -= prior * prior;
+}
+
 BC_POP_WARNING()
 
 } // namespace node
@@ -40,7 +40,9 @@ settings::settings() NOEXCEPT
     quitting{ false /*levels::quitting_defined*/ },
     objects{ false /*levels::objects_defined*/ },
     verbose{ false /*levels::verbose_defined*/ },
-    maximum_size{ 1'000'000_u32 }
+    binary_events{ false },
+    maximum_size{ 1'000'000_u32 },
+    flush_milliseconds{ 0 }
 {
 }
 
@@ -66,7 +68,14 @@ std::filesystem::path settings::log_file2() const NOEXCEPT
 std::filesystem::path settings::events_file() const NOEXCEPT
 {
     BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-    return path / "events.log";
+    return path / (binary_events ? "events.bin" : "events.log");
+    BC_POP_WARNING()
+}
+
+std::filesystem::path settings::trace_file() const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+    return path / "trace.json";
     BC_POP_WARNING()
 }
 
@@ -76,14 +85,62 @@ namespace node {
 
 settings::settings() NOEXCEPT
   : headers_first{ true },
+    cumulative_work{ true },
+    persist_tree{ false },
+    parallel_headers{ false },
+    parallel_blocks{ false },
+    auto_scale{ false },
+    coalesce_events{ false },
+    instrument_strands{ false },
+    snapshot_concurrent{ false },
+    warm_start{ false },
+    defer_witness{ false },
+    defer_strong{ false },
+    validate_candidates{ false },
     allowed_deviation{ 1.5 },
     snapshot_bytes{ 107'374'182'400 },
+    prevout_bytes{ 1'073'741'824 },
+    window_bytes{ 4'294'967'296 },
+    tree_bytes{ 268'435'456 },
+    preallocate_bytes{ 0 },
+    mempool_bytes{ 314'572'800 },
+    block_cache_bytes{ 67'108'864 },
     snapshot_valid{ 100'000 },
+    seen_headers{ 65'536 },
     maximum_height{ 0 },
     maximum_concurrency{ 50'000 },
+    maximum_backlog{ 100'000 },
     sample_period_seconds{ 10 },
+    metrics_port{ 0 },
+    query_connections{ 16 },
+    query_port{ 0 },
+    sibling_port{ 0 },
+    template_port{ 0 },
+    template_connections{ 8 },
+    query_threads{ 2 },
+    preferred_peers{ 0 },
     currency_window_minutes{ 60 },
-    threads{ 1 }
+    threads{ 1 },
+    populate_threads{ 0 },
+    check_threads{ 4 },
+    confirm_threads{ 0 },
+    event_shards{ 4 },
+    trace_spans{ 0 },
+    storage_horizon_minutes{ 0 },
+    prefetch_blocks{ 0 },
+    admission_threads{ 4 },
+    script_cache_entries{ 100'000 },
+    announcement_milliseconds{ 5'000 },
+    tip_blocks{ 0 },
+    download_bytes_per_second{ 0 },
+    memory_bytes{ 0 },
+    history_threads{ 0 },
+    bootstrap_path{},
+    headers_path{},
+    sibling_host{},
+    serve_address{ "127.0.0.1" },
+    validate_affinity{},
+    network_affinity{}
 {
 }
 
@@ -103,6 +160,11 @@ size_t settings::maximum_concurrency_() const NOEXCEPT
     return to_bool(maximum_concurrency) ? maximum_concurrency : max_size_t;
 }
 
+size_t settings::maximum_backlog_() const NOEXCEPT
+{
+    return to_bool(maximum_backlog) ? maximum_backlog : max_size_t;
+}
+
 network::steady_clock::duration settings::sample_period() const NOEXCEPT
 {
     return network::seconds(sample_period_seconds);
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/span_tracer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+constexpr auto relaxed = std::memory_order_relaxed;
+
+// The span kind is the high byte of the tag, the height is the remainder.
+constexpr auto height_bits = to_bits(sizeof(uint64_t) - sizeof(uint8_t));
+constexpr auto height_mask = sub1(power2<uint64_t>(height_bits));
+
+// Distinguishes tracer instances in the per-thread ring cache.
+static std::atomic_uint64_t instances{};
+
+// Indexed by span_tracer::span (Chrome trace event names).
+static const std::array<std::string, 7> span_names
+{
+    "download",
+    "check",
+    "archive",
+    "populate",
+    "validate_tx",
+    "confirm",
+    "snapshot"
+};
+
+span_tracer::span_tracer(size_t capacity) NOEXCEPT
+  : capacity_(capacity),
+    instance_(add1(instances.fetch_add(one, relaxed))),
+    epoch_(clock::now()),
+    rings_(is_zero(capacity) ? zero : threads)
+{
+    static_assert(span_names.size() == static_cast<size_t>(span::count));
+
+    for (auto& ring: rings_)
+        ring.entries = std::vector<entry>(capacity_);
+}
+
+bool span_tracer::enabled() const NOEXCEPT
+{
+    return !is_zero(capacity_);
+}
+
+uint64_t span_tracer::now() const NOEXCEPT
+{
+    if (!enabled())
+        return zero;
+
+    using namespace std::chrono;
+    const auto elapsed = duration_cast<microseconds>(clock::now() - epoch_);
+    return to_unsigned(elapsed.count());
+}
+
+void span_tracer::record(span kind, uint64_t start, size_t height) NOEXCEPT
+{
+    const auto ring = local();
+    if (is_null(ring))
+        return;
+
+    // The owning thread is the only writer of its ring.
+    const auto end = now();
+    const auto head = ring->head.load(relaxed);
+    auto& entry = ring->entries[head % capacity_];
+    entry.start.store(start, relaxed);
+    entry.duration.store(end > start ? end - start : zero, relaxed);
+    entry.tag.store((uint64_t{ static_cast<uint8_t>(kind) } << height_bits) |
+        (height & height_mask), relaxed);
+    ring->head.store(add1(head), std::memory_order_release);
+}
+
+const std::string& span_tracer::span_name(span kind) NOEXCEPT
+{
+    return span_names[static_cast<size_t>(kind)];
+}
+
+// Threads (tid) are numbered in order of their first recorded span.
+std::string span_tracer::report() const NOEXCEPT
+{
+    std::ostringstream out{};
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    auto first = true;
+    const auto used = std::min(next_.load(relaxed), rings_.size());
+    for (size_t thread = 0; thread < used; ++thread)
+    {
+        const auto& ring = rings_[thread];
+        const auto head = ring.head.load(std::memory_order_acquire);
+        const auto begin = head > capacity_ ? head - capacity_ : zero;
+        for (auto index = begin; index < head; ++index)
+        {
+            const auto& entry = ring.entries[index % capacity_];
+            const auto tag = entry.tag.load(relaxed);
+            const auto kind = tag >> height_bits;
+            if (kind >= span_names.size())
+                continue;
+
+            out << (first ? "" : ",")
+                << "{\"name\":\"" << span_names[kind] << "\""
+                << ",\"cat\":\"node\",\"ph\":\"X\",\"pid\":1"
+                << ",\"tid\":" << thread
+                << ",\"ts\":" << entry.start.load(relaxed)
+                << ",\"dur\":" << entry.duration.load(relaxed)
+                << ",\"args\":{\"height\":" << (tag & height_mask) << "}}";
+            first = false;
+        }
+    }
+
+    out << "]}\n";
+    return out.str();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Each thread claims a ring upon its first span, null if disabled or full.
+span_tracer::ring* span_tracer::local() NOEXCEPT
+{
+    if (!enabled())
+        return nullptr;
+
+    thread_local uint64_t owner{};
+    thread_local ring* cached{};
+    if (owner != instance_)
+    {
+        const auto index = next_.fetch_add(one, relaxed);
+        cached = index < rings_.size() ? &rings_[index] : nullptr;
+        owner = instance_;
+    }
+
+    return cached;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
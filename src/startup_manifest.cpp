@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/startup_manifest.hpp>
+
+#include <charconv>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+constexpr auto candidate_hash_name = "candidate_hash";
+constexpr auto candidate_height_name = "candidate_height";
+constexpr auto confirmed_height_name = "confirmed_height";
+constexpr auto checked_height_name = "checked_height";
+
+static bool to_height(size_t& out, const std::string& text) NOEXCEPT
+{
+    const auto end = std::next(text.data(), text.size());
+    const auto result = std::from_chars(text.data(), end, out);
+    return result.ec == std::errc{} && result.ptr == end;
+}
+
+std::string startup_manifest::to_string() const NOEXCEPT
+{
+    std::ostringstream out{};
+    out << candidate_hash_name << " " << encode_hash(candidate_hash) << "\n"
+        << candidate_height_name << " " << candidate_height << "\n"
+        << confirmed_height_name << " " << confirmed_height << "\n"
+        << checked_height_name << " " << checked_height << "\n";
+    return out.str();
+}
+
+bool startup_manifest::from_string(const std::string& text,
+    startup_manifest& out) NOEXCEPT
+{
+    std::istringstream in{ text };
+    std::string name{};
+    std::string value{};
+    size_t found{};
+    while (in >> name >> value)
+    {
+        if (name == candidate_hash_name)
+        {
+            if (!decode_hash(out.candidate_hash, value))
+                return false;
+
+            found |= 1u;
+        }
+        else if (name == candidate_height_name)
+        {
+            if (!to_height(out.candidate_height, value))
+                return false;
+
+            found |= 2u;
+        }
+        else if (name == confirmed_height_name)
+        {
+            if (!to_height(out.confirmed_height, value))
+                return false;
+
+            found |= 4u;
+        }
+        else if (name == checked_height_name)
+        {
+            if (!to_height(out.checked_height, value))
+                return false;
+
+            found |= 8u;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // Each value is required.
+    return found == 0x0fu;
+}
+
+bool startup_manifest::save(const std::filesystem::path& file) const NOEXCEPT
+{
+    system::ofstream sink{ file };
+    sink << to_string();
+    sink.flush();
+    return sink.good();
+}
+
+bool startup_manifest::load(const std::filesystem::path& file,
+    startup_manifest& out) NOEXCEPT
+{
+    std::string text{};
+    {
+        system::ifstream source{ file };
+        if (!source.good())
+            return false;
+
+        std::ostringstream buffer{};
+        buffer << source.rdbuf();
+        text = buffer.str();
+    }
+
+    std::error_code ec{};
+    std::filesystem::remove(file, ec);
+    return !ec && from_string(text, out);
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,533 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/store_archive.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <bitcoin/network.hpp>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+namespace fs = std::filesystem;
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+struct entry
+{
+    fs::path relative;
+    uint64_t bytes;
+};
+
+// Sibling requests are a file index, or this value for the manifest.
+constexpr auto manifest = max_uint32;
+constexpr size_t chunk_bytes = 1'048'576;
+constexpr uint32_t maximum_entries = max_uint16;
+constexpr auto accept_poll = std::chrono::milliseconds{ 100 };
+constexpr auto io_timeout = std::chrono::seconds{ 30 };
+
+// Idle limit of blocking reads or writes of a socket (SettableSocketOption).
+template <int Name>
+class timeout
+{
+public:
+    timeout(const std::chrono::seconds& value) NOEXCEPT
+#if defined(HAVE_MSC)
+      : value_(possible_narrow_cast<DWORD>(value.count() * 1'000))
+#else
+      : value_{ value.count(), 0 }
+#endif
+    {
+    }
+
+    template <typename Protocol>
+    int level(const Protocol&) const NOEXCEPT
+    {
+        return SOL_SOCKET;
+    }
+
+    template <typename Protocol>
+    int name(const Protocol&) const NOEXCEPT
+    {
+        return Name;
+    }
+
+    template <typename Protocol>
+    const void* data(const Protocol&) const NOEXCEPT
+    {
+        return &value_;
+    }
+
+    template <typename Protocol>
+    size_t size(const Protocol&) const NOEXCEPT
+    {
+        return sizeof(value_);
+    }
+
+private:
+#if defined(HAVE_MSC)
+    DWORD value_;
+#else
+    timeval value_;
+#endif
+};
+
+static bool set_timeouts(tcp::socket& socket) NOEXCEPT
+{
+    boost::system::error_code ec{};
+    socket.set_option(timeout<SO_RCVTIMEO>{ io_timeout }, ec);
+    if (!ec)
+        socket.set_option(timeout<SO_SNDTIMEO>{ io_timeout }, ec);
+
+    return !ec;
+}
+
+// Directories and files of the tree, files largest first.
+static bool list(std::vector<fs::path>& directories,
+    std::vector<entry>& files, const fs::path& from) NOEXCEPT
+{
+    std::error_code ec{};
+    if (!fs::is_directory(from, ec))
+        return false;
+
+    fs::recursive_directory_iterator it{ from, ec }, end{};
+    for (; !ec && it != end; it.increment(ec))
+    {
+        const auto relative = fs::relative(it->path(), from, ec);
+        if (ec)
+            break;
+
+        if (it->is_directory(ec))
+            directories.push_back(relative);
+        else if (it->is_regular_file(ec))
+            files.push_back({ relative, it->file_size(ec) });
+    }
+
+    std::sort(files.begin(), files.end(), [](const auto& a, const auto& b)
+    {
+        return a.bytes > b.bytes;
+    });
+
+    return !ec;
+}
+
+// A served path must remain within the target.
+static bool is_contained(const fs::path& relative) NOEXCEPT
+{
+    return !relative.empty() && relative.is_relative() &&
+        std::none_of(relative.begin(), relative.end(), [](const auto& part)
+        {
+            return part == "..";
+        });
+}
+
+template <typename Integer>
+static bool put(tcp::socket& socket, Integer value) NOEXCEPT
+{
+    boost::system::error_code ec{};
+    const auto bytes = to_little_endian(value);
+    asio::write(socket, asio::buffer(bytes), ec);
+    return !ec;
+}
+
+template <typename Integer>
+static bool get(tcp::socket& socket, Integer& out) NOEXCEPT
+{
+    boost::system::error_code ec{};
+    data_array<sizeof(Integer)> bytes{};
+    asio::read(socket, asio::buffer(bytes), ec);
+    out = from_little_endian<Integer>(bytes);
+    return !ec;
+}
+
+static bool put_path(tcp::socket& socket, const fs::path& path) NOEXCEPT
+{
+    boost::system::error_code ec{};
+    const auto text = path.generic_string();
+    if (text.size() > max_uint16 ||
+        !put(socket, possible_narrow_cast<uint16_t>(text.size())))
+        return false;
+
+    asio::write(socket, asio::buffer(text), ec);
+    return !ec;
+}
+
+static bool get_path(tcp::socket& socket, fs::path& out) NOEXCEPT
+{
+    uint16_t size{};
+    if (!get(socket, size))
+        return false;
+
+    boost::system::error_code ec{};
+    std::string text(size, '\0');
+    asio::read(socket, asio::buffer(text), ec);
+    out = fs::path{ text }.lexically_normal();
+    return !ec && is_contained(out);
+}
+
+// Manifest is directories then files (with sizes), in claim order.
+static bool put_manifest(tcp::socket& socket,
+    const std::vector<fs::path>& directories,
+    const std::vector<entry>& files) NOEXCEPT
+{
+    if (!put(socket, possible_narrow_cast<uint32_t>(directories.size())))
+        return false;
+
+    for (const auto& directory: directories)
+        if (!put_path(socket, directory))
+            return false;
+
+    if (!put(socket, possible_narrow_cast<uint32_t>(files.size())))
+        return false;
+
+    for (const auto& file: files)
+        if (!put_path(socket, file.relative) || !put(socket, file.bytes))
+            return false;
+
+    return true;
+}
+
+static bool get_manifest(tcp::socket& socket,
+    std::vector<fs::path>& directories, std::vector<entry>& files) NOEXCEPT
+{
+    uint32_t count{};
+    if (!get(socket, count) || count > maximum_entries)
+        return false;
+
+    directories.resize(count);
+    for (auto& directory: directories)
+        if (!get_path(socket, directory))
+            return false;
+
+    if (!get(socket, count) || count > maximum_entries)
+        return false;
+
+    files.resize(count);
+    for (auto& file: files)
+        if (!get_path(socket, file.relative) || !get(socket, file.bytes))
+            return false;
+
+    return true;
+}
+
+// File is its size then its bytes, read from the file in chunks.
+// Streaming stops at the next chunk once cancel is set.
+static bool put_file(tcp::socket& socket, const fs::path& path,
+    const std::atomic_bool& cancel) NOEXCEPT
+{
+    std::error_code fault{};
+    const auto bytes = fs::file_size(path, fault);
+    if (fault || !put(socket, possible_wide_cast<uint64_t>(bytes)))
+        return false;
+
+    std::ifstream source{ path, std::ios::binary };
+    std::vector<char> buffer(chunk_bytes);
+    uint64_t sent{};
+    while (!cancel && sent < bytes &&
+        source.read(buffer.data(), buffer.size()).gcount())
+    {
+        boost::system::error_code ec{};
+        const auto size = possible_narrow_cast<size_t>(source.gcount());
+        asio::write(socket, asio::buffer(buffer.data(), size), ec);
+        if (ec)
+            return false;
+
+        sent += size;
+    }
+
+    return sent == bytes;
+}
+
+static bool get_file(tcp::socket& socket, const fs::path& path,
+    uint64_t expected) NOEXCEPT
+{
+    uint64_t bytes{};
+    if (!get(socket, bytes) || bytes != expected)
+        return false;
+
+    std::ofstream sink{ path, std::ios::binary | std::ios::trunc };
+    std::vector<char> buffer(chunk_bytes);
+    while (sink && !is_zero(bytes))
+    {
+        boost::system::error_code ec{};
+        const auto size = possible_narrow_cast<size_t>(std::min(bytes,
+            possible_wide_cast<uint64_t>(buffer.size())));
+
+        asio::read(socket, asio::buffer(buffer.data(), size), ec);
+        if (ec)
+            return false;
+
+        sink.write(buffer.data(), size);
+        bytes -= size;
+    }
+
+    sink.flush();
+    return !sink.fail();
+}
+
+code store_archive::copy(const fs::path& from, const fs::path& to,
+    size_t threads, const progress& handler) NOEXCEPT
+{
+    std::error_code ec{};
+    if (!fs::is_directory(from, ec) || fs::exists(to, ec) ||
+        !fs::create_directories(to, ec))
+        return error::store_archive;
+
+    // Directories are created up front, so workers only copy files.
+    std::vector<fs::path> directories{};
+    std::vector<entry> files{};
+    if (!list(directories, files, from))
+        return error::store_archive;
+
+    for (const auto& directory: directories)
+    {
+        fs::create_directories(to / directory, ec);
+        if (ec)
+            return error::store_archive;
+    }
+
+    std::mutex mutex{};
+    std::atomic_size_t next{};
+    std::atomic_bool failed{};
+    const auto worker = [&]() NOEXCEPT
+    {
+        for (auto index = next++; !failed && index < files.size();
+            index = next++)
+        {
+            const auto& file = files.at(index);
+            std::error_code fault{};
+            if (!fs::copy_file(from / file.relative, to / file.relative,
+                fault) || fault)
+            {
+                failed = true;
+                return;
+            }
+
+            std::unique_lock lock(mutex);
+            if (handler)
+                handler(file.relative, file.bytes);
+        }
+    };
+
+    const auto count = std::clamp(threads, one, std::max(files.size(), one));
+    std::vector<std::thread> workers{};
+    workers.reserve(count);
+    for (size_t thread = 0; thread < count; ++thread)
+        workers.emplace_back(worker);
+
+    for (auto& thread: workers)
+        thread.join();
+
+    return failed ? error::store_archive : error::success;
+}
+
+// Each thread accepts and serves one connection at a time, one request per
+// connection, so that connections are bounded by threads. The acceptor is
+// shared under a mutex, since it is polled (non-blocking) by each thread.
+code store_archive::serve(const fs::path& from, const std::string& address,
+    uint16_t port, size_t threads, const std::atomic_bool& cancel,
+    const progress& handler) NOEXCEPT
+{
+    std::vector<fs::path> directories{};
+    std::vector<entry> files{};
+    if (!list(directories, files, from))
+        return error::store_archive;
+
+    boost::system::error_code ec{};
+    const auto host = asio::ip::make_address(address, ec);
+    if (ec)
+        return error::store_sibling;
+
+    asio::io_context service{};
+    tcp::acceptor acceptor{ service };
+    const tcp::endpoint endpoint{ host, port };
+    acceptor.open(endpoint.protocol(), ec);
+    if (!ec)
+        acceptor.set_option(tcp::acceptor::reuse_address(true), ec);
+    if (!ec)
+        acceptor.bind(endpoint, ec);
+    if (!ec)
+        acceptor.listen(asio::socket_base::max_listen_connections, ec);
+    if (!ec)
+        acceptor.non_blocking(true, ec);
+    if (ec)
+        return error::store_sibling;
+
+    std::mutex mutex{};
+    const auto session = [&](tcp::socket& socket) NOEXCEPT
+    {
+        uint32_t index{};
+        if (!set_timeouts(socket) || !get(socket, index))
+            return;
+
+        if (index == manifest)
+        {
+            put_manifest(socket, directories, files);
+            return;
+        }
+
+        if (index >= files.size())
+            return;
+
+        const auto& file = files.at(index);
+        if (put_file(socket, from / file.relative, cancel))
+        {
+            std::unique_lock lock(mutex);
+            if (handler)
+                handler(file.relative, file.bytes);
+        }
+    };
+
+    // Polled so that cancel is observed without closing from another thread.
+    // The socket is closed as its session returns (timeout or cancel).
+    std::mutex accepting{};
+    std::atomic_bool failed{};
+    const auto worker = [&]() NOEXCEPT
+    {
+        while (!cancel && !failed)
+        {
+            boost::system::error_code error{};
+            tcp::socket socket{ service };
+            {
+                std::unique_lock lock(accepting);
+                acceptor.accept(socket, error);
+            }
+
+            if (error == asio::error::would_block ||
+                error == asio::error::try_again)
+            {
+                std::this_thread::sleep_for(accept_poll);
+                continue;
+            }
+
+            if (error)
+            {
+                failed = true;
+                return;
+            }
+
+            socket.non_blocking(false, error);
+            if (!error)
+                session(socket);
+        }
+    };
+
+    std::vector<std::thread> workers{};
+    workers.reserve(std::max(threads, one));
+    for (size_t thread = 0; thread < std::max(threads, one); ++thread)
+        workers.emplace_back(worker);
+
+    for (auto& thread: workers)
+        thread.join();
+
+    return failed ? error::store_sibling : error::success;
+}
+
+code store_archive::fetch(const std::string& host, uint16_t port,
+    const fs::path& to, size_t threads, const progress& handler) NOEXCEPT
+{
+    std::error_code fault{};
+    if (fs::exists(to, fault) || !fs::create_directories(to, fault))
+        return error::store_archive;
+
+    boost::system::error_code ec{};
+    asio::io_context service{};
+    tcp::resolver resolver{ service };
+    const auto endpoints = resolver.resolve(host, std::to_string(port), ec);
+    if (ec)
+        return error::store_sibling;
+
+    const auto request = [&](tcp::socket& socket, uint32_t index) NOEXCEPT
+    {
+        boost::system::error_code error{};
+        asio::connect(socket, endpoints, error);
+        return !error && put(socket, index);
+    };
+
+    std::vector<fs::path> directories{};
+    std::vector<entry> files{};
+    tcp::socket socket{ service };
+    if (!request(socket, manifest) ||
+        !get_manifest(socket, directories, files))
+        return error::store_sibling;
+
+    for (const auto& directory: directories)
+    {
+        fs::create_directories(to / directory, fault);
+        if (fault)
+            return error::store_archive;
+    }
+
+    // Files are requested in the served order (largest first) by index.
+    std::mutex mutex{};
+    std::atomic_size_t next{};
+    std::atomic_bool failed{};
+    const auto worker = [&]() NOEXCEPT
+    {
+        for (auto index = next++; !failed && index < files.size();
+            index = next++)
+        {
+            const auto& file = files.at(index);
+            const auto target = to / file.relative;
+            tcp::socket connection{ service };
+            std::error_code error{};
+            fs::create_directories(target.parent_path(), error);
+            if (error || !request(connection,
+                possible_narrow_cast<uint32_t>(index)) ||
+                !get_file(connection, target, file.bytes))
+            {
+                failed = true;
+                return;
+            }
+
+            std::unique_lock lock(mutex);
+            if (handler)
+                handler(file.relative, file.bytes);
+        }
+    };
+
+    const auto count = std::clamp(threads, one, std::max(files.size(), one));
+    std::vector<std::thread> workers{};
+    workers.reserve(count);
+    for (size_t thread = 0; thread < count; ++thread)
+        workers.emplace_back(worker);
+
+    for (auto& thread: workers)
+        thread.join();
+
+    return failed ? error::store_sibling : error::success;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
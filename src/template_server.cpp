@@ -0,0 +1,275 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/template_server.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/block_template.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace std::placeholders;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_VALUE_OR_CONST_REF_SHARED_PTR)
+BC_PUSH_WARNING(SMART_PTR_NOT_NEEDED)
+
+template_server::connection::connection(tcp::socket&& socket) NOEXCEPT
+  : socket(std::move(socket))
+{
+}
+
+template_server::template_server(query& query, size_t connections) NOEXCEPT
+  : query_(query),
+    connections_(std::max(connections, one)),
+    pool_(one),
+    strand_(pool_.service().get_executor()),
+    acceptor_(pool_.service(), strand_)
+{
+}
+
+code template_server::start(uint16_t port) NOEXCEPT
+{
+    if (is_zero(port))
+        return error::success;
+
+    return acceptor_.start(port,
+        std::bind(&template_server::handle_accept, this, _1)) ?
+            error::success : error::template_bind;
+}
+
+void template_server::publish(size_t height,
+    const block_template::assembly::cptr& assembly) NOEXCEPT
+{
+    boost::asio::post(strand_,
+        std::bind(&template_server::do_publish, this, height, assembly));
+}
+
+// Reads must complete before the store is closed, so the thread is joined.
+// Sockets are closed once no thread remains to run their handlers.
+void template_server::stop() NOEXCEPT
+{
+    pool_.stop();
+    pool_.join();
+
+    acceptor_.stop();
+
+    boost::system::error_code ignore{};
+    for (const auto& client: clients_)
+        client->socket.close(ignore);
+
+    clients_.clear();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// A new client is sent the current parent and all txs of the template.
+void template_server::handle_accept(tcp::socket&& socket) NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    boost::system::error_code ignore{};
+    if (clients_.size() >= connections_)
+    {
+        socket.close(ignore);
+        return;
+    }
+
+    // Pushes are latency sensitive, so small writes are not coalesced.
+    socket.set_option(tcp::no_delay(true), ignore);
+
+    const auto client = std::make_shared<connection>(std::move(socket));
+    clients_.insert(client);
+    client->socket.async_read_some(boost::asio::buffer(client->discard),
+        boost::asio::bind_executor(strand_,
+            std::bind(&template_server::handle_read, this, _1, client)));
+
+    if (assembly_)
+        send(client, std::make_shared<const std::string>(
+            to_prevhash(height_, prevhash_) +
+            to_update(assembly_->fees, {}, assembly_->txs)));
+}
+
+// Client data is discarded, the read only detects disconnection.
+void template_server::handle_read(const boost::system::error_code& ec,
+    const connection::ptr& connection) NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    if (ec)
+    {
+        drop(connection);
+        return;
+    }
+
+    connection->socket.async_read_some(boost::asio::buffer(
+        connection->discard),
+            boost::asio::bind_executor(strand_,
+                std::bind(&template_server::handle_read, this, _1,
+                    connection)));
+}
+
+// The change from the prior template is serialized once for all clients.
+void template_server::do_publish(size_t height,
+    const block_template::assembly::cptr& assembly) NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    if (!acceptor_.is_open() || !assembly)
+        return;
+
+    std::string out{};
+    if (height != height_)
+    {
+        height_ = height;
+        prevhash_ = query_.get_header_key(query_.to_confirmed(sub1(height)));
+        out += to_prevhash(height_, prevhash_);
+    }
+
+    hash_set hashes{};
+    chain::transaction_cptrs added{};
+    for (const auto& tx: assembly->txs)
+    {
+        const auto hash = tx->hash(false);
+        if (!hashes_.contains(hash))
+            added.push_back(tx);
+
+        hashes.insert(hash);
+    }
+
+    system::hashes removed{};
+    for (const auto& hash: hashes_)
+        if (!hashes.contains(hash))
+            removed.push_back(hash);
+
+    if (!assembly_ || assembly_->fees != assembly->fees || !added.empty() ||
+        !removed.empty())
+        out += to_update(assembly->fees, removed, added);
+
+    assembly_ = assembly;
+    hashes_ = std::move(hashes);
+    if (out.empty())
+        return;
+
+    // A client may be dropped by send, so the set is not iterated.
+    const auto shared = std::make_shared<const std::string>(std::move(out));
+    const std::vector<connection::ptr> clients{ clients_.begin(),
+        clients_.end() };
+
+    for (const auto& client: clients)
+        send(client, shared);
+}
+
+void template_server::send(const connection::ptr& connection,
+    const message& data) NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    auto& queue = connection->queue;
+    if (queue.size() >= maximum_queue)
+    {
+        drop(connection);
+        return;
+    }
+
+    queue.push_back(data);
+    if (is_one(queue.size()))
+        write(connection);
+}
+
+void template_server::write(const connection::ptr& connection) NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    boost::asio::async_write(connection->socket,
+        boost::asio::buffer(*connection->queue.front()),
+            boost::asio::bind_executor(strand_,
+                std::bind(&template_server::handle_write, this, _1,
+                    connection)));
+}
+
+void template_server::handle_write(const boost::system::error_code& ec,
+    const connection::ptr& connection) NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    if (ec)
+    {
+        drop(connection);
+        return;
+    }
+
+    auto& queue = connection->queue;
+    queue.pop_front();
+    if (!queue.empty())
+        write(connection);
+}
+
+// Pending handlers are aborted by the close, and find the client dropped.
+void template_server::drop(const connection::ptr& connection) NOEXCEPT
+{
+    BC_ASSERT(strand_.running_in_this_thread());
+
+    if (is_zero(clients_.erase(connection)))
+        return;
+
+    boost::system::error_code ignore{};
+    connection->socket.close(ignore);
+}
+
+std::string template_server::to_prevhash(size_t height,
+    const hash_digest& hash) NOEXCEPT
+{
+    std::ostringstream out{};
+    out << "prevhash " << height << " " << encode_hash(hash) << "\n";
+    return out.str();
+}
+
+std::string template_server::to_update(uint64_t fees, const hashes& removed,
+    const chain::transaction_cptrs& added) NOEXCEPT
+{
+    std::ostringstream out{};
+    out << "update " << fees << " " << removed.size() << " " << added.size()
+        << "\n";
+
+    for (const auto& hash: removed)
+        out << encode_hash(hash) << "\n";
+
+    for (const auto& tx: added)
+        out << encode_base16(tx->to_data(true)) << "\n";
+
+    return out.str();
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/thread_affinity.hpp>
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+#if defined(HAVE_LINUX)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Binding jobs that do not all start within this time are abandoned.
+constexpr std::chrono::seconds bind_timeout{ 5 };
+constexpr auto numa_prefix = "numa:";
+constexpr size_t maximum_core = 4095;
+
+static bool parse_number(size_t& out, const std::string& text) NOEXCEPT
+{
+    const auto end = std::next(text.data(), text.size());
+    const auto result = std::from_chars(text.data(), end, out);
+    return !text.empty() && result.ec == std::errc{} && result.ptr == end;
+}
+
+static bool parse_list(thread_affinity::cores& out,
+    const std::string& text) NOEXCEPT
+{
+    std::istringstream stream{ text };
+    std::string token{};
+    while (std::getline(stream, token, ','))
+    {
+        size_t first{};
+        size_t last{};
+        const auto dash = token.find('-');
+        const auto from = trim_copy(token.substr(zero, dash));
+        const auto to = (dash == std::string::npos) ? from :
+            trim_copy(token.substr(add1(dash)));
+
+        if (!parse_number(first, from) || !parse_number(last, to) ||
+            last < first || last > maximum_core)
+            return false;
+
+        for (auto core = first; core <= last; ++core)
+            out.push_back(core);
+    }
+
+    return true;
+}
+
+bool thread_affinity::parse(cores& out, const std::string& text) NOEXCEPT
+{
+    out.clear();
+    const auto value = trim_copy(text);
+    if (value.empty())
+        return true;
+
+    if (!value.starts_with(numa_prefix))
+        return parse_list(out, value);
+
+    // The kernel publishes the cores of each NUMA node as a core list.
+    size_t node{};
+    if (!parse_number(node, value.substr(std::string{ numa_prefix }.size())))
+        return false;
+
+    std::ifstream file{ "/sys/devices/system/node/node" +
+        std::to_string(node) + "/cpulist" };
+
+    std::string list{};
+    return std::getline(file, list) && parse_list(out, trim_copy(list)) &&
+        !out.empty();
+}
+
+bool thread_affinity::bind(boost::asio::io_context& service, size_t count,
+    const cores& set) NOEXCEPT
+{
+#if defined(HAVE_LINUX)
+    if (set.empty() || is_zero(count))
+        return true;
+
+    cpu_set_t mask{};
+    CPU_ZERO(&mask);
+    for (const auto core: set)
+        if (core < CPU_SETSIZE)
+            CPU_SET(core, &mask);
+
+    // Shared with jobs that may outlive a timed out call.
+    struct state
+    {
+        std::mutex mutex{};
+        std::condition_variable started{};
+        size_t pending{};
+        std::atomic_bool failed{};
+    };
+
+    const auto shared = std::make_shared<state>();
+    shared->pending = count;
+
+    // Each job holds its thread until all jobs have started, so that every
+    // thread of the pool runs exactly one job.
+    for (size_t job = 0; job < count; ++job)
+    {
+        boost::asio::post(service, [shared, mask]() NOEXCEPT
+        {
+            if (!is_zero(::pthread_setaffinity_np(::pthread_self(),
+                sizeof(mask), &mask)))
+                shared->failed.store(true);
+
+            std::unique_lock lock(shared->mutex);
+            if (is_zero(--shared->pending))
+                shared->started.notify_all();
+            else
+                shared->started.wait_for(lock, bind_timeout, [&]() NOEXCEPT
+                {
+                    return is_zero(shared->pending);
+                });
+        });
+    }
+
+    std::unique_lock lock(shared->mutex);
+    const auto done = shared->started.wait_for(lock, bind_timeout,
+        [&]() NOEXCEPT
+        {
+            return is_zero(shared->pending);
+        });
+
+    return done && !shared->failed.load();
+#else
+    return set.empty();
+#endif
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,391 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/tx_pool.hpp>
+
+#include <algorithm>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace system::chain;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Map nodes, graph links, order keys and shared pointer (approximate).
+constexpr uint64_t entry_overhead = 512;
+
+tx_pool::tx_pool(uint64_t maximum_bytes) NOEXCEPT
+  : maximum_bytes_(maximum_bytes)
+{
+}
+
+bool tx_pool::enabled() const NOEXCEPT
+{
+    return !is_zero(maximum_bytes_);
+}
+
+size_t tx_pool::count() const NOEXCEPT
+{
+    return entries_.size();
+}
+
+uint64_t tx_pool::bytes() const NOEXCEPT
+{
+    return bytes_;
+}
+
+bool tx_pool::exists(const hash_digest& hash) const NOEXCEPT
+{
+    return entries_.contains(hash);
+}
+
+transaction::cptr tx_pool::get(const hash_digest& hash) const NOEXCEPT
+{
+    const auto it = entries_.find(hash);
+    return it == entries_.end() ? nullptr : it->second.tx;
+}
+
+hash_digest tx_pool::spender(const point& point) const NOEXCEPT
+{
+    const auto it = spends_.find({ point.hash(), point.index() });
+    return it == spends_.end() ? null_hash : it->second;
+}
+
+bool tx_pool::populate(const transaction& tx) const NOEXCEPT
+{
+    auto complete = true;
+    for (const auto& in: *tx.inputs_ptr())
+    {
+        const auto& point = in->point();
+        if (in->prevout || point.is_null())
+            continue;
+
+        const auto it = entries_.find(point.hash());
+        if (it == entries_.end() ||
+            point.index() >= it->second.tx->outputs_ptr()->size())
+        {
+            complete = false;
+            continue;
+        }
+
+        in->prevout = it->second.tx->outputs_ptr()->at(point.index());
+    }
+
+    return complete;
+}
+
+code tx_pool::add(const transaction::cptr& tx, uint64_t fee,
+    size_t sigops) NOEXCEPT
+{
+    if (!enabled())
+        return error::pool_full;
+
+    const auto hash = tx->hash(false);
+    if (exists(hash))
+        return error::pool_duplicate;
+
+    hashes parents{};
+    for (const auto& in: *tx->inputs_ptr())
+    {
+        const auto& point = in->point();
+        if (spends_.contains({ point.hash(), point.index() }))
+            return error::pool_conflict;
+
+        if (exists(point.hash()) && std::find(parents.begin(),
+            parents.end(), point.hash()) == parents.end())
+            parents.push_back(point.hash());
+    }
+
+    // Ancestors (and their descendants) are bounded including this tx.
+    hash_set ancestry{};
+    for (const auto& parent: parents)
+    {
+        ancestry.insert(parent);
+        ancestry.merge(collect(parent, true));
+    }
+
+    if (ancestry.size() >= maximum_package)
+        return error::pool_package;
+
+    for (const auto& ancestor: ancestry)
+        if (entries_.at(ancestor).descendants.count >= maximum_package)
+            return error::pool_package;
+
+    const package self{ one, tx->virtual_size(), fee, sigops };
+    auto aggregate = self;
+    for (const auto& ancestor: ancestry)
+        add(aggregate, entries_.at(ancestor).self);
+
+    const auto bytes = footprint(*tx);
+    entries_.emplace(hash, entry{ hash, tx, self, bytes, parents, {},
+        aggregate, self });
+    by_ancestors_.insert({ rate(aggregate), hash });
+    by_descendants_.insert({ rate(self), hash });
+    changed_.insert(hash);
+    removed_.erase(hash);
+    bytes_ += bytes;
+
+    for (const auto& ancestor: ancestry)
+    {
+        auto& value = entries_.at(ancestor);
+        auto descendants = value.descendants;
+        add(descendants, self);
+        set_descendants(value, descendants);
+    }
+
+    for (const auto& parent: parents)
+        entries_.at(parent).children.push_back(hash);
+
+    for (const auto& in: *tx->inputs_ptr())
+        spends_.emplace(point_key{ in->point().hash(), in->point().index() },
+            hash);
+
+    // Evict lowest fee-rate packages, which may include the new tx.
+    while (bytes_ > maximum_bytes_ && !by_descendants_.empty())
+    {
+        const auto low = by_descendants_.begin()->hash;
+        remove(low);
+    }
+
+    return exists(hash) ? error::success : error::pool_full;
+}
+
+size_t tx_pool::confirm(const transaction& tx) NOEXCEPT
+{
+    size_t removed{};
+    const auto hash = tx.hash(false);
+    const auto it = entries_.find(hash);
+    if (it != entries_.end())
+    {
+        const auto self = it->second.self;
+        for (const auto& ancestor: collect(hash, true))
+        {
+            auto& value = entries_.at(ancestor);
+            auto descendants = value.descendants;
+            subtract(descendants, self);
+            set_descendants(value, descendants);
+        }
+
+        for (const auto& descendant: collect(hash, false))
+        {
+            auto& value = entries_.at(descendant);
+            auto ancestors = value.ancestors;
+            subtract(ancestors, self);
+            set_ancestors(value, ancestors);
+        }
+
+        erase(hash);
+        ++removed;
+    }
+
+    // Any remaining spender of a confirmed outpoint is a conflict.
+    for (const auto& in: *tx.inputs_ptr())
+    {
+        const auto conflict = spender(in->point());
+        if (conflict != null_hash)
+            removed += remove(conflict);
+    }
+
+    return removed;
+}
+
+size_t tx_pool::remove(const hash_digest& hash) NOEXCEPT
+{
+    if (!exists(hash))
+        return zero;
+
+    auto package = collect(hash, false);
+    package.insert(hash);
+    return remove(package);
+}
+
+tx_pool::package tx_pool::ancestors(const hash_digest& hash) const NOEXCEPT
+{
+    const auto it = entries_.find(hash);
+    return it == entries_.end() ? package{} : it->second.ancestors;
+}
+
+tx_pool::package tx_pool::descendants(const hash_digest& hash) const NOEXCEPT
+{
+    const auto it = entries_.find(hash);
+    return it == entries_.end() ? package{} : it->second.descendants;
+}
+
+hash_digest tx_pool::lowest() const NOEXCEPT
+{
+    return by_descendants_.empty() ? null_hash :
+        by_descendants_.begin()->hash;
+}
+
+hash_digest tx_pool::highest() const NOEXCEPT
+{
+    return by_ancestors_.empty() ? null_hash :
+        by_ancestors_.rbegin()->hash;
+}
+
+tx_pool::changes tx_pool::drain() NOEXCEPT
+{
+    changes out{};
+    out.updated.reserve(changed_.size());
+    for (const auto& hash: changed_)
+    {
+        const auto& value = entries_.at(hash);
+        out.updated.push_back({ value.tx, value.parents, value.self,
+            value.ancestors });
+    }
+
+    out.removed.assign(removed_.begin(), removed_.end());
+    changed_.clear();
+    removed_.clear();
+    return out;
+}
+
+uint64_t tx_pool::rate(const package& value) NOEXCEPT
+{
+    constexpr uint64_t milli = 1'000;
+    return ceilinged_multiply(value.fee, milli) /
+        std::max(value.size, 1_u64);
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+void tx_pool::add(package& to, const package& value) NOEXCEPT
+{
+    to.count += value.count;
+    to.size += value.size;
+    to.fee += value.fee;
+    to.sigops += value.sigops;
+}
+
+void tx_pool::subtract(package& from, const package& value) NOEXCEPT
+{
+    from.count = floored_subtract(from.count, value.count);
+    from.size = floored_subtract(from.size, value.size);
+    from.fee = floored_subtract(from.fee, value.fee);
+    from.sigops = floored_subtract(from.sigops, value.sigops);
+}
+
+uint64_t tx_pool::footprint(const transaction& tx) NOEXCEPT
+{
+    return entry_overhead + tx.serialized_size(true);
+}
+
+// Walk is bounded by package limits, excludes the given tx.
+tx_pool::hash_set tx_pool::collect(const hash_digest& hash,
+    bool ancestors) const NOEXCEPT
+{
+    hash_set out{};
+    hashes pending{ hash };
+    while (!pending.empty())
+    {
+        const auto it = entries_.find(pending.back());
+        pending.pop_back();
+        if (it == entries_.end())
+            continue;
+
+        for (const auto& next: ancestors ? it->second.parents :
+            it->second.children)
+            if (exists(next) && out.insert(next).second)
+                pending.push_back(next);
+    }
+
+    return out;
+}
+
+void tx_pool::set_ancestors(entry& value, const package& aggregate) NOEXCEPT
+{
+    by_ancestors_.erase({ rate(value.ancestors), value.hash });
+    value.ancestors = aggregate;
+    by_ancestors_.insert({ rate(value.ancestors), value.hash });
+    changed_.insert(value.hash);
+}
+
+void tx_pool::set_descendants(entry& value, const package& aggregate) NOEXCEPT
+{
+    by_descendants_.erase({ rate(value.descendants), value.hash });
+    value.descendants = aggregate;
+    by_descendants_.insert({ rate(value.descendants), value.hash });
+}
+
+// Unlink and drop the entry, aggregates of others are not updated.
+void tx_pool::erase(const hash_digest& hash) NOEXCEPT
+{
+    const auto it = entries_.find(hash);
+    if (it == entries_.end())
+        return;
+
+    const auto& value = it->second;
+    const auto unlink = [&](hashes& links) NOEXCEPT
+    {
+        links.erase(std::remove(links.begin(), links.end(), hash),
+            links.end());
+    };
+
+    for (const auto& parent: value.parents)
+        if (const auto found = entries_.find(parent); found != entries_.end())
+            unlink(found->second.children);
+
+    for (const auto& child: value.children)
+        if (const auto found = entries_.find(child); found != entries_.end())
+            unlink(found->second.parents);
+
+    for (const auto& in: *value.tx->inputs_ptr())
+        spends_.erase({ in->point().hash(), in->point().index() });
+
+    by_ancestors_.erase({ rate(value.ancestors), hash });
+    by_descendants_.erase({ rate(value.descendants), hash });
+    bytes_ = floored_subtract(bytes_, value.bytes);
+    changed_.erase(hash);
+    removed_.insert(hash);
+    entries_.erase(it);
+}
+
+// The package is closed under descendants, so only ancestors outside of it
+// require aggregate update.
+size_t tx_pool::remove(const hash_set& package) NOEXCEPT
+{
+    for (const auto& hash: package)
+    {
+        const auto self = entries_.at(hash).self;
+        for (const auto& ancestor: collect(hash, true))
+        {
+            if (package.contains(ancestor))
+                continue;
+
+            auto& value = entries_.at(ancestor);
+            auto descendants = value.descendants;
+            subtract(descendants, self);
+            set_descendants(value, descendants);
+        }
+    }
+
+    for (const auto& hash: package)
+        erase(hash);
+
+    return package.size();
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,391 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/tx_sketch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+// GF(2^32) modulo x^32 + x^7 + x^3 + x^2 + 1 (the minisketch 32 bit field).
+// Polynomials over the field are coefficient vectors, lowest degree first.
+// ----------------------------------------------------------------------------
+
+using element = tx_sketch::element;
+using polynomial = std::vector<element>;
+
+constexpr element reduction = 0x8d;
+constexpr size_t field_bits = 32;
+constexpr size_t maximum_attempts = 64;
+
+static element multiply(element left, element right) NOEXCEPT
+{
+    element out{};
+    for (; !is_zero(right); right >>= 1)
+    {
+        if (to_bool(right & 1u))
+            out ^= left;
+
+        left = (left << 1) ^ (to_bool(left >> 31) ? reduction : 0u);
+    }
+
+    return out;
+}
+
+static element square(element value) NOEXCEPT
+{
+    return multiply(value, value);
+}
+
+// value^(2^32 - 2).
+static element inverse(element value) NOEXCEPT
+{
+    element out{ 1 };
+    for (auto bit = one; bit < field_bits; ++bit)
+    {
+        value = square(value);
+        out = multiply(out, value);
+    }
+
+    return out;
+}
+
+static void trim(polynomial& value) NOEXCEPT
+{
+    while (!value.empty() && is_zero(value.back()))
+        value.pop_back();
+}
+
+static void add(polynomial& to, const polynomial& value) NOEXCEPT
+{
+    if (to.size() < value.size())
+        to.resize(value.size());
+
+    for (size_t index = 0; index < value.size(); ++index)
+        to[index] ^= value[index];
+
+    trim(to);
+}
+
+static polynomial monic(polynomial value) NOEXCEPT
+{
+    trim(value);
+    if (value.empty())
+        return value;
+
+    const auto factor = inverse(value.back());
+    for (auto& coefficient: value)
+        coefficient = multiply(coefficient, factor);
+
+    return value;
+}
+
+// Remainder of value by the monic divisor, quotient optionally collected.
+static polynomial reduce(polynomial value, const polynomial& divisor,
+    polynomial* quotient=nullptr) NOEXCEPT
+{
+    trim(value);
+    if (quotient != nullptr)
+        quotient->assign(value.size() >= divisor.size() ?
+            add1(value.size() - divisor.size()) : zero, 0);
+
+    while (value.size() >= divisor.size())
+    {
+        const auto lead = value.back();
+        const auto shift = value.size() - divisor.size();
+        for (size_t index = 0; index < divisor.size(); ++index)
+            value[shift + index] ^= multiply(lead, divisor[index]);
+
+        if (quotient != nullptr)
+            (*quotient)[shift] = lead;
+
+        trim(value);
+    }
+
+    return value;
+}
+
+static polynomial square(const polynomial& value,
+    const polynomial& modulus) NOEXCEPT
+{
+    polynomial out(value.empty() ? zero : sub1(two * value.size()), 0);
+    for (size_t index = 0; index < value.size(); ++index)
+        out[two * index] = square(value[index]);
+
+    return reduce(std::move(out), modulus);
+}
+
+static polynomial gcd(polynomial left, polynomial right) NOEXCEPT
+{
+    trim(right);
+    while (!right.empty())
+    {
+        right = monic(std::move(right));
+        left = reduce(std::move(left), right);
+        std::swap(left, right);
+    }
+
+    return monic(std::move(left));
+}
+
+// The polynomial (monic) has distinct roots in the field, all of them.
+static bool splits(const polynomial& value) NOEXCEPT
+{
+    const auto x = reduce({ 0, 1 }, value);
+    auto power = x;
+    for (size_t bit = 0; bit < field_bits; ++bit)
+        power = square(power, value);
+
+    return power == x;
+}
+
+// Trace(beta * x) = sum of (beta * x)^(2^i), modulo value.
+static polynomial trace(element beta, const polynomial& value) NOEXCEPT
+{
+    auto power = reduce({ 0, beta }, value);
+    auto out = power;
+    for (auto bit = one; bit < field_bits; ++bit)
+    {
+        power = square(power, value);
+        add(out, power);
+    }
+
+    return out;
+}
+
+// Berlekamp trace algorithm, value is monic and splits (distinct roots).
+static bool find_roots(tx_sketch::elements& out, const polynomial& value,
+    std::mt19937& random) NOEXCEPT
+{
+    if (value.size() < two)
+        return true;
+
+    if (value.size() == two)
+    {
+        out.push_back(value.front());
+        return true;
+    }
+
+    std::uniform_int_distribution<element> betas{ 1 };
+    for (size_t attempt = 0; attempt < maximum_attempts; ++attempt)
+    {
+        const auto factor = gcd(value, trace(betas(random), value));
+        if (factor.size() > one && factor.size() < value.size())
+        {
+            polynomial quotient{};
+            reduce(value, factor, &quotient);
+            return find_roots(out, factor, random) &&
+                find_roots(out, monic(std::move(quotient)), random);
+        }
+    }
+
+    return false;
+}
+
+// Static.
+// ----------------------------------------------------------------------------
+
+siphash_key tx_sketch::to_key(uint64_t salt1, uint64_t salt2) NOEXCEPT
+{
+    const auto tag = sha256_hash(to_chunk("Tx Relay Salting"));
+    const auto salts = splice(to_little_endian(std::min(salt1, salt2)),
+        to_little_endian(std::max(salt1, salt2)));
+    const auto digest = sha256_hash(splice(splice(tag, tag), salts));
+
+    half_hash half{};
+    std::copy_n(digest.begin(), half.size(), half.begin());
+    return to_siphash_key(half);
+}
+
+tx_sketch::element tx_sketch::to_short_id(const siphash_key& key,
+    const hash_digest& wtxid) NOEXCEPT
+{
+    return possible_narrow_cast<element>(add1(siphash(key, wtxid) %
+        max_uint32));
+}
+
+// Sketch.
+// ----------------------------------------------------------------------------
+
+tx_sketch::tx_sketch(size_t capacity) NOEXCEPT
+  : syndromes_(capacity, 0)
+{
+}
+
+size_t tx_sketch::capacity() const NOEXCEPT
+{
+    return syndromes_.size();
+}
+
+// The syndromes are the odd power sums (x, x^3, x^5, ...) of the elements.
+void tx_sketch::add(element value) NOEXCEPT
+{
+    if (is_zero(value))
+        return;
+
+    const auto squared = square(value);
+    for (auto& syndrome: syndromes_)
+    {
+        syndrome ^= value;
+        value = multiply(value, squared);
+    }
+}
+
+bool tx_sketch::merge(const tx_sketch& other) NOEXCEPT
+{
+    if (other.capacity() != capacity())
+        return false;
+
+    for (size_t index = 0; index < capacity(); ++index)
+        syndromes_[index] ^= other.syndromes_[index];
+
+    return true;
+}
+
+bool tx_sketch::decode(elements& out) const NOEXCEPT
+{
+    out.clear();
+    const auto count = two * capacity();
+
+    // Even power sums are squares of lower power sums (characteristic two).
+    elements sums(count, 0);
+    for (size_t power = 1; power <= count; ++power)
+        sums[sub1(power)] = is_odd(power) ? syndromes_[power / two] :
+            square(sums[sub1(power / two)]);
+
+    // Berlekamp-Massey, connection polynomial is the product of (1 - x*z).
+    polynomial connection{ 1 };
+    polynomial prior{ 1 };
+    element prior_discrepancy{ 1 };
+    size_t length{};
+    size_t shift{ 1 };
+    for (size_t index = 0; index < count; ++index)
+    {
+        auto discrepancy = sums[index];
+        for (size_t term = 1; term <= length && term < connection.size();
+            ++term)
+            discrepancy ^= multiply(connection[term], sums[index - term]);
+
+        if (is_zero(discrepancy))
+        {
+            ++shift;
+            continue;
+        }
+
+        const auto factor = multiply(discrepancy, inverse(prior_discrepancy));
+        const auto previous = connection;
+        if (connection.size() < prior.size() + shift)
+            connection.resize(prior.size() + shift);
+
+        for (size_t term = 0; term < prior.size(); ++term)
+            connection[term + shift] ^= multiply(factor, prior[term]);
+
+        if (two * length <= index)
+        {
+            length = add1(index) - length;
+            prior = previous;
+            prior_discrepancy = discrepancy;
+            shift = 1;
+        }
+        else
+        {
+            ++shift;
+        }
+    }
+
+    if (length > capacity())
+        return false;
+
+    if (is_zero(length))
+        return true;
+
+    // A zero root (zero lead) is not an element.
+    connection.resize(add1(length));
+    if (is_zero(connection.back()))
+        return false;
+
+    // The reversed connection polynomial has the elements as its roots.
+    std::reverse(connection.begin(), connection.end());
+    const auto locator = monic(std::move(connection));
+    if (!splits(locator))
+        return false;
+
+    // Deterministic, so that decode is repeatable.
+    std::mt19937 random{ 42 };
+    elements roots{};
+    roots.reserve(length);
+    if (!find_roots(roots, locator, random) || roots.size() != length)
+        return false;
+
+    // Roots are resketched, as a difference beyond capacity usually decodes
+    // to an inconsistent set (but may be indistinguishable from a smaller).
+    tx_sketch check{ capacity() };
+    for (const auto root: roots)
+        check.add(root);
+
+    if (check.syndromes_ != syndromes_)
+        return false;
+
+    std::sort(roots.begin(), roots.end());
+    out = std::move(roots);
+    return true;
+}
+
+data_chunk tx_sketch::to_data() const NOEXCEPT
+{
+    data_chunk out{};
+    out.reserve(sizeof(element) * capacity());
+    for (const auto syndrome: syndromes_)
+        for (size_t byte = 0; byte < sizeof(element); ++byte)
+            out.push_back(narrow_cast<uint8_t>(syndrome >> to_bits(byte)));
+
+    return out;
+}
+
+bool tx_sketch::from_data(const data_slice& data) NOEXCEPT
+{
+    if (data.size() != sizeof(element) * capacity())
+        return false;
+
+    auto it = data.begin();
+    for (auto& syndrome: syndromes_)
+    {
+        syndrome = 0;
+        for (size_t byte = 0; byte < sizeof(element); ++byte)
+            syndrome |= element{ *it++ } << to_bits(byte);
+    }
+
+    return true;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
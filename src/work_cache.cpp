@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/work_cache.hpp>
+
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace database;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+work_cache::work_cache(bool enable) NOEXCEPT
+  : enabled_(enable)
+{
+}
+
+bool work_cache::enabled() const NOEXCEPT
+{
+    return enabled_;
+}
+
+bool work_cache::get_work(uint256_t& out, const query& query,
+    const header_link& top, const header_link& base) NOEXCEPT
+{
+    if (!enabled_ || top.is_terminal() || base.is_terminal())
+        return false;
+
+    uint256_t floor{};
+    if (!find(floor, base.value))
+    {
+        uint32_t bits{};
+        if (!query.get_bits(bits, base))
+            return false;
+
+        // The first query anchors the cache at its base (a fork point), and
+        // work above a base that is not cached is summed but not cached.
+        if (!put(base, {}, bits) || !find(floor, base.value))
+            return sum_work(out, query, top, base);
+    }
+
+    // Walk down to a cached ancestor, at the (cached) base at the latest.
+    auto parent = top;
+    std::vector<header_link> branch{};
+    for (; !find(out, parent.value); parent = query.to_parent(parent))
+    {
+        if (parent.is_terminal())
+            return false;
+
+        branch.push_back(parent);
+    }
+
+    // Size once for the walk, as links increase from parent to child.
+    {
+        std::unique_lock lock(mutex_);
+        if (work_.size() <= top.value)
+            work_.resize(add1(top.value));
+    }
+
+    // Cache work upward from the ancestor, each header onto its parent.
+    for (auto it = branch.rbegin(); it != branch.rend(); parent = *it++)
+    {
+        uint32_t bits{};
+        if (!query.get_bits(bits, *it) || !put(*it, parent, bits))
+            return false;
+    }
+
+    if (!find(out, top.value))
+        return false;
+
+    out -= floor;
+    return true;
+}
+
+bool work_cache::get(uint256_t& out, const header_link& link) const NOEXCEPT
+{
+    return enabled_ && !link.is_terminal() && find(out, link.value);
+}
+
+bool work_cache::put(const header_link& link, const header_link& parent,
+    uint32_t bits) NOEXCEPT
+{
+    if (!enabled_ || link.is_terminal())
+        return false;
+
+    uint256_t work{};
+    if (!parent.is_terminal() && !find(work, parent.value))
+        return false;
+
+    std::unique_lock lock(mutex_);
+    if (parent.is_terminal())
+    {
+        // Only one anchor, as all entries are relative to it.
+        if (anchored_)
+            return false;
+
+        anchored_ = true;
+    }
+
+    if (work_.size() <= link.value)
+        work_.resize(add1(link.value));
+
+    work_.at(link.value) = work + chain::header::proof(bits);
+    return true;
+}
+
+// Work above base through top, by traversal (not cached).
+bool work_cache::sum_work(uint256_t& out, const query& query,
+    const header_link& top, const header_link& base) NOEXCEPT
+{
+    out = uint256_t{};
+    for (auto link = top; link.value != base.value;
+        link = query.to_parent(link))
+    {
+        uint32_t bits{};
+        if (link.is_terminal() || !query.get_bits(bits, link))
+            return false;
+
+        out += chain::header::proof(bits);
+    }
+
+    return true;
+}
+
+bool work_cache::find(uint256_t& out, size_t index) const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+    if (index >= work_.size() || is_zero(work_.at(index)))
+        return false;
+
+    out = work_.at(index);
+    return true;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
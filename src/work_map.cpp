@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/work_map.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <bitcoin/database.hpp>
+#include <bitcoin/system.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace database;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+work_map::work_map() NOEXCEPT
+  : table_(std::make_shared<const table>())
+{
+}
+
+work_map::work_map(const associations& associations) NOEXCEPT
+  : work_map(items(associations.pos_begin(), associations.pos_end()))
+{
+}
+
+work_map::work_map(items&& items) NOEXCEPT
+{
+    std::stable_sort(items.begin(), items.end(),
+        [](const item& left, const item& right) NOEXCEPT
+        {
+            return left.context.height < right.context.height;
+        });
+
+    const auto to = std::make_shared<table>();
+    to->keys.reserve(items.size());
+    for (size_t index = 0; index < items.size(); ++index)
+        to->keys.emplace_back(to_prefix(items.at(index).hash),
+            possible_narrow_cast<uint32_t>(index));
+
+    std::sort(to->keys.begin(), to->keys.end());
+    remaining_ = items.size();
+    received_.resize(remaining_);
+    to->values = std::move(items);
+    table_ = to;
+}
+
+size_t work_map::size() const NOEXCEPT
+{
+    return remaining_;
+}
+
+bool work_map::empty() const NOEXCEPT
+{
+    return is_zero(remaining_);
+}
+
+size_t work_map::floor() const NOEXCEPT
+{
+    return empty() ? zero :
+        table_->values.at(begin_ + cursor_).context.height;
+}
+
+size_t work_map::top() const NOEXCEPT
+{
+    return received_.empty() ? zero :
+        table_->values.at(begin_ + sub1(received_.size())).context.height;
+}
+
+const work_map::item* work_map::find(const hash_digest& hash) const NOEXCEPT
+{
+    const auto index = locate(hash);
+    return index == max_size_t ? nullptr : &table_->values.at(begin_ + index);
+}
+
+bool work_map::erase(const hash_digest& hash) NOEXCEPT
+{
+    const auto index = locate(hash);
+    if (index == max_size_t)
+        return false;
+
+    received_.at(index) = true;
+    --remaining_;
+    advance();
+    return true;
+}
+
+void work_map::clear() NOEXCEPT
+{
+    table_ = std::make_shared<const table>();
+    begin_ = zero;
+    cursor_ = zero;
+    remaining_ = zero;
+    received_.clear();
+}
+
+// Items are in height order, so the range is truncated from its top.
+size_t work_map::trim(size_t height) NOEXCEPT
+{
+    size_t count{};
+    auto end = received_.size();
+    while (!is_zero(end) &&
+        table_->values.at(begin_ + sub1(end)).context.height > height)
+    {
+        if (!received_.at(--end))
+            ++count;
+    }
+
+    received_.resize(end);
+    cursor_ = std::min(cursor_, end);
+    remaining_ -= count;
+    return count;
+}
+
+// A map with nothing received splits at count, otherwise the bits are read.
+map_ptr work_map::take(size_t count) NOEXCEPT
+{
+    const auto part = std::make_shared<work_map>();
+    count = std::min(count, remaining_);
+    if (is_zero(count))
+        return part;
+
+    auto split = count;
+    if (remaining_ != received_.size())
+        for (size_t taken{}, index = cursor_; taken < count; ++index)
+            if (!received_.at(index) && (++taken == count))
+                split = add1(index);
+
+    const auto end = std::next(received_.begin(), split);
+    part->table_ = table_;
+    part->begin_ = begin_;
+    part->cursor_ = cursor_;
+    part->remaining_ = count;
+    part->received_.assign(received_.begin(), end);
+
+    received_.erase(received_.begin(), end);
+    begin_ += split;
+    cursor_ = zero;
+    remaining_ -= count;
+    advance();
+    return part;
+}
+
+// Merged items are not contiguous in a common table, so the map is rebuilt.
+void work_map::merge(work_map& other, size_t count) NOEXCEPT
+{
+    const auto part = other.take(count);
+    if (part->empty())
+        return;
+
+    items out{};
+    out.reserve(remaining_ + part->size());
+    const auto push = [&](const item& value) NOEXCEPT
+    {
+        out.push_back(value);
+    };
+
+    for_each(push);
+    part->for_each(push);
+    *this = work_map{ std::move(out) };
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+uint64_t work_map::to_prefix(const hash_digest& hash) NOEXCEPT
+{
+    uint64_t prefix{};
+    std::memcpy(&prefix, hash.data(), sizeof(prefix));
+    return prefix;
+}
+
+// Relative position of the outstanding item, max_size_t if not found.
+size_t work_map::locate(const hash_digest& hash) const NOEXCEPT
+{
+    const auto& keys = table_->keys;
+    const auto prefix = to_prefix(hash);
+    auto it = std::lower_bound(keys.begin(), keys.end(), key{ prefix, 0 });
+    for (; it != keys.end() && it->first == prefix; ++it)
+    {
+        const size_t index = it->second;
+        if (index < begin_ || index >= begin_ + received_.size())
+            continue;
+
+        const auto position = index - begin_;
+        if (!received_.at(position) && table_->values.at(index).hash == hash)
+            return position;
+    }
+
+    return max_size_t;
+}
+
+void work_map::advance() NOEXCEPT
+{
+    while (cursor_ < received_.size() && received_.at(cursor_))
+        ++cursor_;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/worker_shares.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <bitcoin/network.hpp>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace network;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+// Shares move by one thread at most once per interval.
+constexpr std::chrono::seconds interval{ 1 };
+
+// Validation backlog (per mille of maximum) below which it is idle, and at
+// or above which it is deep.
+constexpr size_t idle_backlog = 100;
+constexpr size_t deep_backlog = 500;
+constexpr size_t per_mille = 1'000;
+
+// Check threads of zero disables the check pool (checked on strand), so
+// there is nothing to move.
+worker_shares::worker_shares(size_t validate, size_t check,
+    bool scale) NOEXCEPT
+  : total_(std::max(validate, one) + check),
+    check_threads_(check),
+    scale_(scale && !is_zero(check)),
+    validate_(std::max(validate, one)),
+    check_(std::max(check, one))
+{
+}
+
+size_t worker_shares::validate_capacity() const NOEXCEPT
+{
+    return scale_ ? sub1(total_) : validate_.load();
+}
+
+size_t worker_shares::check_capacity() const NOEXCEPT
+{
+    return scale_ ? sub1(total_) : std::max(check_threads_, one);
+}
+
+size_t worker_shares::validate() const NOEXCEPT
+{
+    return validate_.load(std::memory_order_relaxed);
+}
+
+size_t worker_shares::check() const NOEXCEPT
+{
+    return check_.load(std::memory_order_relaxed);
+}
+
+void worker_shares::set_backlog(size_t backlog, size_t maximum) NOEXCEPT
+{
+    if (!scale_)
+        return;
+
+    backlog_.store(is_zero(maximum) ? zero :
+        std::min(per_mille, backlog * per_mille / maximum),
+        std::memory_order_relaxed);
+
+    rebalance();
+}
+
+bool worker_shares::claim_check() NOEXCEPT
+{
+    if (!scale_)
+        return true;
+
+    rebalance();
+    if (checking_.fetch_add(one) < check_.load())
+        return true;
+
+    checking_.fetch_sub(one);
+    refused_.fetch_add(one);
+    return false;
+}
+
+void worker_shares::release_check() NOEXCEPT
+{
+    if (scale_)
+        checking_.fetch_sub(one);
+}
+
+// private
+void worker_shares::rebalance() NOEXCEPT
+{
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+        return;
+
+    const auto now = steady_clock::now();
+    if (now - balanced_ < interval)
+        return;
+
+    balanced_ = now;
+    const auto refused = refused_.exchange(zero);
+    const auto backlog = backlog_.load();
+    const auto validate = validate_.load();
+    const auto check = check_.load();
+
+    if (backlog < idle_backlog && !is_zero(refused) && validate > one)
+    {
+        validate_.store(sub1(validate));
+        check_.store(add1(check));
+    }
+    else if (backlog >= deep_backlog && is_zero(refused) && check > one)
+    {
+        validate_.store(add1(validate));
+        check_.store(sub1(check));
+    }
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_TEST_BENCHMARKS_HPP
+#define LIBBITCOIN_NODE_TEST_BENCHMARKS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <bitcoin/node.hpp>
+
+using namespace bc;
+using namespace bc::node;
+
+/// Mean nanoseconds per iteration of body, written to standard output.
+/// Setup within the body is measured, so cases keep it outside of body.
+template <typename Body>
+void measure(const std::string& name, size_t iterations, Body&& body)
+{
+    using namespace std::chrono;
+    const auto start = steady_clock::now();
+    for (size_t iteration = 0; iteration < iterations; ++iteration)
+        body(iteration);
+
+    const auto span = duration_cast<nanoseconds>(steady_clock::now() - start);
+    std::cout << name << " : " << (span.count() / std::max(iterations, one))
+        << " ns" << std::endl;
+}
+
+/// Distinct and uniformly distributed hash for each value.
+inline system::hash_digest make_hash(size_t value)
+{
+    return system::bitcoin_hash(system::to_little_endian(uint64_t{ value }));
+}
+
+/// Hashes of values [first, first + count), precomputed outside of body.
+inline system::hashes make_hashes(size_t count, size_t first=0)
+{
+    system::hashes out(count);
+    for (size_t index = 0; index < count; ++index)
+        out.at(index) = make_hash(first + index);
+
+    return out;
+}
+
+void work_map_benchmarks();
+void event_bus_benchmarks();
+void hash_filter_benchmarks();
+
+#endif
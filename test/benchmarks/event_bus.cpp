@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmarks.hpp"
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+
+// Fan-out of one chase event to each channel subscriber (full_node::notify),
+// measured to delivery of the last event to all subscribers.
+void event_bus_benchmarks()
+{
+    constexpr size_t events = 10'000;
+    for (const auto subscribers: { 10_size, 100_size, 1'000_size })
+    {
+        network::threadpool pool{ 4 };
+        event_bus bus{ pool.service(), 4 };
+        std::atomic_size_t subscribed{};
+        std::atomic_size_t delivered{};
+        std::promise<bool> complete{};
+        const auto total = events * subscribers;
+
+        for (size_t key = 0; key < subscribers; ++key)
+        {
+            bus.subscribe([&](const code&, chase event_, event_value,
+                const event_payload&) NOEXCEPT
+            {
+                if (event_ == chase::stop)
+                    return false;
+
+                if (add1(delivered.fetch_add(one)) == total)
+                    complete.set_value(true);
+
+                return true;
+            }, to_topics(chase::download), key,
+            [&](const code&, object_key) NOEXCEPT
+            {
+                subscribed.fetch_add(one);
+            });
+        }
+
+        while (subscribed.load() < subscribers)
+            std::this_thread::yield();
+
+        // Mean per event, to delivery of all events to all subscribers.
+        auto future = complete.get_future();
+        measure("event_bus notify, " + std::to_string(subscribers) +
+            " subscribers", events, [&](size_t iteration)
+        {
+            bus.notify(error::success, chase::download, iteration, {});
+            if (iteration == sub1(events))
+                future.wait();
+        });
+
+        bus.stop(network::error::service_stopped);
+        pool.stop();
+        pool.join();
+    }
+}
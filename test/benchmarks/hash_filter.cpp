@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmarks.hpp"
+
+using namespace system;
+
+// Header organization checks each announced hash against recently organized
+// headers before the (strand serialized) store lookup.
+void hash_filter_benchmarks()
+{
+    constexpr size_t hashes = 100'000;
+    hash_filter filter{ hashes };
+    const auto inserted = make_hashes(hashes);
+    const auto missing = make_hashes(hashes, hashes);
+
+    measure("hash_filter insert", hashes, [&](size_t value)
+    {
+        filter.insert(inserted.at(value));
+    });
+
+    size_t hits{};
+    measure("hash_filter contains", hashes, [&](size_t value)
+    {
+        hits += to_int(filter.contains(inserted.at(value)));
+    });
+
+    measure("hash_filter miss", hashes, [&](size_t value)
+    {
+        hits += to_int(filter.contains(missing.at(value)));
+    });
+}
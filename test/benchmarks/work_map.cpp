@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmarks.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace system;
+
+static work_map::items make_items(size_t count)
+{
+    work_map::items out(count);
+    for (size_t height = 0; height < count; ++height)
+    {
+        out.at(height).hash = make_hash(height);
+        out.at(height).context.height = possible_narrow_cast<uint32_t>(
+            add1(height));
+    }
+
+    return out;
+}
+
+// Distribution of a download window to channels (chaser_check get_hashes),
+// receipt of each block (protocol_block_in_31800), and return of the work
+// of stalled or stopped channels (chaser_check put_hashes).
+void work_map_benchmarks()
+{
+    constexpr size_t window = 50'000;
+    const auto hashes = make_hashes(window);
+    for (const auto channels: { 10_size, 100_size, 1'000_size })
+    {
+        const auto name = std::to_string(channels) + " channels";
+        const auto count = window / channels;
+        work_map map{ make_items(window) };
+        std::vector<map_ptr> parts{};
+        parts.reserve(channels);
+
+        measure("work_map take, " + name, channels, [&](size_t)
+        {
+            parts.push_back(map.take(count));
+        });
+
+        measure("work_map erase, " + name, window, [&](size_t height)
+        {
+            parts.at(height / count)->erase(hashes.at(height));
+        });
+
+        work_map pending{ make_items(window) };
+        work_map returned{};
+        measure("work_map merge, " + name, channels, [&](size_t)
+        {
+            const auto part = pending.take(count);
+            returned.merge(*part, count);
+        });
+    }
+
+    size_t found{};
+    const work_map map{ make_items(window) };
+    measure("work_map find", window, [&](size_t height)
+    {
+        found += to_int(!is_null(map.find(hashes.at(height))));
+    });
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(block_cache_tests)
+
+using namespace system;
+
+// The nonce distinguishes blocks.
+static chain::block::cptr make(uint32_t nonce) NOEXCEPT
+{
+    return std::make_shared<const chain::block>(chain::header{ 1, null_hash,
+        null_hash, 0, 0, nonce }, chain::transactions{});
+}
+
+BOOST_AUTO_TEST_CASE(block_cache__put__disabled__not_cached)
+{
+    block_cache cache{ 0 };
+    const auto block = make(1);
+    BOOST_REQUIRE(!cache.enabled());
+    cache.put(block);
+    BOOST_REQUIRE_EQUAL(cache.count(), 0u);
+    BOOST_REQUIRE(!cache.get(block->hash()));
+}
+
+BOOST_AUTO_TEST_CASE(block_cache__get__cached__expected)
+{
+    block_cache cache{ 1'000'000 };
+    const auto block = make(1);
+    cache.put(block);
+    cache.put(block);
+    BOOST_REQUIRE_EQUAL(cache.count(), 1u);
+    BOOST_REQUIRE(!is_zero(cache.bytes()));
+    BOOST_REQUIRE_EQUAL(cache.get(block->hash()), block);
+    BOOST_REQUIRE(!cache.get(make(2)->hash()));
+}
+
+BOOST_AUTO_TEST_CASE(block_cache__put__overflow__evicts_least_recently_used)
+{
+    const auto first = make(1);
+    const auto second = make(2);
+    const auto third = make(3);
+    const auto size = 2u * first->serialized_size(true);
+    block_cache cache{ 2u * size };
+
+    cache.put(first);
+    cache.put(second);
+    BOOST_REQUIRE_EQUAL(cache.get(first->hash()), first);
+
+    cache.put(third);
+    BOOST_REQUIRE_EQUAL(cache.count(), 2u);
+    BOOST_REQUIRE_EQUAL(cache.get(first->hash()), first);
+    BOOST_REQUIRE_EQUAL(cache.get(third->hash()), third);
+    BOOST_REQUIRE(!cache.get(second->hash()));
+}
+
+BOOST_AUTO_TEST_CASE(block_cache__trim__partial__evicts_least_recently_used)
+{
+    const auto first = make(1);
+    const auto second = make(2);
+    const auto third = make(3);
+    const auto size = 2u * first->serialized_size(true);
+    block_cache cache{ 3u * size };
+
+    cache.put(first);
+    cache.put(second);
+    cache.put(third);
+    BOOST_REQUIRE_EQUAL(cache.get(first->hash()), first);
+
+    cache.trim(add1(size));
+    BOOST_REQUIRE_EQUAL(cache.count(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.bytes(), size);
+    BOOST_REQUIRE_EQUAL(cache.get(first->hash()), first);
+    BOOST_REQUIRE(!cache.get(second->hash()));
+    BOOST_REQUIRE(!cache.get(third->hash()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(block_claims_tests)
+
+using namespace system;
+
+BOOST_AUTO_TEST_CASE(block_claims__tracked__not_tracked__false)
+{
+    const block_claims instance{ 4 };
+    BOOST_REQUIRE(!instance.tracked(one_hash));
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_claims__track__tracked_unclaimed__claimable)
+{
+    block_claims instance{ 4 };
+    instance.track(one_hash);
+    BOOST_REQUIRE(instance.tracked(one_hash));
+    BOOST_REQUIRE(instance.claim(one_hash));
+}
+
+BOOST_AUTO_TEST_CASE(block_claims__claim__claimed__false)
+{
+    block_claims instance{ 4 };
+    BOOST_REQUIRE(instance.claim(one_hash));
+    BOOST_REQUIRE(instance.tracked(one_hash));
+    BOOST_REQUIRE(!instance.claim(one_hash));
+}
+
+BOOST_AUTO_TEST_CASE(block_claims__release__claimed__claimable_and_tracked)
+{
+    block_claims instance{ 4 };
+    BOOST_REQUIRE(instance.claim(one_hash));
+    instance.release(one_hash);
+    BOOST_REQUIRE(instance.tracked(one_hash));
+    BOOST_REQUIRE(instance.claim(one_hash));
+}
+
+BOOST_AUTO_TEST_CASE(block_claims__track__claimed__remains_claimed)
+{
+    block_claims instance{ 4 };
+    BOOST_REQUIRE(instance.claim(one_hash));
+    instance.track(one_hash);
+    BOOST_REQUIRE(!instance.claim(one_hash));
+}
+
+BOOST_AUTO_TEST_CASE(block_claims__track__over_capacity__oldest_displaced)
+{
+    block_claims instance{ 2 };
+    instance.track(one_hash);
+    instance.track(null_hash);
+    instance.track(base16_hash(
+        "0000000000000000000000000000000000000000000000000000000000000002"));
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u);
+    BOOST_REQUIRE(!instance.tracked(one_hash));
+    BOOST_REQUIRE(instance.tracked(null_hash));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
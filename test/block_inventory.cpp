@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(block_inventory_tests)
+
+using namespace system;
+using namespace system::chain;
+
+static block::cptr make_block(uint32_t nonce) NOEXCEPT
+{
+    return std::make_shared<const block>(
+        header{ 1, null_hash, null_hash, 0, 0, nonce }, transactions{});
+}
+
+static void ignore(const block::cptr&, organize_handler&&) NOEXCEPT
+{
+}
+
+BOOST_AUTO_TEST_CASE(block_inventory__merge__duplicates__added_once)
+{
+    block_inventory instance{ 10, ignore };
+    BOOST_REQUIRE_EQUAL(instance.merge({ null_hash, one_hash }), 2u);
+    BOOST_REQUIRE_EQUAL(instance.merge({ one_hash, null_hash }), 0u);
+    BOOST_REQUIRE_EQUAL(instance.pending(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(block_inventory__claim__window__limited_in_order)
+{
+    const auto first = make_block(1);
+    const auto second = make_block(2);
+    const auto third = make_block(3);
+    block_inventory instance{ 2, ignore };
+    instance.merge({ first->hash(), second->hash(), third->hash() });
+
+    BOOST_REQUIRE(instance.claim(1) == hashes{ first->hash() });
+    BOOST_REQUIRE(instance.claim(5) == hashes{ second->hash() });
+    BOOST_REQUIRE(instance.claim(5).empty());
+}
+
+BOOST_AUTO_TEST_CASE(block_inventory__release__claimed__reclaimable)
+{
+    block_inventory instance{ 10, ignore };
+    instance.merge({ null_hash, one_hash });
+    BOOST_REQUIRE_EQUAL(instance.claim(2).size(), 2u);
+    instance.release({ one_hash });
+    BOOST_REQUIRE(instance.claim(2) == hashes{ one_hash });
+}
+
+BOOST_AUTO_TEST_CASE(block_inventory__complete__out_of_order__organized_in_order)
+{
+    const auto first = make_block(1);
+    const auto second = make_block(2);
+    std::vector<hash_digest> organized{};
+    block_inventory instance{ 10, [&](const block::cptr& block,
+        organize_handler&& handler) NOEXCEPT
+    {
+        organized.push_back(block->hash());
+        handler(error::success, organized.size());
+    } };
+
+    instance.merge({ first->hash(), second->hash() });
+    BOOST_REQUIRE(!instance.complete(first));
+    BOOST_REQUIRE_EQUAL(instance.claim(2).size(), 2u);
+
+    BOOST_REQUIRE(instance.complete(second));
+    BOOST_REQUIRE(organized.empty());
+    BOOST_REQUIRE(instance.complete(first));
+    BOOST_REQUIRE(organized == hashes({ first->hash(), second->hash() }));
+    BOOST_REQUIRE(!instance.complete(first));
+    BOOST_REQUIRE_EQUAL(instance.pending(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(block_template_tests)
+
+using namespace system;
+using test::funding;
+using test::spend;
+
+BOOST_AUTO_TEST_CASE(block_template__assemble__empty__empty)
+{
+    block_template instance{ 1'000'000, 80'000 };
+    const auto assembly = instance.assemble();
+    BOOST_REQUIRE(assembly);
+    BOOST_REQUIRE(assembly->txs.empty());
+    BOOST_REQUIRE_EQUAL(assembly->fees, 0u);
+    BOOST_REQUIRE_EQUAL(assembly->size, 0u);
+    BOOST_REQUIRE_EQUAL(assembly->sigops, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(block_template__assemble__unchanged__cached)
+{
+    tx_pool pool{ 1'000'000 };
+    block_template instance{ 1'000'000, 80'000 };
+    BOOST_REQUIRE(!pool.add(spend({ funding }), 100));
+    instance.apply(pool.drain());
+
+    const auto first = instance.assemble();
+    BOOST_REQUIRE_EQUAL(instance.assemble(), first);
+
+    instance.apply(pool.drain());
+    BOOST_REQUIRE_EQUAL(instance.assemble(), first);
+}
+
+BOOST_AUTO_TEST_CASE(block_template__assemble__high_fee_child__parent_first)
+{
+    tx_pool pool{ 1'000'000 };
+    block_template instance{ 1'000'000, 80'000 };
+    const auto other = spend({ funding }, 1);
+    const auto parent = spend({ { funding.hash(), 1 } });
+    const auto child = spend({ { parent->hash(false), 0 } });
+    BOOST_REQUIRE(!pool.add(other, 200));
+    BOOST_REQUIRE(!pool.add(parent, 1));
+    BOOST_REQUIRE(!pool.add(child, 1'000));
+    instance.apply(pool.drain());
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+
+    const auto assembly = instance.assemble();
+    BOOST_REQUIRE_EQUAL(assembly->txs.size(), 3u);
+    BOOST_REQUIRE_EQUAL(assembly->txs.at(0), parent);
+    BOOST_REQUIRE_EQUAL(assembly->txs.at(1), child);
+    BOOST_REQUIRE_EQUAL(assembly->txs.at(2), other);
+    BOOST_REQUIRE_EQUAL(assembly->fees, 1'201u);
+}
+
+BOOST_AUTO_TEST_CASE(block_template__assemble__limited__highest_rate)
+{
+    tx_pool pool{ 1'000'000 };
+    const auto low = spend({ funding }, 1);
+    const auto high = spend({ { funding.hash(), 1 } });
+    block_template instance{ high->virtual_size(), 80'000 };
+    BOOST_REQUIRE(!pool.add(low, 100));
+    BOOST_REQUIRE(!pool.add(high, 200));
+    instance.apply(pool.drain());
+
+    const auto assembly = instance.assemble();
+    BOOST_REQUIRE_EQUAL(assembly->txs.size(), 1u);
+    BOOST_REQUIRE_EQUAL(assembly->txs.front(), high);
+    BOOST_REQUIRE_EQUAL(assembly->size, high->virtual_size());
+}
+
+BOOST_AUTO_TEST_CASE(block_template__assemble__sigop_limited__highest_rate)
+{
+    tx_pool pool{ 1'000'000 };
+    block_template instance{ 1'000'000, 100 };
+    const auto low = spend({ funding }, 1);
+    const auto high = spend({ { funding.hash(), 1 } });
+    const auto light = spend({ { funding.hash(), 2 } });
+    BOOST_REQUIRE(!pool.add(low, 100, 80));
+    BOOST_REQUIRE(!pool.add(high, 200, 80));
+    BOOST_REQUIRE(!pool.add(light, 50, 20));
+    instance.apply(pool.drain());
+
+    const auto assembly = instance.assemble();
+    BOOST_REQUIRE_EQUAL(assembly->txs.size(), 2u);
+    BOOST_REQUIRE_EQUAL(assembly->txs.front(), high);
+    BOOST_REQUIRE_EQUAL(assembly->txs.back(), light);
+    BOOST_REQUIRE_EQUAL(assembly->sigops, 100u);
+}
+
+BOOST_AUTO_TEST_CASE(block_template__apply__confirmed__removed)
+{
+    tx_pool pool{ 1'000'000 };
+    block_template instance{ 1'000'000, 80'000 };
+    const auto parent = spend({ funding });
+    const auto child = spend({ { parent->hash(false), 0 } });
+    BOOST_REQUIRE(!pool.add(parent, 100));
+    BOOST_REQUIRE(!pool.add(child, 100));
+    instance.apply(pool.drain());
+    BOOST_REQUIRE_EQUAL(instance.assemble()->txs.size(), 2u);
+
+    BOOST_REQUIRE_EQUAL(pool.confirm(*parent), 1u);
+    instance.apply(pool.drain());
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+
+    const auto assembly = instance.assemble();
+    BOOST_REQUIRE_EQUAL(assembly->txs.size(), 1u);
+    BOOST_REQUIRE_EQUAL(assembly->txs.front(), child);
+}
+
+BOOST_AUTO_TEST_CASE(block_template__clear__populated__empty)
+{
+    tx_pool pool{ 1'000'000 };
+    block_template instance{ 1'000'000, 80'000 };
+    BOOST_REQUIRE(!pool.add(spend({ funding }), 100));
+    instance.apply(pool.drain());
+    instance.clear();
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+    BOOST_REQUIRE(instance.assemble()->txs.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
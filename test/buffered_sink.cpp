@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(buffered_sink_tests)
+
+using namespace std::chrono;
+
+BOOST_AUTO_TEST_CASE(buffered_sink__write__zero_period__written_through)
+{
+    std::ostringstream stream{};
+    buffered_sink instance{ stream, 1024, milliseconds::zero() };
+    instance.write("abc");
+    BOOST_REQUIRE_EQUAL(stream.str(), "abc");
+}
+
+BOOST_AUTO_TEST_CASE(buffered_sink__flush__buffered__written)
+{
+    std::ostringstream stream{};
+    buffered_sink instance{ stream, 1024, hours(1) };
+    instance.write("abc");
+    instance.write("def");
+    instance.flush();
+    BOOST_REQUIRE_EQUAL(stream.str(), "abcdef");
+}
+
+BOOST_AUTO_TEST_CASE(buffered_sink__stop__buffered__written_and_ignores_writes)
+{
+    std::ostringstream stream{};
+    buffered_sink instance{ stream, 1024, hours(1) };
+    instance.write("abc");
+    instance.stop();
+    BOOST_REQUIRE_EQUAL(stream.str(), "abc");
+
+    instance.write("def");
+    instance.flush();
+    instance.stop();
+    BOOST_REQUIRE_EQUAL(stream.str(), "abc");
+}
+
+BOOST_AUTO_TEST_CASE(buffered_sink__destruct__buffered__written)
+{
+    std::ostringstream stream{};
+    {
+        buffered_sink instance{ stream, 1024, hours(1) };
+        instance.write("abc");
+    }
+
+    BOOST_REQUIRE_EQUAL(stream.str(), "abc");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -25,4 +25,61 @@ BOOST_AUTO_TEST_CASE(chaser_confirm_test)
     BOOST_REQUIRE(true);
 }
 
+using namespace system;
+using test::funding;
+using test::spend;
+
+// Exposes the protected batch type (never constructed).
+class accessor
+  : public chaser_confirm
+{
+public:
+    using chaser_confirm::confirmation;
+};
+
+using batch = accessor::confirmation;
+
+static chain::block make_block(const chain::point& point) NOEXCEPT
+{
+    const auto coinbase = spend({ chain::point{} });
+    const auto tx = spend({ point });
+    return { chain::header{}, chain::transactions{ *coinbase, *tx } };
+}
+
+BOOST_AUTO_TEST_CASE(chaser_confirm__set_spends__coinbase__excluded)
+{
+    batch instance{ 1, 0, {}, { 1 } };
+    instance.set_spends(0, make_block(funding));
+    BOOST_REQUIRE_EQUAL(instance.spends.at(0).size(), 1u);
+    BOOST_REQUIRE(instance.spends.at(0).front() == funding);
+}
+
+BOOST_AUTO_TEST_CASE(chaser_confirm__conflicts__same_outpoint__true)
+{
+    batch instance{ 2, 0, {}, { 1, 2 } };
+    instance.set_spends(0, make_block(funding));
+    instance.set_spends(1, make_block(funding));
+    BOOST_REQUIRE(!instance.conflicts(0));
+
+    instance.spend(0);
+    BOOST_REQUIRE(instance.conflicts(1));
+}
+
+BOOST_AUTO_TEST_CASE(chaser_confirm__conflicts__distinct_outpoints__false)
+{
+    batch instance{ 2, 0, {}, { 1, 2 } };
+    instance.set_spends(0, make_block(funding));
+    instance.set_spends(1, make_block({ funding.hash(), 1 }));
+    instance.spend(0);
+    BOOST_REQUIRE(!instance.conflicts(1));
+}
+
+BOOST_AUTO_TEST_CASE(chaser_confirm__conflicts__partial__true)
+{
+    batch instance{ 2, 0, {}, { 1, 2 } };
+    instance.set_spends(1, make_block(funding));
+    instance.partial.store(true);
+    BOOST_REQUIRE(instance.conflicts(1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
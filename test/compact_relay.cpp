@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(compact_relay_tests)
+
+using namespace system;
+
+// Coinbase and two spends, the locktime distinguishes txs.
+static chain::block::cptr make_block() NOEXCEPT
+{
+    const auto make = [](const chain::point& point, uint32_t locktime)
+    {
+        return chain::transaction{ 1, chain::inputs{ { point,
+            chain::script{}, 0 } }, chain::outputs{ { 42, chain::script{} } },
+            locktime };
+    };
+
+    const chain::point spent{ base16_hash(
+        "0000000000000000000000000000000000000000000000000000000000000001"),
+        0 };
+
+    return std::make_shared<const chain::block>(chain::header{ 1, null_hash,
+        null_hash, 0, 0, 42 }, chain::transactions{ make({}, 0),
+            make(spent, 1), make(spent, 2) });
+}
+
+BOOST_AUTO_TEST_CASE(compact_relay__to_short_id__nonce__distinct)
+{
+    const auto block = make_block();
+    const auto wtxid = block->transactions_ptr()->back()->hash(true);
+    const auto key1 = compact_relay::to_key(block->header(), 1);
+    const auto key2 = compact_relay::to_key(block->header(), 2);
+    BOOST_REQUIRE(compact_relay::to_short_id(key1, wtxid) ==
+        compact_relay::to_short_id(key1, wtxid));
+    BOOST_REQUIRE(compact_relay::to_short_id(key1, wtxid) !=
+        compact_relay::to_short_id(key2, wtxid));
+}
+
+BOOST_AUTO_TEST_CASE(compact_relay__to_short_ids__block__excludes_coinbase)
+{
+    const auto block = make_block();
+    BOOST_REQUIRE_EQUAL(compact_relay::to_short_ids(*block, 7).size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(compact_relay__construct__invalid_prefill__invalid)
+{
+    const auto block = make_block();
+    const auto& txs = *block->transactions_ptr();
+    const auto ids = compact_relay::to_short_ids(*block, 7);
+    const compact_relay out_of_range{ block->header_ptr(), 7, ids,
+        { { 3, txs.front() } } };
+    const compact_relay duplicated{ block->header_ptr(), 7, { ids.front() },
+        { { 0, txs.front() }, { 0, txs.back() } } };
+    BOOST_REQUIRE(!out_of_range.is_valid());
+    BOOST_REQUIRE(!duplicated.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(compact_relay__construct__duplicate_short_id__invalid)
+{
+    const auto block = make_block();
+    const auto ids = compact_relay::to_short_ids(*block, 7);
+    const compact_relay instance{ block->header_ptr(), 7,
+        { ids.front(), ids.front() },
+        { { 0, block->transactions_ptr()->front() } } };
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(compact_relay__match_fill__missing__reconstructed)
+{
+    const auto block = make_block();
+    const auto& txs = *block->transactions_ptr();
+    compact_relay instance{ block->header_ptr(), 7,
+        compact_relay::to_short_ids(*block, 7), { { 0, txs.front() } } };
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.hash(), block->hash());
+    BOOST_REQUIRE_EQUAL(instance.missing().size(), 2u);
+    BOOST_REQUIRE(!instance.to_block());
+
+    instance.match(txs.at(1));
+    instance.match(txs.at(1));
+    BOOST_REQUIRE_EQUAL(instance.missing().size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.missing().front(), 2u);
+    BOOST_REQUIRE(!instance.fill({}));
+    BOOST_REQUIRE(instance.fill({ txs.at(2) }));
+    BOOST_REQUIRE(instance.missing().empty());
+
+    const auto reconstructed = instance.to_block();
+    BOOST_REQUIRE(reconstructed);
+    BOOST_REQUIRE_EQUAL(reconstructed->hash(), block->hash());
+    BOOST_REQUIRE_EQUAL(reconstructed->transactions_ptr()->size(), 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
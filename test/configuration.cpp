@@ -35,13 +35,26 @@ BOOST_AUTO_TEST_CASE(configuration__construct1__none_context__expected)
     BOOST_REQUIRE(!instance.newstore);
     BOOST_REQUIRE(!instance.backup);
     BOOST_REQUIRE(!instance.restore);
+    BOOST_REQUIRE_EQUAL(instance.serve, 0u);
     BOOST_REQUIRE(!instance.flags);
     BOOST_REQUIRE(!instance.information);
     BOOST_REQUIRE(!instance.slabs);
     BOOST_REQUIRE(!instance.buckets);
     BOOST_REQUIRE(!instance.collisions);
+    BOOST_REQUIRE(!instance.sizing);
+    BOOST_REQUIRE_EQUAL(instance.sizing_height, 0_u32);
     BOOST_REQUIRE(!instance.test);
     BOOST_REQUIRE(!instance.write);
+    BOOST_REQUIRE(!instance.benchmark);
+    BOOST_REQUIRE_EQUAL(instance.benchmark_start, 0_u32);
+    BOOST_REQUIRE_EQUAL(instance.benchmark_count, 0_u32);
+    BOOST_REQUIRE(instance.record.empty());
+    BOOST_REQUIRE(instance.replay.empty());
+    BOOST_REQUIRE(instance.generate.empty());
+    BOOST_REQUIRE_EQUAL(instance.generate_count, 0_u32);
+    BOOST_REQUIRE_EQUAL(instance.generate_txs, 0_u32);
+    BOOST_REQUIRE_EQUAL(instance.generate_fanout, 0_u32);
+    BOOST_REQUIRE_EQUAL(instance.generate_fork, 0_u32);
 
     // Just a sample of settings.
     BOOST_REQUIRE(instance.database.minimize);
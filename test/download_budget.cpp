@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(download_budget_tests)
+
+using namespace system;
+using namespace network;
+
+BOOST_AUTO_TEST_CASE(download_budget__delay__disabled__zero)
+{
+    download_budget instance{ 0 };
+    BOOST_REQUIRE(!instance.enabled());
+    instance.consume(1'000'000);
+    BOOST_REQUIRE(instance.delay(42) == steady_clock::duration::zero());
+}
+
+BOOST_AUTO_TEST_CASE(download_budget__frontier__disabled__set)
+{
+    download_budget instance{ 0 };
+    BOOST_REQUIRE_EQUAL(instance.frontier(), 0u);
+    instance.set_frontier(42);
+    BOOST_REQUIRE_EQUAL(instance.frontier(), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(download_budget__delay__within_budget__zero)
+{
+    download_budget instance{ 1'000 };
+    BOOST_REQUIRE(instance.enabled());
+    instance.consume(500);
+    BOOST_REQUIRE(instance.delay(1'000'000) == steady_clock::duration::zero());
+}
+
+BOOST_AUTO_TEST_CASE(download_budget__delay__overdrawn_bulk__nonzero)
+{
+    download_budget instance{ 1'000 };
+    instance.set_frontier(100);
+    instance.consume(2'000);
+    const auto delay = instance.delay(100 + download_budget::frontier_blocks + 1);
+    BOOST_REQUIRE(delay > steady_clock::duration::zero());
+    BOOST_REQUIRE(delay <= std::chrono::seconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(download_budget__delay__overdrawn_frontier__zero)
+{
+    download_budget instance{ 1'000 };
+    instance.set_frontier(100);
+    instance.consume(2'000);
+    BOOST_REQUIRE(instance.delay(100 + download_budget::frontier_blocks) ==
+        steady_clock::duration::zero());
+}
+
+BOOST_AUTO_TEST_CASE(download_budget__delay__overdraft_exceeded_frontier__nonzero)
+{
+    download_budget instance{ 1'000 };
+    instance.consume(3'000);
+    BOOST_REQUIRE(instance.delay(0) > steady_clock::duration::zero());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
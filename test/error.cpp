@@ -90,6 +90,89 @@ BOOST_AUTO_TEST_CASE(error_t__code__store_snapshot__true_exected_message)
     BOOST_REQUIRE_EQUAL(ec.message(), "store snapshot");
 }
 
+BOOST_AUTO_TEST_CASE(error_t__code__store_archive__true_exected_message)
+{
+    constexpr auto value = error::store_archive;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "store archive");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__store_bootstrap__true_exected_message)
+{
+    constexpr auto value = error::store_bootstrap;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "store bootstrap");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__store_sibling__true_exected_message)
+{
+    constexpr auto value = error::store_sibling;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "store sibling");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__header_archive__true_exected_message)
+{
+    constexpr auto value = error::header_archive;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "header archive");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__header_commitment__true_exected_message)
+{
+    constexpr auto value = error::header_commitment;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "header commitment");
+}
+
+// mempool
+
+BOOST_AUTO_TEST_CASE(error_t__code__pool_duplicate__true_exected_message)
+{
+    constexpr auto value = error::pool_duplicate;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "pool duplicate");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__pool_conflict__true_exected_message)
+{
+    constexpr auto value = error::pool_conflict;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "pool conflict");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__pool_package__true_exected_message)
+{
+    constexpr auto value = error::pool_package;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "pool package limit");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__pool_full__true_exected_message)
+{
+    constexpr auto value = error::pool_full;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "pool full");
+}
+
 // network
 
 BOOST_AUTO_TEST_CASE(error_t__code__slow_channel__true_exected_message)
@@ -146,6 +229,33 @@ BOOST_AUTO_TEST_CASE(error_t__code__suspended_service__true_exected_message)
     BOOST_REQUIRE_EQUAL(ec.message(), "sacrificed service");
 }
 
+BOOST_AUTO_TEST_CASE(error_t__code__metrics_bind__true_exected_message)
+{
+    constexpr auto value = error::metrics_bind;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "metrics bind");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__query_bind__true_exected_message)
+{
+    constexpr auto value = error::query_bind;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "query bind");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__template_bind__true_exected_message)
+{
+    constexpr auto value = error::template_bind;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "template bind");
+}
+
 // blockchain
 
 BOOST_AUTO_TEST_CASE(error_t__code__orphan_block__true_exected_message)
@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+#include <future>
+
+BOOST_AUTO_TEST_SUITE(event_bus_tests)
+
+BOOST_AUTO_TEST_CASE(event_bus__to_topics__events__expected)
+{
+    BOOST_REQUIRE(is_topic(to_topics(chase::split, chase::report),
+        chase::report));
+    BOOST_REQUIRE(!is_topic(to_topics(chase::split, chase::report),
+        chase::download));
+    BOOST_REQUIRE(is_topic(all_topics, chase::stop));
+}
+
+BOOST_AUTO_TEST_CASE(event_bus__notify__unsubscribed_topic__skipped)
+{
+    network::threadpool pool{ 2 };
+    event_bus instance{ pool.service(), 2 };
+
+    std::promise<code> subscribed{};
+    std::promise<chase> delivered{};
+    std::promise<bool> stopped{};
+    instance.subscribe([&](const code&, chase event_, event_value,
+        const event_payload&) NOEXCEPT
+    {
+        if (event_ == chase::stop)
+        {
+            stopped.set_value(true);
+            return false;
+        }
+
+        delivered.set_value(event_);
+        return true;
+    }, to_topics(chase::download), 42,
+    [&](const code& ec, object_key) NOEXCEPT
+    {
+        subscribed.set_value(ec);
+    });
+
+    BOOST_REQUIRE(!subscribed.get_future().get());
+
+    // Both are posted to the one shard of the subscriber, in order.
+    instance.notify(error::success, chase::report, {}, {});
+    instance.notify(error::success, chase::download, {}, {});
+    BOOST_REQUIRE(delivered.get_future().get() == chase::download);
+
+    instance.stop(network::error::service_stopped);
+    BOOST_REQUIRE(stopped.get_future().get());
+
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(event_bus__notify__payload__shared)
+{
+    network::threadpool pool{ 2 };
+    event_bus instance{ pool.service(), 1 };
+
+    std::promise<code> subscribed{};
+    std::promise<size_t> delivered{};
+    instance.subscribe([&](const code&, chase event_, event_value,
+        const event_payload& payload) NOEXCEPT
+    {
+        if (event_ == chase::stop)
+            return false;
+
+        delivered.set_value(*payload_cast<size_t>(payload));
+        return true;
+    }, to_topics(chase::checked), 1, [&](const code& ec, object_key) NOEXCEPT
+    {
+        subscribed.set_value(ec);
+    });
+
+    BOOST_REQUIRE(!subscribed.get_future().get());
+
+    instance.notify(error::success, chase::checked, 9,
+        make_payload<size_t>(42u));
+    BOOST_REQUIRE_EQUAL(delivered.get_future().get(), 42u);
+
+    instance.stop(network::error::service_stopped);
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_CASE(event_bus__notify_one__subscriber__delivered)
+{
+    network::threadpool pool{ 2 };
+    event_bus instance{ pool.service(), 3 };
+
+    std::promise<code> subscribed{};
+    std::promise<event_value> delivered{};
+    instance.subscribe([&](const code&, chase event_,
+        event_value value, const event_payload&) NOEXCEPT
+    {
+        if (event_ == chase::stop)
+            return false;
+
+        delivered.set_value(value);
+        return true;
+    }, all_topics, 7, [&](const code& ec, object_key) NOEXCEPT
+    {
+        subscribed.set_value(ec);
+    });
+
+    BOOST_REQUIRE(!subscribed.get_future().get());
+
+    instance.notify_one(7, error::success, chase::split, 42);
+    BOOST_REQUIRE_EQUAL(delivered.get_future().get(), 42u);
+
+    instance.stop(network::error::service_stopped);
+    pool.stop();
+    BOOST_REQUIRE(pool.join());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
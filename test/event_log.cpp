@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(event_log_tests)
+
+BOOST_AUTO_TEST_CASE(event_log__write__record__fixed_width_little_endian)
+{
+    std::ostringstream sink{};
+    event_log::write(sink, { 0x0102030405060708, 0x0a0b0c0d, 42 });
+    const auto bytes = sink.str();
+    BOOST_REQUIRE_EQUAL(bytes.size(), event_log::record_size);
+    BOOST_REQUIRE_EQUAL(bytes[0], '\x08');
+    BOOST_REQUIRE_EQUAL(bytes[7], '\x01');
+    BOOST_REQUIRE_EQUAL(bytes[8], '\x0d');
+    BOOST_REQUIRE_EQUAL(bytes[11], '\x0a');
+    BOOST_REQUIRE_EQUAL(bytes[12], '\x2a');
+    BOOST_REQUIRE_EQUAL(bytes[15], '\x00');
+}
+
+BOOST_AUTO_TEST_CASE(event_log__read__written__round_trip)
+{
+    std::stringstream stream{};
+    event_log::write(stream, { 0x0102030405060708, 0x0a0b0c0d, 42 });
+
+    event_log::record out{};
+    BOOST_REQUIRE(event_log::read(stream, out));
+    BOOST_REQUIRE_EQUAL(out.value, 0x0102030405060708u);
+    BOOST_REQUIRE_EQUAL(out.milliseconds, 0x0a0b0c0du);
+    BOOST_REQUIRE_EQUAL(out.event, 42u);
+    BOOST_REQUIRE(!event_log::read(stream, out));
+}
+
+BOOST_AUTO_TEST_CASE(event_log__read__partial__false)
+{
+    std::stringstream stream{ std::string(sub1(event_log::record_size), '\0') };
+    event_log::record out{};
+    BOOST_REQUIRE(!event_log::read(stream, out));
+}
+
+BOOST_AUTO_TEST_CASE(event_log__aggregate__records__counts_by_period)
+{
+    std::stringstream stream{};
+    event_log::write(stream, { 1, 0, 3 });
+    event_log::write(stream, { 2, 999, 3 });
+    event_log::write(stream, { 3, 2500, 3 });
+    event_log::write(stream, { 4, 1000, 5 });
+
+    const auto rates = event_log::aggregate(stream, 1000);
+    BOOST_REQUIRE_EQUAL(rates.size(), 2u);
+    BOOST_REQUIRE_EQUAL(rates.at(3).size(), 3u);
+    BOOST_REQUIRE_EQUAL(rates.at(3)[0], 2u);
+    BOOST_REQUIRE_EQUAL(rates.at(3)[1], 0u);
+    BOOST_REQUIRE_EQUAL(rates.at(3)[2], 1u);
+    BOOST_REQUIRE_EQUAL(rates.at(5).size(), 2u);
+    BOOST_REQUIRE_EQUAL(rates.at(5)[1], 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
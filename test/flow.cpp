@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(flow_tests)
+
+using strand_t = boost::asio::strand<boost::asio::io_context::executor_type>;
+using handler_t = std::function<void(const code&, size_t)>;
+
+// Sets its flag when destroyed (with its frame).
+struct sentinel
+{
+    ~sentinel() NOEXCEPT
+    {
+        destroyed = true;
+    }
+
+    bool& destroyed;
+};
+
+static flow awaiting(strand_t& strand, handler_t& pending, code& out_ec,
+    size_t& out_value, bool& destroyed) NOEXCEPT
+{
+    const sentinel guard{ destroyed };
+    const auto [ec, value] = co_await await<code, size_t>(strand,
+        [&](handler_t&& handler) NOEXCEPT
+        {
+            pending = std::move(handler);
+        });
+
+    out_ec = ec;
+    out_value = value;
+}
+
+BOOST_AUTO_TEST_CASE(flow__await__completed__resumed_on_strand)
+{
+    boost::asio::io_context service{};
+    strand_t strand{ service.get_executor() };
+    handler_t pending{};
+    code ec{};
+    size_t value{};
+    auto destroyed = false;
+    awaiting(strand, pending, ec, value, destroyed);
+    BOOST_REQUIRE(pending);
+    BOOST_REQUIRE(!destroyed);
+
+    pending(error::unexpected_event, 42);
+    BOOST_REQUIRE_EQUAL(value, 0u);
+    BOOST_REQUIRE(!destroyed);
+
+    service.run();
+    BOOST_REQUIRE_EQUAL(ec, error::unexpected_event);
+    BOOST_REQUIRE_EQUAL(value, 42u);
+    BOOST_REQUIRE(destroyed);
+}
+
+BOOST_AUTO_TEST_CASE(flow__await__unresumed__frame_freed)
+{
+    code ec{};
+    size_t value{};
+    auto destroyed = false;
+    {
+        boost::asio::io_context service{};
+        strand_t strand{ service.get_executor() };
+        handler_t pending{};
+        awaiting(strand, pending, ec, value, destroyed);
+        pending(error::success, 42);
+        BOOST_REQUIRE(!destroyed);
+    }
+
+    BOOST_REQUIRE(destroyed);
+    BOOST_REQUIRE_EQUAL(value, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(flow__await__uninvoked__frame_freed)
+{
+    boost::asio::io_context service{};
+    strand_t strand{ service.get_executor() };
+    handler_t pending{};
+    code ec{};
+    size_t value{};
+    auto destroyed = false;
+    awaiting(strand, pending, ec, value, destroyed);
+    BOOST_REQUIRE(pending);
+    BOOST_REQUIRE(!destroyed);
+
+    pending = nullptr;
+    BOOST_REQUIRE(destroyed);
+    BOOST_REQUIRE_EQUAL(value, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(hash_filter_tests)
+
+using namespace system;
+
+BOOST_AUTO_TEST_CASE(hash_filter__enabled__zero_slots__false)
+{
+    const hash_filter instance{ 0 };
+    BOOST_REQUIRE(!instance.enabled());
+}
+
+BOOST_AUTO_TEST_CASE(hash_filter__contains__disabled_inserted__false)
+{
+    hash_filter instance{ 0 };
+    instance.insert(one_hash);
+    BOOST_REQUIRE(!instance.contains(one_hash));
+}
+
+BOOST_AUTO_TEST_CASE(hash_filter__contains__not_inserted__false)
+{
+    const hash_filter instance{ 16 };
+    BOOST_REQUIRE(instance.enabled());
+    BOOST_REQUIRE(!instance.contains(one_hash));
+    BOOST_REQUIRE(!instance.contains(null_hash));
+}
+
+BOOST_AUTO_TEST_CASE(hash_filter__contains__inserted__true)
+{
+    hash_filter instance{ 16 };
+    instance.insert(one_hash);
+    BOOST_REQUIRE(instance.contains(one_hash));
+}
+
+BOOST_AUTO_TEST_CASE(hash_filter__contains__erased__false)
+{
+    hash_filter instance{ 16 };
+    instance.insert(one_hash);
+    instance.erase(one_hash);
+    BOOST_REQUIRE(!instance.contains(one_hash));
+}
+
+BOOST_AUTO_TEST_CASE(hash_filter__erase__overwritten_slot__retains_newer)
+{
+    auto first = null_hash;
+    auto second = null_hash;
+    first[8] = 1;
+    second[8] = 2;
+
+    hash_filter instance{ 16 };
+    instance.insert(first);
+    instance.insert(second);
+    instance.erase(first);
+    BOOST_REQUIRE(instance.contains(second));
+}
+
+BOOST_AUTO_TEST_CASE(hash_filter__contains__overwritten_slot__false)
+{
+    // Both hashes map to the same slot (zero low bytes), with distinct tags.
+    auto first = null_hash;
+    auto second = null_hash;
+    first[8] = 1;
+    second[8] = 2;
+
+    hash_filter instance{ 16 };
+    instance.insert(first);
+    instance.insert(second);
+    BOOST_REQUIRE(!instance.contains(first));
+    BOOST_REQUIRE(instance.contains(second));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
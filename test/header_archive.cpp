@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(header_archive_tests)
+
+using namespace system;
+namespace fs = std::filesystem;
+
+static const hash_digest genesis{ base16_hash(
+    "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f") };
+
+// Headers linked from genesis, at heights one through count.
+static chain::header_cptrs make_chain(size_t count) NOEXCEPT
+{
+    chain::header_cptrs chain{};
+    auto previous = genesis;
+    for (size_t height = 1; height <= count; ++height)
+    {
+        const auto value = possible_narrow_cast<uint32_t>(height);
+        chain.push_back(std::make_shared<const chain::header>(1u,
+            hash_digest{ previous }, sha256_hash(to_chunk(to_big_endian(value))),
+            value, 0x1d00ffffu, value));
+        previous = chain.back()->hash();
+    }
+
+    return chain;
+}
+
+static code write_chain(const fs::path& file,
+    const chain::header_cptrs& chain) NOEXCEPT
+{
+    return header_archive::write(file, chain.size(), [&](size_t height)
+        NOEXCEPT
+    {
+        return chain.at(sub1(height));
+    });
+}
+
+BOOST_AUTO_TEST_CASE(header_archive__read__written__expected_headers)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path file{ TEST_DIRECTORY + "/headers.bin" };
+    const auto chain = make_chain(3);
+    BOOST_REQUIRE(!write_chain(file, chain));
+    BOOST_REQUIRE_EQUAL(fs::file_size(file), 3u * header_archive::record_size);
+
+    chain::header_cptrs out{};
+    const chain::checkpoint commitment{ chain.back()->hash(), 3 };
+    const auto ec = header_archive::read(file, genesis, commitment,
+        [&](const chain::header& header) NOEXCEPT
+        {
+            out.push_back(std::make_shared<const chain::header>(header));
+            return true;
+        });
+
+    BOOST_REQUIRE(!ec);
+    BOOST_REQUIRE_EQUAL(out.size(), 3u);
+    BOOST_REQUIRE(*out.at(0) == *chain.at(0));
+    BOOST_REQUIRE(*out.at(1) == *chain.at(1));
+    BOOST_REQUIRE(*out.at(2) == *chain.at(2));
+}
+
+BOOST_AUTO_TEST_CASE(header_archive__read__wrong_hash__header_commitment)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path file{ TEST_DIRECTORY + "/headers.bin" };
+    const auto chain = make_chain(3);
+    BOOST_REQUIRE(!write_chain(file, chain));
+
+    size_t count{};
+    const chain::checkpoint commitment{ chain.front()->hash(), 3 };
+    const auto ec = header_archive::read(file, genesis, commitment,
+        [&](const chain::header&) NOEXCEPT
+        {
+            ++count;
+            return true;
+        });
+
+    BOOST_REQUIRE_EQUAL(ec, error::header_commitment);
+    BOOST_REQUIRE_EQUAL(count, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(header_archive__read__wrong_height__header_commitment)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path file{ TEST_DIRECTORY + "/headers.bin" };
+    const auto chain = make_chain(3);
+    BOOST_REQUIRE(!write_chain(file, chain));
+
+    const chain::checkpoint commitment{ chain.at(1)->hash(), 2 };
+    const auto ec = header_archive::read(file, genesis, commitment,
+        [](const chain::header&) NOEXCEPT { return true; });
+
+    BOOST_REQUIRE_EQUAL(ec, error::header_commitment);
+}
+
+BOOST_AUTO_TEST_CASE(header_archive__read__sink_failure__header_archive)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path file{ TEST_DIRECTORY + "/headers.bin" };
+    const auto chain = make_chain(2);
+    BOOST_REQUIRE(!write_chain(file, chain));
+
+    const chain::checkpoint commitment{ chain.back()->hash(), 2 };
+    const auto ec = header_archive::read(file, genesis, commitment,
+        [](const chain::header&) NOEXCEPT { return false; });
+
+    BOOST_REQUIRE_EQUAL(ec, error::header_archive);
+}
+
+BOOST_AUTO_TEST_CASE(header_archive__read__missing_file__header_archive)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path file{ TEST_DIRECTORY + "/missing.bin" };
+    const auto ec = header_archive::read(file, genesis, {},
+        [](const chain::header&) NOEXCEPT { return true; });
+
+    BOOST_REQUIRE_EQUAL(ec, error::header_archive);
+}
+
+BOOST_AUTO_TEST_CASE(header_archive__write__missing_header__header_archive)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path file{ TEST_DIRECTORY + "/headers.bin" };
+    const auto ec = header_archive::write(file, 2, [](size_t) NOEXCEPT
+    {
+        return chain::header::cptr{};
+    });
+
+    BOOST_REQUIRE_EQUAL(ec, error::header_archive);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
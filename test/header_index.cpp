@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(header_index_tests)
+
+using namespace system;
+
+// The nonce distinguishes headers.
+static chain::header make(uint32_t nonce) NOEXCEPT
+{
+    return { 1, null_hash, null_hash, 0, 0, nonce };
+}
+
+BOOST_AUTO_TEST_CASE(header_index__push__not_next__false)
+{
+    header_index instance{};
+    BOOST_REQUIRE(!instance.push(make(1), 1));
+    BOOST_REQUIRE(instance.push(make(0), 0));
+    BOOST_REQUIRE(!instance.push(make(1), 0));
+    BOOST_REQUIRE(!instance.push(make(2), 2));
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(header_index__get__range__expected)
+{
+    header_index instance{};
+    BOOST_REQUIRE(instance.push(make(0), 0));
+    BOOST_REQUIRE(instance.push(make(1), 1));
+    BOOST_REQUIRE(instance.push(make(2), 2));
+
+    const auto headers = instance.get(1, 5);
+    BOOST_REQUIRE_EQUAL(headers.size(), 2u);
+    BOOST_REQUIRE_EQUAL(headers.front()->hash(), make(1).hash());
+    BOOST_REQUIRE_EQUAL(headers.back()->hash(), make(2).hash());
+    BOOST_REQUIRE_EQUAL(instance.get(0, 1).size(), 1u);
+    BOOST_REQUIRE(instance.get(3, 1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(header_index__pop__reorganized__replaced)
+{
+    header_index instance{};
+    BOOST_REQUIRE(instance.push(make(0), 0));
+    BOOST_REQUIRE(instance.push(make(1), 1));
+    BOOST_REQUIRE(instance.push(make(2), 2));
+
+    instance.pop(1);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+    BOOST_REQUIRE(instance.push(make(42), 1));
+    BOOST_REQUIRE_EQUAL(instance.get(1, 1).front()->hash(), make(42).hash());
+
+    instance.clear();
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(header_ranges_tests)
+
+using namespace system;
+using namespace system::chain;
+
+static const checkpoints points
+{
+    { null_hash, 0 },
+    { one_hash, 10 },
+    { null_hash, 20 }
+};
+
+static void ignore(const header_cptrs&, organize_handler&&) NOEXCEPT
+{
+}
+
+BOOST_AUTO_TEST_CASE(header_ranges__claim__unstarted__false)
+{
+    header_ranges instance{ points, ignore };
+    header_ranges::range out{};
+    BOOST_REQUIRE(!instance.claim(out));
+    BOOST_REQUIRE(instance.done());
+}
+
+BOOST_AUTO_TEST_CASE(header_ranges__claim__started__ascending_ranges)
+{
+    header_ranges instance{ points, ignore };
+    instance.start({ null_hash, 5 });
+
+    header_ranges::range out{};
+    BOOST_REQUIRE(instance.claim(out));
+    BOOST_REQUIRE_EQUAL(out.index, 0u);
+    BOOST_REQUIRE_EQUAL(out.start.height(), 5u);
+    BOOST_REQUIRE_EQUAL(out.stop.height(), 10u);
+
+    BOOST_REQUIRE(instance.claim(out));
+    BOOST_REQUIRE_EQUAL(out.index, 1u);
+    BOOST_REQUIRE_EQUAL(out.start.height(), 10u);
+    BOOST_REQUIRE_EQUAL(out.stop.height(), 20u);
+
+    BOOST_REQUIRE(!instance.claim(out));
+    BOOST_REQUIRE(!instance.done());
+}
+
+BOOST_AUTO_TEST_CASE(header_ranges__release__claimed__reclaimable)
+{
+    header_ranges instance{ points, ignore };
+    instance.start({ null_hash, 0 });
+
+    header_ranges::range first{};
+    header_ranges::range second{};
+    BOOST_REQUIRE(instance.claim(first));
+    BOOST_REQUIRE(instance.claim(second));
+    instance.release(first);
+
+    header_ranges::range out{};
+    BOOST_REQUIRE(instance.claim(out));
+    BOOST_REQUIRE_EQUAL(out.index, first.index);
+}
+
+BOOST_AUTO_TEST_CASE(header_ranges__complete__wrong_count__false_released)
+{
+    header_ranges instance{ points, ignore };
+    instance.start({ null_hash, 0 });
+
+    header_ranges::range out{};
+    BOOST_REQUIRE(instance.claim(out));
+    BOOST_REQUIRE(!instance.complete(out, {}));
+    BOOST_REQUIRE(instance.claim(out));
+    BOOST_REQUIRE_EQUAL(out.index, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(memory_governor_tests)
+
+BOOST_AUTO_TEST_CASE(memory_governor__balance__disabled__full_allowance)
+{
+    memory_governor instance{ 0 };
+    instance.enroll("cache", []() NOEXCEPT { return 42_u64; });
+    BOOST_REQUIRE(!instance.enabled());
+    BOOST_REQUIRE_EQUAL(instance.balance(), 100u);
+    BOOST_REQUIRE_EQUAL(instance.usage(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.usage("cache"), 0u);
+    BOOST_REQUIRE(!instance.pressured());
+}
+
+BOOST_AUTO_TEST_CASE(memory_governor__balance__below_low__full_allowance)
+{
+    memory_governor instance{ 1000 };
+    instance.enroll("cache", []() NOEXCEPT { return 500_u64; });
+    instance.enroll("queue", []() NOEXCEPT { return 250_u64; });
+    BOOST_REQUIRE_EQUAL(instance.balance(), 100u);
+    BOOST_REQUIRE_EQUAL(instance.usage(), 750u);
+    BOOST_REQUIRE_EQUAL(instance.usage("queue"), 250u);
+    BOOST_REQUIRE(!instance.pressured());
+}
+
+BOOST_AUTO_TEST_CASE(memory_governor__balance__between__scaled_allowance)
+{
+    memory_governor instance{ 1000 };
+    instance.enroll("queue", []() NOEXCEPT { return 875_u64; });
+    BOOST_REQUIRE_EQUAL(instance.balance(), 50u);
+    BOOST_REQUIRE_EQUAL(instance.allowance(), 50u);
+    BOOST_REQUIRE(!instance.pressured());
+}
+
+BOOST_AUTO_TEST_CASE(memory_governor__balance__over__shrinks_in_order)
+{
+    uint64_t cache{ 600 };
+    uint64_t tree{ 600 };
+    uint64_t asked{};
+    memory_governor instance{ 1000 };
+    instance.enroll("queue", []() NOEXCEPT { return 100_u64; });
+    instance.enroll("cache", [&]() NOEXCEPT { return cache; },
+        [&](uint64_t excess) NOEXCEPT
+        {
+            asked = excess;
+            cache -= 100;
+        });
+    instance.enroll("tree", [&]() NOEXCEPT { return tree; },
+        [&](uint64_t excess) NOEXCEPT
+        {
+            tree -= excess;
+        });
+
+    BOOST_REQUIRE_EQUAL(instance.balance(), 0u);
+    BOOST_REQUIRE_EQUAL(asked, 300u);
+    BOOST_REQUIRE_EQUAL(cache, 500u);
+    BOOST_REQUIRE_EQUAL(tree, 400u);
+    BOOST_REQUIRE_EQUAL(instance.usage(), 1000u);
+    BOOST_REQUIRE(instance.pressured());
+}
+
+BOOST_AUTO_TEST_CASE(memory_governor__balance__shrunk__allowance_restored)
+{
+    uint64_t cache{ 2000 };
+    memory_governor instance{ 1000 };
+    instance.enroll("cache", [&]() NOEXCEPT { return cache; });
+    BOOST_REQUIRE_EQUAL(instance.balance(), 0u);
+    BOOST_REQUIRE(instance.pressured());
+
+    cache = 100;
+    BOOST_REQUIRE_EQUAL(instance.balance(), 100u);
+    BOOST_REQUIRE(!instance.pressured());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(metrics_registry_tests)
+
+using gauge = metrics_registry::gauge;
+using counter = metrics_registry::counter;
+using histogram = metrics_registry::histogram;
+
+BOOST_AUTO_TEST_CASE(metrics_registry__fired__events__counted)
+{
+    metrics_registry instance{};
+    instance.fired(events::block_archived);
+    instance.fired(events::block_archived);
+    instance.fired(events::block_confirmed);
+    BOOST_REQUIRE_EQUAL(instance.fired_count(events::block_archived), 2u);
+    BOOST_REQUIRE_EQUAL(instance.fired_count(events::block_confirmed), 1u);
+    BOOST_REQUIRE_EQUAL(instance.fired_count(events::block_validated), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(metrics_registry__fired__unknown_event__ignored)
+{
+    metrics_registry instance{};
+    instance.fired(max_uint8);
+    BOOST_REQUIRE_EQUAL(instance.fired_count(max_uint8), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(metrics_registry__add__counter__accumulated)
+{
+    metrics_registry instance{};
+    instance.add(counter::archived_bytes, 40);
+    instance.add(counter::archived_bytes, 2);
+    BOOST_REQUIRE_EQUAL(instance.value(counter::archived_bytes), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(metrics_registry__set__gauge__overwritten)
+{
+    metrics_registry instance{};
+    instance.set(gauge::confirmed_height, 42);
+    instance.set(gauge::confirmed_height, 41);
+    BOOST_REQUIRE_EQUAL(instance.value(gauge::confirmed_height), 41u);
+}
+
+BOOST_AUTO_TEST_CASE(metrics_registry__report__observations__cumulative_buckets)
+{
+    metrics_registry instance{};
+    instance.observe(histogram::archive_microseconds, 0);
+    instance.observe(histogram::archive_microseconds, 3);
+    instance.observe(histogram::archive_microseconds, max_uint64);
+    BOOST_REQUIRE_EQUAL(instance.observations(
+        histogram::archive_microseconds), 3u);
+
+    const auto report = instance.report();
+    BOOST_REQUIRE(report.find(
+        "bn_archive_microseconds_bucket{le=\"0\"} 1\n") != std::string::npos);
+    BOOST_REQUIRE(report.find(
+        "bn_archive_microseconds_bucket{le=\"3\"} 2\n") != std::string::npos);
+    BOOST_REQUIRE(report.find(
+        "bn_archive_microseconds_bucket{le=\"+Inf\"} 3\n") != std::string::npos);
+    BOOST_REQUIRE(report.find(
+        "bn_archive_microseconds_count 3\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(metrics_registry__strand_at__wrap__handled_and_drained)
+{
+    metrics_registry instance{};
+    auto& metrics = instance.strand_at(metrics_registry::strand::check);
+    auto called = false;
+    auto wrapped = metrics.wrap([&]() NOEXCEPT { called = true; });
+    BOOST_REQUIRE_EQUAL(metrics.depth.load(), 1u);
+
+    wrapped();
+    BOOST_REQUIRE(called);
+    BOOST_REQUIRE_EQUAL(metrics.depth.load(), 0u);
+    BOOST_REQUIRE_EQUAL(metrics.handled.load(), 1u);
+
+    const auto report = instance.report();
+    BOOST_REQUIRE(report.find(
+        "bn_strand_handled_total{strand=\"check\"} 1\n") != std::string::npos);
+    BOOST_REQUIRE(report.find(
+        "bn_strand_depth{strand=\"check\"} 0\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(metrics_registry__strand_name__all__expected)
+{
+    BOOST_REQUIRE_EQUAL(metrics_registry::strand_name(
+        metrics_registry::strand::node), "node");
+    BOOST_REQUIRE_EQUAL(metrics_registry::strand_name(
+        metrics_registry::strand::storage), "storage");
+}
+
+BOOST_AUTO_TEST_CASE(metrics_registry__report__default__openmetrics_terminated)
+{
+    const metrics_registry instance{};
+    const auto report = instance.report();
+    BOOST_REQUIRE(report.find(
+        "bn_events_total{event=\"block_archived\"} 0\n") != std::string::npos);
+    BOOST_REQUIRE(report.find("bn_archived_bytes_total 0\n") != std::string::npos);
+    BOOST_REQUIRE(report.find("bn_snapshot_bytes_total 0\n") != std::string::npos);
+    BOOST_REQUIRE(report.find("bn_confirmed_height 0\n") != std::string::npos);
+    BOOST_REQUIRE(report.find("bn_checked_height 0\n") != std::string::npos);
+    BOOST_REQUIRE(report.ends_with("# EOF\n"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
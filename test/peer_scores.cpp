@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(peer_scores_tests)
+
+BOOST_AUTO_TEST_CASE(peer_scores__record__zero_capacity__disabled)
+{
+    peer_scores instance{ 0 };
+    instance.record("1.2.3.4", 8333, 1000);
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(instance.best(10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(peer_scores__record__repeated__moving_average)
+{
+    peer_scores instance{ 10 };
+    instance.record("1.2.3.4", 8333, 1000);
+    instance.record("1.2.3.4", 8333, 2000);
+    const auto best = instance.best(10);
+    BOOST_REQUIRE_EQUAL(best.size(), 1u);
+    BOOST_REQUIRE_EQUAL(best.front().rate, 1250u);
+}
+
+BOOST_AUTO_TEST_CASE(peer_scores__best__dropped__demoted)
+{
+    peer_scores instance{ 10 };
+    instance.record("1.2.3.4", 8333, 1000);
+    instance.record("5.6.7.8", 8333, 800);
+    instance.drop("1.2.3.4", 8333);
+    const auto best = instance.best(2);
+    BOOST_REQUIRE_EQUAL(best.size(), 2u);
+    BOOST_REQUIRE_EQUAL(best.front().host, "5.6.7.8");
+    BOOST_REQUIRE_EQUAL(peer_scores::to_score(best.back()), 500u);
+}
+
+BOOST_AUTO_TEST_CASE(peer_scores__best__unmeasured__excluded)
+{
+    peer_scores instance{ 10 };
+    instance.drop("1.2.3.4", 8333);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE(instance.best(10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(peer_scores__record__above_capacity__lowest_evicted)
+{
+    peer_scores instance{ 2 };
+    instance.record("1.2.3.4", 8333, 300);
+    instance.record("5.6.7.8", 8333, 100);
+    instance.record("9.9.9.9", 8333, 200);
+    const auto best = instance.best(10);
+    BOOST_REQUIRE_EQUAL(best.size(), 2u);
+    BOOST_REQUIRE_EQUAL(best.front().host, "1.2.3.4");
+    BOOST_REQUIRE_EQUAL(best.back().host, "9.9.9.9");
+}
+
+BOOST_AUTO_TEST_CASE(peer_scores__from_string__to_string__round_trip)
+{
+    peer_scores instance{ 10 };
+    instance.record("1.2.3.4", 8333, 1000);
+    instance.drop("1.2.3.4", 8333);
+
+    peer_scores out{ 10 };
+    BOOST_REQUIRE(out.from_string(instance.to_string()));
+    const auto best = out.best(10);
+    BOOST_REQUIRE_EQUAL(best.size(), 1u);
+    BOOST_REQUIRE_EQUAL(best.front().host, "1.2.3.4");
+    BOOST_REQUIRE_EQUAL(best.front().port, 8333u);
+    BOOST_REQUIRE_EQUAL(best.front().rate, 1000u);
+    BOOST_REQUIRE_EQUAL(best.front().drops, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(peer_scores__from_string__malformed__false)
+{
+    peer_scores instance{ 10 };
+    BOOST_REQUIRE(!instance.from_string("1.2.3.4 8333 x 0\n"));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
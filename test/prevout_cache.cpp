@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(prevout_cache_tests)
+
+using namespace system;
+
+BOOST_AUTO_TEST_CASE(prevout_cache__enabled__zero__false)
+{
+    prevout_cache cache{ 0 };
+    BOOST_REQUIRE(!cache.enabled());
+    BOOST_REQUIRE(!cache.populate(chain::transaction{}));
+    BOOST_REQUIRE_EQUAL(cache.bytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(prevout_cache__populate__cached_output__taken)
+{
+    prevout_cache cache{ 1'000'000 };
+    BOOST_REQUIRE(cache.enabled());
+
+    const chain::transaction prior
+    {
+        1,
+        chain::inputs{},
+        chain::outputs{ chain::output{ 42, chain::script{} } },
+        0
+    };
+
+    cache.put(chain::block{ chain::header{}, chain::transactions{ prior } });
+    BOOST_REQUIRE(!is_zero(cache.bytes()));
+
+    const chain::transaction spend
+    {
+        1,
+        chain::inputs
+        {
+            chain::input
+            {
+                chain::point{ prior.hash(false), 0 },
+                chain::script{},
+                0
+            }
+        },
+        chain::outputs{},
+        0
+    };
+
+    BOOST_REQUIRE(cache.populate(spend));
+    const auto& prevout = spend.inputs_ptr()->front()->prevout;
+    BOOST_REQUIRE(prevout);
+    BOOST_REQUIRE_EQUAL(prevout->value(), 42u);
+
+    // Taken on hit, spend of the same output is no longer cached.
+    const chain::transaction respend
+    {
+        1,
+        chain::inputs
+        {
+            chain::input
+            {
+                chain::point{ prior.hash(false), 0 },
+                chain::script{},
+                0
+            }
+        },
+        chain::outputs{},
+        0
+    };
+
+    BOOST_REQUIRE(!cache.populate(respend));
+}
+
+BOOST_AUTO_TEST_CASE(prevout_cache__populate__null_point__true)
+{
+    prevout_cache cache{ 1'000'000 };
+    const chain::transaction coinbase
+    {
+        1,
+        chain::inputs
+        {
+            chain::input
+            {
+                chain::point{ null_hash, chain::point::null_index },
+                chain::script{},
+                0
+            }
+        },
+        chain::outputs{},
+        0
+    };
+
+    BOOST_REQUIRE(cache.populate(coinbase));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(script_cache_tests)
+
+using namespace system;
+
+static const auto wtxid = base16_hash(
+    "0000000000000000000000000000000000000000000000000000000000000001");
+
+BOOST_AUTO_TEST_CASE(script_cache__enabled__zero__false)
+{
+    script_cache cache{ 0 };
+    BOOST_REQUIRE(!cache.enabled());
+    cache.insert(wtxid, 42);
+    BOOST_REQUIRE(!cache.contains(wtxid, 42));
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__contains__inserted__keyed_by_flags)
+{
+    script_cache cache{ 100 };
+    BOOST_REQUIRE(cache.enabled());
+    cache.insert(wtxid, 42);
+    BOOST_REQUIRE(cache.contains(wtxid, 42));
+    BOOST_REQUIRE(!cache.contains(wtxid, 43));
+    BOOST_REQUIRE(!cache.contains(null_hash, 42));
+
+    // Duplicates are not counted.
+    cache.insert(wtxid, 42);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__insert__shard_overflow__evicts_oldest)
+{
+    // One entry per shard, and all keys below map to the same shard.
+    script_cache cache{ 16 };
+    cache.insert(wtxid, 1);
+    cache.insert(wtxid, 2);
+    BOOST_REQUIRE(!cache.contains(wtxid, 1));
+    BOOST_REQUIRE(cache.contains(wtxid, 2));
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
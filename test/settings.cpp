@@ -37,11 +37,14 @@ BOOST_AUTO_TEST_CASE(settings__log__default_context__expected)
     BOOST_REQUIRE_EQUAL(log.quitting, false /*levels::quitting_defined*/);
     BOOST_REQUIRE_EQUAL(log.objects, false /*levels::objects_defined*/);
     BOOST_REQUIRE_EQUAL(log.verbose, false /*levels::verbose_defined*/);
+    BOOST_REQUIRE_EQUAL(log.binary_events, false);
     BOOST_REQUIRE_EQUAL(log.maximum_size, 1'000'000_u32);
+    BOOST_REQUIRE_EQUAL(log.flush_milliseconds, 0u);
     BOOST_REQUIRE_EQUAL(log.path, "");
     BOOST_REQUIRE_EQUAL(log.log_file1(), "bn_end.log");
     BOOST_REQUIRE_EQUAL(log.log_file2(), "bn_begin.log");
     BOOST_REQUIRE_EQUAL(log.events_file(), "events.log");
+    BOOST_REQUIRE_EQUAL(log.trace_file(), "trace.json");
 #if defined(HAVE_MSC)
     BOOST_REQUIRE_EQUAL(log.symbols, "");
 #endif
@@ -55,18 +58,67 @@ BOOST_AUTO_TEST_CASE(settings__node__default_context__expected)
 
     const node::settings node{};
     BOOST_REQUIRE_EQUAL(node.headers_first, true);
+    BOOST_REQUIRE_EQUAL(node.cumulative_work, true);
+    BOOST_REQUIRE_EQUAL(node.persist_tree, false);
+    BOOST_REQUIRE_EQUAL(node.parallel_headers, false);
+    BOOST_REQUIRE_EQUAL(node.parallel_blocks, false);
+    BOOST_REQUIRE_EQUAL(node.auto_scale, false);
+    BOOST_REQUIRE_EQUAL(node.coalesce_events, false);
+    BOOST_REQUIRE_EQUAL(node.instrument_strands, false);
+    BOOST_REQUIRE_EQUAL(node.snapshot_concurrent, false);
+    BOOST_REQUIRE_EQUAL(node.warm_start, false);
+    BOOST_REQUIRE_EQUAL(node.defer_witness, false);
+    BOOST_REQUIRE_EQUAL(node.defer_strong, false);
+    BOOST_REQUIRE_EQUAL(node.validate_candidates, false);
+    BOOST_REQUIRE_EQUAL(node.trace_spans, 0u);
+    BOOST_REQUIRE_EQUAL(node.storage_horizon_minutes, 0u);
+    BOOST_REQUIRE_EQUAL(node.prefetch_blocks, 0u);
+    BOOST_REQUIRE_EQUAL(node.admission_threads, 4u);
+    BOOST_REQUIRE_EQUAL(node.script_cache_entries, 100'000u);
+    BOOST_REQUIRE_EQUAL(node.announcement_milliseconds, 5000u);
+    BOOST_REQUIRE_EQUAL(node.tip_blocks, 0_u32);
+    BOOST_REQUIRE_EQUAL(node.download_bytes_per_second, 0u);
+    BOOST_REQUIRE_EQUAL(node.memory_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(node.history_threads, 0u);
+    BOOST_REQUIRE(node.bootstrap_path.empty());
+    BOOST_REQUIRE(node.headers_path.empty());
+    BOOST_REQUIRE(node.sibling_host.empty());
+    BOOST_REQUIRE_EQUAL(node.serve_address, "127.0.0.1");
+    BOOST_REQUIRE(node.validate_affinity.empty());
+    BOOST_REQUIRE(node.network_affinity.empty());
     BOOST_REQUIRE_EQUAL(node.allowed_deviation, 1.5);
     BOOST_REQUIRE_EQUAL(node.snapshot_bytes, 107'374'182'400_u64);
+    BOOST_REQUIRE_EQUAL(node.prevout_bytes, 1'073'741'824_u64);
+    BOOST_REQUIRE_EQUAL(node.window_bytes, 4'294'967'296_u64);
+    BOOST_REQUIRE_EQUAL(node.tree_bytes, 268'435'456_u64);
+    BOOST_REQUIRE_EQUAL(node.preallocate_bytes, 0_u64);
+    BOOST_REQUIRE_EQUAL(node.mempool_bytes, 314'572'800_u64);
+    BOOST_REQUIRE_EQUAL(node.block_cache_bytes, 67'108'864_u64);
     BOOST_REQUIRE_EQUAL(node.snapshot_valid, 100'000_u32);
+    BOOST_REQUIRE_EQUAL(node.seen_headers, 65'536_u32);
     BOOST_REQUIRE_EQUAL(node.maximum_height, 0_u32);
     BOOST_REQUIRE_EQUAL(node.maximum_height_(), max_size_t);
     BOOST_REQUIRE_EQUAL(node.maximum_concurrency, 50000_u32);
     BOOST_REQUIRE_EQUAL(node.maximum_concurrency_(), 50000_size);
+    BOOST_REQUIRE_EQUAL(node.maximum_backlog, 100000_u32);
+    BOOST_REQUIRE_EQUAL(node.maximum_backlog_(), 100000_size);
     BOOST_REQUIRE_EQUAL(node.sample_period_seconds, 10_u16);
     BOOST_REQUIRE(node.sample_period() == steady_clock::duration(seconds(10)));
+    BOOST_REQUIRE_EQUAL(node.metrics_port, 0_u16);
+    BOOST_REQUIRE_EQUAL(node.query_connections, 16_u32);
+    BOOST_REQUIRE_EQUAL(node.query_port, 0_u16);
+    BOOST_REQUIRE_EQUAL(node.sibling_port, 0u);
+    BOOST_REQUIRE_EQUAL(node.template_port, 0_u16);
+    BOOST_REQUIRE_EQUAL(node.template_connections, 8_u32);
+    BOOST_REQUIRE_EQUAL(node.query_threads, 2_u32);
+    BOOST_REQUIRE_EQUAL(node.preferred_peers, 0_u32);
     BOOST_REQUIRE_EQUAL(node.currency_window_minutes, 60_u32);
     BOOST_REQUIRE(node.currency_window() == steady_clock::duration(minutes(60)));
     BOOST_REQUIRE_EQUAL(node.threads, 1_u32);
+    BOOST_REQUIRE_EQUAL(node.populate_threads, 0_u32);
+    BOOST_REQUIRE_EQUAL(node.check_threads, 4_u32);
+    BOOST_REQUIRE_EQUAL(node.confirm_threads, 0_u32);
+    BOOST_REQUIRE_EQUAL(node.event_shards, 4_u32);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
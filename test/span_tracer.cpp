@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(span_tracer_tests)
+
+using span = span_tracer::span;
+
+BOOST_AUTO_TEST_CASE(span_tracer__enabled__zero_capacity__false)
+{
+    const span_tracer instance{ 0 };
+    BOOST_REQUIRE(!instance.enabled());
+    BOOST_REQUIRE_EQUAL(instance.now(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(span_tracer__report__disabled_recorded__empty)
+{
+    span_tracer instance{ 0 };
+    instance.record(span::check, instance.now(), 42);
+    BOOST_REQUIRE_EQUAL(instance.report(),
+        "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}\n");
+}
+
+BOOST_AUTO_TEST_CASE(span_tracer__report__recorded__expected_event)
+{
+    span_tracer instance{ 4 };
+    BOOST_REQUIRE(instance.enabled());
+
+    instance.record(span::validate_tx, instance.now(), 42);
+    const auto report = instance.report();
+    BOOST_REQUIRE(report.find("\"name\":\"validate_tx\"") != std::string::npos);
+    BOOST_REQUIRE(report.find("\"ph\":\"X\"") != std::string::npos);
+    BOOST_REQUIRE(report.find("\"tid\":0") != std::string::npos);
+    BOOST_REQUIRE(report.find("{\"height\":42}") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(span_tracer__report__overwritten__retains_newest)
+{
+    span_tracer instance{ 2 };
+    instance.record(span::download, instance.now(), 1);
+    instance.record(span::archive, instance.now(), 2);
+    instance.record(span::confirm, instance.now(), 3);
+
+    const auto report = instance.report();
+    BOOST_REQUIRE(report.find("\"name\":\"download\"") == std::string::npos);
+    BOOST_REQUIRE(report.find("\"name\":\"archive\"") != std::string::npos);
+    BOOST_REQUIRE(report.find("\"name\":\"confirm\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(span_tracer__span_name__all__expected)
+{
+    BOOST_REQUIRE_EQUAL(span_tracer::span_name(span::download), "download");
+    BOOST_REQUIRE_EQUAL(span_tracer::span_name(span::snapshot), "snapshot");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
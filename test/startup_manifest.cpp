@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(startup_manifest_tests)
+
+static startup_manifest expected() NOEXCEPT
+{
+    startup_manifest manifest{};
+    manifest.candidate_hash = system::base16_hash(
+        "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    manifest.candidate_height = 42;
+    manifest.confirmed_height = 40;
+    manifest.checked_height = 41;
+    return manifest;
+}
+
+BOOST_AUTO_TEST_CASE(startup_manifest__from_string__to_string__round_trip)
+{
+    const auto manifest = expected();
+    startup_manifest out{};
+    BOOST_REQUIRE(startup_manifest::from_string(manifest.to_string(), out));
+    BOOST_REQUIRE_EQUAL(out.candidate_hash, manifest.candidate_hash);
+    BOOST_REQUIRE_EQUAL(out.candidate_height, manifest.candidate_height);
+    BOOST_REQUIRE_EQUAL(out.confirmed_height, manifest.confirmed_height);
+    BOOST_REQUIRE_EQUAL(out.checked_height, manifest.checked_height);
+}
+
+BOOST_AUTO_TEST_CASE(startup_manifest__from_string__missing_value__false)
+{
+    startup_manifest out{};
+    BOOST_REQUIRE(!startup_manifest::from_string(
+        "candidate_height 42\nconfirmed_height 40\nchecked_height 41\n", out));
+}
+
+BOOST_AUTO_TEST_CASE(startup_manifest__from_string__malformed_value__false)
+{
+    auto text = expected().to_string();
+    text.append("checked_height 4x\n");
+    startup_manifest out{};
+    BOOST_REQUIRE(!startup_manifest::from_string(text, out));
+}
+
+BOOST_AUTO_TEST_CASE(startup_manifest__from_string__unknown_name__false)
+{
+    auto text = expected().to_string();
+    text.append("requested_height 50\n");
+    startup_manifest out{};
+    BOOST_REQUIRE(!startup_manifest::from_string(text, out));
+}
+
+BOOST_AUTO_TEST_CASE(startup_manifest__load__saved__round_trip_once)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const std::filesystem::path file{ TEST_PATH };
+    const auto manifest = expected();
+    BOOST_REQUIRE(manifest.save(file));
+
+    startup_manifest out{};
+    BOOST_REQUIRE(startup_manifest::load(file, out));
+    BOOST_REQUIRE_EQUAL(out.checked_height, manifest.checked_height);
+    BOOST_REQUIRE(!std::filesystem::exists(file));
+    BOOST_REQUIRE(!startup_manifest::load(file, out));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(store_archive_tests)
+
+namespace fs = std::filesystem;
+
+static void write_file(const fs::path& file, const std::string& text) NOEXCEPT
+{
+    system::ofstream sink{ file };
+    sink << text;
+}
+
+static std::string read_file(const fs::path& file) NOEXCEPT
+{
+    system::ifstream source{ file };
+    std::ostringstream text{};
+    text << source.rdbuf();
+    return text.str();
+}
+
+BOOST_AUTO_TEST_CASE(store_archive__copy__tree__copied_with_progress)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path from{ TEST_DIRECTORY + "/from" };
+    const fs::path to{ TEST_DIRECTORY + "/to" };
+    fs::create_directories(from / "heads");
+    write_file(from / "flush.lock", "");
+    write_file(from / "heads" / "header.head", "abc");
+    write_file(from / "header.data", "abcdef");
+
+    size_t files{};
+    uint64_t bytes{};
+    const auto ec = store_archive::copy(from, to, 4, [&](const fs::path&,
+        uint64_t size) NOEXCEPT
+    {
+        ++files;
+        bytes += size;
+    });
+
+    BOOST_REQUIRE(!ec);
+    BOOST_REQUIRE_EQUAL(files, 3u);
+    BOOST_REQUIRE_EQUAL(bytes, 9u);
+    BOOST_REQUIRE_EQUAL(read_file(to / "heads" / "header.head"), "abc");
+    BOOST_REQUIRE_EQUAL(read_file(to / "header.data"), "abcdef");
+    BOOST_REQUIRE(fs::exists(to / "flush.lock"));
+}
+
+BOOST_AUTO_TEST_CASE(store_archive__copy__existing_target__store_archive)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path from{ TEST_DIRECTORY + "/from" };
+    const fs::path to{ TEST_DIRECTORY + "/to" };
+    fs::create_directories(from);
+    fs::create_directories(to);
+
+    const auto ec = store_archive::copy(from, to, 1, {});
+    BOOST_REQUIRE_EQUAL(ec, error::store_archive);
+}
+
+BOOST_AUTO_TEST_CASE(store_archive__copy__missing_source__store_archive)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path from{ TEST_DIRECTORY + "/from" };
+    const fs::path to{ TEST_DIRECTORY + "/to" };
+
+    const auto ec = store_archive::copy(from, to, 1, {});
+    BOOST_REQUIRE_EQUAL(ec, error::store_archive);
+    BOOST_REQUIRE(!fs::exists(to));
+}
+
+BOOST_AUTO_TEST_CASE(store_archive__fetch__served_tree__copied_with_progress)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path from{ TEST_DIRECTORY + "/from" };
+    const fs::path to{ TEST_DIRECTORY + "/to" };
+    fs::create_directories(from / "heads");
+    fs::create_directories(from / "primary");
+    write_file(from / "flush.lock", "");
+    write_file(from / "heads" / "header.head", "abc");
+    write_file(from / "header.data", "abcdef");
+
+    constexpr uint16_t port = 28'231;
+    std::atomic_bool cancel{};
+    std::thread server([&]() NOEXCEPT
+    {
+        store_archive::serve(from, "127.0.0.1", port, 2, cancel, {});
+    });
+
+    // The server may not yet be listening.
+    size_t files{};
+    code ec{ error::store_sibling };
+    for (auto attempt = 0; ec == error::store_sibling && attempt < 50;
+        ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+        fs::remove_all(to);
+        files = zero;
+        ec = store_archive::fetch("127.0.0.1", port, to, 2,
+            [&](const fs::path&, uint64_t) NOEXCEPT
+            {
+                ++files;
+            });
+    }
+
+    cancel = true;
+    server.join();
+    BOOST_REQUIRE(!ec);
+    BOOST_REQUIRE_EQUAL(files, 3u);
+    BOOST_REQUIRE_EQUAL(read_file(to / "heads" / "header.head"), "abc");
+    BOOST_REQUIRE_EQUAL(read_file(to / "header.data"), "abcdef");
+    BOOST_REQUIRE(fs::exists(to / "flush.lock"));
+    BOOST_REQUIRE(fs::is_directory(to / "primary"));
+}
+
+BOOST_AUTO_TEST_CASE(store_archive__fetch__existing_target__store_archive)
+{
+    BOOST_REQUIRE(test::clear(TEST_DIRECTORY));
+    const fs::path to{ TEST_DIRECTORY + "/to" };
+    fs::create_directories(to);
+
+    const auto ec = store_archive::fetch("127.0.0.1", 28'232, to, 1, {});
+    BOOST_REQUIRE_EQUAL(ec, error::store_archive);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
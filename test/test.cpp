@@ -89,4 +89,20 @@ bool remove(const std::filesystem::path& file_path) NOEXCEPT
     return std::filesystem::remove(system::to_extended_path(file_path), ec);
 }
 
+using namespace system;
+
+const chain::point funding{ base16_hash(
+    "0000000000000000000000000000000000000000000000000000000000000001"), 0 };
+
+chain::transaction::cptr spend(const chain::points& spends,
+    uint32_t locktime) NOEXCEPT
+{
+    chain::inputs ins{};
+    for (const auto& point: spends)
+        ins.emplace_back(chain::point{ point }, chain::script{}, 0);
+
+    return std::make_shared<const chain::transaction>(1, std::move(ins),
+        chain::outputs{ chain::output{ 42, chain::script{} } }, locktime);
+}
+
 } // namespace test
\ No newline at end of file
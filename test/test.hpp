@@ -94,6 +94,13 @@ bool create(const std::filesystem::path& file_path) NOEXCEPT;
 bool exists(const std::filesystem::path& file_path) NOEXCEPT;
 bool remove(const std::filesystem::path& file_path) NOEXCEPT;
 
+// Pool transaction fixture, spends of a common (unconfirmed) funding point.
+extern const system::chain::point funding;
+
+// Spends the given outpoints to one output, the locktime distinguishes txs.
+system::chain::transaction::cptr spend(const system::chain::points& spends,
+    uint32_t locktime=0) NOEXCEPT;
+
 } // namespace test
 
 #endif
\ No newline at end of file
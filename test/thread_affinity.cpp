@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(thread_affinity_tests)
+
+using namespace system;
+
+BOOST_AUTO_TEST_CASE(thread_affinity__parse__empty__true_empty)
+{
+    thread_affinity::cores out{ 42 };
+    BOOST_REQUIRE(thread_affinity::parse(out, ""));
+    BOOST_REQUIRE(out.empty());
+}
+
+BOOST_AUTO_TEST_CASE(thread_affinity__parse__list_and_ranges__expected)
+{
+    thread_affinity::cores out{};
+    BOOST_REQUIRE(thread_affinity::parse(out, "0-2, 8,10-11"));
+    BOOST_REQUIRE(out == thread_affinity::cores({ 0, 1, 2, 8, 10, 11 }));
+}
+
+BOOST_AUTO_TEST_CASE(thread_affinity__parse__invalid__false)
+{
+    thread_affinity::cores out{};
+    BOOST_REQUIRE(!thread_affinity::parse(out, "3-1"));
+    BOOST_REQUIRE(!thread_affinity::parse(out, "a"));
+    BOOST_REQUIRE(!thread_affinity::parse(out, "1,,2"));
+    BOOST_REQUIRE(!thread_affinity::parse(out, "0-99999"));
+    BOOST_REQUIRE(!thread_affinity::parse(out, "numa:x"));
+}
+
+BOOST_AUTO_TEST_CASE(thread_affinity__bind__empty_set__true)
+{
+    boost::asio::io_context service{};
+    BOOST_REQUIRE(thread_affinity::bind(service, 4, {}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(tx_pool_tests)
+
+using namespace system;
+using test::funding;
+using test::spend;
+
+BOOST_AUTO_TEST_CASE(tx_pool__add__disabled__pool_full)
+{
+    tx_pool pool{ 0 };
+    BOOST_REQUIRE(!pool.enabled());
+    BOOST_REQUIRE_EQUAL(pool.add(spend({ funding }), 100), error::pool_full);
+    BOOST_REQUIRE_EQUAL(pool.count(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__add__child__aggregates)
+{
+    tx_pool pool{ 1'000'000 };
+    const auto parent = spend({ funding });
+    const auto child = spend({ { parent->hash(false), 0 } });
+    BOOST_REQUIRE(!pool.add(parent, 100, 4));
+    BOOST_REQUIRE(!pool.add(child, 300, 8));
+    BOOST_REQUIRE_EQUAL(pool.count(), 2u);
+    BOOST_REQUIRE(!is_zero(pool.bytes()));
+
+    const auto ancestors = pool.ancestors(child->hash(false));
+    BOOST_REQUIRE_EQUAL(ancestors.count, 2u);
+    BOOST_REQUIRE_EQUAL(ancestors.fee, 400u);
+    BOOST_REQUIRE_EQUAL(ancestors.sigops, 12u);
+    BOOST_REQUIRE_EQUAL(ancestors.size,
+        parent->virtual_size() + child->virtual_size());
+
+    const auto descendants = pool.descendants(parent->hash(false));
+    BOOST_REQUIRE_EQUAL(descendants.count, 2u);
+    BOOST_REQUIRE_EQUAL(descendants.fee, 400u);
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__add__duplicate__pool_duplicate)
+{
+    tx_pool pool{ 1'000'000 };
+    const auto tx = spend({ funding });
+    BOOST_REQUIRE(!pool.add(tx, 100));
+    BOOST_REQUIRE_EQUAL(pool.add(tx, 100), error::pool_duplicate);
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__add__conflict__pool_conflict)
+{
+    tx_pool pool{ 1'000'000 };
+    const auto tx = spend({ funding });
+    BOOST_REQUIRE(!pool.add(tx, 100));
+    BOOST_REQUIRE_EQUAL(pool.add(spend({ funding }, 1), 200),
+        error::pool_conflict);
+    BOOST_REQUIRE_EQUAL(pool.spender(funding), tx->hash(false));
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__populate__pooled_parent__populated)
+{
+    tx_pool pool{ 1'000'000 };
+    const auto parent = spend({ funding });
+    BOOST_REQUIRE(!pool.add(parent, 100));
+
+    const auto child = spend({ { parent->hash(false), 0 } });
+    BOOST_REQUIRE(pool.populate(*child));
+    BOOST_REQUIRE_EQUAL(child->inputs_ptr()->front()->prevout->value(), 42u);
+
+    const auto orphan = spend({ funding }, 1);
+    BOOST_REQUIRE(!pool.populate(*orphan));
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__remove__parent__removes_descendants)
+{
+    tx_pool pool{ 1'000'000 };
+    const auto parent = spend({ funding });
+    const auto child = spend({ { parent->hash(false), 0 } });
+    const auto grandchild = spend({ { child->hash(false), 0 } });
+    BOOST_REQUIRE(!pool.add(parent, 100));
+    BOOST_REQUIRE(!pool.add(child, 100));
+    BOOST_REQUIRE(!pool.add(grandchild, 100));
+    BOOST_REQUIRE_EQUAL(pool.remove(child->hash(false)), 2u);
+    BOOST_REQUIRE_EQUAL(pool.count(), 1u);
+    BOOST_REQUIRE_EQUAL(pool.descendants(parent->hash(false)).count, 1u);
+    BOOST_REQUIRE_EQUAL(pool.spender({ parent->hash(false), 0 }), null_hash);
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__confirm__parent__retains_child)
+{
+    tx_pool pool{ 1'000'000 };
+    const auto parent = spend({ funding });
+    const auto child = spend({ { parent->hash(false), 0 } });
+    BOOST_REQUIRE(!pool.add(parent, 100));
+    BOOST_REQUIRE(!pool.add(child, 300));
+    BOOST_REQUIRE_EQUAL(pool.confirm(*parent), 1u);
+    BOOST_REQUIRE(pool.exists(child->hash(false)));
+
+    const auto ancestors = pool.ancestors(child->hash(false));
+    BOOST_REQUIRE_EQUAL(ancestors.count, 1u);
+    BOOST_REQUIRE_EQUAL(ancestors.fee, 300u);
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__confirm__conflict__removes_package)
+{
+    tx_pool pool{ 1'000'000 };
+    const auto pooled = spend({ funding });
+    const auto child = spend({ { pooled->hash(false), 0 } });
+    BOOST_REQUIRE(!pool.add(pooled, 100));
+    BOOST_REQUIRE(!pool.add(child, 100));
+    BOOST_REQUIRE_EQUAL(pool.confirm(*spend({ funding }, 1)), 2u);
+    BOOST_REQUIRE_EQUAL(pool.count(), 0u);
+    BOOST_REQUIRE_EQUAL(pool.bytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__highest_lowest__fee_rates__ordered)
+{
+    tx_pool pool{ 1'000'000 };
+    BOOST_REQUIRE_EQUAL(pool.highest(), null_hash);
+    BOOST_REQUIRE_EQUAL(pool.lowest(), null_hash);
+
+    const auto cheap = spend({ funding });
+    const auto dear = spend({ { funding.hash(), 1 } });
+    BOOST_REQUIRE(!pool.add(cheap, 100));
+    BOOST_REQUIRE(!pool.add(dear, 10'000));
+    BOOST_REQUIRE_EQUAL(pool.highest(), dear->hash(false));
+    BOOST_REQUIRE_EQUAL(pool.lowest(), cheap->hash(false));
+
+    // A high fee child raises the ancestor rate of its package above dear.
+    const auto child = spend({ { cheap->hash(false), 0 } });
+    BOOST_REQUIRE(!pool.add(child, 100'000));
+    BOOST_REQUIRE_EQUAL(pool.highest(), child->hash(false));
+    BOOST_REQUIRE_EQUAL(pool.lowest(), dear->hash(false));
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__add__chain_exceeds_package__pool_package)
+{
+    tx_pool pool{ 100'000'000 };
+    auto previous = spend({ funding });
+    BOOST_REQUIRE(!pool.add(previous, 100));
+    for (size_t count = 1; count < tx_pool::maximum_package; ++count)
+    {
+        const auto next = spend({ { previous->hash(false), 0 } });
+        BOOST_REQUIRE(!pool.add(next, 100));
+        previous = next;
+    }
+
+    const auto over = spend({ { previous->hash(false), 0 } });
+    BOOST_REQUIRE_EQUAL(pool.add(over, 100), error::pool_package);
+    BOOST_REQUIRE_EQUAL(pool.count(), tx_pool::maximum_package);
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__add__overflow__evicts_lowest_rate)
+{
+    const auto cheap = spend({ funding });
+    const auto dear = spend({ { funding.hash(), 1 } });
+    const auto cheapest = spend({ { funding.hash(), 2 } });
+
+    // Room for one transaction only.
+    tx_pool pool{ 1'000 };
+    BOOST_REQUIRE(!pool.add(cheap, 100));
+    BOOST_REQUIRE(!pool.add(dear, 10'000));
+    BOOST_REQUIRE(!pool.exists(cheap->hash(false)));
+    BOOST_REQUIRE(pool.exists(dear->hash(false)));
+
+    BOOST_REQUIRE_EQUAL(pool.add(cheapest, 1), error::pool_full);
+    BOOST_REQUIRE_EQUAL(pool.count(), 1u);
+    BOOST_REQUIRE(pool.bytes() <= 1'000u);
+}
+
+BOOST_AUTO_TEST_CASE(tx_pool__drain__confirm_parent__changes)
+{
+    tx_pool pool{ 1'000'000 };
+    const auto parent = spend({ funding });
+    const auto child = spend({ { parent->hash(false), 0 } });
+    BOOST_REQUIRE(!pool.add(parent, 100));
+    BOOST_REQUIRE(!pool.add(child, 300));
+    BOOST_REQUIRE_EQUAL(pool.drain().updated.size(), 2u);
+    BOOST_REQUIRE(pool.drain().updated.empty());
+
+    BOOST_REQUIRE_EQUAL(pool.confirm(*parent), 1u);
+    const auto changes = pool.drain();
+    BOOST_REQUIRE_EQUAL(changes.removed.size(), 1u);
+    BOOST_REQUIRE_EQUAL(changes.removed.front(), parent->hash(false));
+    BOOST_REQUIRE_EQUAL(changes.updated.size(), 1u);
+    BOOST_REQUIRE_EQUAL(changes.updated.front().tx, child);
+    BOOST_REQUIRE_EQUAL(changes.updated.front().ancestors.count, 1u);
+    BOOST_REQUIRE_EQUAL(changes.updated.front().ancestors.fee, 300u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(tx_sketch_tests)
+
+using namespace system;
+
+BOOST_AUTO_TEST_CASE(tx_sketch__decode__empty__empty)
+{
+    const tx_sketch instance{ 4 };
+    tx_sketch::elements out{ 42 };
+    BOOST_REQUIRE(instance.decode(out));
+    BOOST_REQUIRE(out.empty());
+}
+
+BOOST_AUTO_TEST_CASE(tx_sketch__decode__within_capacity__expected)
+{
+    tx_sketch instance{ 4 };
+    instance.add(3);
+    instance.add(0xfffffffe);
+    instance.add(42);
+    instance.add(0);
+
+    tx_sketch::elements out{};
+    BOOST_REQUIRE(instance.decode(out));
+    BOOST_REQUIRE(out == tx_sketch::elements({ 3, 42, 0xfffffffe }));
+}
+
+BOOST_AUTO_TEST_CASE(tx_sketch__merge__shared_elements__difference)
+{
+    tx_sketch ours{ 3 };
+    tx_sketch theirs{ 3 };
+    for (tx_sketch::element value = 1; value < 100; ++value)
+    {
+        ours.add(value);
+        theirs.add(value);
+    }
+
+    ours.add(1'000);
+    theirs.add(2'000);
+    theirs.add(3'000);
+    BOOST_REQUIRE(ours.merge(theirs));
+
+    tx_sketch::elements out{};
+    BOOST_REQUIRE(ours.decode(out));
+    BOOST_REQUIRE(out == tx_sketch::elements({ 1'000, 2'000, 3'000 }));
+    BOOST_REQUIRE(!ours.merge(tx_sketch{ 4 }));
+}
+
+BOOST_AUTO_TEST_CASE(tx_sketch__add__twice__removed)
+{
+    tx_sketch instance{ 2 };
+    instance.add(7);
+    instance.add(9);
+    instance.add(7);
+
+    tx_sketch::elements out{};
+    BOOST_REQUIRE(instance.decode(out));
+    BOOST_REQUIRE(out == tx_sketch::elements({ 9 }));
+}
+
+BOOST_AUTO_TEST_CASE(tx_sketch__from_data__to_data__round_trip)
+{
+    tx_sketch instance{ 2 };
+    instance.add(7);
+    const auto data = instance.to_data();
+    BOOST_REQUIRE_EQUAL(data.size(), 8u);
+
+    tx_sketch copy{ 2 };
+    BOOST_REQUIRE(copy.from_data(data));
+    BOOST_REQUIRE(copy.to_data() == data);
+    BOOST_REQUIRE(!tx_sketch{ 3 }.from_data(data));
+}
+
+BOOST_AUTO_TEST_CASE(tx_sketch__to_short_id__salts__order_independent_nonzero)
+{
+    const auto wtxid = sha256_hash(to_chunk("wtxid"));
+    const auto key = tx_sketch::to_key(1, 2);
+    const auto id = tx_sketch::to_short_id(key, wtxid);
+    BOOST_REQUIRE(!is_zero(id));
+    BOOST_REQUIRE_EQUAL(tx_sketch::to_short_id(tx_sketch::to_key(2, 1), wtxid),
+        id);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(work_cache_tests)
+
+BOOST_AUTO_TEST_CASE(work_cache__enabled__disabled__false)
+{
+    const work_cache instance{ false };
+    BOOST_REQUIRE(!instance.enabled());
+}
+
+BOOST_AUTO_TEST_CASE(work_cache__enabled__enabled__true)
+{
+    const work_cache instance{ true };
+    BOOST_REQUIRE(instance.enabled());
+}
+
+using namespace system;
+using link = database::header_link;
+
+// Every link in a small chain takes the minimum (proof of work limit) bits.
+constexpr uint32_t bits = 0x1d00ffff;
+
+BOOST_AUTO_TEST_CASE(work_cache__put__disabled__false)
+{
+    work_cache instance{ false };
+    uint256_t out{};
+    BOOST_REQUIRE(!instance.put(0, link{}, bits));
+    BOOST_REQUIRE(!instance.get(out, 0));
+}
+
+BOOST_AUTO_TEST_CASE(work_cache__put__terminal_link__false)
+{
+    work_cache instance{ true };
+    BOOST_REQUIRE(!instance.put(link{}, link{}, bits));
+}
+
+BOOST_AUTO_TEST_CASE(work_cache__put__second_anchor__false)
+{
+    work_cache instance{ true };
+    uint256_t out{};
+    BOOST_REQUIRE(instance.put(5, link{}, bits));
+    BOOST_REQUIRE(!instance.put(9, link{}, bits));
+    BOOST_REQUIRE(!instance.get(out, 9));
+}
+
+BOOST_AUTO_TEST_CASE(work_cache__put__anchor_above_genesis__relative)
+{
+    work_cache instance{ true };
+    BOOST_REQUIRE(instance.put(5, link{}, bits));
+    BOOST_REQUIRE(instance.put(6, 5, bits));
+
+    uint256_t base{};
+    uint256_t top{};
+    BOOST_REQUIRE(instance.get(base, 5));
+    BOOST_REQUIRE(instance.get(top, 6));
+    BOOST_REQUIRE_EQUAL(top - base, chain::header::proof(bits));
+}
+
+BOOST_AUTO_TEST_CASE(work_cache__put__uncached_parent__false)
+{
+    work_cache instance{ true };
+    uint256_t out{};
+    BOOST_REQUIRE(!instance.put(2, 1, bits));
+    BOOST_REQUIRE(!instance.get(out, 2));
+}
+
+BOOST_AUTO_TEST_CASE(work_cache__get__uncached__false)
+{
+    const work_cache instance{ true };
+    uint256_t out{};
+    BOOST_REQUIRE(!instance.get(out, 0));
+    BOOST_REQUIRE(!instance.get(out, link{}));
+}
+
+BOOST_AUTO_TEST_CASE(work_cache__put__anchor__proof)
+{
+    work_cache instance{ true };
+    uint256_t out{};
+    BOOST_REQUIRE(instance.put(0, link{}, bits));
+    BOOST_REQUIRE(instance.get(out, 0));
+    BOOST_REQUIRE_EQUAL(out, chain::header::proof(bits));
+}
+
+BOOST_AUTO_TEST_CASE(work_cache__put__chain__cumulative)
+{
+    work_cache instance{ true };
+    BOOST_REQUIRE(instance.put(0, link{}, bits));
+    BOOST_REQUIRE(instance.put(1, 0, bits));
+    BOOST_REQUIRE(instance.put(2, 1, bits));
+    BOOST_REQUIRE(instance.put(3, 2, bits));
+
+    uint256_t out{};
+    const auto proof = chain::header::proof(bits);
+    BOOST_REQUIRE(instance.get(out, 1));
+    BOOST_REQUIRE_EQUAL(out, proof * 2u);
+    BOOST_REQUIRE(instance.get(out, 3));
+    BOOST_REQUIRE_EQUAL(out, proof * 4u);
+}
+
+BOOST_AUTO_TEST_CASE(work_cache__put__branches__strength_is_difference)
+{
+    // Weak branch 0 <- 1 <- 2 <- 3, strong branch 1 <- 4 of greater work.
+    work_cache instance{ true };
+    constexpr uint32_t harder = 0x1c00ffff;
+    BOOST_REQUIRE(instance.put(0, link{}, bits));
+    BOOST_REQUIRE(instance.put(1, 0, bits));
+    BOOST_REQUIRE(instance.put(2, 1, bits));
+    BOOST_REQUIRE(instance.put(3, 2, bits));
+    BOOST_REQUIRE(instance.put(4, 1, harder));
+
+    uint256_t weak{};
+    uint256_t strong{};
+    uint256_t base{};
+    BOOST_REQUIRE(instance.get(weak, 3));
+    BOOST_REQUIRE(instance.get(strong, 4));
+    BOOST_REQUIRE(instance.get(base, 1));
+
+    const auto proof = chain::header::proof(bits);
+    BOOST_REQUIRE_EQUAL(weak - base, proof * 2u);
+    BOOST_REQUIRE_EQUAL(strong - base, chain::header::proof(harder));
+    BOOST_REQUIRE_GT(strong - base, weak - base);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(work_map_tests)
+
+using namespace system;
+
+static work_map::item make_item(uint8_t value, size_t height) NOEXCEPT
+{
+    work_map::item out{};
+    out.hash = hash_digest{};
+    out.hash.front() = value;
+    out.context.height = possible_narrow_cast<uint32_t>(height);
+    return out;
+}
+
+static hash_digest make_hash(uint8_t value) NOEXCEPT
+{
+    return make_item(value, zero).hash;
+}
+
+BOOST_AUTO_TEST_CASE(work_map__construct__default__empty)
+{
+    const work_map instance{};
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.top(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(work_map__construct__unordered__height_ordered)
+{
+    const work_map instance{ work_map::items
+    {
+        make_item(3, 30), make_item(1, 10), make_item(2, 20)
+    } };
+
+    std::vector<size_t> heights{};
+    instance.for_each([&](const auto& item) NOEXCEPT
+    {
+        heights.push_back(item.context.height);
+    });
+
+    BOOST_REQUIRE_EQUAL(instance.size(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 10u);
+    BOOST_REQUIRE_EQUAL(instance.top(), 30u);
+    BOOST_REQUIRE(heights == (std::vector<size_t>{ 10, 20, 30 }));
+}
+
+BOOST_AUTO_TEST_CASE(work_map__erase__outstanding__excluded)
+{
+    work_map instance{ work_map::items{ make_item(1, 10), make_item(2, 20) } };
+    BOOST_REQUIRE(!is_null(instance.find(make_hash(1))));
+    BOOST_REQUIRE(instance.erase(make_hash(1)));
+    BOOST_REQUIRE(!instance.erase(make_hash(1)));
+    BOOST_REQUIRE(!instance.erase(make_hash(3)));
+    BOOST_REQUIRE(is_null(instance.find(make_hash(1))));
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 20u);
+}
+
+BOOST_AUTO_TEST_CASE(work_map__take__partially_received__lowest_outstanding)
+{
+    work_map instance{ work_map::items
+    {
+        make_item(1, 10), make_item(2, 20), make_item(3, 30), make_item(4, 40)
+    } };
+
+    BOOST_REQUIRE(instance.erase(make_hash(2)));
+    const auto part = instance.take(2);
+
+    BOOST_REQUIRE_EQUAL(part->size(), 2u);
+    BOOST_REQUIRE_EQUAL(part->floor(), 10u);
+    BOOST_REQUIRE(!is_null(part->find(make_hash(3))));
+    BOOST_REQUIRE(is_null(part->find(make_hash(4))));
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 40u);
+    BOOST_REQUIRE(is_null(instance.find(make_hash(1))));
+}
+
+BOOST_AUTO_TEST_CASE(work_map__merge__count__moved_in_order)
+{
+    work_map instance{ work_map::items{ make_item(3, 30) } };
+    work_map other{ work_map::items
+    {
+        make_item(1, 10), make_item(2, 20), make_item(4, 40)
+    } };
+
+    instance.merge(other, 2);
+    BOOST_REQUIRE_EQUAL(instance.size(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 10u);
+    BOOST_REQUIRE_EQUAL(instance.top(), 30u);
+    BOOST_REQUIRE_EQUAL(other.size(), 1u);
+    BOOST_REQUIRE(!is_null(other.find(make_hash(4))));
+}
+
+BOOST_AUTO_TEST_CASE(work_map__clear__populated__empty)
+{
+    work_map instance{ work_map::items{ make_item(1, 10) } };
+    instance.clear();
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE(is_null(instance.find(make_hash(1))));
+}
+
+BOOST_AUTO_TEST_CASE(work_map__trim__above_height__lower_retained)
+{
+    work_map instance{ work_map::items
+    {
+        make_item(1, 10), make_item(2, 20), make_item(3, 30), make_item(4, 40)
+    } };
+
+    BOOST_REQUIRE(instance.erase(make_hash(4)));
+    BOOST_REQUIRE_EQUAL(instance.trim(20), 1u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 10u);
+    BOOST_REQUIRE_EQUAL(instance.top(), 20u);
+    BOOST_REQUIRE(is_null(instance.find(make_hash(3))));
+    BOOST_REQUIRE(!is_null(instance.find(make_hash(2))));
+    BOOST_REQUIRE_EQUAL(instance.trim(5), 2u);
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
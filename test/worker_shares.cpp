@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(worker_shares_tests)
+
+BOOST_AUTO_TEST_CASE(worker_shares__fixed__configured_shares_always_claimed)
+{
+    worker_shares instance{ 8, 4, false };
+    BOOST_REQUIRE_EQUAL(instance.validate_capacity(), 8u);
+    BOOST_REQUIRE_EQUAL(instance.check_capacity(), 4u);
+    BOOST_REQUIRE_EQUAL(instance.validate(), 8u);
+    BOOST_REQUIRE_EQUAL(instance.check(), 4u);
+
+    for (size_t claim = 0; claim < 10; ++claim)
+        BOOST_REQUIRE(instance.claim_check());
+}
+
+BOOST_AUTO_TEST_CASE(worker_shares__scaling__pools_sized_to_total_less_one)
+{
+    const worker_shares instance{ 8, 4, true };
+    BOOST_REQUIRE_EQUAL(instance.validate_capacity(), 11u);
+    BOOST_REQUIRE_EQUAL(instance.check_capacity(), 11u);
+    BOOST_REQUIRE_EQUAL(instance.validate(), 8u);
+    BOOST_REQUIRE_EQUAL(instance.check(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(worker_shares__scaling_without_check__fixed)
+{
+    worker_shares instance{ 8, 0, true };
+    BOOST_REQUIRE_EQUAL(instance.validate_capacity(), 8u);
+    BOOST_REQUIRE_EQUAL(instance.check_capacity(), 1u);
+    BOOST_REQUIRE(instance.claim_check());
+}
+
+BOOST_AUTO_TEST_CASE(worker_shares__claim_check__share_in_use__refused_until_released)
+{
+    worker_shares instance{ 2, 2, true };
+    BOOST_REQUIRE(instance.claim_check());
+    BOOST_REQUIRE(instance.claim_check());
+    BOOST_REQUIRE(!instance.claim_check());
+    instance.release_check();
+    BOOST_REQUIRE(instance.claim_check());
+}
+
+BOOST_AUTO_TEST_CASE(worker_shares__set_backlog__deep__moves_to_validate)
+{
+    worker_shares instance{ 2, 2, true };
+    instance.set_backlog(9, 10);
+    BOOST_REQUIRE_EQUAL(instance.validate(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.check(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(worker_shares__set_backlog__shallow__unchanged)
+{
+    worker_shares instance{ 2, 2, true };
+    instance.set_backlog(4, 10);
+    BOOST_REQUIRE_EQUAL(instance.validate(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.check(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(worker_shares__set_backlog__fixed__unchanged)
+{
+    worker_shares instance{ 2, 2, false };
+    instance.set_backlog(10, 10);
+    BOOST_REQUIRE_EQUAL(instance.validate(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.check(), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()